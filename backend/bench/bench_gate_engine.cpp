@@ -0,0 +1,321 @@
+#include "circuit_manager.h"
+#include "gate_engine.h"
+#include "gate_fusion.h"
+#include "qubit_manager.h"
+#include "utils.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <iostream>
+#include <streambuf>
+
+/**
+ * @file bench_gate_engine.cpp
+ * @brief Microbenchmarks for every GateEngine kernel
+ *
+ * Each case runs one operation repeatedly on a register of `qubits` qubits
+ * in uniform superposition and is swept over the register width and the
+ * target position: bit 0 (pairs are adjacent in memory), the middle bit,
+ * and the top bit (pairs half the state apart). items_per_second is
+ * amplitudes of the register per second. bytes_per_second is effective
+ * bandwidth: every amplitude the operation must change counts as one
+ * read and one write, so a CNOT counts half the register and a Toffoli a
+ * quarter. Comparing it with the machine's stream bandwidth shows how far
+ * a kernel is from memory-bound.
+ */
+
+namespace {
+
+/// Register widths every kernel is swept over (24 qubits = 256 MiB)
+constexpr int SWEEP_QUBITS[] = {12, 16, 20, 24};
+
+/// Narrower sweep for formatting, which produces one string per amplitude
+constexpr int FORMAT_QUBITS[] = {8, 12, 16, 20};
+
+// Registers {qubits, target} for target = 0, the middle bit and the top bit
+void targetSweep(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"qubits", "target"});
+    for (int qubits : SWEEP_QUBITS) {
+        for (int target : {0, qubits / 2, qubits - 1}) {
+            bench->Args({qubits, target});
+        }
+    }
+}
+
+// Registers {qubits} only, for whole-register operations
+void widthSweep(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("qubits");
+    for (int qubits : SWEEP_QUBITS) {
+        bench->Arg(qubits);
+    }
+}
+
+// Register in uniform superposition, so no kernel can skip zero amplitudes
+template <typename Real>
+BasicQubitManager<Real> uniformRegister(int numQubits) {
+    BasicQubitManager<Real> qubits(numQubits);
+    const Real amplitude = static_cast<Real>(1.0 / std::sqrt(static_cast<double>(qubits.getDimension())));
+    qubits.getState().setConstant(std::complex<Real>(amplitude, 0));
+    return qubits;
+}
+
+// `count` controls other than target, alternating between the top and bottom bits
+std::vector<int> controlsFor(int numQubits, int target, int count) {
+    std::vector<int> controls;
+    for (int step = 0; static_cast<int>(controls.size()) < count; ++step) {
+        const int qubit = step % 2 == 0 ? numQubits - 1 - step / 2 : step / 2;
+        if (qubit != target) {
+            controls.push_back(qubit);
+        }
+    }
+    return controls;
+}
+
+// A control other than target: the top bit for low targets, bit 0 otherwise
+int controlFor(int numQubits, int target) {
+    return target == 0 ? numQubits - 1 : 0;
+}
+
+// Second control, distinct from target and controlFor
+int secondControlFor(int numQubits, int target) {
+    return target == 1 ? numQubits / 2 + 1 : 1;
+}
+
+// items = register amplitudes; bytes = changed amplitudes x (read + write)
+template <typename Real>
+void reportThroughput(benchmark::State& state, std::uint64_t dimension, double changedFraction) {
+    const auto iterations = static_cast<std::int64_t>(state.iterations());
+    state.SetItemsProcessed(iterations * static_cast<std::int64_t>(dimension));
+    state.SetBytesProcessed(static_cast<std::int64_t>(
+        iterations * changedFraction * 2.0 * static_cast<double>(dimension * sizeof(std::complex<Real>))));
+}
+
+// Runs a kernel that touches changedFraction of a double register per call
+template <typename Kernel>
+void runKernel(benchmark::State& state, double changedFraction, Kernel kernel) {
+    const int num_qubits = static_cast<int>(state.range(0));
+    const int target = static_cast<int>(state.range(1));
+    QubitManager qubits = uniformRegister<double>(num_qubits);
+    GateEngine engine;
+    for (auto _ : state) {
+        kernel(engine, qubits, num_qubits, target);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput<double>(state, qubits.getDimension(), changedFraction);
+}
+
+/// Discards everything written to it (for timing printState without a terminal)
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+}  // namespace
+
+// Single-qubit gates
+
+static void BM_PauliX(benchmark::State& state) {
+    runKernel(state, 1.0, [](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyPauliX(qubits, target);
+    });
+}
+BENCHMARK(BM_PauliX)->Apply(targetSweep);
+
+static void BM_PauliY(benchmark::State& state) {
+    runKernel(state, 1.0, [](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyPauliY(qubits, target);
+    });
+}
+BENCHMARK(BM_PauliY)->Apply(targetSweep);
+
+static void BM_PauliZ(benchmark::State& state) {
+    runKernel(state, 0.5, [](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyPauliZ(qubits, target);
+    });
+}
+BENCHMARK(BM_PauliZ)->Apply(targetSweep);
+
+static void BM_Hadamard(benchmark::State& state) {
+    runKernel(state, 1.0, [](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyHadamard(qubits, target);
+    });
+}
+BENCHMARK(BM_Hadamard)->Apply(targetSweep);
+
+static void BM_SingleQubitGate(benchmark::State& state) {
+    const double angle = 0.3;
+    const kernels::Matrix2 matrix = {std::cos(angle), std::complex<double>(0.0, -std::sin(angle)),
+                                     std::complex<double>(0.0, -std::sin(angle)), std::cos(angle)};
+    runKernel(state, 1.0, [&matrix](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applySingleQubitGate(qubits, target, matrix);
+    });
+}
+BENCHMARK(BM_SingleQubitGate)->Apply(targetSweep);
+
+static void BM_RotationRX(benchmark::State& state) {
+    const std::vector<double> angles = {0.3};
+    runKernel(state, 1.0, [&angles](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyRotation(qubits, OpCode::RX, target, angles);
+    });
+}
+BENCHMARK(BM_RotationRX)->Apply(targetSweep);
+
+static void BM_RotationRZ(benchmark::State& state) {
+    const std::vector<double> angles = {0.3};
+    runKernel(state, 1.0, [&angles](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyRotation(qubits, OpCode::RZ, target, angles);
+    });
+}
+BENCHMARK(BM_RotationRZ)->Apply(targetSweep);
+
+static void BM_RotationU3(benchmark::State& state) {
+    const std::vector<double> angles = {0.3, -0.7, 1.1};
+    runKernel(state, 1.0, [&angles](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyRotation(qubits, OpCode::U3, target, angles);
+    });
+}
+BENCHMARK(BM_RotationU3)->Apply(targetSweep);
+
+// Multi-qubit gates (target as swept; controls placed by controlFor)
+
+static void BM_CNOT(benchmark::State& state) {
+    runKernel(state, 0.5, [](GateEngine& engine, QubitManager& qubits, int n, int target) {
+        engine.applyCNOT(qubits, controlFor(n, target), target);
+    });
+}
+BENCHMARK(BM_CNOT)->Apply(targetSweep);
+
+static void BM_SWAP(benchmark::State& state) {
+    runKernel(state, 0.5, [](GateEngine& engine, QubitManager& qubits, int n, int target) {
+        engine.applySWAP(qubits, controlFor(n, target), target);
+    });
+}
+BENCHMARK(BM_SWAP)->Apply(targetSweep);
+
+static void BM_Toffoli(benchmark::State& state) {
+    runKernel(state, 0.25, [](GateEngine& engine, QubitManager& qubits, int n, int target) {
+        engine.applyToffoli(qubits, controlFor(n, target), secondControlFor(n, target), target);
+    });
+}
+BENCHMARK(BM_Toffoli)->Apply(targetSweep);
+
+static void BM_ControlledGate(benchmark::State& state) {
+    const kernels::Matrix2 matrix = {0.6, 0.8, 0.8, -0.6};
+    runKernel(state, 0.5, [&matrix](GateEngine& engine, QubitManager& qubits, int n, int target) {
+        engine.applyControlledGate(qubits, matrix, target, {controlFor(n, target)});
+    });
+}
+BENCHMARK(BM_ControlledGate)->Apply(targetSweep);
+
+static void BM_MCX4(benchmark::State& state) {
+    const std::vector<int> controls =
+        controlsFor(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)), 4);
+    runKernel(state, 1.0 / 16, [&controls](GateEngine& engine, QubitManager& qubits, int, int target) {
+        engine.applyMCX(qubits, controls, target);
+    });
+}
+BENCHMARK(BM_MCX4)->Apply(targetSweep);
+
+static void BM_CZ(benchmark::State& state) {
+    runKernel(state, 0.25, [](GateEngine& engine, QubitManager& qubits, int n, int target) {
+        engine.applyCZ(qubits, controlFor(n, target), target);
+    });
+}
+BENCHMARK(BM_CZ)->Apply(targetSweep);
+
+static void BM_CPhase(benchmark::State& state) {
+    runKernel(state, 0.25, [](GateEngine& engine, QubitManager& qubits, int n, int target) {
+        engine.applyCPhase(qubits, controlFor(n, target), target, 0.3);
+    });
+}
+BENCHMARK(BM_CPhase)->Apply(targetSweep);
+
+// Compiled ops through applyOp, in both precisions
+
+// Lowers H on target followed by CNOTs into a single fused op of `width` qubits
+CompiledOp fusedOp(int numQubits, int target, int width) {
+    CircuitManager circuit;
+    circuit.addGate("H", target);
+    circuit.addGate("CNOT", controlFor(numQubits, target), target);
+    if (width == 3) {
+        circuit.addGate("CNOT", secondControlFor(numQubits, target), target);
+    }
+    CompiledCircuit plan = circuit.compile(numQubits);
+    fuseGates(plan, width);
+    return plan.ops.front();
+}
+
+template <typename Real, int Width>
+static void BM_ApplyOpFused(benchmark::State& state) {
+    const int num_qubits = static_cast<int>(state.range(0));
+    const CompiledOp op = fusedOp(num_qubits, static_cast<int>(state.range(1)), Width);
+    BasicQubitManager<Real> qubits = uniformRegister<Real>(num_qubits);
+    GateEngine engine;
+    for (auto _ : state) {
+        engine.applyOp(qubits, op);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput<Real>(state, qubits.getDimension(), 1.0);
+}
+BENCHMARK_TEMPLATE(BM_ApplyOpFused, double, 2)->Apply(targetSweep);
+BENCHMARK_TEMPLATE(BM_ApplyOpFused, double, 3)->Apply(targetSweep);
+BENCHMARK_TEMPLATE(BM_ApplyOpFused, float, 2)->Apply(targetSweep);
+
+// Measurement and whole-register utilities
+
+template <typename Real>
+static void BM_MeasureQubit(benchmark::State& state) {
+    const int num_qubits = static_cast<int>(state.range(0));
+    const int target = static_cast<int>(state.range(1));
+    BasicQubitManager<Real> qubits = uniformRegister<Real>(num_qubits);
+    GateEngine engine;
+    engine.setSeed(1);
+    // After the first collapse every call still sums all 2^n probabilities and rescales
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.measureQubit(qubits, target));
+    }
+    reportThroughput<Real>(state, qubits.getDimension(), 1.0);
+}
+BENCHMARK_TEMPLATE(BM_MeasureQubit, double)->Apply(targetSweep);
+BENCHMARK_TEMPLATE(BM_MeasureQubit, float)->Apply(targetSweep);
+
+static void BM_NormalizeState(benchmark::State& state) {
+    QubitManager qubits = uniformRegister<double>(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        normalizeState(qubits.getState());
+        benchmark::ClobberMemory();
+    }
+    reportThroughput<double>(state, qubits.getDimension(), 1.0);
+}
+BENCHMARK(BM_NormalizeState)->Apply(widthSweep);
+
+// Formatting: bytes_per_second counts characters of output instead of state traffic
+
+static void BM_FormatBasisState(benchmark::State& state) {
+    const int num_qubits = static_cast<int>(state.range(0));
+    const std::uint64_t dimension = std::uint64_t{1} << num_qubits;
+    for (auto _ : state) {
+        for (std::uint64_t index = 0; index < dimension; ++index) {
+            benchmark::DoNotOptimize(formatBasisState(index, num_qubits));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * dimension));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * dimension * num_qubits));
+}
+BENCHMARK(BM_FormatBasisState)->ArgName("qubits")->Arg(FORMAT_QUBITS[0])->Arg(FORMAT_QUBITS[1])
+    ->Arg(FORMAT_QUBITS[2])->Arg(FORMAT_QUBITS[3]);
+
+static void BM_PrintState(benchmark::State& state) {
+    QubitManager qubits = uniformRegister<double>(static_cast<int>(state.range(0)));
+    NullBuffer sink;
+    std::streambuf* terminal = std::cout.rdbuf(&sink);
+    for (auto _ : state) {
+        qubits.printState();
+    }
+    std::cout.rdbuf(terminal);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * qubits.getDimension()));
+}
+BENCHMARK(BM_PrintState)->ArgName("qubits")->Arg(FORMAT_QUBITS[0])->Arg(FORMAT_QUBITS[1])
+    ->Arg(FORMAT_QUBITS[2])->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
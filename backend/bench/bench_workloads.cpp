@@ -0,0 +1,646 @@
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**
+ * @file bench_workloads.cpp
+ * @brief End-to-end workload driver with JSON results and baseline comparison
+ *
+ * Builds standard circuits (GHZ, QFT, quantum-volume layers, Grover search,
+ * Cuccaro ripple-carry adders) at each requested width, runs them through
+ * CircuitManager::executeCircuit and records, per workload:
+ *
+ *   first_seconds     first run, including compilation, fusion and blocking
+ *   best_seconds      fastest of the timed repeats (cached plan)
+ *   median_seconds    median of the timed repeats
+ *   gates_per_second  circuit gates / best_seconds
+ *   peak_rss_bytes    resident-set high-water mark during the workload
+ *   checksum          weighted sum of the final amplitudes
+ *
+ * With --compare, each result is matched to the baseline entry of the same
+ * name, width and depth. The run fails (exit code 1) if best_seconds grew by
+ * more than --threshold or the checksum moved beyond CHECKSUM_TOLERANCE.
+ * The checksum is a weighted sum rather than a hash of the bits, so SIMD
+ * variants that round differently still agree.
+ *
+ * Usage:
+ *   workload_bench [--qubits 16,20] [--depth 20] [--repeat 5] [--seed 1]
+ *                  [--workloads ghz,qft,qv,grover,adder] [--output FILE]
+ *                  [--compare BASELINE] [--threshold 0.10]
+ */
+
+namespace {
+
+/// Revision of the JSON layout written by writeJson
+constexpr int RESULT_SCHEMA_VERSION = 1;
+
+/// Relative change in the checksum treated as a different final state
+constexpr double CHECKSUM_TOLERANCE = 1e-9;
+
+/// Default fractional slowdown reported as a regression
+constexpr double DEFAULT_THRESHOLD = 0.10;
+
+constexpr double PI = 3.14159265358979323846;
+
+/// One generated circuit
+struct Workload {
+    std::string name;
+    int qubits = 0;
+    int depth = 0;
+    CircuitManager circuit;
+};
+
+/// Measurements of one workload (also the unit of the JSON file)
+struct WorkloadResult {
+    std::string name;
+    int qubits = 0;
+    int depth = 0;
+    long long gates = 0;
+    int repeats = 0;
+    double first_seconds = 0.0;
+    double best_seconds = 0.0;
+    double median_seconds = 0.0;
+    double gates_per_second = 0.0;
+    long long peak_rss_bytes = 0;
+    double checksum = 0.0;
+};
+
+/// Command-line options
+struct Options {
+    std::vector<int> qubits = {20};
+    int depth = 20;
+    int repeat = 5;
+    std::uint64_t seed = 1;
+    std::vector<std::string> workloads = {"ghz", "qft", "qv", "grover", "adder"};
+    std::string output;
+    std::string compare;
+    double threshold = DEFAULT_THRESHOLD;
+};
+
+// Generators. `depth` means layers for qv, iterations for grover and
+// repeated additions for adder; ghz and qft have a fixed structure.
+
+// H then a CNOT chain: one long entangling dependency chain
+void buildGhz(CircuitManager& circuit, int n, int, std::mt19937_64&) {
+    circuit.addGate("H", 0);
+    for (int q = 1; q < n; ++q) {
+        circuit.addGate("CNOT", q, q - 1);
+    }
+}
+
+// Textbook QFT on a random basis state: n(n-1)/2 controlled phases and n/2 swaps
+void buildQft(CircuitManager& circuit, int n, int, std::mt19937_64& rng) {
+    for (int q = 0; q < n; ++q) {
+        if (rng() & 1) {
+            circuit.addGate("X", q);
+        }
+    }
+    for (int target = n - 1; target >= 0; --target) {
+        circuit.addGate("H", target);
+        for (int control = target - 1; control >= 0; --control) {
+            circuit.addControlledGate("PHASE", target, {control}, {}, PI / std::ldexp(1.0, target - control));
+        }
+    }
+    for (int q = 0; q < n / 2; ++q) {
+        circuit.addGate("SWAP", q, n - 1 - q);
+    }
+}
+
+// Quantum-volume layers: a random pairing, then a generic two-qubit block
+// (U3 on both, CNOT, three times, and a final U3 pair) on every pair
+void buildQuantumVolume(CircuitManager& circuit, int n, int depth, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> angle(-PI, PI);
+    auto randomU3 = [&](int qubit) {
+        circuit.addParameterizedGate("U3", qubit, {GateParameter{angle(rng)}, GateParameter{angle(rng)},
+                                                   GateParameter{angle(rng)}});
+    };
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    for (int layer = 0; layer < depth; ++layer) {
+        std::shuffle(order.begin(), order.end(), rng);
+        for (int pair = 0; pair + 1 < n; pair += 2) {
+            const int a = order[pair], b = order[pair + 1];
+            for (int round = 0; round < 3; ++round) {
+                randomU3(a);
+                randomU3(b);
+                circuit.addGate("CNOT", b, a);
+            }
+            randomU3(a);
+            randomU3(b);
+        }
+    }
+}
+
+// Phase flip of one basis state: Z on the top qubit, conditioned on the others matching `bits`
+void flipPhaseOf(CircuitManager& circuit, int n, std::uint64_t bits) {
+    std::vector<int> controls, negative;
+    for (int q = 0; q < n - 1; ++q) {
+        ((bits >> q) & 1 ? controls : negative).push_back(q);
+    }
+    const bool top_is_zero = ((bits >> (n - 1)) & 1) == 0;
+    if (top_is_zero) {
+        circuit.addGate("X", n - 1);
+    }
+    circuit.addControlledGate("Z", n - 1, controls, negative);
+    if (top_is_zero) {
+        circuit.addGate("X", n - 1);
+    }
+}
+
+// Grover search for one random marked state; depth caps the iteration count
+void buildGrover(CircuitManager& circuit, int n, int depth, std::mt19937_64& rng) {
+    const std::uint64_t marked = rng() & ((std::uint64_t{1} << n) - 1);
+    const int optimal = static_cast<int>(PI / 4.0 * std::sqrt(std::ldexp(1.0, n)));
+    const int iterations = std::max(1, std::min(depth, optimal));
+    for (int q = 0; q < n; ++q) {
+        circuit.addGate("H", q);
+    }
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        flipPhaseOf(circuit, n, marked);
+        for (int q = 0; q < n; ++q) {
+            circuit.addGate("H", q);
+        }
+        flipPhaseOf(circuit, n, 0);
+        for (int q = 0; q < n; ++q) {
+            circuit.addGate("H", q);
+        }
+    }
+}
+
+// Cuccaro ripple-carry adder b += a, repeated depth times. Layout: carry-in
+// at 0, a_i at 1 + 2i, b_i at 2 + 2i, carry-out at 2m + 1 (m = (n - 2) / 2)
+void buildAdder(CircuitManager& circuit, int n, int depth, std::mt19937_64& rng) {
+    const int m = (n - 2) / 2;
+    auto a = [](int i) { return 1 + 2 * i; };
+    auto b = [](int i) { return 2 + 2 * i; };
+    const int carry_out = 2 * m + 1;
+    for (int i = 0; i < m; ++i) {
+        if (rng() & 1) circuit.addGate("X", a(i));
+        if (rng() & 1) circuit.addGate("X", b(i));
+    }
+    for (int repetition = 0; repetition < depth; ++repetition) {
+        // MAJ(c, b_i, a_i) up the register, where c is the previous a (or carry-in)
+        for (int i = 0; i < m; ++i) {
+            const int c = i == 0 ? 0 : a(i - 1);
+            circuit.addGate("CNOT", b(i), a(i));
+            circuit.addGate("CNOT", c, a(i));
+            circuit.addGate("TOFFOLI", a(i), c, b(i));
+        }
+        circuit.addGate("CNOT", carry_out, a(m - 1));
+        // UMA(c, b_i, a_i) back down
+        for (int i = m - 1; i >= 0; --i) {
+            const int c = i == 0 ? 0 : a(i - 1);
+            circuit.addGate("TOFFOLI", a(i), c, b(i));
+            circuit.addGate("CNOT", c, a(i));
+            circuit.addGate("CNOT", b(i), c);
+        }
+    }
+}
+
+using Generator = std::function<void(CircuitManager&, int, int, std::mt19937_64&)>;
+
+/// Generators by name, with the smallest width each one accepts
+const std::map<std::string, std::pair<Generator, int>>& generators() {
+    static const std::map<std::string, std::pair<Generator, int>> table = {
+        {"ghz", {buildGhz, 2}},
+        {"qft", {buildQft, 2}},
+        {"qv", {buildQuantumVolume, 2}},
+        {"grover", {buildGrover, 2}},
+        {"adder", {buildAdder, 4}},
+    };
+    return table;
+}
+
+// Resets the kernel's resident-set high-water mark, if supported. Freed heap
+// pages from the previous workload are returned first, or glibc would keep
+// them resident and every later workload would report them as its own.
+void resetPeakRss() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+// VmHWM since the last reset; ru_maxrss (peak of the whole process) otherwise
+long long peakRssBytes() {
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            long long kilobytes = 0;
+            status >> kilobytes;
+            return kilobytes * 1024;
+        }
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<long long>(usage.ru_maxrss) * 1024;
+}
+
+// Sum of w_i (Re a_i + sqrt(2) Im a_i) with fixed pseudo-random weights in [1, 2)
+double stateChecksum(const QubitManager& qubits) {
+    const std::complex<double>* state = qubits.getState().data();
+    double sum = 0.0;
+    for (std::uint64_t i = 0; i < qubits.getDimension(); ++i) {
+        std::uint64_t z = i + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        const double weight = 1.0 + static_cast<double>((z ^ (z >> 31)) >> 11) * 0x1.0p-53;
+        sum += weight * (state[i].real() + std::sqrt(2.0) * state[i].imag());
+    }
+    return sum;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+WorkloadResult runWorkload(Workload& workload, int repeats) {
+    WorkloadResult result;
+    result.name = workload.name;
+    result.qubits = workload.qubits;
+    result.depth = workload.depth;
+    result.gates = workload.circuit.getCircuitSize();
+    result.repeats = repeats;
+
+    resetPeakRss();
+    QubitManager qubits(workload.qubits);
+    auto start = std::chrono::steady_clock::now();
+    workload.circuit.executeCircuit(qubits);
+    result.first_seconds = secondsSince(start);
+    result.checksum = stateChecksum(qubits);
+
+    std::vector<double> times;
+    for (int r = 0; r < repeats; ++r) {
+        qubits.initializeZeroState();
+        start = std::chrono::steady_clock::now();
+        workload.circuit.executeCircuit(qubits);
+        times.push_back(secondsSince(start));
+    }
+    if (times.empty()) {
+        times.push_back(result.first_seconds);
+    }
+    std::sort(times.begin(), times.end());
+    result.best_seconds = times.front();
+    result.median_seconds = times[times.size() / 2];
+    result.gates_per_second = result.best_seconds > 0.0 ? result.gates / result.best_seconds : 0.0;
+    result.peak_rss_bytes = peakRssBytes();
+    return result;
+}
+
+// JSON output: one object per workload, numbers printed round-trippable
+
+void writeJson(std::ostream& out, const std::vector<WorkloadResult>& results) {
+    out << std::setprecision(17);
+    out << "{\n  \"schema\": " << RESULT_SCHEMA_VERSION << ",\n"
+        << "  \"threads\": " << ThreadPool::global().getThreadCount() << ",\n"
+        << "  \"simd\": \"" << kernels::simdLevelName(kernels::getSimdLevel()) << "\",\n"
+        << "  \"workloads\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const WorkloadResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"name\": \"" << r.name << "\", \"qubits\": " << r.qubits << ", \"depth\": " << r.depth
+            << ", \"gates\": " << r.gates << ", \"repeats\": " << r.repeats
+            << ", \"first_seconds\": " << r.first_seconds << ", \"best_seconds\": " << r.best_seconds
+            << ", \"median_seconds\": " << r.median_seconds << ", \"gates_per_second\": " << r.gates_per_second
+            << ", \"peak_rss_bytes\": " << r.peak_rss_bytes << ", \"checksum\": " << r.checksum << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/// Minimal JSON value: enough to read files written by writeJson
+struct JsonValue {
+    enum class Kind { Null, Number, String, Array, Object } kind = Kind::Null;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* find(const std::string& key) const {
+        for (const auto& member : members) {
+            if (member.first == key) {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : text(text) {}
+
+    JsonValue parseDocument() {
+        JsonValue value = parseValue();
+        skipSpace();
+        if (position != text.size()) {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    const std::string& text;
+    std::size_t position = 0;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("Invalid baseline JSON at offset " + std::to_string(position) + ": " + message);
+    }
+
+    void skipSpace() {
+        while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+            ++position;
+        }
+    }
+
+    void expect(char c) {
+        skipSpace();
+        if (position >= text.size() || text[position] != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++position;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string value;
+        while (position < text.size() && text[position] != '"') {
+            if (text[position] == '\\' && position + 1 < text.size()) {
+                ++position;
+            }
+            value += text[position++];
+        }
+        expect('"');
+        return value;
+    }
+
+    JsonValue parseValue() {
+        skipSpace();
+        if (position >= text.size()) {
+            fail("unexpected end");
+        }
+        JsonValue value;
+        const char c = text[position];
+        if (c == '{') {
+            value.kind = JsonValue::Kind::Object;
+            ++position;
+            skipSpace();
+            if (position < text.size() && text[position] == '}') {
+                ++position;
+                return value;
+            }
+            do {
+                std::string key = parseString();
+                expect(':');
+                value.members.emplace_back(std::move(key), parseValue());
+                skipSpace();
+            } while (position < text.size() && text[position] == ',' && ++position);
+            expect('}');
+        } else if (c == '[') {
+            value.kind = JsonValue::Kind::Array;
+            ++position;
+            skipSpace();
+            if (position < text.size() && text[position] == ']') {
+                ++position;
+                return value;
+            }
+            do {
+                value.items.push_back(parseValue());
+                skipSpace();
+            } while (position < text.size() && text[position] == ',' && ++position);
+            expect(']');
+        } else if (c == '"') {
+            value.kind = JsonValue::Kind::String;
+            value.text = parseString();
+        } else if (text.compare(position, 4, "null") == 0) {
+            position += 4;
+        } else {
+            char* end = nullptr;
+            value.kind = JsonValue::Kind::Number;
+            value.number = std::strtod(text.c_str() + position, &end);
+            if (end == text.c_str() + position) {
+                fail("expected a value");
+            }
+            position = static_cast<std::size_t>(end - text.c_str());
+        }
+        return value;
+    }
+};
+
+std::vector<WorkloadResult> readBaseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open baseline " + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+    const JsonValue document = JsonReader(text).parseDocument();
+    const JsonValue* workloads = document.find("workloads");
+    if (workloads == nullptr || workloads->kind != JsonValue::Kind::Array) {
+        throw std::runtime_error(path + " has no \"workloads\" array");
+    }
+
+    auto number = [&path](const JsonValue& entry, const char* key) {
+        const JsonValue* field = entry.find(key);
+        if (field == nullptr || field->kind != JsonValue::Kind::Number) {
+            throw std::runtime_error(path + ": workload entry lacks numeric \"" + key + "\"");
+        }
+        return field->number;
+    };
+    std::vector<WorkloadResult> results;
+    for (const JsonValue& entry : workloads->items) {
+        const JsonValue* name = entry.find("name");
+        if (name == nullptr || name->kind != JsonValue::Kind::String) {
+            throw std::runtime_error(path + ": workload entry lacks \"name\"");
+        }
+        WorkloadResult result;
+        result.name = name->text;
+        result.qubits = static_cast<int>(number(entry, "qubits"));
+        result.depth = static_cast<int>(number(entry, "depth"));
+        result.best_seconds = number(entry, "best_seconds");
+        result.checksum = number(entry, "checksum");
+        results.push_back(result);
+    }
+    return results;
+}
+
+// Prints one line per workload; returns the number of regressions and state mismatches
+int compareWithBaseline(const std::vector<WorkloadResult>& current, const std::vector<WorkloadResult>& baseline,
+                        double threshold) {
+    int failures = 0;
+    std::cout << "\nComparison with baseline (threshold " << std::fixed << std::setprecision(1) << threshold * 100.0
+              << "%):\n" << std::defaultfloat;
+    for (const WorkloadResult& now : current) {
+        auto match = std::find_if(baseline.begin(), baseline.end(), [&now](const WorkloadResult& before) {
+            return before.name == now.name && before.qubits == now.qubits && before.depth == now.depth;
+        });
+        std::cout << "  " << std::left << std::setw(8) << now.name << std::right << " n=" << std::setw(2)
+                  << now.qubits << " d=" << std::setw(3) << now.depth << "  ";
+        if (match == baseline.end()) {
+            std::cout << "new (no baseline entry)\n";
+            continue;
+        }
+        const double ratio = now.best_seconds / match->best_seconds;
+        const double checksum_scale = std::max(1.0, std::abs(match->checksum));
+        const bool state_changed = std::abs(now.checksum - match->checksum) > CHECKSUM_TOLERANCE * checksum_scale;
+        std::cout << std::fixed << std::setprecision(4) << match->best_seconds << " s -> " << now.best_seconds
+                  << " s (" << std::showpos << std::setprecision(1) << (ratio - 1.0) * 100.0 << "%)"
+                  << std::noshowpos << std::defaultfloat;
+        if (ratio > 1.0 + threshold) {
+            std::cout << "  REGRESSION";
+            ++failures;
+        } else if (ratio < 1.0 - threshold) {
+            std::cout << "  improved";
+        }
+        if (state_changed) {
+            std::cout << "  STATE CHANGED (checksum " << std::setprecision(17) << match->checksum << " -> "
+                      << now.checksum << ")" << std::defaultfloat;
+            ++failures;
+        }
+        std::cout << "\n";
+    }
+    return failures;
+}
+
+template <typename T>
+std::vector<T> splitList(const std::string& text, T (*convert)(const std::string&)) {
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(convert(item));
+        }
+    }
+    return values;
+}
+
+int toInt(const std::string& text) {
+    return std::stoi(text);
+}
+
+std::string toString(const std::string& text) {
+    return text;
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag == "--help" || flag == "-h") {
+            std::cout << "Usage: " << argv[0] << " [--qubits 16,20] [--depth 20] [--repeat 5] [--seed 1]\n"
+                      << "       [--workloads ghz,qft,qv,grover,adder] [--output FILE]\n"
+                      << "       [--compare BASELINE] [--threshold 0.10]\n";
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + flag);
+        }
+        const std::string value = argv[++i];
+        if (flag == "--qubits") {
+            options.qubits = splitList<int>(value, toInt);
+        } else if (flag == "--depth") {
+            options.depth = std::stoi(value);
+        } else if (flag == "--repeat") {
+            options.repeat = std::stoi(value);
+        } else if (flag == "--seed") {
+            options.seed = std::stoull(value);
+        } else if (flag == "--workloads") {
+            options.workloads = splitList<std::string>(value, toString);
+        } else if (flag == "--output") {
+            options.output = value;
+        } else if (flag == "--compare") {
+            options.compare = value;
+        } else if (flag == "--threshold") {
+            options.threshold = std::stod(value);
+        } else {
+            throw std::invalid_argument("Unknown option " + flag);
+        }
+    }
+    if (options.depth < 1 || options.repeat < 0 || options.threshold < 0.0) {
+        throw std::invalid_argument("--depth must be >= 1, --repeat >= 0 and --threshold >= 0");
+    }
+    for (const std::string& name : options.workloads) {
+        if (generators().count(name) == 0) {
+            throw std::invalid_argument("Unknown workload " + name);
+        }
+    }
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const Options options = parseOptions(argc, argv);
+        std::vector<WorkloadResult> results;
+        for (int qubits : options.qubits) {
+            for (const std::string& name : options.workloads) {
+                const auto& [generate, min_qubits] = generators().at(name);
+                if (qubits < min_qubits || qubits > QubitManager::MAX_QUBITS) {
+                    throw std::invalid_argument(name + " needs " + std::to_string(min_qubits) + " to " +
+                                                std::to_string(QubitManager::MAX_QUBITS) + " qubits");
+                }
+                // Same seed per (workload, width), so reruns build identical circuits
+                std::mt19937_64 rng(options.seed * 1000003 + qubits);
+                Workload workload;
+                workload.name = name;
+                workload.qubits = qubits;
+                workload.depth = options.depth;
+                generate(workload.circuit, qubits, options.depth, rng);
+
+                WorkloadResult result = runWorkload(workload, options.repeat);
+                std::cout << std::left << std::setw(8) << name << std::right << " n=" << std::setw(2) << qubits
+                          << " gates=" << std::setw(7) << result.gates << "  best " << std::fixed
+                          << std::setprecision(4) << result.best_seconds << " s  median " << result.median_seconds
+                          << " s  " << std::setprecision(0) << result.gates_per_second << " gates/s  rss "
+                          << std::setprecision(1) << result.peak_rss_bytes / 1048576.0 << " MiB"
+                          << std::defaultfloat << "\n";
+                results.push_back(result);
+            }
+        }
+
+        if (!options.output.empty()) {
+            std::ofstream file(options.output);
+            if (!file) {
+                throw std::runtime_error("Cannot write " + options.output);
+            }
+            writeJson(file, results);
+        } else if (options.compare.empty()) {
+            writeJson(std::cout, results);
+        }
+        if (!options.compare.empty()) {
+            return compareWithBaseline(results, readBaseline(options.compare), options.threshold) > 0 ? 1 : 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "adjoint_gradient.h"
+#include "gate_engine.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Re⟨a|b⟩ summed over the thread pool
+double realInnerProduct(const QubitManager& a, const QubitManager& b) {
+    const std::complex<double>* x = a.getState().data();
+    const std::complex<double>* y = b.getState().data();
+    return ThreadPool::global().parallelSum(0, a.getDimension(), [&](std::uint64_t begin, std::uint64_t end) {
+        double sum = 0.0;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            sum += x[i].real() * y[i].real() + x[i].imag() * y[i].imag();
+        }
+        return sum;
+    });
+}
+
+}  // namespace
+
+GradientResult adjointGradient(const CompiledCircuit& plan, std::size_t numParameters,
+                               QubitManager& qubits, const ObservableFunction& observable) {
+    if (plan.num_qubits != qubits.getNumQubits()) {
+        throw std::invalid_argument("Plan was compiled for " + std::to_string(plan.num_qubits) +
+                                    " qubits, register has " + std::to_string(qubits.getNumQubits()));
+    }
+    if (std::any_of(plan.ops.begin(), plan.ops.end(),
+                    [](const CompiledOp& op) {
+                        return op.opcode == OpCode::Measure || op.opcode == OpCode::Noise;
+                    })) {
+        throw std::invalid_argument("Adjoint gradient does not support MEASURE or noise");
+    }
+
+    GradientResult result;
+    result.gradient.assign(numParameters, 0.0);
+    const std::uint64_t dimension = qubits.getDimension();
+
+    // Forward pass: qubits holds |ψ⟩, lambda holds H|ψ⟩
+    for (const CompiledOp& op : plan.ops) {
+        GateEngine::applyToBuffer(qubits.getState().data(), dimension, op);
+    }
+    QubitManager lambda(qubits);
+    observable(lambda);
+    result.expectation = realInnerProduct(qubits, lambda);
+
+    // Backward pass: undo each op on both states, differentiating symbolic ones on the way
+    QubitManager mu(qubits.getNumQubits());
+    for (auto it = plan.ops.rbegin(); it != plan.ops.rend(); ++it) {
+        const CompiledOp adjoint = adjointOp(*it);
+        GateEngine::applyToBuffer(qubits.getState().data(), dimension, adjoint);
+
+        if (it->param_slot >= 0) {
+            const ParametricGate& gate = plan.parametric[it->param_slot];
+            for (int k = 0; k < parameterCount(gate.opcode); ++k) {
+                const int symbol = gate.parameters[k].symbol;
+                if (symbol < 0) {
+                    continue;
+                }
+                if (symbol >= static_cast<int>(numParameters)) {
+                    throw std::out_of_range("Parameter index out of range: " + std::to_string(symbol));
+                }
+                CompiledOp derivative = *it;
+                derivative.matrix = rotationDerivative(gate.opcode, gate.angles.data(), k);
+                mu.getState() = qubits.getState();
+                GateEngine::applyToBuffer(mu.getState().data(), dimension, derivative);
+                result.gradient[symbol] += 2.0 * realInnerProduct(lambda, mu);
+            }
+        }
+
+        GateEngine::applyToBuffer(lambda.getState().data(), dimension, adjoint);
+    }
+    return result;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "qubit_manager.h"
+#include "compiled_circuit.h"
+#include <functional>
+#include <vector>
+
+/**
+ * @file adjoint_gradient.h
+ * @brief Gradients of expectation values by the adjoint method
+ *
+ * For E = ⟨ψ|H|ψ⟩ with |ψ⟩ = U_N...U_1|ψ0⟩, one forward pass produces |ψ⟩
+ * and |λ⟩ = H|ψ⟩. The circuit is then undone gate by gate on both states;
+ * at each symbolic gate, dE/dθ = 2 Re⟨λ|dU/dθ|φ⟩ where |φ⟩ is the state just
+ * before that gate. Every parameter costs one extra sweep regardless of the
+ * parameter count, and only three state buffers are live at any time.
+ */
+
+/// Applies a Hermitian observable H to a register in place (|ψ⟩ -> H|ψ⟩)
+using ObservableFunction = std::function<void(QubitManager&)>;
+
+/**
+ * @struct GradientResult
+ * @brief Expectation value and its derivative for every circuit parameter
+ */
+struct GradientResult {
+    /// ⟨ψ|H|ψ⟩ for the final state
+    double expectation = 0.0;
+
+    /// dE/d parameter, indexed like the parameter table
+    std::vector<double> gradient;
+};
+
+/**
+ * @brief Computes ⟨H⟩ and its gradient with respect to every symbolic parameter
+ * @param plan Bound, measurement-free plan (see bindParameters)
+ * @param numParameters Size of the parameter table
+ * @param qubits Initial state; restored to it (up to rounding) on return
+ * @param observable Callable applying H in place
+ * @return Expectation value and numParameters derivatives
+ * @throws std::invalid_argument if the plan width differs from qubits or it contains MEASURE or NOISE
+ *
+ * A symbol used by several gates accumulates the contribution of each.
+ */
+GradientResult adjointGradient(const CompiledCircuit& plan, std::size_t numParameters,
+                               QubitManager& qubits, const ObservableFunction& observable);
@@ -0,0 +1,87 @@
+#include "batched_state.h"
+#include "thread_pool.h"
+#include "utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+BatchedState::BatchedState(int numQubits, std::uint64_t batchSize)
+    : num_qubits(numQubits), batch_size(batchSize) {
+    if (numQubits < 1 || numQubits > MAX_QUBITS) {
+        throw std::invalid_argument("Batched registers must have between 1 and " +
+                                    std::to_string(MAX_QUBITS) + " qubits");
+    }
+    if (batchSize == 0 || batchSize > (std::uint64_t{1} << (QubitManager::MAX_QUBITS - numQubits))) {
+        throw std::invalid_argument("Invalid batch size: " + std::to_string(batchSize));
+    }
+
+    // Widen blocks up to BLOCK_BYTES, but not past the batch itself
+    const std::uint64_t member_bytes = QubitManager::estimateMemoryBytes(numQubits);
+    while ((member_bytes << (lane_bits + 1)) <= BLOCK_BYTES &&
+           (std::uint64_t{1} << lane_bits) < batchSize) {
+        ++lane_bits;
+    }
+    num_blocks = (batchSize + getBlockWidth() - 1) >> lane_bits;
+
+    std::uint64_t required = num_blocks * getBlockDimension() * sizeof(std::complex<double>);
+    std::uint64_t available = availableMemoryBytes();
+    if (required > available) {
+        throw std::runtime_error("Batched state needs " + std::to_string(required) +
+                                 " bytes but only " + std::to_string(available) + " bytes are available");
+    }
+    std::uint64_t padded = (required + QubitManager::STATE_ALIGNMENT - 1) /
+                           QubitManager::STATE_ALIGNMENT * QubitManager::STATE_ALIGNMENT;
+    void* raw = std::aligned_alloc(QubitManager::STATE_ALIGNMENT, padded);
+    if (raw == nullptr) {
+        throw std::runtime_error("Failed to allocate " + std::to_string(padded) + " bytes for batched state");
+    }
+    buffer.reset(static_cast<std::complex<double>*>(raw));
+    initializeZeroState();
+}
+
+void BatchedState::initializeZeroState() {
+    std::complex<double>* amplitudes = buffer.get();
+    const std::uint64_t lanes = getBlockWidth();
+    const std::uint64_t block_dimension = getBlockDimension();
+    ThreadPool::global().parallelFor(0, num_blocks * block_dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        std::fill(amplitudes + begin, amplitudes + end, std::complex<double>(0.0, 0.0));
+    });
+    // |0...0⟩ of every lane is the first stripe of each block
+    for (std::uint64_t block = 0; block < num_blocks; ++block) {
+        std::fill(amplitudes + block * block_dimension, amplitudes + block * block_dimension + lanes,
+                  std::complex<double>(1.0, 0.0));
+    }
+}
+
+void BatchedState::checkMember(std::uint64_t member) const {
+    if (member >= batch_size) {
+        throw std::out_of_range("Batch member out of range: " + std::to_string(member));
+    }
+}
+
+void BatchedState::setInitialState(std::uint64_t member, const std::string& stateString) {
+    checkMember(member);
+    std::uint64_t index = parseBasisState(stateString, num_qubits);
+    for (std::uint64_t i = 0; i < getDimension(); ++i) {
+        buffer.get()[offsetOf(i, member)] = (i == index) ? 1.0 : 0.0;
+    }
+}
+
+void BatchedState::loadState(std::uint64_t member, const QubitManager& qubits) {
+    checkMember(member);
+    if (qubits.getNumQubits() != num_qubits) {
+        throw std::invalid_argument("Register width does not match batched state");
+    }
+    for (std::uint64_t i = 0; i < getDimension(); ++i) {
+        buffer.get()[offsetOf(i, member)] = qubits.getState()(i);
+    }
+}
+
+void BatchedState::storeState(std::uint64_t member, QubitManager& qubits) const {
+    checkMember(member);
+    if (qubits.getNumQubits() != num_qubits) {
+        throw std::invalid_argument("Register width does not match batched state");
+    }
+    for (std::uint64_t i = 0; i < getDimension(); ++i) {
+        qubits.getState()(i) = amplitude(i, member);
+    }
+}
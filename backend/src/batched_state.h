@@ -0,0 +1,128 @@
+#pragma once
+
+#include "qubit_manager.h"
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+/**
+ * @class BatchedState
+ * @brief Many small state vectors stored with the batch dimension contiguous
+ *
+ * Members are grouped into blocks of W lanes (W a power of two). Within a
+ * block, amplitude `index` of lane `l` lives at blockData(b)[index * W + l],
+ * so each block is exactly a state vector of n + log2(W) qubits whose low
+ * qubits are the lane index: a gate on qubit q of every member is the same
+ * gate on qubit q + log2(W) of the block. GateEngine::executeBatch runs the
+ * whole plan on one block before moving to the next, with the SIMD kernels
+ * sweeping contiguous lane stripes instead of the few amplitudes of one
+ * tiny register.
+ *
+ * W is chosen so that a block stays around BLOCK_BYTES (cache resident);
+ * padding lanes start in |0...0⟩ and are never exposed.
+ */
+class BatchedState {
+public:
+    /// Largest register width supported for batching
+    static constexpr int MAX_QUBITS = 12;
+
+    /// Target size of one block of lanes (fits in L2 on common CPUs)
+    static constexpr std::uint64_t BLOCK_BYTES = std::uint64_t{1} << 18;
+
+    /**
+     * @brief Allocates batchSize registers of numQubits qubits, all in |0...0⟩
+     * @param numQubits Qubits per member (1-MAX_QUBITS)
+     * @param batchSize Number of members (at least 1)
+     * @throws std::invalid_argument if numQubits or batchSize is out of range
+     * @throws std::runtime_error if the buffer does not fit in available memory
+     */
+    BatchedState(int numQubits, std::uint64_t batchSize);
+
+    /// Resets every member to |0...0⟩
+    void initializeZeroState();
+
+    /**
+     * @brief Sets one member to a computational basis state
+     * @param member Batch member index
+     * @param stateString Binary label, highest qubit first (e.g., "0101")
+     * @throws std::out_of_range if member >= batch size
+     * @throws std::invalid_argument if the label is malformed
+     */
+    void setInitialState(std::uint64_t member, const std::string& stateString);
+
+    /**
+     * @brief Copies a full register into one member
+     * @param member Batch member index
+     * @param qubits Source register (same width)
+     * @throws std::out_of_range if member >= batch size
+     * @throws std::invalid_argument if the widths differ
+     */
+    void loadState(std::uint64_t member, const QubitManager& qubits);
+
+    /**
+     * @brief Copies one member out into a register
+     * @param member Batch member index
+     * @param qubits Destination register (same width)
+     * @throws std::out_of_range if member >= batch size
+     * @throws std::invalid_argument if the widths differ
+     */
+    void storeState(std::uint64_t member, QubitManager& qubits) const;
+
+    /**
+     * @brief Gets one amplitude of one member
+     * @param index Basis state index in [0, 2^numQubits)
+     * @param member Batch member index
+     * @return Amplitude (unchecked)
+     */
+    std::complex<double> amplitude(std::uint64_t index, std::uint64_t member) const {
+        return buffer.get()[offsetOf(index, member)];
+    }
+
+    /// Qubits per member
+    int getNumQubits() const { return num_qubits; }
+
+    /// Number of members visible to callers
+    std::uint64_t getBatchSize() const { return batch_size; }
+
+    /// Lanes per block (W, a power of two)
+    std::uint64_t getBlockWidth() const { return std::uint64_t{1} << lane_bits; }
+
+    /// log2(W): how many low qubits the lane index occupies
+    int getLaneBits() const { return lane_bits; }
+
+    /// Number of blocks (batch size rounded up to whole blocks)
+    std::uint64_t getNumBlocks() const { return num_blocks; }
+
+    /// Amplitudes per member (2^numQubits)
+    std::uint64_t getDimension() const { return std::uint64_t{1} << num_qubits; }
+
+    /// Amplitudes per block (getDimension() * getBlockWidth())
+    std::uint64_t getBlockDimension() const { return getDimension() << lane_bits; }
+
+    /// Interleaved amplitudes of one block
+    std::complex<double>* blockData(std::uint64_t block) { return buffer.get() + block * getBlockDimension(); }
+    const std::complex<double>* blockData(std::uint64_t block) const {
+        return buffer.get() + block * getBlockDimension();
+    }
+
+private:
+    /// Releases buffers obtained from std::aligned_alloc
+    struct AlignedDeleter {
+        void operator()(std::complex<double>* ptr) const { std::free(ptr); }
+    };
+
+    std::unique_ptr<std::complex<double>[], AlignedDeleter> buffer;
+    int num_qubits;
+    std::uint64_t batch_size;
+    int lane_bits = 0;
+    std::uint64_t num_blocks = 0;
+
+    std::uint64_t offsetOf(std::uint64_t index, std::uint64_t member) const {
+        const std::uint64_t lanes = getBlockWidth();
+        return (member >> lane_bits) * getBlockDimension() + index * lanes + (member & (lanes - 1));
+    }
+
+    void checkMember(std::uint64_t member) const;
+};
@@ -0,0 +1,215 @@
+#include "cache_blocking.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Qubits that must sit below the block width for op to run within a block
+std::vector<int> lowQubits(const CompiledOp& op) {
+    switch (op.opcode) {
+        case OpCode::Measure:
+        case OpCode::Noise:
+            return {};
+        case OpCode::SWAP:
+        case OpCode::Fused:
+            return std::vector<int>(op.positions.begin(), op.positions.begin() + op.num_positions);
+        default:
+            return {op.target};  // Controls (of CNOT, TOFFOLI and Controlled ops) may stay high
+    }
+}
+
+// CNOT / TOFFOLI as an X on the target where every control (mask_a) is set
+CompiledOp asControlledX(const CompiledOp& op) {
+    CompiledOp controlled;
+    controlled.opcode = OpCode::Controlled;
+    controlled.target = op.target;
+    controlled.matrix = {0.0, 1.0, 1.0, 0.0};
+    controlled.control_mask = op.mask_a;
+    controlled.control_values = op.mask_a;
+    controlled.gate_index = op.gate_index;
+    return controlled;
+}
+
+// Every qubit an op reads or writes, controls included
+std::uint64_t touchedQubits(const CompiledOp& op) {
+    if (op.opcode == OpCode::Controlled) {
+        return op.control_mask | (std::uint64_t{1} << op.target);
+    }
+    std::uint64_t mask = op.target >= 0 ? std::uint64_t{1} << op.target : 0;
+    for (int p = 0; p < op.num_positions; ++p) {
+        mask |= std::uint64_t{1} << op.positions[p];
+    }
+    return mask;
+}
+
+bool isBarrier(const CompiledOp& op) {
+    return op.opcode == OpCode::Measure || op.opcode == OpCode::Noise;
+}
+
+}  // namespace
+
+BlockedCircuit blockCircuit(const CompiledCircuit& plan, int blockQubits) {
+    if (blockQubits < kernels::MAX_DENSE_QUBITS) {
+        throw std::invalid_argument("Block width must be at least " +
+                                    std::to_string(kernels::MAX_DENSE_QUBITS) + " qubits");
+    }
+    const int num_qubits = plan.num_qubits;
+    BlockedCircuit blocked;
+    blocked.num_qubits = num_qubits;
+    blocked.block_qubits = std::min(blockQubits, num_qubits);
+    blocked.measurement_gates = plan.measurement_gates;
+    const int block_qubits = blocked.block_qubits;
+    const std::uint64_t low_bits = (std::uint64_t{1} << block_qubits) - 1;
+
+    // Op indices at which each logical qubit has to be low, for furthest-next-use
+    // eviction. Ops sharing a qubit are never reordered, so a per-qubit cursor
+    // skips the uses already emitted
+    std::vector<std::vector<std::size_t>> uses(num_qubits);
+    for (std::size_t i = 0; i < plan.ops.size(); ++i) {
+        for (int qubit : lowQubits(plan.ops[i])) {
+            uses[qubit].push_back(i);
+        }
+    }
+    std::vector<std::size_t> used(num_qubits, 0);
+    auto nextUse = [&](int qubit) {
+        return used[qubit] < uses[qubit].size() ? uses[qubit][used[qubit]]
+                                                : std::numeric_limits<std::size_t>::max();
+    };
+
+    // layout[logical] = physical position, occupant[physical] = logical qubit
+    std::vector<int> layout(num_qubits), occupant(num_qubits);
+    std::iota(layout.begin(), layout.end(), 0);
+    std::iota(occupant.begin(), occupant.end(), 0);
+
+    SweepStage group{true, {}};
+    auto flush = [&] {
+        if (!group.ops.empty()) {
+            blocked.stages.push_back(std::move(group));
+            group = SweepStage{true, {}};
+        }
+    };
+    auto addWhole = [&](const CompiledOp& op) {
+        flush();
+        blocked.stages.push_back(SweepStage{false, {BlockedOp{op}}});
+    };
+    auto swapPhysical = [&](int a, int b) {
+        CompiledOp swap = lowerOp(OpCode::SWAP, num_qubits, a, b);
+        if (a < block_qubits && b < block_qubits) {
+            group.ops.push_back(BlockedOp{swap});
+        } else {
+            addWhole(swap);
+            ++blocked.stats.swaps;
+        }
+        std::swap(occupant[a], occupant[b]);
+        layout[occupant[a]] = a;
+        layout[occupant[b]] = b;
+    };
+
+    // Appends op i to the current pass, swapping its high qubits in first
+    auto emit = [&](std::size_t i) {
+        const CompiledOp& op = plan.ops[i];
+        const std::vector<int> needed = lowQubits(op);
+        for (int qubit : needed) {
+            if (layout[qubit] < block_qubits) {
+                continue;
+            }
+            int victim = -1;
+            std::size_t victim_use = 0;
+            for (int p = 0; p < block_qubits; ++p) {
+                if (std::find(needed.begin(), needed.end(), occupant[p]) != needed.end()) {
+                    continue;
+                }
+                const std::size_t use = nextUse(occupant[p]);
+                if (victim < 0 || use > victim_use) {
+                    victim = p;
+                    victim_use = use;
+                }
+            }
+            swapPhysical(victim, layout[qubit]);
+        }
+        for (int qubit : needed) {
+            ++used[qubit];
+        }
+
+        // High controls select whole blocks instead of amplitudes within one
+        BlockedOp entry{permuteQubits(op, layout)};
+        CompiledOp& physical = entry.op;
+        if ((physical.opcode == OpCode::CNOT || physical.opcode == OpCode::Toffoli) &&
+            (physical.mask_a & ~low_bits)) {
+            physical = asControlledX(physical);
+        }
+        if (physical.opcode == OpCode::Controlled) {
+            entry.block_mask = (physical.control_mask & ~low_bits) >> block_qubits;
+            entry.block_values = (physical.control_values & ~low_bits) >> block_qubits;
+            physical.control_mask &= low_bits;
+            physical.control_values &= low_bits;
+        }
+        group.ops.push_back(entry);
+    };
+
+    // Ops that need a SWAP wait here; later ops on other qubits commute with
+    // them and may still join the current pass
+    std::vector<std::size_t> pending;
+    std::uint64_t pending_qubits = 0;
+    auto drain = [&] {
+        for (std::size_t i : pending) {
+            emit(i);
+        }
+        pending.clear();
+        pending_qubits = 0;
+    };
+
+    for (std::size_t i = 0; i < plan.ops.size(); ++i) {
+        const CompiledOp& op = plan.ops[i];
+        if (isBarrier(op)) {
+            drain();
+            addWhole(permuteQubits(op, layout));
+            continue;
+        }
+        ++blocked.stats.sweeps_before;
+
+        const std::uint64_t touched = touchedQubits(op);
+        const std::vector<int> needed = lowQubits(op);
+        const bool fits = std::all_of(needed.begin(), needed.end(),
+                                      [&](int qubit) { return layout[qubit] < block_qubits; });
+        if (fits && !(touched & pending_qubits)) {
+            emit(i);
+            continue;
+        }
+        pending.push_back(i);
+        pending_qubits |= touched;
+
+        // Once every low qubit waits on a deferred op, nothing else can join the pass
+        std::uint64_t free_low = 0;
+        for (int p = 0; p < block_qubits; ++p) {
+            free_low |= std::uint64_t{1} << occupant[p];
+        }
+        if (!(free_low & ~pending_qubits)) {
+            drain();
+        }
+    }
+    drain();
+
+    for (int qubit = 0; qubit < num_qubits; ++qubit) {
+        if (layout[qubit] != qubit) {
+            swapPhysical(qubit, layout[qubit]);
+        }
+    }
+    flush();
+
+    blocked.stats.sweeps_after = static_cast<int>(std::count_if(blocked.stages.begin(), blocked.stages.end(),
+        [](const SweepStage& stage) { return stage.blocked || !isBarrier(stage.ops.front().op); }));
+    return blocked;
+}
+
+int outOfCoreBlockQubits(int numQubits, std::size_t amplitudeBytes, std::uint64_t availableBytes) {
+    const std::uint64_t budget = availableBytes / OUT_OF_CORE_MEMORY_SHARE;
+    int width = kernels::MAX_DENSE_QUBITS;
+    while (width < numQubits && (std::uint64_t{amplitudeBytes} << (width + 1)) <= budget) {
+        ++width;
+    }
+    return std::min(width, numQubits);
+}
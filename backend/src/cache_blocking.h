@@ -0,0 +1,122 @@
+#pragma once
+
+#include "compiled_circuit.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file cache_blocking.h
+ * @brief Plan transformation running groups of gates block by block
+ *
+ * Once the state vector is far larger than the last-level cache, every
+ * gate streams all 2^n amplitudes from DRAM. A gate whose qubits are all
+ * below the block width b only mixes amplitudes within aligned blocks of
+ * 2^b amplitudes, so a run of such "low" gates can be applied to one
+ * cache-resident block at a time: the run costs one pass over memory
+ * instead of one pass per gate.
+ *
+ * blockCircuit groups consecutive ops into such sweep stages. A gate whose
+ * target is a high qubit is deferred while later gates on other qubits
+ * (which commute with it) keep joining the current stage. Deferred gates
+ * then have their qubits exchanged with low ones by SWAPs, and the pass
+ * tracks the resulting logical-to-physical layout; the low qubit evicted
+ * is the one whose next use is furthest away. Controls on
+ * high qubits need no SWAP: they are constant within a block and become a
+ * per-block condition. MEASURE and NOISE run on the whole register, on the
+ * relabeled qubit. The identity layout is restored at the end.
+ */
+
+/// Default block width: 2^15 amplitudes (512 KiB) stay resident in L2
+constexpr int DEFAULT_BLOCK_QUBITS = 15;
+
+/// Narrowest register CircuitManager runs blocked (2^22 amplitudes = 64 MiB, beyond common L3 sizes)
+constexpr int MIN_BLOCKED_QUBITS = 22;
+
+/// File-backed registers run in chunks of at most 1/OUT_OF_CORE_MEMORY_SHARE of available memory
+constexpr int OUT_OF_CORE_MEMORY_SHARE = 4;
+
+/**
+ * @brief Picks the block width for a register that streams from disk
+ * @param numQubits Register width
+ * @param amplitudeBytes Bytes per amplitude
+ * @param availableBytes Memory the page cache may use
+ * @return Widest width whose block fits in availableBytes / OUT_OF_CORE_MEMORY_SHARE,
+ *         clamped to [kernels::MAX_DENSE_QUBITS, numQubits]
+ *
+ * Each sweep stage of blockCircuit then reads and writes every chunk of
+ * the file once, in address order, while the chunk stays in memory.
+ */
+int outOfCoreBlockQubits(int numQubits, std::size_t amplitudeBytes, std::uint64_t availableBytes);
+
+/**
+ * @struct BlockedOp
+ * @brief One op of a sweep stage and the blocks it applies to
+ */
+struct BlockedOp {
+    /// Op on physical qubits (all below the block width in blocked stages)
+    CompiledOp op;
+
+    /// Block-index bits of high controls, and the value each must have
+    std::uint64_t block_mask = 0;
+    std::uint64_t block_values = 0;
+};
+
+/**
+ * @struct SweepStage
+ * @brief One pass over the state vector
+ */
+struct SweepStage {
+    /// True if ops are applied block by block; false for one op on the whole register
+    bool blocked = false;
+
+    /// Ops in execution order (exactly one if not blocked)
+    std::vector<BlockedOp> ops;
+};
+
+/**
+ * @struct BlockingStats
+ * @brief Passes over memory before and after blocking
+ */
+struct BlockingStats {
+    /// Passes of the unblocked plan (ops other than MEASURE and NOISE)
+    int sweeps_before = 0;
+
+    /// Passes of the blocked plan (blocked stages plus whole-register gates and SWAPs)
+    int sweeps_after = 0;
+
+    /// SWAPs on a high qubit inserted to change the layout
+    int swaps = 0;
+};
+
+/**
+ * @struct BlockedCircuit
+ * @brief Executable plan produced by blockCircuit
+ */
+struct BlockedCircuit {
+    /// Register width the plan runs on
+    int num_qubits = 0;
+
+    /// Block width b: blocks hold 2^b amplitudes
+    int block_qubits = 0;
+
+    /// Passes in execution order
+    std::vector<SweepStage> stages;
+
+    /// Originating gate index for each measurement slot (as in CompiledCircuit)
+    std::vector<int> measurement_gates;
+
+    /// Pass counts for the plan
+    BlockingStats stats;
+};
+
+/**
+ * @brief Groups a compiled plan into cache-sized sweep stages
+ * @param plan Compiled (and possibly fused) plan
+ * @param blockQubits Block width, at least kernels::MAX_DENSE_QUBITS; clamped to plan.num_qubits
+ * @return Blocked plan leaving the register in the same state as plan
+ * @throws std::invalid_argument if blockQubits is too small
+ *
+ * Run it with GateEngine::executeBlocked. Symbolic ops are copied, so the
+ * plan must be rebuilt after rebinding parameters.
+ */
+BlockedCircuit blockCircuit(const CompiledCircuit& plan, int blockQubits);
@@ -0,0 +1,314 @@
+#include "checkpoint.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+/// Written as-is to disk; readers compare byte_order to detect foreign-endian files
+struct RawHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t num_qubits;
+    std::uint32_t precision_bytes;
+    std::uint32_t layout;
+    std::uint32_t flags;
+    std::uint64_t next_gate;
+    std::uint64_t payload_bytes;
+    std::uint64_t checksum;
+};
+static_assert(sizeof(RawHeader) <= CHECKPOINT_HEADER_BYTES, "Header must fit in its page");
+
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::uint32_t FLAG_CHECKSUM = 1;
+
+constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+
+/// Bytes hashed per parallel work item
+constexpr std::size_t CHECKSUM_BLOCK_BYTES = std::size_t{1} << 20;
+
+inline std::uint64_t rotl(std::uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline std::uint64_t mixRound(std::uint64_t acc, std::uint64_t word) {
+    return rotl(acc + word * PRIME2, 31) * PRIME1;
+}
+
+// Four independent lanes keep the multiplier busy; the tail is folded bytewise
+std::uint64_t hashBlock(const unsigned char* data, std::size_t bytes, std::uint64_t seed) {
+    std::uint64_t lanes[4] = {seed + PRIME1, seed + PRIME2, seed, seed - PRIME1};
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i + 8 * lane, sizeof(word));
+            lanes[lane] = mixRound(lanes[lane], word);
+        }
+    }
+    std::uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    for (; i < bytes; ++i) {
+        hash = rotl(hash ^ (data[i] * PRIME3), 11) * PRIME1;
+    }
+    hash ^= bytes;
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+/// Closes a descriptor on scope exit, including when a load throws
+struct FileCloser {
+    int fd;
+    ~FileCloser() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+std::string errnoText() {
+    return std::strerror(errno);
+}
+
+// Writes header and payload with as few syscalls as the kernel allows
+// (a single write is capped at about 2 GiB on Linux)
+void writeAll(int fd, const void* header, const void* payload, std::size_t payloadBytes,
+              const std::string& path) {
+    iovec parts[2] = {{const_cast<void*>(header), CHECKPOINT_HEADER_BYTES},
+                      {const_cast<void*>(payload), payloadBytes}};
+    iovec* next = parts;
+    int remaining = 2;
+    while (remaining > 0) {
+        ssize_t written = ::writev(fd, next, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Cannot write checkpoint " + path + ": " + errnoText());
+        }
+        std::size_t advance = static_cast<std::size_t>(written);
+        while (remaining > 0 && advance >= next->iov_len) {
+            advance -= next->iov_len;
+            ++next;
+            --remaining;
+        }
+        if (remaining > 0) {
+            next->iov_base = static_cast<char*>(next->iov_base) + advance;
+            next->iov_len -= advance;
+        }
+    }
+}
+
+// Serializes the header, then writes path.tmp and renames it into place
+void writeCheckpoint(const std::string& path, const void* payload, std::uint64_t payloadBytes,
+                     int numQubits, int precisionBytes, StateLayout layout,
+                     std::uint64_t nextGate, bool withChecksum) {
+    std::vector<unsigned char> page(CHECKPOINT_HEADER_BYTES, 0);
+    RawHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.num_qubits = static_cast<std::uint32_t>(numQubits);
+    header.precision_bytes = static_cast<std::uint32_t>(precisionBytes);
+    header.layout = static_cast<std::uint32_t>(layout);
+    header.flags = withChecksum ? FLAG_CHECKSUM : 0;
+    header.next_gate = nextGate;
+    header.payload_bytes = payloadBytes;
+    header.checksum = withChecksum ? checksum64(payload, payloadBytes) : 0;
+    std::memcpy(page.data(), &header, sizeof(header));
+
+    const std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create checkpoint " + temporary + ": " + errnoText());
+    }
+    try {
+        writeAll(fd, page.data(), payload, payloadBytes, temporary);
+        if (::fdatasync(fd) != 0) {
+            throw std::runtime_error("Cannot sync checkpoint " + temporary + ": " + errnoText());
+        }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(temporary.c_str());
+        throw;
+    }
+    ::close(fd);
+    if (::rename(temporary.c_str(), path.c_str()) != 0) {
+        const std::string reason = errnoText();
+        ::unlink(temporary.c_str());
+        throw std::runtime_error("Cannot move checkpoint into " + path + ": " + reason);
+    }
+}
+
+// Validates a raw header against the file it came from
+CheckpointInfo decodeHeader(const RawHeader& header, std::uint64_t fileBytes, const std::string& path) {
+    if (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a state checkpoint");
+    }
+    if (header.byte_order != BYTE_ORDER_MARK) {
+        throw std::runtime_error(path + " was written on a machine of different byte order");
+    }
+    if (header.version != CHECKPOINT_VERSION) {
+        throw std::runtime_error(path + " has checkpoint version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(CHECKPOINT_VERSION));
+    }
+    if (header.num_qubits < 1 || header.num_qubits > static_cast<std::uint32_t>(QubitManager::MAX_QUBITS) ||
+        (header.precision_bytes != 4 && header.precision_bytes != 8) || header.layout > 1) {
+        throw std::runtime_error(path + " has a corrupt checkpoint header");
+    }
+    const std::uint64_t expected = (std::uint64_t{1} << header.num_qubits) * 2 * header.precision_bytes;
+    if (header.payload_bytes != expected || fileBytes < CHECKPOINT_HEADER_BYTES + expected) {
+        throw std::runtime_error(path + " is truncated: expected " + std::to_string(expected) +
+                                 " payload bytes for " + std::to_string(header.num_qubits) + " qubits");
+    }
+
+    CheckpointInfo info;
+    info.num_qubits = static_cast<int>(header.num_qubits);
+    info.precision_bytes = static_cast<int>(header.precision_bytes);
+    info.layout = static_cast<StateLayout>(header.layout);
+    info.next_gate = header.next_gate;
+    info.payload_bytes = header.payload_bytes;
+    info.has_checksum = (header.flags & FLAG_CHECKSUM) != 0;
+    info.checksum = header.checksum;
+    return info;
+}
+
+// Opens a checkpoint and decodes its header; the caller owns the descriptor
+int openCheckpoint(const std::string& path, CheckpointInfo& info, std::uint64_t& fileBytes) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open checkpoint " + path + ": " + errnoText());
+    }
+    FileCloser guard{fd};
+    struct stat status;
+    RawHeader header{};
+    if (::fstat(fd, &status) != 0 ||
+        ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        throw std::runtime_error("Cannot read checkpoint header of " + path);
+    }
+    fileBytes = static_cast<std::uint64_t>(status.st_size);
+    info = decodeHeader(header, fileBytes, path);
+    guard.fd = -1;  // Validated: hand the descriptor to the caller
+    return fd;
+}
+
+void checkLayout(const CheckpointInfo& info, int precisionBytes, StateLayout layout, const std::string& path) {
+    if (info.precision_bytes != precisionBytes || info.layout != layout) {
+        auto describe = [](int precision, StateLayout kind) {
+            return std::string(precision == 8 ? "double" : "float") +
+                   (kind == StateLayout::Split ? " split" : " interleaved");
+        };
+        throw std::runtime_error(path + " holds a " + describe(info.precision_bytes, info.layout) +
+                                 " state, expected " + describe(precisionBytes, layout));
+    }
+}
+
+void verifyChecksum(const CheckpointInfo& info, const void* payload, const std::string& path) {
+    if (info.has_checksum && checksum64(payload, info.payload_bytes) != info.checksum) {
+        throw std::runtime_error("Checksum mismatch in checkpoint " + path);
+    }
+}
+
+}  // namespace
+
+std::uint64_t checksum64(const void* data, std::size_t bytes) {
+    const auto* base = static_cast<const unsigned char*>(data);
+    const std::size_t blocks = (bytes + CHECKSUM_BLOCK_BYTES - 1) / CHECKSUM_BLOCK_BYTES;
+    std::vector<std::uint64_t> hashes(blocks);
+    ThreadPool::global().parallelFor(0, blocks, [&](std::uint64_t begin, std::uint64_t end) {
+        for (std::uint64_t block = begin; block < end; ++block) {
+            const std::size_t offset = block * CHECKSUM_BLOCK_BYTES;
+            hashes[block] = hashBlock(base + offset, std::min(CHECKSUM_BLOCK_BYTES, bytes - offset), block);
+        }
+    });
+    return hashBlock(reinterpret_cast<const unsigned char*>(hashes.data()),
+                     hashes.size() * sizeof(std::uint64_t), bytes);
+}
+
+template <typename Real>
+void saveCheckpoint(const std::string& path, const BasicQubitManager<Real>& qubits,
+                    std::uint64_t nextGate, bool withChecksum) {
+    writeCheckpoint(path, qubits.getState().data(), qubits.getDimension() * sizeof(std::complex<Real>),
+                    qubits.getNumQubits(), sizeof(Real), StateLayout::Interleaved, nextGate, withChecksum);
+}
+
+void saveCheckpoint(const std::string& path, const SplitState& state,
+                    std::uint64_t nextGate, bool withChecksum) {
+    writeCheckpoint(path, state.real(), 2 * state.getDimension() * sizeof(double),
+                    state.getNumQubits(), sizeof(double), StateLayout::Split, nextGate, withChecksum);
+}
+
+CheckpointInfo readCheckpointInfo(const std::string& path) {
+    CheckpointInfo info;
+    std::uint64_t file_bytes = 0;
+    ::close(openCheckpoint(path, info, file_bytes));
+    return info;
+}
+
+// Maps the whole file privately; the payload starts on the page after the header
+template <typename Real>
+BasicQubitManager<Real> loadCheckpoint(const std::string& path, bool verify) {
+    CheckpointInfo info;
+    std::uint64_t file_bytes = 0;
+    void* mapping = MAP_FAILED;
+    {
+        FileCloser file{openCheckpoint(path, info, file_bytes)};
+        checkLayout(info, sizeof(Real), StateLayout::Interleaved, path);
+        mapping = ::mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_NORESERVE, file.fd, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Cannot map checkpoint " + path + ": " + errnoText());
+        }
+    }
+    ::madvise(mapping, file_bytes, MADV_SEQUENTIAL);
+
+    BasicQubitManager<Real> qubits =
+        BasicQubitManager<Real>::adoptMapping(info.num_qubits, mapping, file_bytes, CHECKPOINT_HEADER_BYTES);
+    if (verify) {
+        verifyChecksum(info, qubits.getState().data(), path);
+    }
+    return qubits;
+}
+
+SplitState loadSplitCheckpoint(const std::string& path, bool verify) {
+    CheckpointInfo info;
+    std::uint64_t file_bytes = 0;
+    FileCloser file{openCheckpoint(path, info, file_bytes)};
+    checkLayout(info, sizeof(double), StateLayout::Split, path);
+
+    SplitState state(info.num_qubits);
+    auto* target = reinterpret_cast<char*>(state.real());
+    std::uint64_t done = 0;
+    while (done < info.payload_bytes) {
+        ssize_t got = ::pread(file.fd, target + done, info.payload_bytes - done,
+                              static_cast<off_t>(CHECKPOINT_HEADER_BYTES + done));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            throw std::runtime_error("Cannot read checkpoint " + path + ": " +
+                                     (got < 0 ? errnoText() : std::string("unexpected end of file")));
+        }
+        done += static_cast<std::uint64_t>(got);
+    }
+    if (verify) {
+        verifyChecksum(info, state.real(), path);
+    }
+    return state;
+}
+
+template void saveCheckpoint<double>(const std::string&, const BasicQubitManager<double>&, std::uint64_t, bool);
+template void saveCheckpoint<float>(const std::string&, const BasicQubitManager<float>&, std::uint64_t, bool);
+template BasicQubitManager<double> loadCheckpoint<double>(const std::string&, bool);
+template BasicQubitManager<float> loadCheckpoint<float>(const std::string&, bool);
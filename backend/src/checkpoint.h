@@ -0,0 +1,137 @@
+#pragma once
+
+#include "qubit_manager.h"
+#include "split_state.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file checkpoint.h
+ * @brief Binary state checkpoints that load without copying
+ *
+ * A checkpoint file is a CHECKPOINT_HEADER_BYTES header followed by the raw
+ * amplitudes exactly as they sit in memory:
+ *
+ *   offset 0     CheckpointHeader (magic, version, qubit count, precision,
+ *                layout, next gate, payload size, optional checksum),
+ *                zero-padded to one page
+ *   offset 4096  2^n amplitudes (interleaved) or the real then imaginary
+ *                plane (split), native byte order
+ *
+ * Saving issues one gathered write of header and payload to a temporary
+ * file, syncs it and renames it over the target, so a crash never leaves a
+ * truncated checkpoint under the final name. Because the payload starts on
+ * a page boundary, loadCheckpoint maps the file privately and the register
+ * views the amplitudes in place: pages are read on first touch and copied
+ * only when a gate writes them, and the file itself is never modified.
+ */
+
+/// First eight bytes of every checkpoint file
+constexpr char CHECKPOINT_MAGIC[8] = {'Q', 'S', 'I', 'M', 'C', 'K', 'P', 'T'};
+
+/// Format revision written by saveCheckpoint; other revisions are rejected
+constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+
+/// Header size and payload offset (one page, so the payload can be mapped in place)
+constexpr std::size_t CHECKPOINT_HEADER_BYTES = 4096;
+
+/// Amplitude arrangement of a checkpoint payload
+enum class StateLayout : std::uint32_t {
+    Interleaved = 0,  ///< (re, im) pairs, as in BasicQubitManager
+    Split = 1         ///< Real plane then imaginary plane, as in SplitState
+};
+
+/**
+ * @struct CheckpointInfo
+ * @brief Decoded checkpoint header
+ */
+struct CheckpointInfo {
+    /// Register width
+    int num_qubits = 0;
+
+    /// Bytes per real component: 8 (double) or 4 (float)
+    int precision_bytes = 0;
+
+    /// Payload arrangement
+    StateLayout layout = StateLayout::Interleaved;
+
+    /// Index of the first gate not yet applied to the saved state
+    std::uint64_t next_gate = 0;
+
+    /// Payload size in bytes
+    std::uint64_t payload_bytes = 0;
+
+    /// Whether the header carries a payload checksum
+    bool has_checksum = false;
+
+    /// checksum64 of the payload (0 if has_checksum is false)
+    std::uint64_t checksum = 0;
+};
+
+/**
+ * @brief Hashes a byte range for corruption checks
+ * @param data Start of the range
+ * @param bytes Length of the range
+ * @return 64-bit hash (xxHash64-style rounds over four lanes; not
+ *         bit-compatible with xxHash)
+ *
+ * Megabyte blocks are hashed in parallel and folded in order, so the
+ * result does not depend on the thread count.
+ */
+std::uint64_t checksum64(const void* data, std::size_t bytes);
+
+/**
+ * @brief Writes a register to a checkpoint file
+ * @param path Destination, replaced atomically
+ * @param qubits State to save (double or float)
+ * @param nextGate Number of circuit gates already applied, for resuming
+ * @param withChecksum Hash the payload into the header (one extra read of the state)
+ * @throws std::runtime_error if the file cannot be written
+ */
+template <typename Real>
+void saveCheckpoint(const std::string& path, const BasicQubitManager<Real>& qubits,
+                    std::uint64_t nextGate = 0, bool withChecksum = true);
+
+/// Split-layout overload; the payload is the real plane followed by the imaginary plane
+void saveCheckpoint(const std::string& path, const SplitState& state,
+                    std::uint64_t nextGate = 0, bool withChecksum = true);
+
+/**
+ * @brief Reads and validates a checkpoint header
+ * @param path Checkpoint file
+ * @return Decoded header
+ * @throws std::runtime_error if the file is missing, truncated, of another
+ *         version or byte order, or its header is inconsistent
+ */
+CheckpointInfo readCheckpointInfo(const std::string& path);
+
+/**
+ * @brief Maps an interleaved checkpoint as a register, without copying
+ * @param path Checkpoint file
+ * @param verify Recompute the checksum (if present) before returning
+ * @return Register viewing a private mapping of the file (isFileBacked() is true)
+ * @throws std::runtime_error if the header is invalid, the precision or layout
+ *         does not match Real, the mapping fails or the checksum differs
+ *
+ * Gates applied to the register never reach the file. Verification reads
+ * the whole payload once; skip it for a lazy, page-on-demand load.
+ */
+template <typename Real>
+BasicQubitManager<Real> loadCheckpoint(const std::string& path, bool verify = true);
+
+/**
+ * @brief Reads a split-layout (double) checkpoint into a SplitState
+ * @param path Checkpoint file
+ * @param verify Recompute the checksum (if present) after reading
+ * @return State holding a copy of both planes
+ * @throws std::runtime_error as loadCheckpoint
+ */
+SplitState loadSplitCheckpoint(const std::string& path, bool verify = true);
+
+extern template void saveCheckpoint<double>(const std::string&, const BasicQubitManager<double>&,
+                                            std::uint64_t, bool);
+extern template void saveCheckpoint<float>(const std::string&, const BasicQubitManager<float>&,
+                                           std::uint64_t, bool);
+extern template BasicQubitManager<double> loadCheckpoint<double>(const std::string&, bool);
+extern template BasicQubitManager<float> loadCheckpoint<float>(const std::string&, bool);
@@ -0,0 +1,428 @@
+#include "circuit_file.h"
+#include "checkpoint.h"
+#include "circuit_manager.h"
+#include "qasm_parser.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// Written as-is to disk; readers compare byte_order to detect foreign-endian files
+struct RawHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t num_qubits;
+    std::uint32_t name_count;
+    std::uint32_t parameter_count;
+    std::uint32_t reserved;
+    std::uint64_t gate_count;
+    std::uint64_t qubit_entries;
+    std::uint64_t parameter_entries;
+    std::uint64_t matrix_count;
+    std::uint64_t name_bytes;
+    std::uint64_t symbol_bytes;
+    std::uint64_t checksum;
+};
+static_assert(sizeof(RawHeader) == 88, "Header layout is part of the file format");
+
+/// One gate; its lists and matrix live in the tables that follow the records
+struct GateRecord {
+    std::uint16_t name;
+    std::uint8_t num_parameters;
+    std::uint8_t flags;
+    std::int32_t target;
+    std::int32_t control1;
+    std::int32_t control2;
+    std::uint32_t num_controls;
+    std::uint32_t num_negative_controls;
+};
+static_assert(sizeof(GateRecord) == CIRCUIT_RECORD_BYTES, "Gate records must be fixed-width");
+
+/// One angle argument in the parameter table
+struct ParameterEntry {
+    double value;
+    std::int32_t symbol;
+    std::int32_t padding;
+};
+
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// GateRecord::flags bit: the gate carries a matrix in the matrix table
+constexpr std::uint8_t FLAG_MATRIX = 1;
+
+/// Doubles per matrix table entry (four complex entries, row-major)
+constexpr std::size_t MATRIX_DOUBLES = 8;
+
+/// Matrix every GateOperation starts with; gates still holding it store none
+const kernels::Matrix2 IDENTITY_MATRIX = {1.0, 0.0, 0.0, 1.0};
+
+/// Closes a descriptor on scope exit, including when a load throws
+struct FileCloser {
+    int fd;
+    ~FileCloser() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+std::string errnoText() {
+    return std::strerror(errno);
+}
+
+std::uint64_t bodyBytes(const RawHeader& header) {
+    return header.gate_count * sizeof(GateRecord) + header.qubit_entries * sizeof(std::int32_t) +
+           header.parameter_entries * sizeof(ParameterEntry) +
+           header.matrix_count * MATRIX_DOUBLES * sizeof(double) + header.name_bytes + header.symbol_bytes;
+}
+
+// Validates a raw header against the size of the file it came from
+CircuitFileInfo decodeHeader(const RawHeader& header, std::uint64_t fileBytes, const std::string& path) {
+    if (std::memcmp(header.magic, CIRCUIT_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a circuit file");
+    }
+    if (header.byte_order != BYTE_ORDER_MARK) {
+        throw std::runtime_error(path + " was written on a machine of different byte order");
+    }
+    if (header.version != CIRCUIT_FILE_VERSION) {
+        throw std::runtime_error(path + " has circuit file version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(CIRCUIT_FILE_VERSION));
+    }
+    // Bounding every count by the file size keeps bodyBytes from overflowing
+    const std::uint64_t limit = fileBytes;
+    if (header.num_qubits > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+        header.name_count > std::numeric_limits<std::uint16_t>::max() + 1u ||
+        header.parameter_count > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+        header.gate_count > limit || header.qubit_entries > limit || header.parameter_entries > limit ||
+        header.matrix_count > limit || header.name_bytes > limit || header.symbol_bytes > limit) {
+        throw std::runtime_error(path + " has a corrupt circuit file header");
+    }
+    if (fileBytes != sizeof(RawHeader) + bodyBytes(header)) {
+        throw std::runtime_error(path + " is truncated or has trailing data: expected " +
+                                 std::to_string(sizeof(RawHeader) + bodyBytes(header)) + " bytes, found " +
+                                 std::to_string(fileBytes));
+    }
+
+    CircuitFileInfo info;
+    info.num_qubits = static_cast<int>(header.num_qubits);
+    info.gate_count = header.gate_count;
+    info.name_count = static_cast<int>(header.name_count);
+    info.parameter_count = static_cast<int>(header.parameter_count);
+    info.file_bytes = fileBytes;
+    return info;
+}
+
+// Reads a section in place, rejecting any access past its end
+class ByteReader {
+public:
+    ByteReader(const unsigned char* data, std::uint64_t bytes, const std::string& path)
+        : data(data), bytes(bytes), path(path) {}
+
+    const unsigned char* take(std::uint64_t count) {
+        if (count > bytes - position) {
+            throw std::runtime_error(path + " has a record that runs past its table");
+        }
+        const unsigned char* start = data + position;
+        position += count;
+        return start;
+    }
+
+private:
+    const unsigned char* data;
+    std::uint64_t bytes;
+    std::uint64_t position = 0;
+    const std::string& path;
+};
+
+// Splits count NUL-terminated strings filling exactly bytes
+std::vector<std::string> decodeNames(const unsigned char* data, std::uint64_t bytes, std::uint32_t count,
+                                     const std::string& path) {
+    std::vector<std::string> names;
+    names.reserve(count);
+    const char* cursor = reinterpret_cast<const char*>(data);
+    const char* end = cursor + bytes;
+    while (cursor < end) {
+        const char* terminator = static_cast<const char*>(std::memchr(cursor, '\0', end - cursor));
+        if (terminator == nullptr) {
+            break;
+        }
+        names.emplace_back(cursor, terminator);
+        cursor = terminator + 1;
+    }
+    if (cursor != end || names.size() != count) {
+        throw std::runtime_error(path + " has a corrupt name table");
+    }
+    return names;
+}
+
+void readAll(int fd, unsigned char* target, std::uint64_t bytes, const std::string& path) {
+    std::uint64_t done = 0;
+    while (done < bytes) {
+        ssize_t got = ::read(fd, target + done, bytes - done);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            throw std::runtime_error("Cannot read circuit file " + path + ": " +
+                                     (got < 0 ? errnoText() : std::string("unexpected end of file")));
+        }
+        done += static_cast<std::uint64_t>(got);
+    }
+}
+
+}  // namespace
+
+bool isCircuitFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    FileCloser guard{fd};
+    char magic[sizeof(CIRCUIT_FILE_MAGIC)];
+    return ::pread(fd, magic, sizeof(magic), 0) == static_cast<ssize_t>(sizeof(magic)) &&
+           std::memcmp(magic, CIRCUIT_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+// Sizes every section in a first pass, then fills one buffer and writes it once
+void writeCircuitFile(const std::string& path, const std::vector<GateOperation>& gates,
+                      const std::vector<std::string>& parameterNames,
+                      const std::vector<double>& parameterValues) {
+    RawHeader header{};
+    std::memcpy(header.magic, CIRCUIT_FILE_MAGIC, sizeof(header.magic));
+    header.version = CIRCUIT_FILE_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.gate_count = gates.size();
+    header.parameter_count = static_cast<std::uint32_t>(parameterNames.size());
+
+    std::unordered_map<std::string, std::uint16_t> name_index;
+    std::vector<const std::string*> names;
+    std::vector<std::uint16_t> gate_names(gates.size());
+    int highest_qubit = -1;
+    for (std::size_t g = 0; g < gates.size(); ++g) {
+        const GateOperation& gate = gates[g];
+        auto found = name_index.find(gate.gate_name);
+        if (found == name_index.end()) {
+            if (names.size() > std::numeric_limits<std::uint16_t>::max()) {
+                throw std::invalid_argument("Circuit uses more than 65536 distinct gate names");
+            }
+            found = name_index.emplace(gate.gate_name, static_cast<std::uint16_t>(names.size())).first;
+            names.push_back(&found->first);
+            header.name_bytes += gate.gate_name.size() + 1;
+        }
+        gate_names[g] = found->second;
+        if (gate.parameters.size() > std::numeric_limits<std::uint8_t>::max()) {
+            throw std::invalid_argument("Gate " + std::to_string(g) + " has more than 255 parameters");
+        }
+        header.qubit_entries += gate.controls.size() + gate.negative_controls.size();
+        header.parameter_entries += gate.parameters.size();
+        header.matrix_count += gate.matrix != IDENTITY_MATRIX;
+        highest_qubit = std::max({highest_qubit, gate.target_qubit, gate.control_qubit1, gate.control_qubit2});
+        for (int qubit : gate.controls) highest_qubit = std::max(highest_qubit, qubit);
+        for (int qubit : gate.negative_controls) highest_qubit = std::max(highest_qubit, qubit);
+    }
+    header.name_count = static_cast<std::uint32_t>(names.size());
+    header.num_qubits = static_cast<std::uint32_t>(highest_qubit + 1);
+    header.symbol_bytes = parameterValues.size() * sizeof(double);
+    for (const std::string& name : parameterNames) {
+        header.symbol_bytes += name.size() + 1;
+    }
+
+    std::vector<unsigned char> body(bodyBytes(header));
+    const std::size_t qubit_offset = gates.size() * sizeof(GateRecord);
+    const std::size_t parameter_offset = qubit_offset + header.qubit_entries * sizeof(std::int32_t);
+    const std::size_t matrix_offset = parameter_offset + header.parameter_entries * sizeof(ParameterEntry);
+    // The qubit table is int32, so later tables may sit off 8-byte alignment: copy bytewise
+    unsigned char* qubits = body.data() + qubit_offset;
+    unsigned char* parameters = body.data() + parameter_offset;
+    unsigned char* matrices = body.data() + matrix_offset;
+    for (std::size_t g = 0; g < gates.size(); ++g) {
+        const GateOperation& gate = gates[g];
+        GateRecord record{};
+        record.name = gate_names[g];
+        record.num_parameters = static_cast<std::uint8_t>(gate.parameters.size());
+        record.target = gate.target_qubit;
+        record.control1 = gate.control_qubit1;
+        record.control2 = gate.control_qubit2;
+        record.num_controls = static_cast<std::uint32_t>(gate.controls.size());
+        record.num_negative_controls = static_cast<std::uint32_t>(gate.negative_controls.size());
+        std::memcpy(qubits, gate.controls.data(), gate.controls.size() * sizeof(std::int32_t));
+        qubits += gate.controls.size() * sizeof(std::int32_t);
+        std::memcpy(qubits, gate.negative_controls.data(), gate.negative_controls.size() * sizeof(std::int32_t));
+        qubits += gate.negative_controls.size() * sizeof(std::int32_t);
+        for (const GateParameter& parameter : gate.parameters) {
+            const ParameterEntry entry{parameter.value, parameter.symbol, 0};
+            std::memcpy(parameters, &entry, sizeof(entry));
+            parameters += sizeof(entry);
+        }
+        if (gate.matrix != IDENTITY_MATRIX) {
+            record.flags |= FLAG_MATRIX;
+            std::memcpy(matrices, gate.matrix.data(), MATRIX_DOUBLES * sizeof(double));
+            matrices += MATRIX_DOUBLES * sizeof(double);
+        }
+        std::memcpy(body.data() + g * sizeof(GateRecord), &record, sizeof(record));
+    }
+
+    std::size_t position = matrix_offset + header.matrix_count * MATRIX_DOUBLES * sizeof(double);
+    for (const std::string* name : names) {
+        std::memcpy(body.data() + position, name->c_str(), name->size() + 1);
+        position += name->size() + 1;
+    }
+    std::memcpy(body.data() + position, parameterValues.data(), parameterValues.size() * sizeof(double));
+    position += parameterValues.size() * sizeof(double);
+    for (const std::string& name : parameterNames) {
+        std::memcpy(body.data() + position, name.c_str(), name.size() + 1);
+        position += name.size() + 1;
+    }
+    header.checksum = checksum64(body.data(), body.size());
+
+    const std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create circuit file " + temporary + ": " + errnoText());
+    }
+    const unsigned char* parts[2] = {reinterpret_cast<const unsigned char*>(&header), body.data()};
+    const std::size_t sizes[2] = {sizeof(header), body.size()};
+    for (int part = 0; part < 2; ++part) {
+        std::size_t done = 0;
+        while (done < sizes[part]) {
+            ssize_t written = ::write(fd, parts[part] + done, sizes[part] - done);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written < 0) {
+                const std::string reason = errnoText();
+                ::close(fd);
+                ::unlink(temporary.c_str());
+                throw std::runtime_error("Cannot write circuit file " + temporary + ": " + reason);
+            }
+            done += static_cast<std::size_t>(written);
+        }
+    }
+    ::close(fd);
+    if (::rename(temporary.c_str(), path.c_str()) != 0) {
+        const std::string reason = errnoText();
+        ::unlink(temporary.c_str());
+        throw std::runtime_error("Cannot move circuit file into " + path + ": " + reason);
+    }
+}
+
+CircuitFileInfo readCircuitFileInfo(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open circuit file " + path + ": " + errnoText());
+    }
+    FileCloser guard{fd};
+    struct stat status;
+    RawHeader header{};
+    if (::fstat(fd, &status) != 0 ||
+        ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        throw std::runtime_error("Cannot read circuit file header of " + path);
+    }
+    return decodeHeader(header, static_cast<std::uint64_t>(status.st_size), path);
+}
+
+// One read fills a buffer sized from fstat; records are then decoded into a
+// vector reserved to the exact gate count, so the list never reallocates
+CircuitFileInfo readCircuitFile(const std::string& path, std::vector<GateOperation>& gates,
+                                std::vector<std::string>& parameterNames,
+                                std::vector<double>& parameterValues) {
+    std::vector<unsigned char> file;
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open circuit file " + path + ": " + errnoText());
+        }
+        FileCloser guard{fd};
+        struct stat status;
+        if (::fstat(fd, &status) != 0) {
+            throw std::runtime_error("Cannot stat circuit file " + path + ": " + errnoText());
+        }
+        if (static_cast<std::uint64_t>(status.st_size) < sizeof(RawHeader)) {
+            throw std::runtime_error(path + " is too short to be a circuit file");
+        }
+        file.resize(static_cast<std::size_t>(status.st_size));
+        readAll(fd, file.data(), file.size(), path);
+    }
+
+    RawHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    CircuitFileInfo info = decodeHeader(header, file.size(), path);
+    const unsigned char* body = file.data() + sizeof(RawHeader);
+    if (checksum64(body, file.size() - sizeof(RawHeader)) != header.checksum) {
+        throw std::runtime_error("Checksum mismatch in circuit file " + path);
+    }
+
+    const unsigned char* qubit_table = body + header.gate_count * sizeof(GateRecord);
+    const unsigned char* parameter_table = qubit_table + header.qubit_entries * sizeof(std::int32_t);
+    const unsigned char* matrix_table = parameter_table + header.parameter_entries * sizeof(ParameterEntry);
+    const unsigned char* name_table = matrix_table + header.matrix_count * MATRIX_DOUBLES * sizeof(double);
+    const unsigned char* symbol_table = name_table + header.name_bytes;
+
+    const std::vector<std::string> names = decodeNames(name_table, header.name_bytes, header.name_count, path);
+    const std::uint64_t value_bytes = std::uint64_t{header.parameter_count} * sizeof(double);
+    if (value_bytes > header.symbol_bytes) {
+        throw std::runtime_error(path + " has a corrupt parameter table");
+    }
+    std::vector<double> values(header.parameter_count);
+    std::memcpy(values.data(), symbol_table, value_bytes);
+    std::vector<std::string> symbols = decodeNames(symbol_table + value_bytes, header.symbol_bytes - value_bytes,
+                                                   header.parameter_count, path);
+
+    ByteReader qubits(qubit_table, header.qubit_entries * sizeof(std::int32_t), path);
+    ByteReader parameters(parameter_table, header.parameter_entries * sizeof(ParameterEntry), path);
+    ByteReader matrices(matrix_table, header.matrix_count * MATRIX_DOUBLES * sizeof(double), path);
+    std::vector<GateOperation> loaded;
+    loaded.reserve(header.gate_count);
+    for (std::uint64_t g = 0; g < header.gate_count; ++g) {
+        GateRecord record;
+        std::memcpy(&record, body + g * sizeof(GateRecord), sizeof(record));
+        if (record.name >= names.size()) {
+            throw std::runtime_error(path + " has a gate record with an unknown name index");
+        }
+        GateOperation& gate = loaded.emplace_back(
+            GateOperation{names[record.name], record.target, record.control1, record.control2});
+
+        const unsigned char* controls = qubits.take(std::uint64_t{record.num_controls} * sizeof(std::int32_t));
+        gate.controls.resize(record.num_controls);
+        std::memcpy(gate.controls.data(), controls, gate.controls.size() * sizeof(std::int32_t));
+        const unsigned char* negative =
+            qubits.take(std::uint64_t{record.num_negative_controls} * sizeof(std::int32_t));
+        gate.negative_controls.resize(record.num_negative_controls);
+        std::memcpy(gate.negative_controls.data(), negative, gate.negative_controls.size() * sizeof(std::int32_t));
+
+        const unsigned char* angles = parameters.take(std::uint64_t{record.num_parameters} * sizeof(ParameterEntry));
+        gate.parameters.resize(record.num_parameters);
+        for (int p = 0; p < record.num_parameters; ++p) {
+            ParameterEntry entry;
+            std::memcpy(&entry, angles + p * sizeof(ParameterEntry), sizeof(entry));
+            if (entry.symbol < -1 || entry.symbol >= static_cast<std::int32_t>(header.parameter_count)) {
+                throw std::runtime_error(path + " has a gate referring to an undeclared parameter");
+            }
+            gate.parameters[p] = GateParameter{entry.value, entry.symbol};
+        }
+        if (record.flags & FLAG_MATRIX) {
+            std::memcpy(gate.matrix.data(), matrices.take(MATRIX_DOUBLES * sizeof(double)),
+                        MATRIX_DOUBLES * sizeof(double));
+        }
+    }
+
+    gates = std::move(loaded);
+    parameterNames = std::move(symbols);
+    parameterValues = std::move(values);
+    return info;
+}
+
+CircuitFileInfo convertQasmToCircuitFile(const std::string& qasmPath, const std::string& circuitPath) {
+    CircuitManager circuit;
+    parseQasmFile(qasmPath, circuit);
+    circuit.saveCircuit(circuitPath);
+    return readCircuitFileInfo(circuitPath);
+}
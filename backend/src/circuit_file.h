@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct GateOperation;
+
+/**
+ * @file circuit_file.h
+ * @brief Compact binary circuit files that load with one read
+ *
+ * A circuit file is a fixed header followed by fixed-width gate records and
+ * the variable-length tables they index, in this order:
+ *
+ *   CircuitFileHeader   magic, version, byte order, qubit count, section
+ *                       sizes and a checksum of everything after it
+ *   gate records        CIRCUIT_RECORD_BYTES each: gate name index,
+ *                       parameter count, flags, target, two controls and
+ *                       the lengths of its control lists
+ *   qubit table         int32 extra controls then negative controls, per gate
+ *   parameter table     (angle, symbol) pairs, per gate
+ *   matrix table        eight doubles per gate that carries a 2x2 matrix
+ *   name table          distinct gate names, NUL-terminated
+ *   symbol table        parameter values, then names, NUL-terminated
+ *
+ * Records consume the tables in order, so no per-gate offsets are stored.
+ * Gate names are kept as written (aliases and case included), and a
+ * circuit saved and loaded again compiles to the same plan. Measurement
+ * results are execution state and are not saved.
+ */
+
+/// First eight bytes of every circuit file
+constexpr char CIRCUIT_FILE_MAGIC[8] = {'Q', 'S', 'I', 'M', 'C', 'I', 'R', 'C'};
+
+/// Format revision written by writeCircuitFile; other revisions are rejected
+constexpr std::uint32_t CIRCUIT_FILE_VERSION = 1;
+
+/// Size of one fixed-width gate record
+constexpr std::size_t CIRCUIT_RECORD_BYTES = 24;
+
+/**
+ * @struct CircuitFileInfo
+ * @brief Decoded circuit file header
+ */
+struct CircuitFileInfo {
+    /// One more than the highest qubit any gate references (0 for an empty circuit)
+    int num_qubits = 0;
+
+    /// Number of gate records
+    std::uint64_t gate_count = 0;
+
+    /// Number of distinct gate names
+    int name_count = 0;
+
+    /// Number of declared symbolic parameters
+    int parameter_count = 0;
+
+    /// File size in bytes
+    std::uint64_t file_bytes = 0;
+};
+
+/**
+ * @brief Tells whether a file starts with the circuit file magic
+ * @param path File to probe
+ * @return True if the file exists and begins with CIRCUIT_FILE_MAGIC
+ */
+bool isCircuitFile(const std::string& path);
+
+/**
+ * @brief Writes gates and a parameter table to a circuit file
+ * @param path Destination, replaced atomically
+ * @param gates Gates in execution order
+ * @param parameterNames Symbolic parameter names, indexed by GateParameter::symbol
+ * @param parameterValues Current value of each symbolic parameter
+ * @throws std::invalid_argument if a gate has more than 255 angles or the
+ *         circuit uses more than 65535 distinct gate names
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeCircuitFile(const std::string& path, const std::vector<GateOperation>& gates,
+                      const std::vector<std::string>& parameterNames,
+                      const std::vector<double>& parameterValues);
+
+/**
+ * @brief Reads and validates a circuit file header
+ * @param path Circuit file
+ * @return Decoded header
+ * @throws std::runtime_error if the file is missing, truncated, of another
+ *         version or byte order, or its header is inconsistent
+ */
+CircuitFileInfo readCircuitFileInfo(const std::string& path);
+
+/**
+ * @brief Reads a whole circuit file with one read and decodes it
+ * @param path Circuit file
+ * @param gates Replaced by the saved gates (reserved to the exact count first)
+ * @param parameterNames Replaced by the saved parameter names
+ * @param parameterValues Replaced by the saved parameter values
+ * @return Decoded header
+ * @throws std::runtime_error if the header is invalid, the checksum differs,
+ *         or a record indexes past its tables; the outputs are unchanged then
+ */
+CircuitFileInfo readCircuitFile(const std::string& path, std::vector<GateOperation>& gates,
+                                std::vector<std::string>& parameterNames,
+                                std::vector<double>& parameterValues);
+
+/**
+ * @brief Converts an OpenQASM 2.0 file to a circuit file
+ * @param qasmPath Source program (see parseQasmFile)
+ * @param circuitPath Destination circuit file
+ * @return Header of the written file
+ * @throws QasmError on parse errors
+ * @throws std::runtime_error if either file cannot be opened or written
+ *
+ * The classical register layout is not kept; the MEASURE gates are.
+ */
+CircuitFileInfo convertQasmToCircuitFile(const std::string& qasmPath, const std::string& circuitPath);
@@ -1,7 +1,25 @@
 #include "circuit_manager.h"
+#include "utils.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <map>
 #include <stdexcept>
 
+namespace {
+
+// True for known gates with angle parameters; unknown names print without them
+bool takesAngles(const std::string& gateName) {
+    try {
+        return parameterCount(parseOpCode(gateName)) > 0;
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+}
+
+}  // namespace
+
 // Adds a gate operation to the circuit queue
 // @param gateName Name of the gate (X, Y, Z, H, CNOT, SWAP, TOFFOLI)
 // @param targetQubit Index of target qubit
@@ -13,6 +31,98 @@ void CircuitManager::addGate(const std::string& gateName, int targetQubit,
         throw std::invalid_argument("Target qubit index cannot be negative");
     }
     circuit.push_back({gateName, targetQubit, controlQubit1, controlQubit2});
+    cached_plan.reset();
+}
+
+void CircuitManager::addControlledGate(const std::string& gateName, int targetQubit,
+                                       const std::vector<int>& controls,
+                                       const std::vector<int>& negativeControls, double angle) {
+    if (targetQubit < 0) {
+        throw std::invalid_argument("Target qubit index cannot be negative");
+    }
+    GateOperation gate{gateName, targetQubit, -1, -1};
+    gate.controls = controls;
+    gate.negative_controls = negativeControls;
+    gate.parameters = {GateParameter{angle}};
+    circuit.push_back(std::move(gate));
+    cached_plan.reset();
+}
+
+void CircuitManager::addParameterizedGate(const std::string& gateName, int targetQubit,
+                                          const std::vector<GateParameter>& parameters,
+                                          const std::vector<int>& controls) {
+    if (targetQubit < 0) {
+        throw std::invalid_argument("Target qubit index cannot be negative");
+    }
+    GateOperation gate{gateName, targetQubit, -1, -1};
+    gate.controls = controls;
+    gate.parameters = parameters;
+    circuit.push_back(std::move(gate));
+    cached_plan.reset();
+}
+
+int CircuitManager::addParameter(const std::string& name, double value) {
+    if (std::find(parameter_names.begin(), parameter_names.end(), name) != parameter_names.end()) {
+        throw std::invalid_argument("Parameter already declared: " + name);
+    }
+    parameter_names.push_back(name);
+    parameter_values.push_back(value);
+    return static_cast<int>(parameter_names.size()) - 1;
+}
+
+GateParameter CircuitManager::parameter(const std::string& name) const {
+    auto it = std::find(parameter_names.begin(), parameter_names.end(), name);
+    if (it == parameter_names.end()) {
+        throw std::invalid_argument("Unknown parameter: " + name);
+    }
+    GateParameter reference;
+    reference.symbol = static_cast<int>(it - parameter_names.begin());
+    return reference;
+}
+
+void CircuitManager::setParameter(const std::string& name, double value) {
+    parameter_values[parameter(name).symbol] = value;
+    if (cached_plan) {
+        ::bindParameters(*cached_plan, parameter_values);
+    }
+}
+
+void CircuitManager::bindParameters(const std::vector<double>& values) {
+    if (values.size() != parameter_values.size()) {
+        throw std::invalid_argument("Expected " + std::to_string(parameter_values.size()) +
+                                    " parameter values, got " + std::to_string(values.size()));
+    }
+    parameter_values = values;
+    if (cached_plan) {
+        ::bindParameters(*cached_plan, parameter_values);
+    }
+}
+
+GradientResult CircuitManager::adjointGradient(QubitManager& qubits, const ObservableFunction& observable) {
+    const CompiledCircuit& plan = preparePlan(qubits.getNumQubits());
+    return ::adjointGradient(plan, parameter_values.size(), qubits, observable);
+}
+
+GradientResult CircuitManager::adjointGradient(QubitManager& qubits, const PauliSum& observable) {
+    return adjointGradient(qubits, [&observable](QubitManager& state) { observable.apply(state); });
+}
+
+void CircuitManager::addControlledUnitary(const kernels::Matrix2& matrix, int targetQubit,
+                                          const std::vector<int>& controls,
+                                          const std::vector<int>& negativeControls) {
+    addControlledGate(controls.empty() && negativeControls.empty() ? "U" : "CU",
+                      targetQubit, controls, negativeControls);
+    circuit.back().matrix = matrix;
+}
+
+void CircuitManager::saveCircuit(const std::string& path) const {
+    writeCircuitFile(path, circuit, parameter_names, parameter_values);
+}
+
+CircuitFileInfo CircuitManager::loadCircuit(const std::string& path) {
+    CircuitFileInfo info = readCircuitFile(path, circuit, parameter_names, parameter_values);
+    cached_plan.reset();
+    return info;
 }
 
 /// Removes a gate from the circuit at specified index
@@ -21,6 +131,7 @@ void CircuitManager::removeGate(int index) {
         throw std::out_of_range("Gate index out of range: " + std::to_string(index));
     }
     circuit.erase(circuit.begin() + index);
+    cached_plan.reset();
 }
 
 /// Reorders a gate to a new position in the circuit
@@ -50,6 +161,7 @@ void CircuitManager::reorderGates(int fromIndex, int toIndex) {
     
     // Insert at new position
     circuit.insert(circuit.begin() + adjustedToIndex, gate);
+    cached_plan.reset();
 }
 
 /// Gets gate at specified index
@@ -63,64 +175,771 @@ const GateOperation& CircuitManager::getGate(int index) const {
 // Executes all gates in the circuit sequentially on the quantum state
 // @param qubits Reference to QubitManager containing the quantum state
 // @throws std::invalid_argument if gate name is invalid or required qubits missing
-void CircuitManager::executeCircuit(QubitManager& qubits) {
-    for (auto& gate : circuit) {
-        try {
-            // Convert gate name to uppercase for case-insensitive comparison
-            std::string gateNameUpper;
-            std::transform(gate.gate_name.begin(), gate.gate_name.end(),
-                         std::back_inserter(gateNameUpper), ::toupper);
-            
-            // Single-qubit gates
-            if (gateNameUpper == "X" || gateNameUpper == "PAULI-X") {
-                gate_engine.applyPauliX(qubits, gate.target_qubit);
+template <typename Real>
+void CircuitManager::executeCircuit(BasicQubitManager<Real>& qubits) {
+    executeCircuit(qubits, 0, circuit.size());
+}
+
+// Runs a gate range; partial ranges get their own plan so fusion stays within the range
+template <typename Real>
+void CircuitManager::executeCircuit(BasicQubitManager<Real>& qubits, std::size_t firstGate, std::size_t lastGate) {
+    if (firstGate > lastGate || lastGate > circuit.size()) {
+        throw std::out_of_range("Gate range [" + std::to_string(firstGate) + ", " + std::to_string(lastGate) +
+                                ") is outside a circuit of " + std::to_string(circuit.size()) + " gates");
+    }
+    CompiledCircuit range_plan;
+    if (firstGate > 0 || lastGate < circuit.size()) {
+        range_plan = compileRange(qubits.getNumQubits(), firstGate, lastGate);
+        finishPlan(range_plan);
+    }
+    const CompiledCircuit& plan = (firstGate > 0 || lastGate < circuit.size())
+        ? range_plan : preparePlan(qubits.getNumQubits());
+    std::vector<int> results;
+    const int chunk_qubits = qubits.isFileBacked()
+        ? outOfCoreBlockQubits(qubits.getNumQubits(), sizeof(std::complex<Real>), availableMemoryBytes())
+        : qubits.getNumQubits();
+    if (chunk_qubits < qubits.getNumQubits()) {
+        // Memory-sized chunks: every stage streams the file once, in order
+        BlockedCircuit blocked = blockCircuit(plan, chunk_qubits);
+        blocking_stats = blocked.stats;
+        gate_engine.executeBlocked(qubits, blocked, results, profiling ? &profiler : nullptr);
+    } else if (block_qubits > 0 && qubits.getNumQubits() >= MIN_BLOCKED_QUBITS) {
+        // Blocking is cheap next to one sweep of such a register, so it is redone per run
+        BlockedCircuit blocked = blockCircuit(plan, block_qubits);
+        blocking_stats = blocked.stats;
+        gate_engine.executeBlocked(qubits, blocked, results, profiling ? &profiler : nullptr);
+    } else {
+        results = executeCompiled(plan, qubits);
+    }
+    for (std::size_t slot = 0; slot < results.size(); ++slot) {
+        circuit[plan.measurement_gates[slot]].measurement_result = results[slot];
+    }
+}
+
+template <typename Real>
+void CircuitManager::executeWithCheckpoint(BasicQubitManager<Real>& qubits, std::size_t gateIndex,
+                                           const std::string& path) {
+    executeCircuit(qubits, 0, gateIndex);
+    saveCheckpoint(path, qubits, gateIndex);
+    executeCircuit(qubits, gateIndex, circuit.size());
+}
+
+template <typename Real>
+BasicQubitManager<Real> CircuitManager::resumeFromCheckpoint(const std::string& path, bool verify) {
+    BasicQubitManager<Real> qubits = loadCheckpoint<Real>(path, verify);
+    const std::uint64_t next_gate = readCheckpointInfo(path).next_gate;
+    if (next_gate > circuit.size()) {
+        throw std::out_of_range("Checkpoint " + path + " resumes at gate " + std::to_string(next_gate) +
+                                " but the circuit has " + std::to_string(circuit.size()) + " gates");
+    }
+    executeCircuit(qubits, static_cast<std::size_t>(next_gate), circuit.size());
+    return qubits;
+}
+
+void CircuitManager::executeCircuit(DensityMatrixManager& rho) {
+    CompiledCircuit super = toSuperoperatorPlan(preparePlan(rho.getNumQubits()));
+    if (max_fused_width > 0) {
+        fuseGates(super, std::max(2, max_fused_width));
+    }
+    QubitManager& vectorized = rho.getVectorized();
+    for (const CompiledOp& op : super.ops) {
+        GateEngine::applyToBuffer(vectorized.getState().data(), vectorized.getDimension(), op);
+    }
+}
+
+void CircuitManager::executeCircuit(HybridState& state) {
+    const CompiledCircuit& plan = preparePlan(state.getNumQubits());
+    for (const CompiledOp& op : plan.ops) {
+        const int result = state.apply(op, gate_engine);
+        if (op.slot >= 0) {
+            circuit[plan.measurement_gates[op.slot]].measurement_result = result;
+        }
+    }
+}
+
+void CircuitManager::executeCircuit(SplitState& state) {
+    if (!noise_model.empty()) {
+        throw std::invalid_argument("The split-layout backend does not support noise models");
+    }
+    const CompiledCircuit& plan = preparePlan(state.getNumQubits());
+    for (const CompiledOp& op : plan.ops) {
+        if (op.opcode == OpCode::Measure) {
+            circuit[plan.measurement_gates[op.slot]].measurement_result =
+                state.measure(op.target, gate_engine.getRandomEngine());
+        } else {
+            state.applyOp(op);
+        }
+    }
+}
+
+void CircuitManager::executeCircuit(MPSState& mps) {
+    if (!noise_model.empty()) {
+        throw std::invalid_argument("The MPS backend does not support noise models");
+    }
+    const int num_qubits = mps.getNumQubits();
+    std::mt19937_64& rng = gate_engine.getRandomEngine();
+    for (GateOperation& gate : circuit) {
+        if (parseOpCode(gate.gate_name) == OpCode::Measure) {
+            if (gate.target_qubit < 0 || gate.target_qubit >= num_qubits) {
+                throw std::out_of_range("Qubit index out of range: " + std::to_string(gate.target_qubit));
             }
-            else if (gateNameUpper == "Y" || gateNameUpper == "PAULI-Y") {
-                gate_engine.applyPauliY(qubits, gate.target_qubit);
+            gate.measurement_result = mps.measure(gate.target_qubit, rng);
+            continue;
+        }
+
+        // Relabel the gate's qubits to 0..k-1 so lowering never builds masks wider than the gate
+        std::vector<int> qubits = gate.controls;
+        qubits.insert(qubits.end(), gate.negative_controls.begin(), gate.negative_controls.end());
+        for (int qubit : {gate.target_qubit, gate.control_qubit1, gate.control_qubit2}) {
+            if (qubit >= 0) {
+                qubits.push_back(qubit);
+            }
+        }
+        for (int qubit : qubits) {
+            if (qubit >= num_qubits) {
+                throw std::out_of_range("Qubit index out of range: " + std::to_string(qubit));
             }
-            else if (gateNameUpper == "Z" || gateNameUpper == "PAULI-Z") {
-                gate_engine.applyPauliZ(qubits, gate.target_qubit);
+        }
+        std::sort(qubits.begin(), qubits.end());
+        qubits.erase(std::unique(qubits.begin(), qubits.end()), qubits.end());
+        auto local = [&](int qubit) {
+            return qubit < 0 ? qubit
+                             : static_cast<int>(std::lower_bound(qubits.begin(), qubits.end(), qubit) - qubits.begin());
+        };
+        GateOperation relabeled = gate;
+        relabeled.target_qubit = local(gate.target_qubit);
+        relabeled.control_qubit1 = local(gate.control_qubit1);
+        relabeled.control_qubit2 = local(gate.control_qubit2);
+        std::transform(gate.controls.begin(), gate.controls.end(), relabeled.controls.begin(), local);
+        std::transform(gate.negative_controls.begin(), gate.negative_controls.end(),
+                       relabeled.negative_controls.begin(), local);
+
+        CompiledCircuit scratch;
+        scratch.num_qubits = static_cast<int>(qubits.size());
+        const CompiledOp dense = toDenseOp(lowerGate(relabeled, scratch.num_qubits, scratch));
+        if (dense.opcode == OpCode::Unitary) {
+            mps.applyGate({qubits[dense.target]},
+                          {dense.matrix[0], dense.matrix[1], dense.matrix[2], dense.matrix[3]});
+        } else {
+            std::vector<int> sites;
+            for (int p = 0; p < dense.num_positions; ++p) {
+                sites.push_back(qubits[dense.positions[p]]);
             }
-            else if (gateNameUpper == "H" || gateNameUpper == "HADAMARD") {
-                gate_engine.applyHadamard(qubits, gate.target_qubit);
+            mps.applyGate(sites, dense.dense_matrix);
+        }
+    }
+}
+
+void CircuitManager::executeBatch(BatchedState& batch) {
+    gate_engine.executeBatch(batch, preparePlan(batch.getNumQubits()));
+}
+
+// Compiles, adds noise ops and fuses on first use for this register width, then reuses the plan
+const CompiledCircuit& CircuitManager::preparePlan(int numQubits) {
+    if (!cached_plan || cached_plan->num_qubits != numQubits) {
+        cached_plan = compile(numQubits);
+        finishPlan(*cached_plan);
+    }
+    return *cached_plan;
+}
+
+void CircuitManager::finishPlan(CompiledCircuit& plan) {
+    if (!noise_model.empty()) {
+        insertNoise(plan);
+    }
+    if (max_fused_width > 0) {
+        fusion_stats = fuseGates(plan, max_fused_width);
+    } else {
+        int sweeps = static_cast<int>(std::count_if(plan.ops.begin(), plan.ops.end(),
+            [](const CompiledOp& op) { return op.opcode != OpCode::Measure && op.opcode != OpCode::Noise; }));
+        fusion_stats = {sweeps, sweeps, 0};
+    }
+}
+
+// Follows every gate with a NOISE op per channel and touched qubit, and tags
+// measurements with their qubit's readout error
+void CircuitManager::insertNoise(CompiledCircuit& plan) const {
+    std::vector<CompiledOp> noisy;
+    noisy.reserve(plan.ops.size() * 2);
+    for (const CompiledOp& op : plan.ops) {
+        noisy.push_back(op);
+        const GateOperation& gate = circuit[op.gate_index];
+        if (op.opcode == OpCode::Measure) {
+            noisy.back().channel = noise_model.readoutFor(op.target);
+            continue;
+        }
+
+        std::vector<int> touched = gate.controls;
+        touched.insert(touched.end(), gate.negative_controls.begin(), gate.negative_controls.end());
+        for (int qubit : {gate.control_qubit1, gate.control_qubit2, gate.target_qubit}) {
+            if (qubit >= 0) {
+                touched.push_back(qubit);
             }
-            else if (gateNameUpper == "MEASURE") {
-                gate.measurement_result = gate_engine.measureQubit(qubits, gate.target_qubit);
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+        for (int qubit : touched) {
+            for (const NoiseChannel& channel : noise_model.channelsAfter(gate.gate_name, qubit)) {
+                CompiledOp noise = lowerOp(OpCode::Noise, plan.num_qubits, qubit);
+                noise.channel = channel;
+                noise.gate_index = op.gate_index;
+                noisy.push_back(noise);
             }
-            // Two-qubit gates
-            else if (gateNameUpper == "CNOT") {
-                if (gate.control_qubit1 < 0) {
-                    throw std::invalid_argument("CNOT gate requires a control qubit");
+        }
+    }
+    plan.ops = std::move(noisy);
+}
+
+// Flips each measured bit with its qubit's readout error
+std::uint64_t CircuitManager::applyReadoutErrors(std::uint64_t outcome, const std::vector<int>& measured,
+                                                 std::mt19937_64& rng) const {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (std::size_t b = 0; b < measured.size(); ++b) {
+        const NoiseChannel channel = noise_model.readoutFor(measured[b]);
+        if (channel.kind != NoiseKind::Readout) {
+            continue;
+        }
+        const bool one = (outcome >> b) & 1;
+        if (uniform(rng) < (one ? channel.probability_one : channel.probability)) {
+            outcome ^= std::uint64_t{1} << b;
+        }
+    }
+    return outcome;
+}
+
+// One simulation per shot. Trajectories are split over the pool as coarse
+// tasks that each reuse one state buffer and engine; shot k is seeded from
+// k, so the histogram does not depend on the thread count.
+template <typename Real>
+OutcomeCounts CircuitManager::sampleTrajectories(const BasicQubitManager<Real>& initial, const CompiledCircuit& plan,
+                                                 const std::vector<int>& measured, std::uint64_t shots) {
+    const std::uint64_t base_seed = gate_engine.getRandomEngine()();
+    const std::uint64_t tasks = std::min<std::uint64_t>(shots, ThreadPool::global().getThreadCount());
+    std::vector<std::map<std::uint64_t, std::uint64_t>> partial(tasks);
+
+    ThreadPool::global().parallelTasks(tasks, [&](std::uint64_t task, std::uint64_t) {
+        BasicQubitManager<Real> buffer(initial.getNumQubits());
+        GateEngine engine;
+        std::vector<int> results;
+        for (std::uint64_t shot = task; shot < shots; shot += tasks) {
+            engine.setSeed(base_seed + shot * 0x9E3779B97F4A7C15ull);
+            buffer.getState() = initial.getState();
+            engine.executePlan(buffer, plan, results);
+
+            std::uint64_t outcome = 0;
+            if (plan.measurement_gates.empty()) {
+                // Unmeasured circuits read out the whole register at the end
+                outcome = sampleFromAmplitudes(buffer.getState().data(), buffer.getDimension(), 1,
+                                               engine.getRandomEngine()).front().first;
+                outcome = applyReadoutErrors(outcome, measured, engine.getRandomEngine());
+            } else {
+                // Later measurements of a qubit overwrite earlier ones
+                for (const CompiledOp& op : plan.ops) {
+                    if (op.slot >= 0) {
+                        std::uint64_t bit = std::uint64_t{1} << (std::lower_bound(measured.begin(), measured.end(),
+                                                                                  op.target) - measured.begin());
+                        outcome = results[op.slot] ? (outcome | bit) : (outcome & ~bit);
+                    }
+                }
+            }
+            ++partial[task][outcome];
+        }
+    });
+
+    std::map<std::uint64_t, std::uint64_t> merged;
+    for (const auto& counts : partial) {
+        for (const auto& [outcome, count] : counts) {
+            merged[outcome] += count;
+        }
+    }
+    return OutcomeCounts(merged.begin(), merged.end());
+}
+
+// Runs the unitary prefix once and draws every shot from the final distribution;
+// circuits with mid-circuit measurements or noise run one trajectory per shot
+template <typename Real>
+Histogram CircuitManager::sample(BasicQubitManager<Real>& qubits, std::uint64_t shots) {
+    if (shots == 0) {
+        throw std::invalid_argument("Shot count must be positive");
+    }
+    const int num_qubits = qubits.getNumQubits();
+    const CompiledCircuit& plan = preparePlan(num_qubits);
+
+    // Terminal measurements form the trailing run of MEASURE ops
+    std::size_t prefix_end = plan.ops.size();
+    while (prefix_end > 0 && plan.ops[prefix_end - 1].opcode == OpCode::Measure) {
+        --prefix_end;
+    }
+    const bool stochastic = std::any_of(plan.ops.begin(), plan.ops.begin() + prefix_end,
+        [](const CompiledOp& op) { return op.opcode == OpCode::Measure || op.opcode == OpCode::Noise; });
+
+    // Bitstrings cover the measured qubits (all qubits if the circuit has no MEASURE)
+    std::vector<int> measured;
+    for (const CompiledOp& op : plan.ops) {
+        if (op.opcode == OpCode::Measure) {
+            measured.push_back(op.target);
+        }
+    }
+    if (measured.empty()) {
+        for (int q = 0; q < num_qubits; ++q) {
+            measured.push_back(q);
+        }
+    }
+    std::sort(measured.begin(), measured.end());
+    measured.erase(std::unique(measured.begin(), measured.end()), measured.end());
+    const int width = static_cast<int>(measured.size());
+
+    Histogram histogram;
+    if (stochastic) {
+        for (const auto& [outcome, count] : sampleTrajectories(qubits, plan, measured, shots)) {
+            histogram[formatBasisState(outcome, width)] = count;
+        }
+        return histogram;
+    }
+
+    std::mt19937_64& rng = gate_engine.getRandomEngine();
+    for (std::size_t i = 0; i < prefix_end; ++i) {
+        gate_engine.applyOp(qubits, plan.ops[i]);
+    }
+    const std::complex<Real>* state = qubits.getState().data();
+    OutcomeCounts counts = width == num_qubits
+        ? sampleFromAmplitudes(state, qubits.getDimension(), shots, rng)
+        : sampleFromProbabilities(marginalProbabilities(state, num_qubits, measured), shots, rng);
+    const bool readout = std::any_of(measured.begin(), measured.end(),
+        [&](int qubit) { return noise_model.readoutFor(qubit).kind == NoiseKind::Readout; });
+    for (const auto& [outcome, count] : counts) {
+        if (!readout) {
+            histogram[formatBasisState(outcome, width)] = count;
+            continue;
+        }
+        // Readout errors are independent per shot
+        for (std::uint64_t shot = 0; shot < count; ++shot) {
+            ++histogram[formatBasisState(applyReadoutErrors(outcome, measured, rng), width)];
+        }
+    }
+    return histogram;
+}
+
+// Lowers gates to tableau ops; PHASE / RZ by k quarter turns become k S gates
+// (RZ differs from PHASE only by a global phase)
+std::optional<std::vector<CliffordOp>> CircuitManager::lowerClifford() const {
+    std::vector<CliffordOp> ops;
+    ops.reserve(circuit.size());
+    for (std::size_t index = 0; index < circuit.size(); ++index) {
+        const GateOperation& gate = circuit[index];
+        int min_controls = 0;
+        OpCode opcode = parseOpCode(gate.gate_name, &min_controls);
+        const int gate_index = static_cast<int>(index);
+
+        std::vector<int> controls = gate.controls;
+        if (opcode == OpCode::CNOT && gate.control_qubit1 >= 0) {
+            controls.push_back(gate.control_qubit1);
+        } else if (min_controls > 0) {
+            for (int control : {gate.control_qubit1, gate.control_qubit2}) {
+                if (control >= 0) {
+                    controls.push_back(control);
                 }
-                gate_engine.applyCNOT(qubits, gate.control_qubit1, gate.target_qubit);
             }
-            else if (gateNameUpper == "SWAP") {
+        }
+        const std::size_t num_controls = controls.size() + gate.negative_controls.size();
+
+        switch (opcode) {
+            case OpCode::Measure:
+                ops.push_back({OpCode::Measure, gate.target_qubit, -1, gate_index});
+                break;
+            case OpCode::SWAP:
                 if (gate.control_qubit1 < 0) {
                     throw std::invalid_argument("SWAP gate requires two qubits");
                 }
-                gate_engine.applySWAP(qubits, gate.control_qubit1, gate.target_qubit);
+                if (num_controls > 0) {
+                    return std::nullopt;
+                }
+                ops.push_back({OpCode::SWAP, gate.target_qubit, gate.control_qubit1, gate_index});
+                break;
+            case OpCode::CNOT:
+            case OpCode::PauliX:
+            case OpCode::PauliZ: {
+                if (opcode == OpCode::CNOT && gate.control_qubit1 < 0) {
+                    throw std::invalid_argument("CNOT gate requires a control qubit");
+                }
+                if (num_controls == 0) {
+                    ops.push_back({opcode, gate.target_qubit, -1, gate_index});
+                    break;
+                }
+                if (num_controls > 1) {
+                    return std::nullopt;
+                }
+                // A negative control is a positive one conjugated by X
+                const bool negative = controls.empty();
+                const int control = negative ? gate.negative_controls.front() : controls.front();
+                const OpCode two_qubit = opcode == OpCode::PauliZ ? OpCode::PauliZ : OpCode::CNOT;
+                if (negative) {
+                    ops.push_back({OpCode::PauliX, control, -1, gate_index});
+                }
+                ops.push_back({two_qubit, gate.target_qubit, control, gate_index});
+                if (negative) {
+                    ops.push_back({OpCode::PauliX, control, -1, gate_index});
+                }
+                break;
             }
-            // Three-qubit gates
-            else if (gateNameUpper == "TOFFOLI") {
-                if (gate.control_qubit1 < 0 || gate.control_qubit2 < 0) {
-                    throw std::invalid_argument("TOFFOLI gate requires two control qubits");
+            case OpCode::PauliY:
+            case OpCode::Hadamard:
+                if (num_controls > 0) {
+                    return std::nullopt;
+                }
+                ops.push_back({opcode, gate.target_qubit, -1, gate_index});
+                break;
+            case OpCode::Phase:
+            case OpCode::RZ: {
+                if (num_controls > 0 || gate.parameters.empty() || gate.parameters.front().symbol >= 0) {
+                    return std::nullopt;
+                }
+                const double turns = gate.parameters.front().value / (M_PI / 2);
+                const long quarter_turns = std::lround(turns);
+                if (std::abs(turns - quarter_turns) > 1e-9) {
+                    return std::nullopt;
                 }
-                gate_engine.applyToffoli(qubits, gate.control_qubit1, gate.control_qubit2, gate.target_qubit);
+                for (long k = 0; k < ((quarter_turns % 4) + 4) % 4; ++k) {
+                    ops.push_back({OpCode::Phase, gate.target_qubit, -1, gate_index});
+                }
+                break;
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+    return ops;
+}
+
+// Unknown or malformed gates are not Clifford; executing the circuit reports them
+bool CircuitManager::isClifford() const {
+    try {
+        return lowerClifford().has_value();
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+}
+
+void CircuitManager::setBackend(Backend requested) {
+    backend = requested;
+}
+
+Backend CircuitManager::getBackend() const {
+    return backend;
+}
+
+Backend CircuitManager::selectBackend(int numQubits) const {
+    if (backend != Backend::Auto) {
+        return backend;
+    }
+    return numQubits >= AUTO_STABILIZER_QUBITS && noise_model.empty() && isClifford()
+        ? Backend::Stabilizer : Backend::StateVector;
+}
+
+void CircuitManager::executeCircuit(StabilizerTableau& tableau) {
+    if (!noise_model.empty()) {
+        throw std::invalid_argument("The stabilizer backend does not support noise models");
+    }
+    std::optional<std::vector<CliffordOp>> ops = lowerClifford();
+    if (!ops) {
+        throw std::invalid_argument("Circuit contains non-Clifford gates");
+    }
+    std::mt19937_64& rng = gate_engine.getRandomEngine();
+    for (const CliffordOp& op : *ops) {
+        const int result = tableau.apply(op, rng);
+        if (op.opcode == OpCode::Measure) {
+            circuit[op.gate_index].measurement_result = result;
+        }
+    }
+}
+
+Histogram CircuitManager::sample(int numQubits, std::uint64_t shots) {
+    if (shots == 0) {
+        throw std::invalid_argument("Shot count must be positive");
+    }
+    if (selectBackend(numQubits) == Backend::StateVector) {
+        QubitManager qubits(numQubits);
+        return sample(qubits, shots);
+    }
+    if (!noise_model.empty()) {
+        throw std::invalid_argument("The stabilizer backend does not support noise models");
+    }
+    std::optional<std::vector<CliffordOp>> ops = lowerClifford();
+    if (!ops) {
+        throw std::invalid_argument("Circuit contains non-Clifford gates");
+    }
+    return sampleStabilizer(numQubits, *ops, shots);
+}
+
+// Runs the tableau once with symbolic measurements: every outcome is then a
+// parity of random coins, so a shot only draws coins and evaluates parities.
+// Shots use the task split and per-shot seeding of sampleTrajectories.
+Histogram CircuitManager::sampleStabilizer(int numQubits, const std::vector<CliffordOp>& ops,
+                                           std::uint64_t shots) {
+    StabilizerTableau tableau(numQubits);
+    std::mt19937_64& rng = gate_engine.getRandomEngine();
+    std::map<int, ParityOutcome> latest;  // Later measurements of a qubit overwrite earlier ones
+    for (const CliffordOp& op : ops) {
+        if (op.opcode == OpCode::Measure) {
+            latest[op.target] = tableau.measureSymbolic(op.target);
+        } else {
+            tableau.apply(op, rng);
+        }
+    }
+    if (latest.empty()) {
+        for (int q = 0; q < numQubits; ++q) {
+            latest[q] = tableau.measureSymbolic(q);
+        }
+    }
+
+    // Highest measured qubit leftmost
+    std::vector<const ParityOutcome*> columns;
+    for (auto it = latest.rbegin(); it != latest.rend(); ++it) {
+        columns.push_back(&it->second);
+    }
+    const std::size_t coins = tableau.getCoinCount();
+    const std::uint64_t base_seed = rng();
+    const std::uint64_t tasks = std::min<std::uint64_t>(shots, ThreadPool::global().getThreadCount());
+    std::vector<Histogram> partial(tasks);
+
+    ThreadPool::global().parallelTasks(tasks, [&](std::uint64_t task, std::uint64_t) {
+        std::mt19937_64 shot_rng;
+        std::vector<std::uint64_t> values((coins + 63) / 64);
+        std::string bits(columns.size(), '0');
+        for (std::uint64_t shot = task; shot < shots; shot += tasks) {
+            shot_rng.seed(base_seed + shot * 0x9E3779B97F4A7C15ull);
+            for (std::uint64_t& word : values) {
+                word = shot_rng();
             }
-            else {
-                throw std::invalid_argument("Unknown gate: " + gate.gate_name);
+            for (std::size_t c = 0; c < columns.size(); ++c) {
+                bits[c] = columns[c]->evaluate(values) ? '1' : '0';
             }
+            ++partial[task][bits];
+        }
+    });
+
+    Histogram histogram;
+    for (const Histogram& counts : partial) {
+        for (const auto& [outcome, count] : counts) {
+            histogram[outcome] += count;
+        }
+    }
+    return histogram;
+}
+
+void CircuitManager::setNoiseModel(const NoiseModel& model) {
+    noise_model = model;
+    cached_plan.reset();
+}
+
+const NoiseModel& CircuitManager::getNoiseModel() const {
+    return noise_model;
+}
+
+void CircuitManager::setSeed(std::uint64_t seed) {
+    gate_engine.setSeed(seed);
+}
+
+void CircuitManager::setMaxFusedWidth(int width) {
+    if (width < 0 || width > MAX_FUSED_WIDTH) {
+        throw std::invalid_argument("Fused width must be between 0 and " +
+                                    std::to_string(MAX_FUSED_WIDTH));
+    }
+    max_fused_width = width;
+    cached_plan.reset();
+}
+
+int CircuitManager::getMaxFusedWidth() const {
+    return max_fused_width;
+}
+
+const FusionStats& CircuitManager::getFusionStats() const {
+    return fusion_stats;
+}
+
+void CircuitManager::setBlockQubits(int width) {
+    if (width != 0 && (width < kernels::MAX_DENSE_QUBITS || width > QubitManager::MAX_QUBITS)) {
+        throw std::invalid_argument("Block width must be 0 or between " +
+                                    std::to_string(kernels::MAX_DENSE_QUBITS) + " and " +
+                                    std::to_string(QubitManager::MAX_QUBITS));
+    }
+    block_qubits = width;
+}
+
+int CircuitManager::getBlockQubits() const {
+    return block_qubits;
+}
+
+const BlockingStats& CircuitManager::getBlockingStats() const {
+    return blocking_stats;
+}
+
+void CircuitManager::setProfiling(bool enabled) {
+    if (enabled && !profiling) {
+        profiler.clear();
+    }
+    profiling = enabled;
+}
+
+bool CircuitManager::isProfiling() const {
+    return profiling;
+}
+
+const GateProfiler& CircuitManager::getProfile() const {
+    return profiler;
+}
+
+void CircuitManager::clearProfile() {
+    profiler.clear();
+}
+
+// Lowers the uncontrolled part of a gate, filling in its angles or matrix;
+// gates with symbolic angles are recorded in plan.parametric for rebinding
+CompiledOp CircuitManager::lowerBase(OpCode opcode, int numQubits, const GateOperation& gate,
+                                     CompiledCircuit& plan) const {
+    CompiledOp op = lowerOp(opcode, numQubits, gate.target_qubit, gate.control_qubit1, gate.control_qubit2);
+    if (opcode == OpCode::Unitary) {
+        op.matrix = gate.matrix;
+    }
+
+    const int count = parameterCount(opcode);
+    if (count == 0) {
+        return op;
+    }
+    if (static_cast<int>(gate.parameters.size()) < count) {
+        throw std::invalid_argument(gate.gate_name + " gate requires " + std::to_string(count) + " parameter(s)");
+    }
+    ParametricGate parametric;
+    parametric.opcode = opcode;
+    bool symbolic = false;
+    for (int k = 0; k < count; ++k) {
+        const GateParameter& parameter = gate.parameters[k];
+        parametric.parameters[k] = parameter;
+        if (parameter.symbol < 0) {
+            parametric.angles[k] = parameter.value;
+            continue;
+        }
+        if (parameter.symbol >= static_cast<int>(parameter_values.size())) {
+            throw std::out_of_range("Parameter index out of range: " + std::to_string(parameter.symbol));
+        }
+        parametric.angles[k] = parameter_values[parameter.symbol];
+        symbolic = true;
+    }
+    op.matrix = rotationMatrix(opcode, parametric.angles.data());
+    if (symbolic) {
+        op.param_slot = static_cast<int>(plan.parametric.size());
+        plan.parametric.push_back(parametric);
+    }
+    return op;
+}
+
+CompiledOp CircuitManager::lowerGate(const GateOperation& gate, int numQubits, CompiledCircuit& plan) const {
+    int min_controls = 0;
+    OpCode opcode = parseOpCode(gate.gate_name, &min_controls);
+
+    // Multi-qubit gates must name their extra qubits explicitly
+    if (opcode == OpCode::CNOT && gate.control_qubit1 < 0) {
+        throw std::invalid_argument("CNOT gate requires a control qubit");
+    }
+    if (opcode == OpCode::SWAP && gate.control_qubit1 < 0) {
+        throw std::invalid_argument("SWAP gate requires two qubits");
+    }
+    if (opcode == OpCode::Toffoli && (gate.control_qubit1 < 0 || gate.control_qubit2 < 0)) {
+        throw std::invalid_argument("TOFFOLI gate requires two control qubits");
+    }
+
+    CompiledOp op;
+    const bool extra_controls = !gate.controls.empty() || !gate.negative_controls.empty();
+    if ((opcode == OpCode::CNOT || opcode == OpCode::Toffoli) && extra_controls) {
+        // CNOT / TOFFOLI with further controls become one multi-controlled X
+        std::vector<int> controls = gate.controls;
+        controls.push_back(gate.control_qubit1);
+        if (opcode == OpCode::Toffoli) {
+            controls.push_back(gate.control_qubit2);
+        }
+        op = lowerControlled(lowerOp(OpCode::PauliX, numQubits, gate.target_qubit),
+                             numQubits, controls, gate.negative_controls);
+    } else if (min_controls > 0 && opcode != OpCode::CNOT && opcode != OpCode::Toffoli) {
+        // Controlled aliases (CZ, CPHASE, CU, MCX) take control_qubit1/2 as well
+        std::vector<int> controls = gate.controls;
+        for (int control : {gate.control_qubit1, gate.control_qubit2}) {
+            if (control >= 0) {
+                controls.push_back(control);
+            }
+        }
+        if (static_cast<int>(controls.size() + gate.negative_controls.size()) < min_controls) {
+            throw std::invalid_argument(gate.gate_name + " gate requires a control qubit");
+        }
+        op = lowerBase(opcode, numQubits, gate, plan);
+        if (op.param_slot >= 0) {
+            throw std::invalid_argument("Symbolic parameters cannot be used on controlled gates");
+        }
+        op = lowerControlled(op, numQubits, controls, gate.negative_controls);
+    } else {
+        op = lowerBase(opcode, numQubits, gate, plan);
+        if (extra_controls && op.param_slot >= 0) {
+            throw std::invalid_argument("Symbolic parameters cannot be used on controlled gates");
+        }
+        if (extra_controls) {
+            op = lowerControlled(op, numQubits, gate.controls, gate.negative_controls);
+        }
+    }
+    return op;
+}
+
+// Lowers every GateOperation to a CompiledOp, validating each exactly once
+CompiledCircuit CircuitManager::compile(int numQubits) const {
+    return compileRange(numQubits, 0, circuit.size());
+}
+
+CompiledCircuit CircuitManager::compileRange(int numQubits, std::size_t firstGate, std::size_t lastGate) const {
+    CompiledCircuit plan;
+    plan.num_qubits = numQubits;
+    plan.ops.reserve(lastGate - firstGate);
+
+    for (std::size_t index = firstGate; index < lastGate; ++index) {
+        const GateOperation& gate = circuit[index];
+        try {
+            CompiledOp op = lowerGate(gate, numQubits, plan);
+            op.gate_index = static_cast<int>(index);
+            if (op.opcode == OpCode::Measure) {
+                op.slot = static_cast<int>(plan.measurement_gates.size());
+                plan.measurement_gates.push_back(op.gate_index);
+            }
+            plan.ops.push_back(op);
         } catch (const std::exception& e) {
             std::cerr << "Error executing gate " << gate.gate_name << ": " << e.what() << std::endl;
             throw;
         }
     }
+    return plan;
+}
+
+// Runs a compiled plan; the switch-dispatch loop lives in GateEngine::executePlan
+template <typename Real>
+std::vector<int> CircuitManager::executeCompiled(const CompiledCircuit& plan, BasicQubitManager<Real>& qubits) {
+    std::vector<int> measurements;
+    gate_engine.executePlan(qubits, plan, measurements, profiling ? &profiler : nullptr);
+    return measurements;
 }
 
 // Prints the circuit structure with gate names and qubit indices
 void CircuitManager::printCircuit() const {
     std::cout << "Quantum Circuit:\n";
     for (const auto& gate : circuit) {
+        // Rotation angles follow the name, symbolic ones by parameter name
+        std::string label = gate.gate_name;
+        if (!gate.parameters.empty() && takesAngles(gate.gate_name)) {
+            label += "(";
+            for (std::size_t k = 0; k < gate.parameters.size(); ++k) {
+                const GateParameter& parameter = gate.parameters[k];
+                label += k > 0 ? ", " : "";
+                label += parameter.symbol >= 0 && parameter.symbol < static_cast<int>(parameter_names.size())
+                    ? parameter_names[parameter.symbol] : std::to_string(parameter.value);
+            }
+            label += ")";
+        }
         if (gate.gate_name == "CNOT") {
             // Two-qubit controlled gate
             std::cout << gate.gate_name << " (Control: " << gate.control_qubit1 
@@ -133,6 +952,22 @@ void CircuitManager::printCircuit() const {
             // Three-qubit controlled gate
             std::cout << gate.gate_name << " (Controls: " << gate.control_qubit1 
                       << ", " << gate.control_qubit2 << ", Target: " << gate.target_qubit << ")\n";
+        } else if (!gate.controls.empty() || !gate.negative_controls.empty() ||
+                   gate.control_qubit1 >= 0) {
+            // Multi-controlled gate; negative controls are prefixed with '!'
+            std::cout << label << " (Controls:";
+            for (int control : {gate.control_qubit1, gate.control_qubit2}) {
+                if (control >= 0) {
+                    std::cout << " " << control;
+                }
+            }
+            for (int control : gate.controls) {
+                std::cout << " " << control;
+            }
+            for (int control : gate.negative_controls) {
+                std::cout << " !" << control;
+            }
+            std::cout << ", Target: " << gate.target_qubit << ")\n";
         } else if (gate.gate_name == "MEASURE") {
             // Measurement operation
             std::cout << gate.gate_name << " (Qubit " << gate.target_qubit << ")";
@@ -142,7 +977,21 @@ void CircuitManager::printCircuit() const {
             std::cout << "\n";
         } else {
             // Single-qubit gates
-            std::cout << gate.gate_name << " (Qubit " << gate.target_qubit << ")\n";
+            std::cout << label << " (Qubit " << gate.target_qubit << ")\n";
         }
     }
-}
\ No newline at end of file
+}
+
+// State-vector execution runs on both register precisions
+template void CircuitManager::executeCircuit(QubitManager&);
+template void CircuitManager::executeCircuit(QubitManagerF&);
+template void CircuitManager::executeCircuit(QubitManager&, std::size_t, std::size_t);
+template void CircuitManager::executeCircuit(QubitManagerF&, std::size_t, std::size_t);
+template void CircuitManager::executeWithCheckpoint(QubitManager&, std::size_t, const std::string&);
+template void CircuitManager::executeWithCheckpoint(QubitManagerF&, std::size_t, const std::string&);
+template QubitManager CircuitManager::resumeFromCheckpoint(const std::string&, bool);
+template QubitManagerF CircuitManager::resumeFromCheckpoint(const std::string&, bool);
+template Histogram CircuitManager::sample(QubitManager&, std::uint64_t);
+template Histogram CircuitManager::sample(QubitManagerF&, std::uint64_t);
+template std::vector<int> CircuitManager::executeCompiled(const CompiledCircuit&, QubitManager&);
+template std::vector<int> CircuitManager::executeCompiled(const CompiledCircuit&, QubitManagerF&);
@@ -2,6 +2,22 @@
 
 #include "qubit_manager.h"
 #include "gate_engine.h"
+#include "compiled_circuit.h"
+#include "gate_fusion.h"
+#include "cache_blocking.h"
+#include "sampler.h"
+#include "adjoint_gradient.h"
+#include "pauli_sum.h"
+#include "noise_model.h"
+#include "density_matrix.h"
+#include "stabilizer_tableau.h"
+#include "hybrid_state.h"
+#include "mps_state.h"
+#include "split_state.h"
+#include "checkpoint.h"
+#include "circuit_file.h"
+#include "gate_profiler.h"
+#include <optional>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -25,6 +41,25 @@ struct GateOperation {
     
     /// Measurement result (-1 if not yet measured, 0 or 1 if measured)
     mutable int measurement_result = -1;
+
+    /// Additional controls that must be |1⟩ (any number)
+    std::vector<int> controls{};
+
+    /// Negative controls that must be |0⟩
+    std::vector<int> negative_controls{};
+
+    /// Angles for rotation gates (RX, RY, RZ, PHASE, U3), constant or symbolic
+    std::vector<GateParameter> parameters{};
+
+    /// Target matrix for "U" / "CU" gates
+    kernels::Matrix2 matrix = {1.0, 0.0, 0.0, 1.0};
+};
+
+/// Simulation method used by CircuitManager::sample(int, std::uint64_t)
+enum class Backend {
+    Auto,         ///< Stabilizer for wide noiseless Clifford circuits, state vector otherwise
+    StateVector,  ///< Dense 2^n amplitudes (any gate, any noise)
+    Stabilizer    ///< Bit-packed tableau (Clifford gates only, no noise)
 };
 
 /**
@@ -37,8 +72,14 @@ struct GateOperation {
  * 
  * @note Gates are executed in the order they are added
  * @note Quantum state is modified in-place during execution
+ * @note executeCircuit compiles the gate list once and reuses the plan
+ *       until the circuit or the register width changes
  */
 class CircuitManager {
+public:
+    /// Narrowest Clifford register Backend::Auto sends to the stabilizer backend
+    static constexpr int AUTO_STABILIZER_QUBITS = 18;
+
 private:
     /// Sequence of gates to execute
     std::vector<GateOperation> circuit;
@@ -46,6 +87,73 @@ private:
     /// Gate execution engine (mutable for const execution)
     mutable GateEngine gate_engine;
 
+    /// Plan reused by executeCircuit until the gate list changes
+    std::optional<CompiledCircuit> cached_plan;
+
+    /// Largest block the fusion pass may build (0 disables fusion)
+    int max_fused_width = DEFAULT_FUSED_WIDTH;
+
+    /// Result of the fusion pass for cached_plan
+    FusionStats fusion_stats;
+
+    /// Block width for cache-blocked execution (0 disables blocking)
+    int block_qubits = DEFAULT_BLOCK_QUBITS;
+
+    /// Pass counts of the last cache-blocked execution
+    BlockingStats blocking_stats;
+
+    /// Channels inserted after gates and readout errors on measurements
+    NoiseModel noise_model;
+
+    /// Per-op timings of executeCircuit while profiling is on
+    GateProfiler profiler;
+
+    /// Whether executeCircuit feeds profiler
+    bool profiling = false;
+
+    /// Returns the cached (compiled, noise-annotated and fused) plan for numQubits, rebuilding it if stale
+    const CompiledCircuit& preparePlan(int numQubits);
+
+    /// Inserts noise and fuses a freshly compiled plan, updating fusion_stats
+    void finishPlan(CompiledCircuit& plan);
+
+    /// Lowers gates [firstGate, lastGate) for a numQubits register
+    CompiledCircuit compileRange(int numQubits, std::size_t firstGate, std::size_t lastGate) const;
+
+    /// Adds NOISE ops after each gate and readout channels to MEASURE ops
+    void insertNoise(CompiledCircuit& plan) const;
+
+    /// Flips bit b of outcome with the readout error of measured[b]
+    std::uint64_t applyReadoutErrors(std::uint64_t outcome, const std::vector<int>& measured,
+                                     std::mt19937_64& rng) const;
+
+    /// Runs one trajectory per shot across the thread pool
+    template <typename Real>
+    OutcomeCounts sampleTrajectories(const BasicQubitManager<Real>& initial, const CompiledCircuit& plan,
+                                     const std::vector<int>& measured, std::uint64_t shots);
+
+    /// Backend requested with setBackend
+    Backend backend = Backend::Auto;
+
+    /// Lowers the circuit to tableau ops, or returns nothing if a gate is not Clifford
+    std::optional<std::vector<CliffordOp>> lowerClifford() const;
+
+    /// Runs the tableau once with symbolic measurements; shots only draw the coins, across the thread pool
+    Histogram sampleStabilizer(int numQubits, const std::vector<CliffordOp>& ops, std::uint64_t shots);
+
+    /// Names of the symbolic parameters, indexed by GateParameter::symbol
+    std::vector<std::string> parameter_names;
+
+    /// Current value of each symbolic parameter
+    std::vector<double> parameter_values;
+
+    /// Lowers one gate (validation, aliases, controls) to a compiled op without gate_index / slot
+    CompiledOp lowerGate(const GateOperation& gate, int numQubits, CompiledCircuit& plan) const;
+
+    /// Lowers a gate without its extra controls (sets rotation angles / U matrix)
+    CompiledOp lowerBase(OpCode opcode, int numQubits, const GateOperation& gate,
+                         CompiledCircuit& plan) const;
+
 public:
     /**
      * @brief Adds a gate to the circuit
@@ -62,6 +170,115 @@ public:
     void addGate(const std::string& gateName, int targetQubit, 
                  int controlQubit1 = -1, int controlQubit2 = -1);
 
+    /**
+     * @brief Adds a single-qubit gate conditioned on any number of controls
+     * @param gateName Base gate ("X", "Y", "Z", "H", "PHASE") or alias ("MCX", "CZ", "CPHASE")
+     * @param targetQubit Target qubit index (0-based)
+     * @param controls Qubits that must be |1⟩
+     * @param negativeControls Qubits that must be |0⟩ (default: none)
+     * @param angle Angle in radians for rotation bases such as PHASE / CPHASE (default: 0)
+     * @throws std::invalid_argument if targetQubit < 0
+     * 
+     * Example: addControlledGate("X", 5, {0, 1, 2, 3, 4}) adds a 5-control
+     * Toffoli that runs as one sweep over 2^(n-6) amplitude pairs.
+     */
+    void addControlledGate(const std::string& gateName, int targetQubit, const std::vector<int>& controls,
+                           const std::vector<int>& negativeControls = {}, double angle = 0.0);
+
+    /**
+     * @brief Adds an arbitrary 2x2 unitary on targetQubit with controls ("CU")
+     * @param matrix Row-major gate matrix
+     * @param targetQubit Target qubit index (0-based)
+     * @param controls Qubits that must be |1⟩ (may be empty for a plain "U")
+     * @param negativeControls Qubits that must be |0⟩ (default: none)
+     * @throws std::invalid_argument if targetQubit < 0
+     */
+    void addControlledUnitary(const kernels::Matrix2& matrix, int targetQubit, const std::vector<int>& controls,
+                              const std::vector<int>& negativeControls = {});
+
+    /**
+     * @brief Adds a rotation gate whose angles may be symbolic parameters
+     * @param gateName "RX", "RY", "RZ", "PHASE" (one angle) or "U3" (theta, phi, lambda)
+     * @param targetQubit Target qubit index (0-based)
+     * @param parameters Constants ({0.5}) or references from parameter()
+     * @param controls Qubits that must be |1⟩ (constant angles only; default: none)
+     * @throws std::invalid_argument if targetQubit < 0
+     * 
+     * Example: addParameterizedGate("RY", 0, {parameter("theta")}) adds a
+     * gate whose angle follows setParameter("theta", ...) without recompiling.
+     */
+    void addParameterizedGate(const std::string& gateName, int targetQubit,
+                              const std::vector<GateParameter>& parameters,
+                              const std::vector<int>& controls = {});
+
+    /**
+     * @brief Declares a named symbolic parameter
+     * @param name Parameter name (unique within the circuit)
+     * @param value Initial value in radians (default: 0)
+     * @return Index of the parameter in the parameter table
+     * @throws std::invalid_argument if name is already declared
+     */
+    int addParameter(const std::string& name, double value = 0.0);
+
+    /**
+     * @brief Gets a symbolic reference to a declared parameter
+     * @param name Parameter name
+     * @return GateParameter referring to the parameter
+     * @throws std::invalid_argument if name is not declared
+     */
+    GateParameter parameter(const std::string& name) const;
+
+    /**
+     * @brief Sets one parameter value
+     * @param name Parameter name
+     * @param value New value in radians
+     * @throws std::invalid_argument if name is not declared
+     * 
+     * The cached plan is rebound in place; it is not recompiled.
+     */
+    void setParameter(const std::string& name, double value);
+
+    /**
+     * @brief Replaces all parameter values at once
+     * @param values One value per declared parameter, in declaration order
+     * @throws std::invalid_argument if values.size() differs from the parameter count
+     */
+    void bindParameters(const std::vector<double>& values);
+
+    /**
+     * @brief Gets the current parameter values in declaration order
+     * @return Parameter table values
+     */
+    const std::vector<double>& getParameterValues() const { return parameter_values; }
+
+    /**
+     * @brief Gets the declared parameter names in declaration order
+     * @return Parameter table names
+     */
+    const std::vector<std::string>& getParameterNames() const { return parameter_names; }
+
+    /**
+     * @brief Computes ⟨H⟩ of the final state and its gradient by the adjoint method
+     * @param qubits Initial state (restored to it, up to rounding, on return)
+     * @param observable Callable applying a Hermitian H in place
+     * @return Expectation value and one derivative per declared parameter
+     * @throws std::invalid_argument if the circuit contains MEASURE or a gate is invalid
+     * 
+     * Costs about one circuit execution forward, two backward and one sweep
+     * per symbolic gate, independent of the number of parameters.
+     */
+    GradientResult adjointGradient(QubitManager& qubits, const ObservableFunction& observable);
+
+    /**
+     * @brief Computes ⟨H⟩ and its gradient for a Pauli-sum observable
+     * @param qubits Initial state (restored to it, up to rounding, on return)
+     * @param observable Pauli sum fitting the register
+     * @return Expectation value and one derivative per declared parameter
+     * @throws std::invalid_argument if the circuit contains MEASURE or a gate is invalid
+     * @throws std::out_of_range if the observable acts outside the register
+     */
+    GradientResult adjointGradient(QubitManager& qubits, const PauliSum& observable);
+
     /**
      * @brief Removes a gate from the circuit at specified index
      * @param index Index of gate to remove (0-based)
@@ -88,6 +305,34 @@ public:
      */
     int getCircuitSize() const { return circuit.size(); }
 
+    /**
+     * @brief Reserves room for gates about to be added
+     * @param count Expected total number of gates
+     *
+     * Bulk loaders (e.g. parseQasm) call this so million-gate circuits are
+     * not reallocated and moved repeatedly while they grow.
+     */
+    void reserveGates(std::size_t count) { circuit.reserve(count); }
+
+    /**
+     * @brief Saves the gates and parameter table to a binary circuit file
+     * @param path Destination, replaced atomically (see circuit_file.h)
+     * @throws std::invalid_argument if a gate cannot be encoded
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveCircuit(const std::string& path) const;
+
+    /**
+     * @brief Replaces the gates and parameter table with a saved circuit
+     * @param path File written by saveCircuit or convertQasmToCircuitFile
+     * @return Decoded header (qubit count, gate count)
+     * @throws std::runtime_error if the file is invalid; the circuit is unchanged then
+     *
+     * The file is read with one call and the gate list is reserved to its
+     * exact size, so loading costs one pass over the records.
+     */
+    CircuitFileInfo loadCircuit(const std::string& path);
+
     /**
      * @brief Gets gate at specified index
      * @param index Gate index (0-based)
@@ -102,9 +347,317 @@ public:
      * @throws std::runtime_error if execution fails
      * @throws std::invalid_argument if gate or qubit invalid
      * 
-     * Gates are applied in the order they were added.
+     * Gates are applied in the order they were added. Runs of adjacent
+     * gates are fused into dense blocks (see setMaxFusedWidth). Registers
+     * of at least MIN_BLOCKED_QUBITS qubits run cache-blocked (see
+     * setBlockQubits). File-backed registers larger than a quarter of
+     * available memory run blocked in chunks of that size instead (see
+     * outOfCoreBlockQubits), so every stage streams the file sequentially.
+     * Accepts QubitManager and QubitManagerF; fused
+     * matrices are built in double and rounded once per op for float.
+     */
+    template <typename Real>
+    void executeCircuit(BasicQubitManager<Real>& qubits);
+
+    /**
+     * @brief Executes gates [firstGate, lastGate) only
+     * @param qubits Register holding the state after the first firstGate gates
+     * @param firstGate Index of the first gate to apply
+     * @param lastGate One past the last gate to apply (at most getCircuitSize())
+     * @throws std::out_of_range if the range is not within the circuit
+     *
+     * Runs like executeCircuit, with fusion confined to the range, so
+     * running [0, k) and then [k, n) gives the same state as one run. Only
+     * the full range reuses the cached plan.
+     */
+    template <typename Real>
+    void executeCircuit(BasicQubitManager<Real>& qubits, std::size_t firstGate, std::size_t lastGate);
+
+    /**
+     * @brief Executes the circuit, saving a checkpoint after gate gateIndex
+     * @param qubits Register to run on
+     * @param gateIndex Number of gates applied before the checkpoint is written
+     * @param path Checkpoint file (see saveCheckpoint)
+     * @throws std::out_of_range if gateIndex exceeds getCircuitSize()
+     * @throws std::runtime_error if the checkpoint cannot be written
+     *
+     * The checkpoint records gateIndex as its next gate, so
+     * resumeFromCheckpoint can continue from it after a failure or with a
+     * different circuit suffix.
+     */
+    template <typename Real>
+    void executeWithCheckpoint(BasicQubitManager<Real>& qubits, std::size_t gateIndex, const std::string& path);
+
+    /**
+     * @brief Loads a checkpoint and runs the remaining gates on it
+     * @param path Checkpoint written by executeWithCheckpoint or saveCheckpoint
+     * @param verify Check the payload checksum before running
+     * @return Final register, backed by a private mapping of the checkpoint
+     * @throws std::runtime_error if the checkpoint is invalid or of another precision or layout
+     * @throws std::out_of_range if its next gate lies beyond the circuit
+     *
+     * The state is mapped without copying (see loadCheckpoint); the file is
+     * left unchanged, so the same checkpoint can seed several suffixes.
+     * Measurements after the checkpoint draw from this manager's current
+     * random engine, not the one of the original run.
+     */
+    template <typename Real>
+    BasicQubitManager<Real> resumeFromCheckpoint(const std::string& path, bool verify = true);
+
+    /**
+     * @brief Executes the circuit exactly on a density matrix
+     * @param rho Mixed state of up to DensityMatrixManager::MAX_QUBITS qubits
+     * @throws std::invalid_argument if a gate or qubit is invalid
+     *
+     * Applies the same compiled plan as executeCircuit, with noise channels
+     * applied as exact superoperators instead of sampled trajectories.
+     * MEASURE acts as a non-selective measurement (it removes coherences
+     * but does not collapse), so GateOperation::measurement_result is not
+     * updated. Readout errors do not affect ρ and are ignored.
+     */
+    void executeCircuit(DensityMatrixManager& rho);
+
+    /**
+     * @brief Executes the circuit on a sparse-first register
+     * @param state Register of up to SparseState::MAX_QUBITS qubits
+     * @throws std::invalid_argument if a gate or qubit is invalid
+     *
+     * Runs the same plan as executeCircuit, on the sparse amplitudes until
+     * the state promotes itself to dense. Mostly-classical circuits (X,
+     * CNOT, TOFFOLI, phases) stay at a few entries on 40+ qubits.
+     * Measurement results are recorded like executeCircuit.
+     */
+    void executeCircuit(HybridState& state);
+
+    /**
+     * @brief Executes the circuit on a matrix product state
+     * @param mps Register of any width (state will be modified)
+     * @throws std::invalid_argument if a gate is invalid, acts on more than
+     *         MPSState::MAX_GATE_QUBITS qubits, or a noise model is set
+     * @throws std::out_of_range if a qubit index is outside the register
+     *
+     * Each gate is lowered on its own qubits only, so registers may be wider
+     * than the 63 qubits compiled plans support, and is applied as a dense
+     * matrix; MPSState inserts the SWAPs for non-adjacent qubits. Gates are
+     * not fused (fusing would merge bonds the SVD could otherwise keep small).
+     * Measurement results are recorded like executeCircuit.
+     */
+    void executeCircuit(MPSState& mps);
+
+    /**
+     * @brief Executes the circuit on a split real/imaginary register
+     * @param state Register to run on (state will be modified)
+     * @throws std::invalid_argument if a gate is invalid or a noise model is set
+     *
+     * Runs the same compiled and fused plan as executeCircuit through the
+     * split-layout kernels. Measurement results are recorded like
+     * executeCircuit. Plans are not cache-blocked.
+     */
+    void executeCircuit(SplitState& state);
+
+    /**
+     * @brief Executes the circuit on every member of a batch at once
+     * @param batch Batched registers of up to BatchedState::MAX_QUBITS qubits
+     * @throws std::invalid_argument if a gate is invalid or the circuit contains MEASURE
+     * 
+     * Uses the same compiled and fused plan as executeCircuit; each op is
+     * applied once to the interleaved buffer instead of once per member.
+     * Every member runs with the current parameter bindings; batching over
+     * parameter sets is not supported.
+     */
+    void executeBatch(BatchedState& batch);
+
+    /**
+     * @brief Samples measurement outcomes over many shots
+     * @param qubits Register to run on (left in the pre-measurement state)
+     * @param shots Number of shots to draw
+     * @return Histogram of measured bitstrings (highest measured qubit leftmost)
+     * @throws std::invalid_argument if shots is 0 or a gate is invalid
+     * 
+     * When all MEASURE gates are at the end of the circuit, the unitary
+     * prefix runs once and every shot is drawn from the final distribution
+     * in a single sorted pass. Bitstrings cover the measured qubits, or the
+     * whole register if the circuit has no MEASURE. Circuits with mid-circuit
+     * measurements or gate noise run one trajectory per shot, spread over
+     * the thread pool; qubits is then left untouched.
+     */
+    template <typename Real>
+    Histogram sample(BasicQubitManager<Real>& qubits, std::uint64_t shots);
+
+    /**
+     * @brief Samples a register of the given width with the selected backend
+     * @param numQubits Register width (may exceed QubitManager::MAX_QUBITS for Clifford circuits)
+     * @param shots Number of shots to draw
+     * @return Histogram of measured bitstrings, as sample(QubitManager&, shots)
+     * @throws std::invalid_argument if shots is 0, or the forced backend cannot run the circuit
+     *
+     * The register starts in |0...0⟩. See selectBackend for the choice of
+     * simulator. The stabilizer backend runs the tableau once with symbolic
+     * measurements; each shot then only draws the measurement coins.
+     */
+    Histogram sample(int numQubits, std::uint64_t shots);
+
+    /**
+     * @brief Executes a Clifford circuit on a stabilizer tableau
+     * @param tableau Register to run on (state will be modified)
+     * @throws std::invalid_argument if a gate is not Clifford or a noise model is set
+     * @throws std::out_of_range if a qubit index is outside the tableau
+     *
+     * Records measurement results on the circuit like executeCircuit.
+     */
+    void executeCircuit(StabilizerTableau& tableau);
+
+    /**
+     * @brief Checks whether every gate is a Clifford gate
+     * @return True if the circuit only uses H, X, Y, Z, CNOT, CZ, SWAP, MEASURE
+     *         and constant PHASE / RZ angles that are multiples of pi/2;
+     *         false for unknown or malformed gates, which fail on execution
+     */
+    bool isClifford() const;
+
+    /**
+     * @brief Forces a backend for sample(int, std::uint64_t)
+     * @param requested Backend to use (Auto by default)
+     */
+    void setBackend(Backend requested);
+
+    /**
+     * @brief Gets the backend set with setBackend
+     * @return Requested backend
+     */
+    Backend getBackend() const;
+
+    /**
+     * @brief Resolves the backend sample(numQubits, shots) will use
+     * @param numQubits Register width
+     * @return StateVector or Stabilizer
+     *
+     * With Backend::Auto, noiseless Clifford circuits on at least
+     * AUTO_STABILIZER_QUBITS qubits use the tableau; narrower registers
+     * sample faster from one state vector.
+     */
+    Backend selectBackend(int numQubits) const;
+
+    /**
+     * @brief Sets the noise applied by executeCircuit and sample
+     * @param model Gate, qubit and readout noise (an empty model is noiseless)
+     * 
+     * executeCircuit then runs a single stochastic trajectory; sample
+     * averages one trajectory per shot.
+     */
+    void setNoiseModel(const NoiseModel& model);
+
+    /**
+     * @brief Gets the current noise model
+     * @return Noise model (empty unless setNoiseModel was called)
+     */
+    const NoiseModel& getNoiseModel() const;
+
+    /**
+     * @brief Seeds the random engine used by MEASURE and sample()
+     * @param seed Seed value; equal seeds reproduce results
+     */
+    void setSeed(std::uint64_t seed);
+
+    /**
+     * @brief Sets the widest block the fusion pass may build
+     * @param width Qubits per fused block in [1, MAX_FUSED_WIDTH], or 0 to disable fusion
+     * @throws std::invalid_argument if width is out of range
+     */
+    void setMaxFusedWidth(int width);
+
+    /**
+     * @brief Gets the fusion width used by executeCircuit
+     * @return Qubits per fused block (0 if fusion is disabled)
+     */
+    int getMaxFusedWidth() const;
+
+    /**
+     * @brief Reports the sweeps saved by fusion for the last executed plan
+     * @return Sweep counts before and after fusion
+     */
+    const FusionStats& getFusionStats() const;
+
+    /**
+     * @brief Sets the block width used for registers larger than the last-level cache
+     * @param width Block width in [kernels::MAX_DENSE_QUBITS, QubitManager::MAX_QUBITS], or 0 to disable blocking
+     * @throws std::invalid_argument if width is out of range
+     *
+     * executeCircuit applies runs of gates on the low width qubits to one
+     * 2^width-amplitude block at a time (see cache_blocking.h) on registers
+     * of at least MIN_BLOCKED_QUBITS qubits.
+     */
+    void setBlockQubits(int width);
+
+    /**
+     * @brief Gets the block width used by executeCircuit
+     * @return Block width (0 if blocking is disabled)
+     */
+    int getBlockQubits() const;
+
+    /**
+     * @brief Reports the passes over memory of the last cache-blocked execution
+     * @return Pass counts before and after blocking (zero if no execution was blocked)
+     */
+    const BlockingStats& getBlockingStats() const;
+
+    /**
+     * @brief Turns per-op profiling of executeCircuit on or off
+     * @param enabled True to time every op of later runs
+     *
+     * While on, executeCircuit and executeCompiled on QubitManager and
+     * QubitManagerF record each op's wall time, bytes moved and kernel
+     * variant in getProfile(); cache-blocked stages are timed as a whole.
+     * Each profiled op costs two clock reads and one event append. While
+     * off, execution takes the unprofiled loop. Turning profiling on
+     * clears earlier events.
+     */
+    void setProfiling(bool enabled);
+
+    /**
+     * @brief Checks whether executeCircuit is being profiled
+     * @return True after setProfiling(true)
+     */
+    bool isProfiling() const;
+
+    /**
+     * @brief Gets the events and per-gate-type totals recorded so far
+     * @return Profiler accumulating over all profiled runs
+     *
+     * Use GateProfiler::summary or printSummary for totals per gate type
+     * and writeChromeTrace for a chrome://tracing / Perfetto timeline.
+     */
+    const GateProfiler& getProfile() const;
+
+    /**
+     * @brief Drops recorded events and totals, keeping profiling on or off
+     */
+    void clearProfile();
+
+    /**
+     * @brief Validates the circuit and lowers it to an opcode plan
+     * @param numQubits Register width the plan will run on
+     * @return Plan with OpCodes, sorted qubit positions and bit masks
+     * @throws std::invalid_argument if a gate is unknown or misses required qubits
+     * @throws std::out_of_range if a qubit index is outside [0, numQubits)
+     * 
+     * All name parsing and index checks happen here, once. The returned
+     * plan can be executed any number of times with executeCompiled.
+     */
+    CompiledCircuit compile(int numQubits) const;
+
+    /**
+     * @brief Executes a previously compiled plan
+     * @param plan Plan returned by compile()
+     * @param qubits Reference to QubitManager (state will be modified)
+     * @return Measurement results in plan measurement-slot order
+     * @throws std::invalid_argument if the plan width differs from qubits
+     * 
+     * Does not touch GateOperation::measurement_result; use executeCircuit
+     * to record results on the circuit itself.
      */
-    void executeCircuit(QubitManager& qubits);
+    template <typename Real>
+    std::vector<int> executeCompiled(const CompiledCircuit& plan, BasicQubitManager<Real>& qubits);
 
     /**
      * @brief Prints circuit information to stdout
@@ -0,0 +1,396 @@
+#include "compiled_circuit.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+/// Unit imaginary number (0 + 1i)
+constexpr std::complex<double> IMAGINARY_UNIT{0.0, 1.0};
+
+/// Reciprocal of square root 2 (1/√2 ≈ 0.707)
+constexpr double INVERSE_SQRT2 = 0.7071067811865475;
+
+// Range check shared by every operand
+void validateQubitIndex(int numQubits, int qubit) {
+    if (qubit < 0 || qubit >= numQubits) {
+        throw std::out_of_range("Qubit index out of range: " + std::to_string(qubit));
+    }
+}
+
+// Stores qubits in ascending order for zero-bit insertion
+void setPositions(CompiledOp& op, std::initializer_list<int> qubits) {
+    op.num_positions = 0;
+    for (int qubit : qubits) {
+        op.positions[op.num_positions++] = qubit;
+    }
+    std::sort(op.positions.begin(), op.positions.begin() + op.num_positions);
+}
+
+}  // namespace
+
+// Gate names are normalized to upper case once, at compile time
+OpCode parseOpCode(const std::string& gateName, int* minControls) {
+    struct Entry {
+        OpCode opcode;
+        int min_controls;
+    };
+    static const std::unordered_map<std::string, Entry> names = {
+        {"X", {OpCode::PauliX, 0}}, {"PAULI-X", {OpCode::PauliX, 0}},
+        {"Y", {OpCode::PauliY, 0}}, {"PAULI-Y", {OpCode::PauliY, 0}},
+        {"Z", {OpCode::PauliZ, 0}}, {"PAULI-Z", {OpCode::PauliZ, 0}},
+        {"H", {OpCode::Hadamard, 0}}, {"HADAMARD", {OpCode::Hadamard, 0}},
+        {"PHASE", {OpCode::Phase, 0}}, {"P", {OpCode::Phase, 0}},
+        {"U", {OpCode::Unitary, 0}},
+        {"CNOT", {OpCode::CNOT, 1}},
+        {"SWAP", {OpCode::SWAP, 0}},
+        {"TOFFOLI", {OpCode::Toffoli, 2}},
+        {"MEASURE", {OpCode::Measure, 0}},
+        {"CZ", {OpCode::PauliZ, 1}},
+        {"CPHASE", {OpCode::Phase, 1}}, {"CP", {OpCode::Phase, 1}},
+        {"CU", {OpCode::Unitary, 1}},
+        {"MCX", {OpCode::PauliX, 1}},
+        {"RX", {OpCode::RX, 0}}, {"RY", {OpCode::RY, 0}}, {"RZ", {OpCode::RZ, 0}},
+        {"U3", {OpCode::U3, 0}},
+    };
+
+    std::string upper;
+    std::transform(gateName.begin(), gateName.end(), std::back_inserter(upper),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    auto it = names.find(upper);
+    if (it == names.end()) {
+        throw std::invalid_argument("Unknown gate: " + gateName);
+    }
+    if (minControls != nullptr) {
+        *minControls = it->second.min_controls;
+    }
+    return it->second.opcode;
+}
+
+kernels::Matrix2 phaseMatrix(double angle) {
+    return {1.0, 0.0, 0.0, std::polar(1.0, angle)};
+}
+
+int parameterCount(OpCode opcode) {
+    switch (opcode) {
+        case OpCode::RX:
+        case OpCode::RY:
+        case OpCode::RZ:
+        case OpCode::Phase:
+            return 1;
+        case OpCode::U3:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+kernels::Matrix2 rotationMatrix(OpCode opcode, const double* angles) {
+    const double c = std::cos(angles[0] / 2);
+    const double s = std::sin(angles[0] / 2);
+    switch (opcode) {
+        case OpCode::RX:
+            return {c, -IMAGINARY_UNIT * s, -IMAGINARY_UNIT * s, c};
+        case OpCode::RY:
+            return {c, -s, s, c};
+        case OpCode::RZ:
+            return {std::polar(1.0, -angles[0] / 2), 0.0, 0.0, std::polar(1.0, angles[0] / 2)};
+        case OpCode::Phase:
+            return phaseMatrix(angles[0]);
+        case OpCode::U3:
+            return {c, -std::polar(s, angles[2]), std::polar(s, angles[1]),
+                    std::polar(c, angles[1] + angles[2])};
+        default:
+            throw std::invalid_argument(std::string(opCodeName(opcode)) + " gate takes no angles");
+    }
+}
+
+kernels::Matrix2 rotationDerivative(OpCode opcode, const double* angles, int index) {
+    if (index < 0 || index >= parameterCount(opcode)) {
+        throw std::invalid_argument(std::string(opCodeName(opcode)) + " gate has no angle " +
+                                    std::to_string(index));
+    }
+    const double c = std::cos(angles[0] / 2);
+    const double s = std::sin(angles[0] / 2);
+    switch (opcode) {
+        case OpCode::RX:
+            return {-s / 2, -IMAGINARY_UNIT * (c / 2), -IMAGINARY_UNIT * (c / 2), -s / 2};
+        case OpCode::RY:
+            return {-s / 2, -c / 2, c / 2, -s / 2};
+        case OpCode::RZ:
+            return {-IMAGINARY_UNIT * std::polar(0.5, -angles[0] / 2), 0.0,
+                    0.0, IMAGINARY_UNIT * std::polar(0.5, angles[0] / 2)};
+        case OpCode::Phase:
+            return {0.0, 0.0, 0.0, IMAGINARY_UNIT * std::polar(1.0, angles[0])};
+        default:
+            break;
+    }
+
+    // U3: theta scales the cos/sin envelope, phi and lambda only rotate phases
+    const double phi = angles[1];
+    const double lambda = angles[2];
+    if (index == 0) {
+        return {-s / 2, -std::polar(c / 2, lambda), std::polar(c / 2, phi), -std::polar(s / 2, phi + lambda)};
+    }
+    if (index == 1) {
+        return {0.0, 0.0, IMAGINARY_UNIT * std::polar(s, phi), IMAGINARY_UNIT * std::polar(c, phi + lambda)};
+    }
+    return {0.0, -IMAGINARY_UNIT * std::polar(s, lambda), 0.0, IMAGINARY_UNIT * std::polar(c, phi + lambda)};
+}
+
+void bindParameters(CompiledCircuit& plan, const std::vector<double>& values) {
+    for (CompiledOp& op : plan.ops) {
+        if (op.param_slot < 0) {
+            continue;
+        }
+        ParametricGate& gate = plan.parametric[op.param_slot];
+        for (int k = 0; k < parameterCount(gate.opcode); ++k) {
+            const GateParameter& parameter = gate.parameters[k];
+            if (parameter.symbol < 0) {
+                gate.angles[k] = parameter.value;
+            } else if (parameter.symbol < static_cast<int>(values.size())) {
+                gate.angles[k] = values[parameter.symbol];
+            } else {
+                throw std::out_of_range("Parameter index out of range: " + std::to_string(parameter.symbol));
+            }
+        }
+        op.matrix = rotationMatrix(gate.opcode, gate.angles.data());
+    }
+}
+
+CompiledOp adjointOp(const CompiledOp& op) {
+    CompiledOp adjoint = op;
+    switch (op.opcode) {
+        case OpCode::CNOT:
+        case OpCode::SWAP:
+        case OpCode::Toffoli:
+            break;  // Permutations are self-inverse
+        case OpCode::Measure:
+            throw std::invalid_argument("MEASURE has no adjoint");
+        case OpCode::Noise:
+            throw std::invalid_argument("NOISE has no adjoint");
+        case OpCode::Fused: {
+            const std::size_t dim = std::size_t{1} << op.num_positions;
+            for (std::size_t r = 0; r < dim; ++r) {
+                for (std::size_t c = 0; c < dim; ++c) {
+                    adjoint.dense_matrix[r * dim + c] = std::conj(op.dense_matrix[c * dim + r]);
+                }
+            }
+            break;
+        }
+        default:
+            adjoint.matrix = {std::conj(op.matrix[0]), std::conj(op.matrix[2]),
+                              std::conj(op.matrix[1]), std::conj(op.matrix[3])};
+            break;
+    }
+    return adjoint;
+}
+
+const char* opCodeName(OpCode opcode) {
+    switch (opcode) {
+        case OpCode::PauliX: return "X";
+        case OpCode::PauliY: return "Y";
+        case OpCode::PauliZ: return "Z";
+        case OpCode::Hadamard: return "H";
+        case OpCode::CNOT: return "CNOT";
+        case OpCode::SWAP: return "SWAP";
+        case OpCode::Toffoli: return "TOFFOLI";
+        case OpCode::Measure: return "MEASURE";
+        case OpCode::Unitary: return "U";
+        case OpCode::Fused: return "FUSED";
+        case OpCode::Phase: return "PHASE";
+        case OpCode::Controlled: return "CONTROLLED";
+        case OpCode::RX: return "RX";
+        case OpCode::RY: return "RY";
+        case OpCode::RZ: return "RZ";
+        case OpCode::U3: return "U3";
+        case OpCode::Noise: return "NOISE";
+    }
+    return "?";
+}
+
+CompiledOp lowerOp(OpCode opcode, int numQubits, int targetQubit, int controlQubit1, int controlQubit2) {
+    CompiledOp op;
+    op.opcode = opcode;
+    op.target = targetQubit;
+    validateQubitIndex(numQubits, targetQubit);
+    const std::uint64_t target_mask = std::uint64_t{1} << targetQubit;
+
+    switch (opcode) {
+        case OpCode::PauliX:
+            op.matrix = {0.0, 1.0, 1.0, 0.0};
+            break;
+        case OpCode::PauliY:
+            op.matrix = {0.0, -IMAGINARY_UNIT, IMAGINARY_UNIT, 0.0};
+            break;
+        case OpCode::PauliZ:
+            op.matrix = {1.0, 0.0, 0.0, -1.0};
+            break;
+        case OpCode::Hadamard:
+            op.matrix = {INVERSE_SQRT2, INVERSE_SQRT2, INVERSE_SQRT2, -INVERSE_SQRT2};
+            break;
+        case OpCode::Unitary:
+        case OpCode::Phase:
+        case OpCode::RX:
+        case OpCode::RY:
+        case OpCode::RZ:
+        case OpCode::U3:
+            op.matrix = {1.0, 0.0, 0.0, 1.0};  // Caller supplies the matrix / angles
+            break;
+        case OpCode::Measure:
+            break;
+        case OpCode::Fused:
+            throw std::invalid_argument("FUSED ops are produced by fuseGates, not lowered from a gate");
+        case OpCode::Controlled:
+            throw std::invalid_argument("Controlled ops are built with lowerControlled");
+        case OpCode::Noise:
+            break;  // Caller supplies the channel
+        case OpCode::CNOT: {
+            validateQubitIndex(numQubits, controlQubit1);
+            if (controlQubit1 == targetQubit) {
+                throw std::invalid_argument("Control and target qubits must be different");
+            }
+            // Indices with control=1, target=0 swap with their target-flipped partner
+            const std::uint64_t control_mask = std::uint64_t{1} << controlQubit1;
+            setPositions(op, {controlQubit1, targetQubit});
+            op.mask_a = control_mask;
+            op.mask_b = control_mask | target_mask;
+            break;
+        }
+        case OpCode::SWAP: {
+            validateQubitIndex(numQubits, controlQubit1);
+            if (controlQubit1 == targetQubit) {
+                throw std::invalid_argument("SWAP gate requires distinct qubits");
+            }
+            setPositions(op, {controlQubit1, targetQubit});
+            op.mask_a = std::uint64_t{1} << controlQubit1;
+            op.mask_b = target_mask;
+            break;
+        }
+        case OpCode::Toffoli: {
+            validateQubitIndex(numQubits, controlQubit1);
+            validateQubitIndex(numQubits, controlQubit2);
+            if (controlQubit1 == controlQubit2 || controlQubit1 == targetQubit || controlQubit2 == targetQubit) {
+                throw std::invalid_argument("Toffoli gate requires distinct qubits");
+            }
+            const std::uint64_t control_mask = (std::uint64_t{1} << controlQubit1) |
+                                               (std::uint64_t{1} << controlQubit2);
+            setPositions(op, {controlQubit1, controlQubit2, targetQubit});
+            op.mask_a = control_mask;
+            op.mask_b = control_mask | target_mask;
+            break;
+        }
+    }
+    return op;
+}
+
+CompiledOp lowerControlled(const CompiledOp& base, int numQubits, const std::vector<int>& controls,
+                           const std::vector<int>& negativeControls) {
+    switch (base.opcode) {
+        case OpCode::PauliX:
+        case OpCode::PauliY:
+        case OpCode::PauliZ:
+        case OpCode::Hadamard:
+        case OpCode::Unitary:
+        case OpCode::Phase:
+        case OpCode::RX:
+        case OpCode::RY:
+        case OpCode::RZ:
+        case OpCode::U3:
+            break;
+        default:
+            throw std::invalid_argument(std::string(opCodeName(base.opcode)) +
+                                        " gate cannot take extra controls");
+    }
+
+    CompiledOp op;
+    op.opcode = OpCode::Controlled;
+    op.target = base.target;
+    op.matrix = base.matrix;
+    const std::uint64_t target_mask = std::uint64_t{1} << base.target;
+
+    // Every control (of either polarity) must be a distinct non-target qubit
+    auto addControl = [&](int qubit, bool value) {
+        validateQubitIndex(numQubits, qubit);
+        const std::uint64_t bit = std::uint64_t{1} << qubit;
+        if (bit & (op.control_mask | target_mask)) {
+            throw std::invalid_argument("Controlled gate requires distinct qubits");
+        }
+        op.control_mask |= bit;
+        op.control_values |= value ? bit : 0;
+    };
+    for (int qubit : controls) {
+        addControl(qubit, true);
+    }
+    for (int qubit : negativeControls) {
+        addControl(qubit, false);
+    }
+    return op;
+}
+
+CompiledOp shiftQubits(const CompiledOp& op, int offset) {
+    CompiledOp shifted = op;
+    shifted.target = op.target + offset;
+    for (int p = 0; p < op.num_positions; ++p) {
+        shifted.positions[p] = op.positions[p] + offset;
+    }
+    shifted.mask_a = op.mask_a << offset;
+    shifted.mask_b = op.mask_b << offset;
+    shifted.control_mask = op.control_mask << offset;
+    shifted.control_values = op.control_values << offset;
+    return shifted;
+}
+
+CompiledOp permuteQubits(const CompiledOp& op, const std::vector<int>& layout) {
+    auto mapMask = [&](std::uint64_t mask) {
+        std::uint64_t mapped = 0;
+        for (; mask != 0; mask &= mask - 1) {
+            mapped |= std::uint64_t{1} << layout[__builtin_ctzll(mask)];
+        }
+        return mapped;
+    };
+
+    CompiledOp permuted = op;
+    if (op.target >= 0) {
+        permuted.target = layout[op.target];
+    }
+    permuted.mask_a = mapMask(op.mask_a);
+    permuted.mask_b = mapMask(op.mask_b);
+    permuted.control_mask = mapMask(op.control_mask);
+    permuted.control_values = mapMask(op.control_values);
+    if (op.num_positions == 0) {
+        return permuted;
+    }
+
+    // New local bit p is old local bit order[p]; at most three entries, so insertion sort
+    std::array<int, kernels::MAX_DENSE_QUBITS> order{};
+    for (int p = 0; p < op.num_positions; ++p) {
+        const int mapped = layout[op.positions[p]];
+        int q = p;
+        for (; q > 0 && layout[op.positions[order[q - 1]]] > mapped; --q) {
+            order[q] = order[q - 1];
+        }
+        order[q] = p;
+    }
+    for (int p = 0; p < op.num_positions; ++p) {
+        permuted.positions[p] = layout[op.positions[order[p]]];
+    }
+    if (op.opcode == OpCode::Fused) {
+        const std::size_t dim = std::size_t{1} << op.num_positions;
+        auto localIndex = [&](std::size_t old) {
+            std::size_t index = 0;
+            for (int p = 0; p < op.num_positions; ++p) {
+                index |= ((old >> order[p]) & 1) << p;
+            }
+            return index;
+        };
+        for (std::size_t r = 0; r < dim; ++r) {
+            for (std::size_t c = 0; c < dim; ++c) {
+                permuted.dense_matrix[localIndex(r) * dim + localIndex(c)] = op.dense_matrix[r * dim + c];
+            }
+        }
+    }
+    return permuted;
+}
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "simd_kernels.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file compiled_circuit.h
+ * @brief Validated, string-free representation of a circuit
+ *
+ * CircuitManager lowers its GateOperation list into a CompiledCircuit once:
+ * gate names become OpCodes, qubit indices are range/distinctness checked,
+ * and every bit mask and gate matrix the kernels need is precomputed.
+ * GateEngine::executePlan then runs the ops with a single switch and no
+ * further validation, so a plan can be replayed on many states cheaply.
+ */
+
+/// Operation kinds understood by GateEngine::executePlan
+enum class OpCode : std::uint8_t {
+    PauliX,
+    PauliY,
+    PauliZ,
+    Hadamard,
+    CNOT,
+    SWAP,
+    Toffoli,
+    Measure,
+    Unitary,   ///< Arbitrary 2x2 matrix on one qubit ("U")
+    Fused,     ///< Dense 4x4 or 8x8 matrix from fuseGates (see gate_fusion.h)
+    Phase,     ///< diag(1, e^{i angle}) ("PHASE", "P")
+    Controlled,///< 2x2 matrix on target, applied where control_mask bits equal control_values
+    RX,        ///< exp(-i theta X / 2)
+    RY,        ///< exp(-i theta Y / 2)
+    RZ,        ///< exp(-i theta Z / 2)
+    U3,        ///< U3(theta, phi, lambda), the general single-qubit rotation
+    Noise      ///< Stochastic noise channel on target (see noise_model.h)
+};
+
+/// Noise processes a NoiseChannel can describe
+enum class NoiseKind : std::uint8_t {
+    None,
+    Depolarizing,     ///< Random X, Y or Z with total probability `probability`
+    AmplitudeDamping, ///< |1⟩ decays to |0⟩ with probability `probability`
+    PhaseDamping,     ///< Loss of phase coherence with strength `probability`
+    Readout           ///< Reported measurement bit flipped (0->1 / 1->0 probabilities)
+};
+
+/**
+ * @struct NoiseChannel
+ * @brief One noise process acting on a single qubit
+ *
+ * Built with the factories in noise_model.h, which validate the probabilities.
+ */
+struct NoiseChannel {
+    /// Process kind
+    NoiseKind kind = NoiseKind::None;
+
+    /// Depolarizing p, damping gamma / lambda, or P(read 1 | 0) for Readout
+    double probability = 0.0;
+
+    /// P(read 0 | 1) for Readout (unused otherwise)
+    double probability_one = 0.0;
+};
+
+/// Most angles any gate takes (U3)
+constexpr int MAX_GATE_PARAMETERS = 3;
+
+/**
+ * @struct GateParameter
+ * @brief One angle argument of a gate: a constant or a named circuit parameter
+ *
+ * Symbolic parameters refer to CircuitManager's parameter table by index,
+ * so their values can be rebound without recompiling the circuit.
+ */
+struct GateParameter {
+    /// Angle in radians (used when symbol is -1)
+    double value = 0.0;
+
+    /// Index into the circuit's parameter table (-1 for a constant)
+    int symbol = -1;
+};
+
+/**
+ * @struct ParametricGate
+ * @brief Angle sources of one compiled op whose matrix depends on symbols
+ */
+struct ParametricGate {
+    /// Gate kind used to rebuild the matrix (RX, RY, RZ, PHASE or U3)
+    OpCode opcode = OpCode::RX;
+
+    /// Angle sources, parameterCount(opcode) entries used
+    std::array<GateParameter, MAX_GATE_PARAMETERS> parameters{};
+
+    /// Angles the op's matrix was last built from
+    std::array<double, MAX_GATE_PARAMETERS> angles{};
+};
+
+/**
+ * @struct CompiledOp
+ * @brief One lowered gate with precomputed masks
+ *
+ * Single-qubit ops carry their 2x2 matrix. Permutation ops (CNOT, SWAP,
+ * Toffoli) enumerate the 2^(n-k) indices with zero bits at `positions` and
+ * swap amplitudes (i | mask_a) and (i | mask_b). Fused ops apply
+ * `dense_matrix` to the qubits in `positions`. Controlled ops apply `matrix`
+ * to `target` on the indices whose control bits equal `control_values`.
+ */
+struct CompiledOp {
+    /// Operation kind
+    OpCode opcode = OpCode::PauliX;
+
+    /// Number of entries used in `positions`
+    int num_positions = 0;
+
+    /// Involved qubits in ascending order (zero-bit insertion order)
+    std::array<int, kernels::MAX_DENSE_QUBITS> positions{};
+
+    /// Target qubit (single-qubit gates and MEASURE)
+    int target = -1;
+
+    /// Permutation masks: swap(state[i | mask_a], state[i | mask_b])
+    std::uint64_t mask_a = 0;
+    std::uint64_t mask_b = 0;
+
+    /// Controlled ops: all control bits, and the value each must have
+    std::uint64_t control_mask = 0;
+    std::uint64_t control_values = 0;
+
+    /// Gate matrix for single-qubit and controlled ops
+    kernels::Matrix2 matrix{};
+
+    /// Row-major 2^k x 2^k matrix for Fused ops (empty otherwise)
+    std::vector<std::complex<double>> dense_matrix;
+
+    /// Index of the originating GateOperation (-1 if none)
+    int gate_index = -1;
+
+    /// Measurement result slot for MEASURE ops (-1 otherwise)
+    int slot = -1;
+
+    /// Index into CompiledCircuit::parametric if the matrix depends on symbols (-1 otherwise)
+    int param_slot = -1;
+
+    /// Channel applied by NOISE ops; readout error of MEASURE ops
+    NoiseChannel channel{};
+};
+
+/**
+ * @struct CompiledCircuit
+ * @brief Executable plan produced by CircuitManager::compile
+ */
+struct CompiledCircuit {
+    /// Register width the plan was validated against
+    int num_qubits = 0;
+
+    /// Ops in execution order
+    std::vector<CompiledOp> ops;
+
+    /// Originating gate index for each measurement slot
+    std::vector<int> measurement_gates;
+
+    /// Angle sources for ops with param_slot >= 0
+    std::vector<ParametricGate> parametric;
+};
+
+/**
+ * @brief Maps a gate name to its OpCode (case-insensitive, accepts aliases)
+ * @param gateName Gate identifier, e.g. "h", "Pauli-X", "CNOT", "CZ"
+ * @param minControls If non-null, receives the number of controls the name
+ *        implies (1 for CNOT, CZ, CPHASE, CU, MCX; 2 for TOFFOLI; else 0)
+ * @return Matching OpCode; controlled aliases return their base gate
+ *         (CZ -> PauliZ, CPHASE -> Phase, CU -> Unitary, MCX -> PauliX)
+ * @throws std::invalid_argument if the name is unknown
+ */
+OpCode parseOpCode(const std::string& gateName, int* minControls = nullptr);
+
+/**
+ * @brief Builds the phase gate matrix diag(1, e^{i angle})
+ * @param angle Phase in radians
+ * @return Row-major 2x2 matrix
+ */
+kernels::Matrix2 phaseMatrix(double angle);
+
+/**
+ * @brief Gets the number of angles a gate takes
+ * @param opcode Operation kind
+ * @return 1 for RX, RY, RZ and PHASE, 3 for U3, 0 otherwise
+ */
+int parameterCount(OpCode opcode);
+
+/**
+ * @brief Builds the matrix of a rotation gate
+ * @param opcode RX, RY, RZ, PHASE or U3
+ * @param angles parameterCount(opcode) angles in radians
+ * @return Row-major 2x2 matrix
+ * @throws std::invalid_argument if opcode takes no angles
+ */
+kernels::Matrix2 rotationMatrix(OpCode opcode, const double* angles);
+
+/**
+ * @brief Differentiates a rotation gate matrix with respect to one angle
+ * @param opcode RX, RY, RZ, PHASE or U3
+ * @param angles parameterCount(opcode) angles in radians
+ * @param index Angle to differentiate by, in [0, parameterCount(opcode))
+ * @return Row-major 2x2 matrix dU/d angles[index] (not unitary)
+ * @throws std::invalid_argument if opcode takes no angles or index is out of range
+ */
+kernels::Matrix2 rotationDerivative(OpCode opcode, const double* angles, int index);
+
+/**
+ * @brief Rebuilds the matrices of every symbolic op from new parameter values
+ * @param plan Compiled plan (may have been fused)
+ * @param values Parameter table, indexed by GateParameter::symbol
+ * @throws std::out_of_range if an op refers to a symbol past values.size()
+ *
+ * Only the ops listed in plan.parametric are touched, so rebinding costs a
+ * few trigonometric calls per symbolic gate instead of a full compile.
+ */
+void bindParameters(CompiledCircuit& plan, const std::vector<double>& values);
+
+/**
+ * @brief Builds the inverse of a lowered op
+ * @param op Lowered non-measurement op
+ * @return Op applying op's conjugate transpose (permutations are returned unchanged)
+ * @throws std::invalid_argument if op is a MEASURE or NOISE
+ */
+CompiledOp adjointOp(const CompiledOp& op);
+
+/**
+ * @brief Gets the canonical name of an OpCode
+ * @param opcode Operation kind
+ * @return Upper-case gate name ("H", "CNOT", ...)
+ */
+const char* opCodeName(OpCode opcode);
+
+/**
+ * @brief Validates operands and precomputes masks for one operation
+ * @param opcode Operation kind
+ * @param numQubits Register width
+ * @param targetQubit Target qubit (second qubit for SWAP)
+ * @param controlQubit1 First control (first qubit for SWAP), -1 if unused
+ * @param controlQubit2 Second control (TOFFOLI only), -1 if unused
+ * @return Lowered operation (gate_index and slot left at -1)
+ * @throws std::out_of_range if a qubit index is outside [0, numQubits)
+ * @throws std::invalid_argument if required qubits are missing or not distinct
+ */
+CompiledOp lowerOp(OpCode opcode, int numQubits, int targetQubit,
+                   int controlQubit1 = -1, int controlQubit2 = -1);
+
+/**
+ * @brief Relabels every qubit of an op as qubit + offset
+ * @param op Lowered op
+ * @param offset Number of qubit positions to shift by
+ * @return Op acting on the shifted qubits (masks shifted accordingly)
+ *
+ * Used to run a plan on a layout with extra low qubits, such as the
+ * batch-index qubits of a BatchedState.
+ */
+CompiledOp shiftQubits(const CompiledOp& op, int offset);
+
+/**
+ * @brief Adds controls to a lowered single-qubit op
+ * @param base Single-qubit op (X, Y, Z, H, PHASE or U) with its matrix set
+ * @param numQubits Register width
+ * @param controls Qubits that must be |1⟩
+ * @param negativeControls Qubits that must be |0⟩
+ * @return Controlled op carrying base's matrix and target
+ * @throws std::out_of_range if a control is outside [0, numQubits)
+ * @throws std::invalid_argument if base is not a single-qubit gate or qubits repeat
+ */
+CompiledOp lowerControlled(const CompiledOp& base, int numQubits, const std::vector<int>& controls,
+                           const std::vector<int>& negativeControls = {});
+
+/**
+ * @brief Relabels every qubit q of an op as layout[q]
+ * @param op Lowered op
+ * @param layout Physical position of each logical qubit (a permutation)
+ * @return Op acting on the relabeled qubits
+ *
+ * Positions are re-sorted, and a Fused op's dense matrix is permuted to
+ * follow its new local bit order. Used by cache blocking (see
+ * cache_blocking.h) to run ops on a register whose qubits were swapped.
+ */
+CompiledOp permuteQubits(const CompiledOp& op, const std::vector<int>& layout);
@@ -0,0 +1,144 @@
+#include "density_matrix.h"
+#include "noise_model.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+#include "utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Validated before the 2n-qubit buffer is allocated
+int checkedWidth(int numQubits) {
+    if (numQubits < 1 || numQubits > DensityMatrixManager::MAX_QUBITS) {
+        throw std::invalid_argument("Density matrices must have between 1 and " +
+                                    std::to_string(DensityMatrixManager::MAX_QUBITS) + " qubits");
+    }
+    return numQubits;
+}
+
+// Elementwise complex conjugate of an op (not the adjoint: no transpose)
+CompiledOp conjugateOp(const CompiledOp& op) {
+    CompiledOp conjugate = op;
+    for (auto& entry : conjugate.matrix) {
+        entry = std::conj(entry);
+    }
+    for (auto& entry : conjugate.dense_matrix) {
+        entry = std::conj(entry);
+    }
+    return conjugate;
+}
+
+}  // namespace
+
+DensityMatrixManager::DensityMatrixManager(int numQubits)
+    : num_qubits(checkedWidth(numQubits)), vectorized(2 * numQubits) {}
+
+DensityMatrixManager::DensityMatrixManager(const QubitManager& pure)
+    : num_qubits(checkedWidth(pure.getNumQubits())), vectorized(2 * pure.getNumQubits()) {
+    const std::complex<double>* psi = pure.getState().data();
+    std::complex<double>* rho = vectorized.getState().data();
+    const std::uint64_t dimension = getDimension();
+    ThreadPool::global().parallelFor(0, dimension * dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        for (std::uint64_t i = begin; i < end; ++i) {
+            rho[i] = psi[i & (dimension - 1)] * std::conj(psi[i >> num_qubits]);
+        }
+    });
+}
+
+void DensityMatrixManager::initializeZeroState() {
+    vectorized.initializeZeroState();
+}
+
+void DensityMatrixManager::setInitialState(const std::string& stateString) {
+    const std::uint64_t index = parseBasisState(stateString, num_qubits);
+    vectorized.getState().setZero();
+    vectorized.getState()(index + (index << num_qubits)) = 1.0;
+}
+
+std::complex<double> DensityMatrixManager::element(std::uint64_t row, std::uint64_t col) const {
+    if (row >= getDimension() || col >= getDimension()) {
+        throw std::out_of_range("Density matrix index out of range");
+    }
+    return vectorized.getState()(row + (col << num_qubits));
+}
+
+std::vector<double> DensityMatrixManager::getProbabilities() const {
+    std::vector<double> probabilities(getDimension());
+    for (std::uint64_t i = 0; i < probabilities.size(); ++i) {
+        probabilities[i] = vectorized.getState()(i + (i << num_qubits)).real();
+    }
+    return probabilities;
+}
+
+double DensityMatrixManager::trace() const {
+    double total = 0.0;
+    for (double p : getProbabilities()) {
+        total += p;
+    }
+    return total;
+}
+
+// Tr(ρ²) = Σ |ρ_rc|² for Hermitian ρ
+double DensityMatrixManager::purity() const {
+    const std::complex<double>* rho = vectorized.getState().data();
+    return ThreadPool::global().parallelSum(0, vectorized.getDimension(), [&](std::uint64_t begin, std::uint64_t end) {
+        return kernels::sumSquaredMagnitudes(rho, begin, end);
+    });
+}
+
+CompiledOp superoperatorOp(const std::vector<kernels::Matrix2>& kraus, int qubit, int numQubits) {
+    // Local basis index is row_bit + 2 * col_bit, matching positions {q, q + n}
+    CompiledOp op;
+    op.opcode = OpCode::Fused;
+    op.num_positions = 2;
+    op.positions[0] = qubit;
+    op.positions[1] = qubit + numQubits;
+    op.dense_matrix.assign(16, 0.0);
+    for (const kernels::Matrix2& k : kraus) {
+        for (int out = 0; out < 4; ++out) {
+            for (int in = 0; in < 4; ++in) {
+                const int row_out = out & 1, col_out = out >> 1;
+                const int row_in = in & 1, col_in = in >> 1;
+                op.dense_matrix[out * 4 + in] += k[row_out * 2 + row_in] * std::conj(k[col_out * 2 + col_in]);
+            }
+        }
+    }
+    return op;
+}
+
+CompiledCircuit toSuperoperatorPlan(const CompiledCircuit& plan) {
+    const int n = plan.num_qubits;
+    CompiledCircuit super;
+    super.num_qubits = 2 * n;
+    super.ops.reserve(plan.ops.size() * 2);
+
+    for (const CompiledOp& op : plan.ops) {
+        CompiledOp row = op;
+        row.param_slot = -1;  // Matrices are already bound; let the fusion pass merge them
+        row.slot = -1;
+        switch (op.opcode) {
+            case OpCode::Measure: {
+                // Non-selective measurement: drop coherences between |0⟩ and |1⟩
+                CompiledOp dephase = superoperatorOp({{1.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 1.0}}, op.target, n);
+                dephase.gate_index = op.gate_index;
+                super.ops.push_back(dephase);
+                break;
+            }
+            case OpCode::Noise: {
+                std::vector<kernels::Matrix2> kraus = krausOperators(op.channel);
+                if (!kraus.empty()) {
+                    CompiledOp channel = superoperatorOp(kraus, op.target, n);
+                    channel.gate_index = op.gate_index;
+                    super.ops.push_back(channel);
+                }
+                break;
+            }
+            default:
+                super.ops.push_back(row);
+                super.ops.push_back(shiftQubits(conjugateOp(row), n));
+                break;
+        }
+    }
+    return super;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "qubit_manager.h"
+#include "compiled_circuit.h"
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class DensityMatrixManager
+ * @brief Mixed state of a small register, stored as a 2n-qubit vector
+ *
+ * ρ is kept column-stacked: element (row, col) lives at index
+ * row + (col << n) of a 2n-qubit QubitManager. In that layout
+ * vec(U ρ U†) = (conj(U) ⊗ U) vec(ρ), so a gate on qubit q is the ordinary
+ * state-vector gate on "row" qubit q followed by its complex conjugate on
+ * "column" qubit q + n, and a single-qubit Kraus channel is one 4x4
+ * superoperator Σ_k conj(K_k) ⊗ K_k on the qubit pair (q, q + n). Both run
+ * through the existing kernel layer (see toSuperoperatorPlan).
+ *
+ * Memory is 16 * 4^n bytes, which limits registers to MAX_QUBITS.
+ */
+class DensityMatrixManager {
+public:
+    /// Largest register width supported (4^14 amplitudes = 4 GiB)
+    static constexpr int MAX_QUBITS = 14;
+
+    /**
+     * @brief Allocates ρ = |0...0⟩⟨0...0|
+     * @param numQubits Register width (1-MAX_QUBITS)
+     * @throws std::invalid_argument if numQubits is out of range
+     * @throws std::runtime_error if 16 * 4^numQubits bytes are not available
+     */
+    explicit DensityMatrixManager(int numQubits);
+
+    /**
+     * @brief Builds the pure state ρ = |ψ⟩⟨ψ|
+     * @param pure Register holding |ψ⟩ (at most MAX_QUBITS qubits)
+     * @throws std::invalid_argument if the register is too wide
+     */
+    explicit DensityMatrixManager(const QubitManager& pure);
+
+    /// Resets ρ to |0...0⟩⟨0...0|
+    void initializeZeroState();
+
+    /**
+     * @brief Sets ρ to a computational basis projector
+     * @param stateString Binary label, highest qubit first (e.g., "0101")
+     * @throws std::invalid_argument if the label is malformed
+     */
+    void setInitialState(const std::string& stateString);
+
+    /**
+     * @brief Gets the register width
+     * @return Number of qubits n (the vector has 2n)
+     */
+    int getNumQubits() const { return num_qubits; }
+
+    /**
+     * @brief Gets the matrix side length
+     * @return 2^n
+     */
+    std::uint64_t getDimension() const { return std::uint64_t{1} << num_qubits; }
+
+    /**
+     * @brief Gets ρ as a 2n-qubit vector for the kernels
+     * @return Column-stacked matrix elements
+     */
+    QubitManager& getVectorized() { return vectorized; }
+
+    /// @copydoc getVectorized()
+    const QubitManager& getVectorized() const { return vectorized; }
+
+    /**
+     * @brief Gets one matrix element ⟨row|ρ|col⟩
+     * @param row Row index in [0, 2^n)
+     * @param col Column index in [0, 2^n)
+     * @return Matrix element
+     * @throws std::out_of_range if an index is out of range
+     */
+    std::complex<double> element(std::uint64_t row, std::uint64_t col) const;
+
+    /**
+     * @brief Gets the measurement distribution (the diagonal of ρ)
+     * @return 2^n probabilities indexed by basis state
+     */
+    std::vector<double> getProbabilities() const;
+
+    /**
+     * @brief Computes Tr(ρ)
+     * @return Trace (1 for a valid state)
+     */
+    double trace() const;
+
+    /**
+     * @brief Computes Tr(ρ²)
+     * @return Purity, 1 for pure states and 2^-n for the maximally mixed state
+     */
+    double purity() const;
+
+private:
+    /// Register width n
+    int num_qubits;
+
+    /// ρ column-stacked into 4^n amplitudes
+    QubitManager vectorized;
+};
+
+/**
+ * @brief Rewrites a state-vector plan as a plan acting on vec(ρ)
+ * @param plan Plan compiled for n qubits (may contain NOISE and MEASURE)
+ * @return Plan for 2n qubits containing only unitary and superoperator ops
+ *
+ * Each gate becomes the gate on qubits 0..n-1 plus its complex conjugate
+ * shifted to qubits n..2n-1. NOISE ops become a Fused 4x4 superoperator on
+ * (q, q + n); MEASURE becomes the dephasing superoperator (a non-selective
+ * measurement). Readout errors are classical and are dropped. Running
+ * fuseGates(result, 2) afterwards merges each single-qubit gate, its
+ * conjugate and any following channels on that qubit into one sweep.
+ */
+CompiledCircuit toSuperoperatorPlan(const CompiledCircuit& plan);
+
+/**
+ * @brief Builds the superoperator Σ_k conj(K_k) ⊗ K_k on (qubit, qubit + n)
+ * @param kraus Kraus operators of a single-qubit channel
+ * @param qubit Row qubit q
+ * @param numQubits Register width n
+ * @return Fused op with positions {q, q + n}
+ */
+CompiledOp superoperatorOp(const std::vector<kernels::Matrix2>& kraus, int qubit, int numQubits);
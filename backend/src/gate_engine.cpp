@@ -1,169 +1,374 @@
 #include "gate_engine.h"
+#include "thread_pool.h"
 #include <Eigen/Dense>
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 #include <cmath>
 
-void GateEngine::validateQubitIndex(const QubitManager& qubits, int qubit) const {
-    if (qubit < 0 || qubit >= qubits.getNumQubits()) {
-        throw std::out_of_range("Qubit index out of range: " + std::to_string(qubit));
-    }
+GateEngine::GateEngine() : rng(std::random_device{}()) {}
+
+void GateEngine::setSeed(std::uint64_t seed) {
+    rng.seed(seed);
 }
 
-void GateEngine::applyPauliX(QubitManager& qubits, int targetQubit) {
-    validateQubitIndex(qubits, targetQubit);
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
+std::mt19937_64& GateEngine::getRandomEngine() {
+    return rng;
+}
+
+void GateEngine::applySingleQubitGate(QubitManager& qubits, int targetQubit, const kernels::Matrix2& matrix) {
+    CompiledOp op = lowerOp(OpCode::Unitary, qubits.getNumQubits(), targetQubit);
+    op.matrix = matrix;
+    applyOp(qubits, op);
+}
 
+void GateEngine::applyPauliX(QubitManager& qubits, int targetQubit) {
     // Pauli-X (bit flip): swap amplitudes of basis states differing in target qubit
-    for (int i = 0; i < dimension; ++i) {
-        int flipped_index = i ^ (1 << targetQubit);
-        if (flipped_index > i) {
-            std::swap(state(i), state(flipped_index));
-        }
-    }
+    applyOp(qubits, lowerOp(OpCode::PauliX, qubits.getNumQubits(), targetQubit));
 }
 
 void GateEngine::applyPauliY(QubitManager& qubits, int targetQubit) {
-    validateQubitIndex(qubits, targetQubit);
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
-
     // Pauli-Y gate: |0⟩ -> i|1⟩, |1⟩ -> -i|0⟩
-    for (int i = 0; i < dimension; ++i) {
-        int flipped_index = i ^ (1 << targetQubit);
-        if (flipped_index > i) {  // Process each pair once
-            std::complex<double> temp = state(i);
-            state(i) = -IMAGINARY_UNIT * state(flipped_index);
-            state(flipped_index) = IMAGINARY_UNIT * temp;
-        }
-    }
+    applyOp(qubits, lowerOp(OpCode::PauliY, qubits.getNumQubits(), targetQubit));
 }
 
 void GateEngine::applyPauliZ(QubitManager& qubits, int targetQubit) {
-    validateQubitIndex(qubits, targetQubit);
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
-
     // Pauli-Z gate: applies -1 phase to |1⟩ states
-    for (int i = 0; i < dimension; ++i) {
-        if ((i >> targetQubit) & 1) {
-            state(i) = -state(i);
-        }
-    }
+    applyOp(qubits, lowerOp(OpCode::PauliZ, qubits.getNumQubits(), targetQubit));
 }
 
 void GateEngine::applyHadamard(QubitManager& qubits, int targetQubit) {
-    validateQubitIndex(qubits, targetQubit);
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
-
     // Hadamard gate: creates superposition. H|0⟩ = (|0⟩+|1⟩)/√2, H|1⟩ = (|0⟩-|1⟩)/√2
-    Eigen::VectorXcd new_state = Eigen::VectorXcd::Zero(dimension);
-
-    for (int i = 0; i < dimension; ++i) {
-        if ((i >> targetQubit) & 1) {
-            new_state[i] = (state[i ^ (1 << targetQubit)] - state[i]) * INVERSE_SQRT2;
-        } else {
-            new_state[i] = (state[i] + state[i ^ (1 << targetQubit)]) * INVERSE_SQRT2;
-        }
-    }
-    state = new_state;
+    applyOp(qubits, lowerOp(OpCode::Hadamard, qubits.getNumQubits(), targetQubit));
 }
 
 void GateEngine::applyCNOT(QubitManager& qubits, int controlQubit, int targetQubit) {
-    validateQubitIndex(qubits, controlQubit);
-    validateQubitIndex(qubits, targetQubit);
-    if (controlQubit == targetQubit) {
-        throw std::invalid_argument("Control and target qubits must be different");
+    // CNOT gate: if control qubit is |1⟩, flip the target qubit
+    applyOp(qubits, lowerOp(OpCode::CNOT, qubits.getNumQubits(), targetQubit, controlQubit));
+}
+
+void GateEngine::applySWAP(QubitManager& qubits, int qubit1, int qubit2) {
+    // SWAP gate: exchange |..1..0..⟩ and |..0..1..⟩ amplitudes
+    applyOp(qubits, lowerOp(OpCode::SWAP, qubits.getNumQubits(), qubit2, qubit1));
+}
+
+void GateEngine::applyToffoli(QubitManager& qubits, int control1, int control2, int targetQubit) {
+    // Toffoli (CCX) gate: flip target if both controls are |1⟩
+    applyOp(qubits, lowerOp(OpCode::Toffoli, qubits.getNumQubits(), targetQubit, control1, control2));
+}
+
+void GateEngine::applyControlledGate(QubitManager& qubits, const kernels::Matrix2& matrix, int targetQubit,
+                                     const std::vector<int>& controls, const std::vector<int>& negativeControls) {
+    CompiledOp base = lowerOp(OpCode::Unitary, qubits.getNumQubits(), targetQubit);
+    base.matrix = matrix;
+    applyOp(qubits, lowerControlled(base, qubits.getNumQubits(), controls, negativeControls));
+}
+
+void GateEngine::applyMCX(QubitManager& qubits, const std::vector<int>& controls, int targetQubit) {
+    // X on the target wherever every control is |1⟩
+    CompiledOp base = lowerOp(OpCode::PauliX, qubits.getNumQubits(), targetQubit);
+    applyOp(qubits, lowerControlled(base, qubits.getNumQubits(), controls));
+}
+
+void GateEngine::applyCZ(QubitManager& qubits, int controlQubit, int targetQubit) {
+    CompiledOp base = lowerOp(OpCode::PauliZ, qubits.getNumQubits(), targetQubit);
+    applyOp(qubits, lowerControlled(base, qubits.getNumQubits(), {controlQubit}));
+}
+
+void GateEngine::applyCPhase(QubitManager& qubits, int controlQubit, int targetQubit, double angle) {
+    CompiledOp base = lowerOp(OpCode::Phase, qubits.getNumQubits(), targetQubit);
+    base.matrix = phaseMatrix(angle);
+    applyOp(qubits, lowerControlled(base, qubits.getNumQubits(), {controlQubit}));
+}
+
+void GateEngine::applyRotation(QubitManager& qubits, OpCode opcode, int targetQubit,
+                               const std::vector<double>& angles) {
+    if (static_cast<int>(angles.size()) != parameterCount(opcode) || angles.empty()) {
+        throw std::invalid_argument(std::string(opCodeName(opcode)) + " gate requires " +
+                                    std::to_string(parameterCount(opcode)) + " angle(s)");
     }
+    CompiledOp op = lowerOp(opcode, qubits.getNumQubits(), targetQubit);
+    op.matrix = rotationMatrix(opcode, angles.data());
+    applyOp(qubits, op);
+}
 
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
+template <typename Real>
+int GateEngine::measureQubit(BasicQubitManager<Real>& qubits, int targetQubit) {
+    return applyOp(qubits, lowerOp(OpCode::Measure, qubits.getNumQubits(), targetQubit));
+}
 
-    // CNOT gate: if control qubit is |1⟩, flip the target qubit
-    for (int i = 0; i < dimension; ++i) {
-        if ((i >> controlQubit) & 1) {
-            int target_index = i ^ (1 << targetQubit);
-            if (target_index > i) {  // Only swap once per pair
-                std::swap(state(i), state(target_index));
+template <typename Real>
+int GateEngine::applyOp(BasicQubitManager<Real>& qubits, const CompiledOp& op) {
+    if (op.opcode == OpCode::Measure) {
+        int result = measure(qubits, op.target);
+        if (op.channel.kind == NoiseKind::Readout) {
+            // The state collapses to the true outcome; only the reported bit flips
+            double flip = result ? op.channel.probability_one : op.channel.probability;
+            if (std::uniform_real_distribution<double>(0.0, 1.0)(rng) < flip) {
+                result ^= 1;
             }
         }
+        return result;
     }
+    if (op.opcode == OpCode::Noise) {
+        applyNoise(qubits, op);
+        return -1;
+    }
+    applyToBuffer(qubits.getState().data(), qubits.getDimension(), op);
+    return -1;
 }
 
-void GateEngine::applySWAP(QubitManager& qubits, int qubit1, int qubit2) {
-    validateQubitIndex(qubits, qubit1);
-    validateQubitIndex(qubits, qubit2);
-    if (qubit1 == qubit2) {
-        throw std::invalid_argument("SWAP gate requires distinct qubits");
+template <typename Real>
+void GateEngine::applyToBuffer(std::complex<Real>* state, std::uint64_t dimension, const CompiledOp& op) {
+    switch (op.opcode) {
+        case OpCode::PauliX:
+        case OpCode::PauliY:
+        case OpCode::PauliZ:
+        case OpCode::Hadamard:
+        case OpCode::Unitary:
+        case OpCode::Phase:
+        case OpCode::RX:
+        case OpCode::RY:
+        case OpCode::RZ:
+        case OpCode::U3:
+            // One sweep over the 2^(n-1) amplitude pairs of the target qubit
+            ThreadPool::global().parallelFor(0, dimension / 2,
+                [&](std::uint64_t begin, std::uint64_t end) {
+                    kernels::applyMatrix2(state, op.target, op.matrix, begin, end);
+                });
+            return;
+
+        case OpCode::CNOT:
+        case OpCode::SWAP:
+        case OpCode::Toffoli:
+            // Enumerate only the 2^(n-k) indices the permutation touches
+            ThreadPool::global().parallelFor(0, dimension >> op.num_positions,
+                [&](std::uint64_t begin, std::uint64_t end) {
+                    kernels::swapMaskedPairs(state, op.positions.data(), op.num_positions,
+                                             op.mask_a, op.mask_b, begin, end);
+                });
+            return;
+
+        case OpCode::Controlled: {
+            // Enumerate only the pairs whose controls are satisfied
+            const int fixed_bits = __builtin_popcountll(op.control_mask) + 1;
+            ThreadPool::global().parallelFor(0, dimension >> fixed_bits,
+                [&](std::uint64_t begin, std::uint64_t end) {
+                    kernels::applyControlledMatrix2(state, op.target, op.matrix,
+                                                    op.control_mask, op.control_values, begin, end);
+                });
+            return;
+        }
+
+        case OpCode::Fused:
+            // One sweep applies the whole fused block
+            ThreadPool::global().parallelFor(0, dimension >> op.num_positions,
+                [&](std::uint64_t begin, std::uint64_t end) {
+                    kernels::applyDenseMatrix(state, op.positions.data(), op.num_positions,
+                                              op.dense_matrix.data(), begin, end);
+                });
+            return;
+
+        case OpCode::Measure:
+            throw std::invalid_argument("MEASURE cannot be applied to a raw amplitude buffer");
+
+        case OpCode::Noise:
+            throw std::invalid_argument("NOISE cannot be applied to a raw amplitude buffer");
     }
+}
 
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
+void GateEngine::executeBatch(BatchedState& batch, const CompiledCircuit& plan) {
+    if (plan.num_qubits != batch.getNumQubits()) {
+        throw std::invalid_argument("Plan compiled for " + std::to_string(plan.num_qubits) +
+                                    " qubits cannot run on a " + std::to_string(batch.getNumQubits()) +
+                                    "-qubit batch");
+    }
+    if (!plan.measurement_gates.empty()) {
+        throw std::invalid_argument("Batched execution does not support MEASURE");
+    }
+    if (std::any_of(plan.ops.begin(), plan.ops.end(),
+                    [](const CompiledOp& op) { return op.opcode == OpCode::Noise; })) {
+        throw std::invalid_argument("Batched execution does not support noise");
+    }
 
-    // SWAP gate: exchange states of qubit1 and qubit2
-    for (int i = 0; i < dimension; ++i) {
-        // Only process if qubit1 and qubit2 have different values
-        if (((i >> qubit1) & 1) != ((i >> qubit2) & 1)) {
-            int swapped_index = (i ^ (1 << qubit1)) ^ (1 << qubit2);
-            if (swapped_index > i) {  // Only swap once per pair
-                std::swap(state(i), state(swapped_index));
+    // Lanes occupy the low qubits of each block, so gate qubits move up by lane_bits
+    std::vector<CompiledOp> shifted;
+    shifted.reserve(plan.ops.size());
+    for (const CompiledOp& op : plan.ops) {
+        shifted.push_back(shiftQubits(op, batch.getLaneBits()));
+    }
+
+    // Whole plan per block while it is cache resident; blocks are spread over
+    // the pool by assigning each block to the chunk containing its first amplitude
+    const std::uint64_t block_dimension = batch.getBlockDimension();
+    ThreadPool::global().parallelFor(0, batch.getNumBlocks() * block_dimension,
+        [&](std::uint64_t begin, std::uint64_t end) {
+            std::uint64_t first = (begin + block_dimension - 1) / block_dimension;
+            std::uint64_t last = (end + block_dimension - 1) / block_dimension;
+            for (std::uint64_t block = first; block < last; ++block) {
+                for (const CompiledOp& op : shifted) {
+                    applyToBuffer(batch.blockData(block), block_dimension, op);
+                }
+            }
+        });
+}
+
+template <typename Real>
+void GateEngine::executePlan(BasicQubitManager<Real>& qubits, const CompiledCircuit& plan, std::vector<int>& measurements,
+                             GateProfiler* profiler) {
+    if (plan.num_qubits != qubits.getNumQubits()) {
+        throw std::invalid_argument("Plan compiled for " + std::to_string(plan.num_qubits) +
+                                    " qubits cannot run on " + std::to_string(qubits.getNumQubits()));
+    }
+    measurements.assign(plan.measurement_gates.size(), -1);
+    if (profiler) {
+        // Separate loop, so unprofiled runs do not test the pointer per op
+        for (const CompiledOp& op : plan.ops) {
+            const GateProfiler::Clock::time_point start = GateProfiler::Clock::now();
+            int result = applyOp(qubits, op);
+            profiler->recordOp(op, qubits.getDimension(), sizeof(std::complex<Real>), start);
+            if (op.slot >= 0) {
+                measurements[op.slot] = result;
             }
         }
+        return;
+    }
+    for (const CompiledOp& op : plan.ops) {
+        int result = applyOp(qubits, op);
+        if (op.slot >= 0) {
+            measurements[op.slot] = result;
+        }
     }
 }
 
-void GateEngine::applyToffoli(QubitManager& qubits, int control1, int control2, int targetQubit) {
-    validateQubitIndex(qubits, control1);
-    validateQubitIndex(qubits, control2);
-    validateQubitIndex(qubits, targetQubit);
-    if (control1 == control2 || control1 == targetQubit || control2 == targetQubit) {
-        throw std::invalid_argument("Toffoli gate requires distinct qubits");
+template <typename Real>
+void GateEngine::executeBlocked(BasicQubitManager<Real>& qubits, const BlockedCircuit& plan, std::vector<int>& measurements,
+                                GateProfiler* profiler) {
+    if (plan.num_qubits != qubits.getNumQubits()) {
+        throw std::invalid_argument("Plan compiled for " + std::to_string(plan.num_qubits) +
+                                    " qubits cannot run on " + std::to_string(qubits.getNumQubits()));
     }
+    measurements.assign(plan.measurement_gates.size(), -1);
+    std::complex<Real>* state = qubits.getState().data();
+    const std::uint64_t block_dimension = std::uint64_t{1} << plan.block_qubits;
+    const std::uint64_t num_blocks = qubits.getDimension() >> plan.block_qubits;
 
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
+    // Stages are long enough that one pointer test each is free
+    for (const SweepStage& stage : plan.stages) {
+        const GateProfiler::Clock::time_point start = profiler ? GateProfiler::Clock::now()
+                                                               : GateProfiler::Clock::time_point{};
+        if (!stage.blocked) {
+            const CompiledOp& op = stage.ops.front().op;
+            int result = applyOp(qubits, op);
+            if (profiler) {
+                profiler->recordOp(op, qubits.getDimension(), sizeof(std::complex<Real>), start);
+            }
+            if (op.slot >= 0) {
+                measurements[op.slot] = result;
+            }
+            continue;
+        }
 
-    // Toffoli (CCX) gate: flip target if both controls are |1⟩
-    for (int i = 0; i < dimension; ++i) {
-        if (((i >> control1) & 1) && ((i >> control2) & 1)) {
-            int target_index = i ^ (1 << targetQubit);
-            std::swap(state(i), state(target_index));
+        // The whole stage runs on a block while it is cache resident; high
+        // controls skip the blocks they exclude
+        ThreadPool::global().parallelTasks(num_blocks, [&](std::uint64_t first, std::uint64_t last) {
+            for (std::uint64_t block = first; block < last; ++block) {
+                for (const BlockedOp& entry : stage.ops) {
+                    if ((block & entry.block_mask) == entry.block_values) {
+                        applyToBuffer(state + block * block_dimension, block_dimension, entry.op);
+                    }
+                }
+            }
+        });
+        if (profiler) {
+            profiler->recordStage(stage, qubits.getDimension(), sizeof(std::complex<Real>), start);
         }
     }
 }
 
-int GateEngine::measureQubit(QubitManager& qubits, int targetQubit) {
-    validateQubitIndex(qubits, targetQubit);
-    Eigen::VectorXcd& state = qubits.getState();
-    int dimension = state.size();
+template <typename Real>
+int GateEngine::measure(BasicQubitManager<Real>& qubits, int targetQubit) {
+    std::complex<Real>* state = qubits.getState().data();
+    const std::uint64_t pairs = qubits.getDimension() / 2;
+    ThreadPool& pool = ThreadPool::global();
+
+    // Calculate probability of measuring |1⟩ (parallel reduction over pairs)
+    double prob_one = pool.parallelSum(0, pairs, [&](std::uint64_t begin, std::uint64_t end) {
+        return kernels::sumSquaredMagnitudesForBit(state, targetQubit, 1, begin, end);
+    });
     
-    // Calculate probability of measuring |1⟩
-    double prob_one = 0.0;
-    for (int i = 0; i < dimension; ++i) {
-        if ((i >> targetQubit) & 1) {
-            prob_one += std::norm(state(i));
-        }
-    }
+    // Draw the outcome: u < P(1) happens with probability P(1)
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    int result = (u < prob_one) ? 1 : 0;
+    double prob_result = result ? prob_one : 1.0 - prob_one;
     
-    // Generate measurement result based on probability
-    // Use simple seeded random for deterministic testing
-    int result = (prob_one > 0.5) ? 1 : 0;
+    // Collapse state: zero the amplitudes inconsistent with the result and
+    // renormalize the survivors in the same pass
+    double scale = prob_result > 1e-20 ? 1.0 / std::sqrt(prob_result) : 1.0;
+    pool.parallelFor(0, pairs, [&](std::uint64_t begin, std::uint64_t end) {
+        kernels::collapsePairs(state, targetQubit, result, scale, begin, end);
+    });
     
-    // Collapse state: keep only states consistent with measurement result
-    for (int i = 0; i < dimension; ++i) {
-        int qubit_value = (i >> targetQubit) & 1;
-        if (qubit_value != result) {
-            state(i) = 0.0;
+    return result;
+}
+
+// Applies one Kraus operator of the channel, chosen with its Born probability
+template <typename Real>
+void GateEngine::applyNoise(BasicQubitManager<Real>& qubits, const CompiledOp& op) {
+    const NoiseChannel& channel = op.channel;
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    CompiledOp kraus = lowerOp(OpCode::Unitary, qubits.getNumQubits(), op.target);
+
+    switch (channel.kind) {
+        case NoiseKind::Depolarizing: {
+            // Mixture of unitaries: no norm is needed to pick the branch
+            if (u >= channel.probability) {
+                return;
+            }
+            static const OpCode paulis[3] = {OpCode::PauliX, OpCode::PauliY, OpCode::PauliZ};
+            int pauli = std::min(2, static_cast<int>(3.0 * u / channel.probability));
+            kraus = lowerOp(paulis[pauli], qubits.getNumQubits(), op.target);
+            break;
         }
+        case NoiseKind::PhaseDamping: {
+            // Equivalent to a Z flip with probability (1 - sqrt(1 - lambda)) / 2
+            if (u >= (1.0 - std::sqrt(1.0 - channel.probability)) / 2.0) {
+                return;
+            }
+            kraus = lowerOp(OpCode::PauliZ, qubits.getNumQubits(), op.target);
+            break;
+        }
+        case NoiseKind::AmplitudeDamping: {
+            // Jump (|1⟩ -> |0⟩) with probability gamma * P(1), else damp |1⟩; renormalize either way
+            const std::complex<Real>* state = qubits.getState().data();
+            double prob_one = ThreadPool::global().parallelSum(0, qubits.getDimension() / 2,
+                [&](std::uint64_t begin, std::uint64_t end) {
+                    return kernels::sumSquaredMagnitudesForBit(state, op.target, 1, begin, end);
+                });
+            double jump = channel.probability * prob_one;
+            if (u < jump) {
+                kraus.matrix = {0.0, 1.0 / std::sqrt(prob_one), 0.0, 0.0};
+            } else {
+                double scale = 1.0 / std::sqrt(1.0 - jump);
+                kraus.matrix = {scale, 0.0, 0.0, std::sqrt(1.0 - channel.probability) * scale};
+            }
+            break;
+        }
+        case NoiseKind::None:
+        case NoiseKind::Readout:
+            return;  // Readout acts on MEASURE results only
     }
-    
-    // Renormalize state
-    double norm = state.norm();
-    if (norm > 1e-10) {
-        state = state / norm;
-    }
-    
-    return result;
-}
\ No newline at end of file
+    applyToBuffer(qubits.getState().data(), qubits.getDimension(), kraus);
+}
+
+// Compiled execution runs on both register precisions
+template int GateEngine::measureQubit(QubitManager&, int);
+template int GateEngine::measureQubit(QubitManagerF&, int);
+template int GateEngine::applyOp(QubitManager&, const CompiledOp&);
+template int GateEngine::applyOp(QubitManagerF&, const CompiledOp&);
+template void GateEngine::executePlan(QubitManager&, const CompiledCircuit&, std::vector<int>&, GateProfiler*);
+template void GateEngine::executePlan(QubitManagerF&, const CompiledCircuit&, std::vector<int>&, GateProfiler*);
+template void GateEngine::executeBlocked(QubitManager&, const BlockedCircuit&, std::vector<int>&, GateProfiler*);
+template void GateEngine::executeBlocked(QubitManagerF&, const BlockedCircuit&, std::vector<int>&, GateProfiler*);
+template void GateEngine::applyToBuffer(std::complex<double>*, std::uint64_t, const CompiledOp&);
+template void GateEngine::applyToBuffer(std::complex<float>*, std::uint64_t, const CompiledOp&);
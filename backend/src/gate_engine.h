@@ -1,7 +1,13 @@
 #pragma once
 
 #include "qubit_manager.h"
+#include "simd_kernels.h"
+#include "compiled_circuit.h"
+#include "batched_state.h"
+#include "cache_blocking.h"
+#include "gate_profiler.h"
 #include <complex>
+#include <random>
 #include <stdexcept>
 
 /**
@@ -14,11 +20,40 @@
  * 
  * @note All gate operations modify state in-place
  * @note Qubit indices are 0-based from least significant qubit
+ * @note Measurement outcomes are drawn from a per-engine random engine,
+ *       seeded from std::random_device unless setSeed is called
  */
 class GateEngine {
 public:
+    /// Seeds the measurement random engine from std::random_device
+    GateEngine();
+
+    /**
+     * @brief Reseeds the measurement random engine
+     * @param seed Seed value; equal seeds reproduce measurement sequences
+     */
+    void setSeed(std::uint64_t seed);
+
+    /**
+     * @brief Gets the random engine used for measurements and sampling
+     * @return Reference to the engine's generator
+     */
+    std::mt19937_64& getRandomEngine();
+
     // Single-qubit gates
 
+    /**
+     * @brief Applies an arbitrary 2x2 unitary to one qubit
+     * @param qubits Reference to QubitManager
+     * @param targetQubit Target qubit index (0-based)
+     * @param matrix Row-major gate matrix {m00, m01, m10, m11}
+     * @throws std::out_of_range if qubit index out of valid range
+     * 
+     * Runs the vectorized pair kernel selected at startup (see simd_kernels.h).
+     * All fixed single-qubit gates below are expressed through this call.
+     */
+    void applySingleQubitGate(QubitManager& qubits, int targetQubit, const kernels::Matrix2& matrix);
+
     /**
      * @brief Applies Pauli-X gate (bit flip): X|0⟩ = |1⟩, X|1⟩ = |0⟩
      * @param qubits Reference to QubitManager
@@ -59,6 +94,17 @@ public:
      */
     void applyHadamard(QubitManager& qubits, int targetQubit);
 
+    /**
+     * @brief Applies a rotation gate (RX, RY, RZ, PHASE or U3)
+     * @param qubits Reference to QubitManager
+     * @param opcode Rotation kind
+     * @param targetQubit Target qubit index (0-based)
+     * @param angles Angles in radians: one, or theta, phi, lambda for U3
+     * @throws std::out_of_range if qubit index out of valid range
+     * @throws std::invalid_argument if opcode is not a rotation or the angle count is wrong
+     */
+    void applyRotation(QubitManager& qubits, OpCode opcode, int targetQubit, const std::vector<double>& angles);
+
     /**
      * @brief Measures a qubit and collapses state
      * @param qubits Reference to QubitManager
@@ -67,10 +113,12 @@ public:
      * @throws std::out_of_range if qubit index out of valid range
      * 
      * Collapses superposition by measuring a single qubit.
-     * Returns 0 or 1 based on probability of basis states.
+     * Returns 1 with probability P(1) = sum of |amplitude|^2 over states
+     * with the qubit set, drawn from the engine's random generator.
      * State is modified: amplitudes of unmeasured states are zero'd.
      */
-    int measureQubit(QubitManager& qubits, int targetQubit);
+    template <typename Real>
+    int measureQubit(BasicQubitManager<Real>& qubits, int targetQubit);
 
     // Multi-qubit gates
 
@@ -111,18 +159,143 @@ public:
      */
     void applyToffoli(QubitManager& qubits, int control1, int control2, int targetQubit);
 
+    /**
+     * @brief Applies a 2x2 unitary to targetQubit conditioned on any number of controls
+     * @param qubits Reference to QubitManager
+     * @param matrix Row-major gate matrix applied to the target
+     * @param targetQubit Target qubit index (0-based)
+     * @param controls Qubits that must be |1⟩
+     * @param negativeControls Qubits that must be |0⟩
+     * @throws std::out_of_range if qubit indices out of valid range
+     * @throws std::invalid_argument if any qubits are identical
+     * 
+     * Visits only the 2^(n-k-1) amplitude pairs where all k controls are
+     * satisfied, so adding controls makes the gate cheaper, not slower.
+     */
+    void applyControlledGate(QubitManager& qubits, const kernels::Matrix2& matrix, int targetQubit,
+                             const std::vector<int>& controls, const std::vector<int>& negativeControls = {});
+
+    /**
+     * @brief Applies multi-controlled X (generalized Toffoli)
+     * @param qubits Reference to QubitManager
+     * @param controls Control qubit indices (all must be |1⟩)
+     * @param targetQubit Target qubit index (0-based)
+     * @throws std::out_of_range if qubit indices out of valid range
+     * @throws std::invalid_argument if any qubits are identical
+     */
+    void applyMCX(QubitManager& qubits, const std::vector<int>& controls, int targetQubit);
+
+    /**
+     * @brief Applies controlled-Z: -1 phase when both qubits are |1⟩
+     * @param qubits Reference to QubitManager
+     * @param controlQubit Control qubit index (0-based)
+     * @param targetQubit Target qubit index (0-based)
+     * @throws std::out_of_range if qubit indices out of valid range
+     * @throws std::invalid_argument if control == target
+     */
+    void applyCZ(QubitManager& qubits, int controlQubit, int targetQubit);
+
+    /**
+     * @brief Applies controlled phase: e^{i angle} phase when both qubits are |1⟩
+     * @param qubits Reference to QubitManager
+     * @param controlQubit Control qubit index (0-based)
+     * @param targetQubit Target qubit index (0-based)
+     * @param angle Phase in radians
+     * @throws std::out_of_range if qubit indices out of valid range
+     * @throws std::invalid_argument if control == target
+     */
+    void applyCPhase(QubitManager& qubits, int controlQubit, int targetQubit, double angle);
+
+    // Compiled execution
+    //
+    // These accept QubitManager and QubitManagerF alike (instantiated for
+    // double and float); the named gate methods above are double-only
+    // conveniences over applyOp.
+
+    /**
+     * @brief Applies one pre-validated operation
+     * @param qubits Reference to QubitManager
+     * @param op Operation produced by lowerOp (masks already computed)
+     * @return Measurement result for MEASURE ops (after any readout error), -1 otherwise
+     * 
+     * No validation is performed; op must have been lowered for a register
+     * of qubits.getNumQubits() qubits.
+     */
+    template <typename Real>
+    int applyOp(BasicQubitManager<Real>& qubits, const CompiledOp& op);
+
+    /**
+     * @brief Runs every operation of a compiled plan in order
+     * @param qubits Reference to QubitManager
+     * @param plan Plan from CircuitManager::compile
+     * @param measurements Filled with one result per plan measurement slot
+     * @param profiler If non-null, receives one timed event per op
+     * @throws std::invalid_argument if plan.num_qubits != qubits.getNumQubits()
+     * 
+     * The register width is checked once; ops then dispatch through a
+     * single switch without per-gate validation or string handling.
+     * Without a profiler the loop reads no clock.
+     */
+    template <typename Real>
+    void executePlan(BasicQubitManager<Real>& qubits, const CompiledCircuit& plan, std::vector<int>& measurements,
+                     GateProfiler* profiler = nullptr);
+
+    /**
+     * @brief Runs a cache-blocked plan
+     * @param qubits Reference to QubitManager
+     * @param plan Plan from blockCircuit
+     * @param measurements Filled with one result per plan measurement slot
+     * @param profiler If non-null, receives one timed event per stage
+     * @throws std::invalid_argument if plan.num_qubits != qubits.getNumQubits()
+     *
+     * Each blocked stage applies all of its ops to one block of
+     * 2^plan.block_qubits amplitudes before moving to the next, with blocks
+     * spread over the thread pool; other stages run like executePlan.
+     */
+    template <typename Real>
+    void executeBlocked(BasicQubitManager<Real>& qubits, const BlockedCircuit& plan, std::vector<int>& measurements,
+                        GateProfiler* profiler = nullptr);
+
+    /**
+     * @brief Applies one non-measurement op to a raw amplitude buffer
+     * @param state Amplitude array (double or float components)
+     * @param dimension Number of amplitudes (2^n)
+     * @param op Lowered op (already validated for n qubits)
+     * @throws std::invalid_argument if op is a MEASURE
+     */
+    template <typename Real>
+    static void applyToBuffer(std::complex<Real>* state, std::uint64_t dimension, const CompiledOp& op);
+
+    /**
+     * @brief Runs a compiled plan on every member of a batch at once
+     * @param batch Batched registers (all members are modified)
+     * @param plan Plan compiled for batch.getNumQubits() qubits
+     * @throws std::invalid_argument if the widths differ or the plan contains MEASURE
+     * 
+     * Each op is shifted past the lane qubits and the whole plan is run on
+     * one cache-resident block of lanes at a time, so the kernels vectorize
+     * across members and blocks are distributed over the thread pool.
+     */
+    void executeBatch(BatchedState& batch, const CompiledCircuit& plan);
+
 private:
-    /// Unit imaginary number (0 + 1i)
-    static constexpr std::complex<double> IMAGINARY_UNIT{0.0, 1.0};
-    
-    /// Reciprocal of square root 2 (1/√2 ≈ 0.707)
-    static constexpr double INVERSE_SQRT2 = 0.7071067811865475;
+    /// Source of measurement randomness
+    std::mt19937_64 rng;
 
     /**
-     * @brief Validates qubit index is within valid range
+     * @brief Measures targetQubit, collapses and renormalizes the state
      * @param qubits Reference to QubitManager
-     * @param qubit Qubit index to validate
-     * @throws std::out_of_range if qubit index >= num_qubits or < 0
+     * @param targetQubit Validated target qubit index
+     * @return Measurement result: 0 or 1
+     */
+    template <typename Real>
+    int measure(BasicQubitManager<Real>& qubits, int targetQubit);
+
+    /**
+     * @brief Applies one randomly chosen Kraus branch of a NOISE op
+     * @param qubits Reference to QubitManager (normalized state)
+     * @param op NOISE op carrying its channel
      */
-    void validateQubitIndex(const QubitManager& qubits, int qubit) const;
+    template <typename Real>
+    void applyNoise(BasicQubitManager<Real>& qubits, const CompiledOp& op);
 };
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "gate_fusion.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Qubits an op touches, in ascending order
+std::vector<int> opQubits(const CompiledOp& op) {
+    if (op.opcode == OpCode::Controlled) {
+        std::vector<int> qubits;
+        const std::uint64_t bits = op.control_mask | (std::uint64_t{1} << op.target);
+        for (int q = 0; q < 64; ++q) {
+            if ((bits >> q) & 1) {
+                qubits.push_back(q);
+            }
+        }
+        return qubits;
+    }
+    if (op.num_positions == 0) {
+        return {op.target};
+    }
+    return std::vector<int>(op.positions.begin(), op.positions.begin() + op.num_positions);
+}
+
+std::vector<int> unionQubits(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> merged;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(merged));
+    return merged;
+}
+
+// Index of a register qubit within the (sorted) block qubits
+int localIndex(const std::vector<int>& qubits, int qubit) {
+    return static_cast<int>(std::lower_bound(qubits.begin(), qubits.end(), qubit) - qubits.begin());
+}
+
+std::uint64_t localMask(const std::vector<int>& qubits, std::uint64_t mask) {
+    std::uint64_t local = 0;
+    for (std::size_t b = 0; b < qubits.size(); ++b) {
+        if ((mask >> qubits[b]) & 1) {
+            local |= std::uint64_t{1} << b;
+        }
+    }
+    return local;
+}
+
+// Applies op to one column of the block matrix, treated as a width-qubit state
+void applyToColumn(std::complex<double>* column, int width, const std::vector<int>& qubits,
+                   const CompiledOp& op) {
+    if (op.opcode == OpCode::Controlled) {
+        const std::uint64_t control_mask = localMask(qubits, op.control_mask);
+        kernels::applyControlledMatrix2(column, localIndex(qubits, op.target), op.matrix, control_mask,
+                                        localMask(qubits, op.control_values),
+                                        0, std::uint64_t{1} << (width - 1 - __builtin_popcountll(control_mask)));
+        return;
+    }
+    if (op.num_positions == 0) {
+        kernels::applyMatrix2(column, localIndex(qubits, op.target), op.matrix,
+                              0, std::uint64_t{1} << (width - 1));
+        return;
+    }
+
+    // The block qubits are sorted, so remapped positions stay ascending
+    std::array<int, kernels::MAX_DENSE_QUBITS> positions{};
+    for (int p = 0; p < op.num_positions; ++p) {
+        positions[p] = localIndex(qubits, op.positions[p]);
+    }
+    const std::uint64_t count = std::uint64_t{1} << (width - op.num_positions);
+    if (op.opcode == OpCode::Fused) {
+        kernels::applyDenseMatrix(column, positions.data(), op.num_positions,
+                                  op.dense_matrix.data(), 0, count);
+    } else {
+        kernels::swapMaskedPairs(column, positions.data(), op.num_positions,
+                                 localMask(qubits, op.mask_a), localMask(qubits, op.mask_b), 0, count);
+    }
+}
+
+// Multiplies the block's gates into one op acting on `qubits`
+CompiledOp buildFusedOp(const std::vector<const CompiledOp*>& block, const std::vector<int>& qubits) {
+    const int width = static_cast<int>(qubits.size());
+    const std::size_t dim = std::size_t{1} << width;
+
+    // Column c is the image of basis state c; start from the identity
+    std::vector<std::complex<double>> columns(dim * dim, 0.0);
+    for (std::size_t c = 0; c < dim; ++c) {
+        columns[c * dim + c] = 1.0;
+    }
+    for (const CompiledOp* op : block) {
+        for (std::size_t c = 0; c < dim; ++c) {
+            applyToColumn(&columns[c * dim], width, qubits, *op);
+        }
+    }
+
+    CompiledOp fused;
+    if (width == 1) {
+        fused.opcode = OpCode::Unitary;
+        fused.target = qubits[0];
+        fused.matrix = {columns[0], columns[2], columns[1], columns[3]};
+        return fused;
+    }
+
+    fused.opcode = OpCode::Fused;
+    fused.num_positions = width;
+    std::copy(qubits.begin(), qubits.end(), fused.positions.begin());
+    fused.dense_matrix.resize(dim * dim);
+    for (std::size_t r = 0; r < dim; ++r) {
+        for (std::size_t c = 0; c < dim; ++c) {
+            fused.dense_matrix[r * dim + c] = columns[c * dim + r];
+        }
+    }
+    return fused;
+}
+
+}  // namespace
+
+FusionStats fuseGates(CompiledCircuit& plan, int maxWidth) {
+    if (maxWidth < 1 || maxWidth > MAX_FUSED_WIDTH) {
+        throw std::invalid_argument("Fused width must be between 1 and " +
+                                    std::to_string(MAX_FUSED_WIDTH));
+    }
+
+    FusionStats stats;
+    std::vector<CompiledOp> fused_ops;
+    fused_ops.reserve(plan.ops.size());
+
+    std::vector<const CompiledOp*> block;
+    std::vector<int> block_qubits;
+
+    auto flush = [&]() {
+        if (block.size() == 1) {
+            fused_ops.push_back(*block[0]);
+        } else if (block.size() > 1) {
+            fused_ops.push_back(buildFusedOp(block, block_qubits));
+            ++stats.fused_blocks;
+        }
+        block.clear();
+        block_qubits.clear();
+    };
+
+    for (const CompiledOp& op : plan.ops) {
+        if (op.opcode == OpCode::Measure || op.opcode == OpCode::Noise) {
+            flush();
+            fused_ops.push_back(op);
+            continue;
+        }
+
+        ++stats.sweeps_before;
+        if (op.param_slot >= 0) {
+            // Symbolic gates stay separate so bindParameters can rebuild their matrix
+            flush();
+            fused_ops.push_back(op);
+            continue;
+        }
+
+        std::vector<int> qubits = opQubits(op);
+        std::vector<int> merged = unionQubits(block_qubits, qubits);
+        if (static_cast<int>(merged.size()) > maxWidth) {
+            flush();
+            merged = qubits;
+        }
+        block.push_back(&op);
+        block_qubits = std::move(merged);
+    }
+    flush();
+
+    plan.ops = std::move(fused_ops);
+    for (const CompiledOp& op : plan.ops) {
+        if (op.opcode != OpCode::Measure && op.opcode != OpCode::Noise) {
+            ++stats.sweeps_after;
+        }
+    }
+    return stats;
+}
+
+CompiledOp toDenseOp(const CompiledOp& op) {
+    if (op.opcode == OpCode::Measure || op.opcode == OpCode::Noise) {
+        throw std::invalid_argument(std::string(opCodeName(op.opcode)) + " has no matrix form");
+    }
+    const std::vector<int> qubits = opQubits(op);
+    if (static_cast<int>(qubits.size()) > MAX_FUSED_WIDTH) {
+        throw std::invalid_argument("Gates on more than " + std::to_string(MAX_FUSED_WIDTH) +
+                                    " qubits have no dense form");
+    }
+    CompiledOp dense = buildFusedOp({&op}, qubits);
+    dense.gate_index = op.gate_index;
+    return dense;
+}
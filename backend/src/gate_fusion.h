@@ -0,0 +1,67 @@
+#pragma once
+
+#include "compiled_circuit.h"
+
+/**
+ * @file gate_fusion.h
+ * @brief Optimization pass merging runs of gates into dense unitaries
+ *
+ * Every gate costs one full sweep over the state vector, which for large
+ * registers is bound by memory bandwidth rather than arithmetic. The fusion
+ * pass walks a compiled plan and multiplies consecutive gates whose combined
+ * qubit set stays within a width limit into a single 2x2, 4x4 or 8x8 matrix,
+ * so e.g. H-Z-H-X on one qubit runs as one sweep instead of four.
+ *
+ * Measurements and noise ops are barriers: gates are never moved across
+ * them. Gates with symbolic parameters are barriers too and are kept
+ * unfused, so rebinding parameters only has to rebuild their own matrices.
+ */
+
+/// Widest block fuseGates may build (matches kernels::MAX_DENSE_QUBITS)
+constexpr int MAX_FUSED_WIDTH = kernels::MAX_DENSE_QUBITS;
+
+/// Width used by CircuitManager unless configured otherwise
+constexpr int DEFAULT_FUSED_WIDTH = 2;
+
+/**
+ * @struct FusionStats
+ * @brief Sweep counts before and after a fusion pass
+ */
+struct FusionStats {
+    /// State-vector sweeps (ops other than MEASURE and NOISE) before fusion
+    int sweeps_before = 0;
+
+    /// Sweeps after fusion
+    int sweeps_after = 0;
+
+    /// Number of fused blocks that replaced two or more gates
+    int fused_blocks = 0;
+
+    /// Sweeps eliminated by the pass
+    int sweepsSaved() const { return sweeps_before - sweeps_after; }
+};
+
+/**
+ * @brief Fuses runs of adjacent gates in place
+ * @param plan Compiled plan to rewrite
+ * @param maxWidth Largest qubit set a fused block may act on, in [1, MAX_FUSED_WIDTH]
+ * @return Sweep counts before and after
+ * @throws std::invalid_argument if maxWidth is out of range
+ *
+ * Gates are grouped greedily in program order while the union of their
+ * qubits fits in maxWidth. A group of one gate is kept as is (so CNOT and
+ * SWAP keep their permutation kernels); larger groups become a Unitary
+ * (width 1) or Fused (width 2-3) op. Fused ops have gate_index -1.
+ */
+FusionStats fuseGates(CompiledCircuit& plan, int maxWidth);
+
+/**
+ * @brief Converts one gate to a dense matrix on the qubits it touches
+ * @param op Any op except MEASURE and NOISE, acting on at most MAX_FUSED_WIDTH qubits
+ * @return Unitary op (one qubit) or Fused op with ascending positions
+ * @throws std::invalid_argument if op is MEASURE / NOISE or touches too many qubits
+ *
+ * Backends that only have a generic k-qubit kernel (e.g. MPSState) use this
+ * instead of the specialised permutation and controlled kernels.
+ */
+CompiledOp toDenseOp(const CompiledOp& op);
@@ -0,0 +1,212 @@
+#include "gate_profiler.h"
+#include <algorithm>
+#include <complex>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+/// Entries in GateProfiler::totals: one per OpCode, then blocked stages
+constexpr std::size_t OPCODE_COUNT = static_cast<std::size_t>(OpCode::Noise) + 1;
+constexpr std::size_t BLOCKED_STAGE_INDEX = OPCODE_COUNT;
+
+/// 2x2 kernel names by kernels::SimdLevel
+constexpr const char* MATRIX2_KERNELS[3] = {"matrix2/scalar", "matrix2/avx2", "matrix2/avx512"};
+
+/// Dense kernel names by width (1-3) and kernels::SimdLevel
+constexpr const char* DENSE_KERNELS[3][3] = {
+    {"dense1/scalar", "dense1/avx2", "dense1/avx512"},
+    {"dense2/scalar", "dense2/avx2", "dense2/avx512"},
+    {"dense3/scalar", "dense3/avx2", "dense3/avx512"},
+};
+
+// Qubits an op acts on: its sorted positions, or its target and controls
+void appendQubits(const CompiledOp& op, std::vector<int>& qubits) {
+    if (op.num_positions > 0) {
+        qubits.insert(qubits.end(), op.positions.begin(), op.positions.begin() + op.num_positions);
+        return;
+    }
+    for (std::uint64_t mask = op.control_mask; mask != 0; mask &= mask - 1) {
+        qubits.push_back(__builtin_ctzll(mask));
+    }
+    qubits.push_back(op.target);
+}
+
+// Trace timestamps are microseconds
+void writeMicroseconds(std::ostream& out, double seconds) {
+    out << std::fixed << std::setprecision(3) << seconds * 1e6 << std::defaultfloat;
+}
+
+}  // namespace
+
+std::uint64_t opBytesTouched(const CompiledOp& op, std::uint64_t dimension, std::size_t amplitudeBytes) {
+    std::uint64_t amplitudes = dimension;
+    switch (op.opcode) {
+        case OpCode::CNOT:
+        case OpCode::SWAP:
+        case OpCode::Toffoli:
+            // Two amplitudes per enumerated index
+            amplitudes = 2 * (dimension >> op.num_positions);
+            break;
+        case OpCode::Controlled:
+            amplitudes = dimension >> __builtin_popcountll(op.control_mask);
+            break;
+        case OpCode::Measure:
+            // Probability pass reads half the register; collapse reads and writes all of it
+            return (dimension / 2 + 2 * dimension) * amplitudeBytes;
+        default:
+            break;
+    }
+    return 2 * amplitudes * amplitudeBytes;
+}
+
+// SIMD kernels report the level they dispatch to; permutations and
+// controlled ops have a single implementation
+const char* kernelVariant(const CompiledOp& op, std::size_t amplitudeBytes) {
+    const bool single = amplitudeBytes == sizeof(std::complex<float>);
+    switch (op.opcode) {
+        case OpCode::PauliX:
+        case OpCode::PauliY:
+        case OpCode::PauliZ:
+        case OpCode::Hadamard:
+        case OpCode::Unitary:
+        case OpCode::Phase:
+        case OpCode::RX:
+        case OpCode::RY:
+        case OpCode::RZ:
+        case OpCode::U3:
+            return MATRIX2_KERNELS[static_cast<int>(kernels::matrix2Level(single))];
+        case OpCode::Fused: {
+            const int width = std::clamp(op.num_positions, 1, kernels::MAX_DENSE_QUBITS);
+            return DENSE_KERNELS[width - 1][static_cast<int>(kernels::denseMatrixLevel(single, width))];
+        }
+        case OpCode::CNOT:
+        case OpCode::SWAP:
+        case OpCode::Toffoli:
+            return "permute";
+        case OpCode::Controlled:
+            return "controlled";
+        case OpCode::Measure:
+            return "measure";
+        case OpCode::Noise:
+            return "noise";
+    }
+    return "?";
+}
+
+GateProfiler::GateProfiler() : epoch(Clock::now()), totals(OPCODE_COUNT + 1) {
+    for (std::size_t k = 0; k < OPCODE_COUNT; ++k) {
+        totals[k].name = opCodeName(static_cast<OpCode>(k));
+    }
+    totals[BLOCKED_STAGE_INDEX].name = BLOCKED_STAGE_NAME;
+}
+
+void GateProfiler::recordOp(const CompiledOp& op, std::uint64_t dimension, std::size_t amplitudeBytes,
+                            Clock::time_point start) {
+    const Clock::time_point end = Clock::now();
+    ProfileEvent event;
+    event.name = opCodeName(op.opcode);
+    event.kernel = kernelVariant(op, amplitudeBytes);
+    event.gate_index = op.gate_index;
+    appendQubits(op, event.qubits);
+    event.start_seconds = std::chrono::duration<double>(start - epoch).count();
+    event.seconds = std::chrono::duration<double>(end - start).count();
+    event.bytes = opBytesTouched(op, dimension, amplitudeBytes);
+    append(std::move(event), static_cast<std::size_t>(op.opcode));
+}
+
+void GateProfiler::recordStage(const SweepStage& stage, std::uint64_t dimension, std::size_t amplitudeBytes,
+                               Clock::time_point start) {
+    const Clock::time_point end = Clock::now();
+    ProfileEvent event;
+    event.name = BLOCKED_STAGE_NAME;
+    event.kernel = "blocked";
+    for (const BlockedOp& entry : stage.ops) {
+        appendQubits(entry.op, event.qubits);
+    }
+    std::sort(event.qubits.begin(), event.qubits.end());
+    event.qubits.erase(std::unique(event.qubits.begin(), event.qubits.end()), event.qubits.end());
+    event.start_seconds = std::chrono::duration<double>(start - epoch).count();
+    event.seconds = std::chrono::duration<double>(end - start).count();
+    event.bytes = 2 * dimension * amplitudeBytes;
+    append(std::move(event), BLOCKED_STAGE_INDEX);
+}
+
+void GateProfiler::append(ProfileEvent event, std::size_t typeIndex) {
+    GateTypeProfile& total = totals[typeIndex];
+    ++total.count;
+    total.seconds += event.seconds;
+    total.bytes += event.bytes;
+    events.push_back(std::move(event));
+}
+
+void GateProfiler::clear() {
+    events.clear();
+    for (GateTypeProfile& total : totals) {
+        total.count = 0;
+        total.seconds = 0.0;
+        total.bytes = 0;
+    }
+    epoch = Clock::now();
+}
+
+std::vector<GateTypeProfile> GateProfiler::summary() const {
+    std::vector<GateTypeProfile> result;
+    std::copy_if(totals.begin(), totals.end(), std::back_inserter(result),
+                 [](const GateTypeProfile& total) { return total.count > 0; });
+    std::stable_sort(result.begin(), result.end(),
+                     [](const GateTypeProfile& a, const GateTypeProfile& b) { return a.seconds > b.seconds; });
+    return result;
+}
+
+double GateProfiler::totalSeconds() const {
+    double seconds = 0.0;
+    for (const GateTypeProfile& total : totals) {
+        seconds += total.seconds;
+    }
+    return seconds;
+}
+
+void GateProfiler::printSummary(std::ostream& out) const {
+    const double all = totalSeconds();
+    out << std::left << std::setw(12) << "Gate" << std::right << std::setw(10) << "Count" << std::setw(12)
+        << "Time (ms)" << std::setw(8) << "Share" << std::setw(10) << "GB/s" << "\n";
+    for (const GateTypeProfile& total : summary()) {
+        out << std::left << std::setw(12) << total.name << std::right << std::setw(10) << total.count
+            << std::fixed << std::setprecision(3) << std::setw(12) << total.seconds * 1e3 << std::setprecision(1)
+            << std::setw(7) << (all > 0.0 ? 100.0 * total.seconds / all : 0.0) << "%" << std::setprecision(2)
+            << std::setw(10) << (total.seconds > 0.0 ? total.bytes / total.seconds / 1e9 : 0.0)
+            << std::defaultfloat << "\n";
+    }
+}
+
+void GateProfiler::writeChromeTrace(std::ostream& out) const {
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const ProfileEvent& event = events[i];
+        out << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"" << event.name
+            << "\", \"cat\": \"gate\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": ";
+        writeMicroseconds(out, event.start_seconds);
+        out << ", \"dur\": ";
+        writeMicroseconds(out, event.seconds);
+        out << ", \"args\": {\"gate\": " << event.gate_index << ", \"qubits\": [";
+        for (std::size_t q = 0; q < event.qubits.size(); ++q) {
+            out << (q == 0 ? "" : ", ") << event.qubits[q];
+        }
+        out << "], \"bytes\": " << event.bytes << ", \"kernel\": \"" << event.kernel << "\"}}";
+    }
+    out << "\n]}\n";
+}
+
+void GateProfiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    writeChromeTrace(file);
+    if (!file.flush()) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
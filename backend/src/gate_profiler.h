@@ -0,0 +1,190 @@
+#pragma once
+
+#include "compiled_circuit.h"
+#include "cache_blocking.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file gate_profiler.h
+ * @brief Per-op timing of compiled plans, with Chrome trace export
+ *
+ * GateEngine::executePlan and executeBlocked take an optional GateProfiler.
+ * With one, every op (or blocked sweep stage) is timed on its own. For each
+ * one the profiler records wall time, the bytes the kernel has to move and
+ * the kernel variant that ran. Totals per gate type are kept as the events
+ * arrive. Without a profiler the plan loops are the plain ones, so
+ * profiling costs nothing while it is off.
+ *
+ * writeChromeTrace emits the Trace Event Format read by chrome://tracing
+ * and https://ui.perfetto.dev: one complete ("X") event per op, with the
+ * gate index, qubits, bytes and kernel as arguments.
+ */
+
+/// Name used for blocked sweep stages, which are timed as one unit
+constexpr const char* BLOCKED_STAGE_NAME = "BLOCK";
+
+/**
+ * @struct ProfileEvent
+ * @brief One timed op
+ */
+struct ProfileEvent {
+    /// Gate type: opCodeName of the op, or BLOCKED_STAGE_NAME
+    const char* name = "";
+
+    /// Kernel variant, e.g. "matrix2/avx512", "dense3/avx2", "permute"
+    const char* kernel = "";
+
+    /// Index of the originating GateOperation (-1 if none, e.g. fused or blocked)
+    int gate_index = -1;
+
+    /// Qubits the op acts on (ops in a blocked stage)
+    std::vector<int> qubits;
+
+    /// Start, in seconds since the profiler was created or cleared
+    double start_seconds = 0.0;
+
+    /// Wall time of the op
+    double seconds = 0.0;
+
+    /// Bytes the kernel reads and writes (each changed amplitude read and written once)
+    std::uint64_t bytes = 0;
+};
+
+/**
+ * @struct GateTypeProfile
+ * @brief Totals for one gate type
+ */
+struct GateTypeProfile {
+    /// Gate type, as in ProfileEvent::name
+    std::string name;
+
+    /// Ops of this type executed
+    std::uint64_t count = 0;
+
+    /// Total wall time
+    double seconds = 0.0;
+
+    /// Total bytes moved
+    std::uint64_t bytes = 0;
+};
+
+/**
+ * @brief Estimates the bytes a kernel reads and writes for one op
+ * @param op Lowered op
+ * @param dimension Amplitudes in the buffer it runs on (2^n)
+ * @param amplitudeBytes Bytes per amplitude (16 for double, 8 for float)
+ * @return Two bytes-per-amplitude passes for every amplitude the op changes
+ *
+ * Permutations and controlled ops count only the amplitudes they touch;
+ * MEASURE counts its probability pass over half the register plus the
+ * collapse pass over all of it.
+ */
+std::uint64_t opBytesTouched(const CompiledOp& op, std::uint64_t dimension, std::size_t amplitudeBytes);
+
+/**
+ * @brief Names the kernel an op dispatches to at the current SIMD level
+ * @param op Lowered op
+ * @param amplitudeBytes Bytes per amplitude (16 for double, 8 for float)
+ * @return Static string: family ("matrix2", "dense3", "permute", ...) and,
+ *         for SIMD-dispatched kernels, "/" and the instruction set
+ *
+ * The instruction set is the one kernels::matrix2Level or
+ * kernels::denseMatrixLevel reports, which is what the dispatcher runs.
+ */
+const char* kernelVariant(const CompiledOp& op, std::size_t amplitudeBytes);
+
+/**
+ * @class GateProfiler
+ * @brief Collects ProfileEvents and per-type totals
+ *
+ * Events accumulate over every profiled run until clear(). Per-type totals
+ * are updated in place, so summary() does not rescan the events.
+ */
+class GateProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Starts the trace clock
+    GateProfiler();
+
+    /**
+     * @brief Records one op that ran on the whole register
+     * @param op Op that was applied
+     * @param dimension Register dimension (2^n)
+     * @param amplitudeBytes Bytes per amplitude
+     * @param start Clock reading taken just before the op
+     */
+    void recordOp(const CompiledOp& op, std::uint64_t dimension, std::size_t amplitudeBytes, Clock::time_point start);
+
+    /**
+     * @brief Records one blocked sweep stage
+     * @param stage Stage that was applied block by block
+     * @param dimension Register dimension (2^n)
+     * @param amplitudeBytes Bytes per amplitude
+     * @param start Clock reading taken just before the stage
+     *
+     * The stage streams the register once, so it counts one read and one
+     * write of every amplitude, however many ops it holds.
+     */
+    void recordStage(const SweepStage& stage, std::uint64_t dimension, std::size_t amplitudeBytes,
+                     Clock::time_point start);
+
+    /**
+     * @brief Drops all events and totals and restarts the trace clock
+     */
+    void clear();
+
+    /**
+     * @brief Gets the recorded events in execution order
+     * @return Events since construction or the last clear()
+     */
+    const std::vector<ProfileEvent>& getEvents() const { return events; }
+
+    /**
+     * @brief Gets the totals per gate type
+     * @return One entry per type seen, slowest total first
+     */
+    std::vector<GateTypeProfile> summary() const;
+
+    /**
+     * @brief Gets the wall time of all recorded events
+     * @return Sum of ProfileEvent::seconds
+     */
+    double totalSeconds() const;
+
+    /**
+     * @brief Prints the per-type totals as a table
+     * @param out Destination stream
+     */
+    void printSummary(std::ostream& out) const;
+
+    /**
+     * @brief Writes the events in Chrome Trace Event Format
+     * @param out Destination stream
+     */
+    void writeChromeTrace(std::ostream& out) const;
+
+    /**
+     * @brief Writes the events in Chrome Trace Event Format to a file
+     * @param path Destination, replaced if it exists
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writeChromeTrace(const std::string& path) const;
+
+private:
+    /// Time origin of ProfileEvent::start_seconds
+    Clock::time_point epoch;
+
+    /// Recorded ops in execution order
+    std::vector<ProfileEvent> events;
+
+    /// Totals indexed by OpCode, with blocked stages in the last entry
+    std::vector<GateTypeProfile> totals;
+
+    /// Appends an event and adds it to totals[typeIndex]
+    void append(ProfileEvent event, std::size_t typeIndex);
+};
@@ -0,0 +1,94 @@
+#include "hybrid_state.h"
+#include <stdexcept>
+
+HybridState::HybridState(int numQubits, double promotionThreshold)
+    : num_qubits(numQubits), promotion_threshold(promotionThreshold), sparse(numQubits) {
+    if (!(promotionThreshold > 0.0 && promotionThreshold <= 1.0)) {
+        throw std::invalid_argument("Promotion threshold must be in (0, 1]");
+    }
+}
+
+void HybridState::initializeZeroState() {
+    dense.reset();
+    sparse.initializeZeroState();
+}
+
+void HybridState::setInitialState(const std::string& stateString) {
+    sparse.setInitialState(stateString);
+    dense.reset();
+}
+
+std::uint64_t HybridState::storedAmplitudes() const {
+    return dense ? dense->getDimension() : sparse.size();
+}
+
+std::complex<double> HybridState::amplitude(std::uint64_t index) const {
+    return dense ? dense->getState()(index) : sparse.amplitude(index);
+}
+
+void HybridState::promote() {
+    if (dense) {
+        return;
+    }
+    if (num_qubits > QubitManager::MAX_QUBITS) {
+        throw std::invalid_argument("A " + std::to_string(num_qubits) + "-qubit register cannot be stored densely");
+    }
+    QubitManager promoted(num_qubits);
+    sparse.toDense(promoted.getState().data());
+    dense.emplace(std::move(promoted));
+    sparse = SparseState(num_qubits);  // Release the map
+}
+
+void HybridState::promoteIfFull() {
+    if (dense || num_qubits > QubitManager::MAX_QUBITS) {
+        return;
+    }
+    const double occupancy = static_cast<double>(sparse.size()) / static_cast<double>(std::uint64_t{1} << num_qubits);
+    if (occupancy <= promotion_threshold) {
+        return;
+    }
+    try {
+        promote();
+    } catch (const std::runtime_error&) {
+        // Not enough memory for the dense vector: keep going sparse
+    }
+}
+
+const QubitManager& HybridState::getDense() const {
+    if (!dense) {
+        throw std::logic_error("State has not been promoted to dense");
+    }
+    return *dense;
+}
+
+const SparseState& HybridState::getSparse() const {
+    if (dense) {
+        throw std::logic_error("State has been promoted to dense");
+    }
+    return sparse;
+}
+
+int HybridState::apply(const CompiledOp& op, GateEngine& engine) {
+    if (op.opcode == OpCode::Noise) {
+        promote();
+    }
+    if (dense) {
+        return engine.applyOp(*dense, op);
+    }
+    if (op.opcode != OpCode::Measure) {
+        sparse.applyOp(op);
+        promoteIfFull();
+        return -1;
+    }
+
+    std::mt19937_64& rng = engine.getRandomEngine();
+    int result = sparse.measure(op.target, rng);
+    if (op.channel.kind == NoiseKind::Readout) {
+        // The state collapses to the true outcome; only the reported bit flips
+        double flip = result ? op.channel.probability_one : op.channel.probability;
+        if (std::uniform_real_distribution<double>(0.0, 1.0)(rng) < flip) {
+            result ^= 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "qubit_manager.h"
+#include "sparse_state.h"
+#include "gate_engine.h"
+#include <complex>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+/**
+ * @class HybridState
+ * @brief Register that starts sparse and switches to a dense vector when it fills up
+ *
+ * Ops run on a SparseState until the number of stored amplitudes exceeds
+ * promotionThreshold * 2^n; the state is then copied into a QubitManager
+ * once and every later op uses the dense kernels. Registers wider than
+ * QubitManager::MAX_QUBITS (or too large for available memory) stay
+ * sparse. NOISE ops need the dense trajectory kernels and force promotion.
+ */
+class HybridState {
+public:
+    /// Default occupancy at which the sparse map costs more than a dense sweep
+    static constexpr double DEFAULT_PROMOTION_THRESHOLD = 1.0 / 16;
+
+    /**
+     * @brief Creates |0...0⟩ in sparse form
+     * @param numQubits Register width (1-SparseState::MAX_QUBITS)
+     * @param promotionThreshold Fraction of 2^n stored amplitudes that triggers promotion, in (0, 1]
+     * @throws std::invalid_argument if an argument is out of range
+     */
+    explicit HybridState(int numQubits, double promotionThreshold = DEFAULT_PROMOTION_THRESHOLD);
+
+    /// Resets to a sparse |0...0⟩
+    void initializeZeroState();
+
+    /**
+     * @brief Sets a computational basis state (sparse)
+     * @param stateString Binary label, highest qubit first (e.g., "0101")
+     * @throws std::invalid_argument if the label is malformed
+     */
+    void setInitialState(const std::string& stateString);
+
+    /**
+     * @brief Gets the register width
+     * @return Number of qubits
+     */
+    int getNumQubits() const { return num_qubits; }
+
+    /**
+     * @brief Checks which representation is active
+     * @return True once the state has been promoted
+     */
+    bool isDense() const { return dense.has_value(); }
+
+    /**
+     * @brief Gets the number of stored amplitudes
+     * @return Sparse entry count, or 2^n when dense
+     */
+    std::uint64_t storedAmplitudes() const;
+
+    /**
+     * @brief Gets one amplitude
+     * @param index Basis state index in [0, 2^n)
+     * @return Amplitude
+     */
+    std::complex<double> amplitude(std::uint64_t index) const;
+
+    /**
+     * @brief Switches to the dense representation now
+     * @throws std::invalid_argument if the register is wider than QubitManager::MAX_QUBITS
+     * @throws std::runtime_error if the dense vector does not fit in memory
+     */
+    void promote();
+
+    /**
+     * @brief Gets the dense register
+     * @return Promoted state
+     * @throws std::logic_error if the state is still sparse
+     */
+    const QubitManager& getDense() const;
+
+    /**
+     * @brief Gets the sparse state
+     * @return Sparse state
+     * @throws std::logic_error if the state has been promoted
+     */
+    const SparseState& getSparse() const;
+
+    /**
+     * @brief Applies one compiled op, promoting afterwards if the threshold is crossed
+     * @param op Compiled op (gates, MEASURE with readout error, NOISE)
+     * @param engine Engine providing dense kernels and the random engine
+     * @return Reported measurement result for MEASURE, -1 otherwise
+     */
+    int apply(const CompiledOp& op, GateEngine& engine);
+
+private:
+    /// Register width n
+    int num_qubits;
+
+    /// Occupancy (fraction of 2^n) that triggers promotion
+    double promotion_threshold;
+
+    /// Active representation until promotion
+    SparseState sparse;
+
+    /// Active representation after promotion
+    std::optional<QubitManager> dense;
+
+    /// Promotes if the sparse state has grown past the threshold and fits
+    void promoteIfFull();
+};
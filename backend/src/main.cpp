@@ -1,10 +1,82 @@
+#include <algorithm>
 #include <iostream>
 #include "qubit_manager.h"
 #include "gate_engine.h"
 #include "circuit_manager.h"
+#include "qasm_parser.h"
+#include "circuit_file.h"
+#include <cstring>
 
-int main() {
+// Prints the per-gate-type profile and writes the trace, if profiling was requested
+static void reportProfile(const CircuitManager& circuit, const std::string& tracePath) {
+    if (tracePath.empty()) {
+        return;
+    }
+    std::cout << "\nGate Profile:\n";
+    circuit.getProfile().printSummary(std::cout);
+    circuit.getProfile().writeChromeTrace(tracePath);
+    std::cout << "Trace written to " << tracePath << "\n";
+}
+
+// Runs an OpenQASM 2.0 file and prints the final state and classical bits
+static int runQasmFile(const std::string& path, const std::string& tracePath) {
+    CircuitManager circuit;
+    QasmProgram program = parseQasmFile(path, circuit);
+    QubitManager qubits(program.num_qubits);
+    std::cout << "Executing " << program.gates_emitted << " gates on " << program.num_qubits << " qubits...\n";
+    circuit.setProfiling(!tracePath.empty());
+    circuit.executeCircuit(qubits);
+
+    std::cout << "\nFinal Quantum State:\n";
+    qubits.printState();
+    if (program.num_clbits > 0) {
+        // Highest classical bit first, like the basis-state labels
+        std::vector<int> bits = classicalBits(program, circuit);
+        std::cout << "\nClassical bits: ";
+        for (auto it = bits.rbegin(); it != bits.rend(); ++it) {
+            std::cout << (*it < 0 ? '-' : static_cast<char>('0' + *it));
+        }
+        std::cout << "\n";
+    }
+    reportProfile(circuit, tracePath);
+    return 0;
+}
+
+// Runs a binary circuit file and prints the final state
+static int runCircuitFile(const std::string& path, const std::string& tracePath) {
+    CircuitManager circuit;
+    CircuitFileInfo info = circuit.loadCircuit(path);
+    QubitManager qubits(std::max(info.num_qubits, 1));
+    std::cout << "Executing " << info.gate_count << " gates on " << qubits.getNumQubits() << " qubits...\n";
+    circuit.setProfiling(!tracePath.empty());
+    circuit.executeCircuit(qubits);
+
+    std::cout << "\nFinal Quantum State:\n";
+    qubits.printState();
+    reportProfile(circuit, tracePath);
+    return 0;
+}
+
+// Runs a QASM or binary circuit file, chosen by its magic bytes
+static int runFile(const std::string& path, const std::string& tracePath) {
+    return isCircuitFile(path) ? runCircuitFile(path, tracePath) : runQasmFile(path, tracePath);
+}
+
+int main(int argc, char** argv) {
     try {
+        if (argc == 4 && std::strcmp(argv[1], "--convert") == 0) {
+            CircuitFileInfo info = convertQasmToCircuitFile(argv[2], argv[3]);
+            std::cout << "Wrote " << info.gate_count << " gates on " << info.num_qubits << " qubits ("
+                      << info.file_bytes << " bytes) to " << argv[3] << "\n";
+            return 0;
+        }
+        if (argc == 4 && std::strcmp(argv[1], "--profile") == 0) {
+            return runFile(argv[3], argv[2]);
+        }
+        if (argc > 1) {
+            return runFile(argv[1], "");
+        }
+
         QubitManager qubits(5);
         CircuitManager circuit;
         
@@ -0,0 +1,273 @@
+#include "mps_state.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Bits of a basis label, qubit 0 first; same checks as parseBasisState
+std::vector<int> parseLabel(const std::string& stateString, int numQubits) {
+    if (static_cast<int>(stateString.length()) != numQubits) {
+        throw std::invalid_argument("Initial state length (" + std::to_string(stateString.length()) +
+                                    ") must match qubit count (" + std::to_string(numQubits) + ")");
+    }
+    std::vector<int> bits(numQubits);
+    for (int q = 0; q < numQubits; ++q) {
+        const char c = stateString[numQubits - 1 - q];
+        if (c != '0' && c != '1') {
+            throw std::invalid_argument("Failed to parse initial state: invalid character '" +
+                                        std::string(1, c) + "'");
+        }
+        bits[q] = c - '0';
+    }
+    return bits;
+}
+
+}  // namespace
+
+MPSState::MPSState(int numQubits, int maxBondDimension, double truncationThreshold)
+    : num_qubits(numQubits), max_bond_dimension(maxBondDimension), truncation_threshold(truncationThreshold) {
+    if (numQubits < 1) {
+        throw std::invalid_argument("Number of qubits must be at least 1");
+    }
+    if (maxBondDimension < 1) {
+        throw std::invalid_argument("Maximum bond dimension must be at least 1");
+    }
+    if (!(truncationThreshold >= 0.0 && truncationThreshold < 1.0)) {
+        throw std::invalid_argument("Truncation threshold must be in [0, 1)");
+    }
+    initializeZeroState();
+}
+
+void MPSState::initializeZeroState() {
+    setInitialState(std::string(num_qubits, '0'));
+}
+
+void MPSState::setInitialState(const std::string& stateString) {
+    const std::vector<int> bits = parseLabel(stateString, num_qubits);
+    sites.assign(num_qubits, Site{Eigen::MatrixXcd::Zero(1, 1), Eigen::MatrixXcd::Zero(1, 1)});
+    for (int q = 0; q < num_qubits; ++q) {
+        sites[q][bits[q]](0, 0) = 1.0;
+    }
+    center = 0;
+    truncation_error = 0.0;
+    swap_count = 0;
+}
+
+int MPSState::getBondDimension(int bond) const {
+    if (bond < 0 || bond >= num_qubits - 1) {
+        throw std::out_of_range("Bond index out of range: " + std::to_string(bond));
+    }
+    return static_cast<int>(sites[bond][0].cols());
+}
+
+int MPSState::getMaxBondDimension() const {
+    int largest = 1;
+    for (const Site& site : sites) {
+        largest = std::max(largest, static_cast<int>(site[0].cols()));
+    }
+    return largest;
+}
+
+std::uint64_t MPSState::storedAmplitudes() const {
+    std::uint64_t total = 0;
+    for (const Site& site : sites) {
+        total += 2 * static_cast<std::uint64_t>(site[0].size());
+    }
+    return total;
+}
+
+std::complex<double> MPSState::amplitude(std::uint64_t index) const {
+    if (num_qubits > 64) {
+        throw std::invalid_argument("Use the label overload for registers wider than 64 qubits");
+    }
+    Eigen::RowVectorXcd row = sites[0][index & 1].row(0);
+    for (int q = 1; q < num_qubits; ++q) {
+        row = row * sites[q][(index >> q) & 1];
+    }
+    return row(0);
+}
+
+std::complex<double> MPSState::amplitude(const std::string& stateString) const {
+    const std::vector<int> bits = parseLabel(stateString, num_qubits);
+    Eigen::RowVectorXcd row = sites[0][bits[0]].row(0);
+    for (int q = 1; q < num_qubits; ++q) {
+        row = row * sites[q][bits[q]];
+    }
+    return row(0);
+}
+
+// Left of the center: reshape to (2 χl) × χr and keep Q; right: the mirror image
+void MPSState::moveCenter(int site) {
+    while (center < site) {
+        Site& current = sites[center];
+        const Eigen::Index left = current[0].rows(), right = current[0].cols();
+        Eigen::MatrixXcd stacked(2 * left, right);
+        stacked << current[0], current[1];
+        Eigen::HouseholderQR<Eigen::MatrixXcd> qr(stacked);
+        const Eigen::Index k = std::min(2 * left, right);
+        const Eigen::MatrixXcd q = qr.householderQ() * Eigen::MatrixXcd::Identity(2 * left, k);
+        const Eigen::MatrixXcd r = qr.matrixQR().topRows(k).triangularView<Eigen::Upper>();
+        current[0] = q.topRows(left);
+        current[1] = q.bottomRows(left);
+        Site& next = sites[center + 1];
+        next[0] = r * next[0];
+        next[1] = r * next[1];
+        ++center;
+    }
+    while (center > site) {
+        Site& current = sites[center];
+        const Eigen::Index left = current[0].rows(), right = current[0].cols();
+        Eigen::MatrixXcd stacked(right * 2, left);
+        stacked << current[0].adjoint(), current[1].adjoint();
+        Eigen::HouseholderQR<Eigen::MatrixXcd> qr(stacked);
+        const Eigen::Index k = std::min(2 * right, left);
+        const Eigen::MatrixXcd q = qr.householderQ() * Eigen::MatrixXcd::Identity(2 * right, k);
+        const Eigen::MatrixXcd r = qr.matrixQR().topRows(k).triangularView<Eigen::Upper>();
+        current[0] = q.topRows(right).adjoint();
+        current[1] = q.bottomRows(right).adjoint();
+        Site& previous = sites[center - 1];
+        previous[0] = previous[0] * r.adjoint();
+        previous[1] = previous[1] * r.adjoint();
+        --center;
+    }
+}
+
+void MPSState::applyGate(const std::vector<int>& qubits, const std::vector<std::complex<double>>& matrix) {
+    const int width = static_cast<int>(qubits.size());
+    if (width < 1 || width > MAX_GATE_QUBITS) {
+        throw std::invalid_argument("MPS gates must act on 1 to " + std::to_string(MAX_GATE_QUBITS) + " qubits");
+    }
+    const std::size_t dim = std::size_t{1} << width;
+    if (matrix.size() != dim * dim) {
+        throw std::invalid_argument("Gate matrix must be " + std::to_string(dim) + "x" + std::to_string(dim));
+    }
+    for (int b = 0; b < width; ++b) {
+        if (qubits[b] < 0 || qubits[b] >= num_qubits) {
+            throw std::out_of_range("Qubit index out of range: " + std::to_string(qubits[b]));
+        }
+        if (b > 0 && qubits[b] <= qubits[b - 1]) {
+            throw std::invalid_argument("Gate qubits must be distinct and ascending");
+        }
+    }
+
+    if (width == 1) {
+        // A one-site unitary keeps the canonical form, so no SVD is needed
+        Site& site = sites[qubits[0]];
+        const Eigen::MatrixXcd zero = site[0], one = site[1];
+        site[0] = matrix[0] * zero + matrix[1] * one;
+        site[1] = matrix[2] * zero + matrix[3] * one;
+        return;
+    }
+
+    // Bring qubits[b] next to qubits[0]; the qubits in between shift right
+    const int first = qubits[0];
+    std::vector<int> swaps;
+    for (int b = 1; b < width; ++b) {
+        for (int site = qubits[b] - 1; site >= first + b; --site) {
+            swapSites(site);
+            swaps.push_back(site);
+        }
+    }
+    applyAdjacent(first, width, matrix);
+    for (auto it = swaps.rbegin(); it != swaps.rend(); ++it) {
+        swapSites(*it);
+    }
+}
+
+void MPSState::swapSites(int site) {
+    static const std::vector<std::complex<double>> swap_matrix = {
+        1.0, 0.0, 0.0, 0.0,
+        0.0, 0.0, 1.0, 0.0,
+        0.0, 1.0, 0.0, 0.0,
+        0.0, 0.0, 0.0, 1.0};
+    applyAdjacent(site, 2, swap_matrix);
+    ++swap_count;
+}
+
+void MPSState::applyAdjacent(int first, int width, const std::vector<std::complex<double>>& matrix) {
+    moveCenter(first);
+    const std::size_t dim = std::size_t{1} << width;
+
+    // theta[c] = A_first[c_0] · ... · A_last[c_{k-1}]; the product holds all the norm
+    std::vector<Eigen::MatrixXcd> theta(dim);
+    for (std::size_t c = 0; c < dim; ++c) {
+        theta[c] = sites[first][c & 1];
+        for (int b = 1; b < width; ++b) {
+            theta[c] = theta[c] * sites[first + b][(c >> b) & 1];
+        }
+    }
+    std::vector<Eigen::MatrixXcd> rotated(dim);
+    for (std::size_t row = 0; row < dim; ++row) {
+        rotated[row] = Eigen::MatrixXcd::Zero(theta[0].rows(), theta[0].cols());
+        for (std::size_t column = 0; column < dim; ++column) {
+            const std::complex<double> entry = matrix[row * dim + column];
+            if (entry != 0.0) {
+                rotated[row] += entry * theta[column];
+            }
+        }
+    }
+
+    // Peel off one site at a time: rows (s_b, l), columns (remaining bits, r)
+    const Eigen::Index right = rotated[0].cols();
+    for (int b = 0; b < width - 1; ++b) {
+        const Eigen::Index left = rotated[0].rows();
+        const std::size_t rest = rotated.size() / 2;
+        Eigen::MatrixXcd unfolded(2 * left, static_cast<Eigen::Index>(rest) * right);
+        for (std::size_t c = 0; c < rotated.size(); ++c) {
+            unfolded.block((c & 1) * left, static_cast<Eigen::Index>(c >> 1) * right, left, right) = rotated[c];
+        }
+
+        // JacobiSVD: Eigen 3.4's BDCSVD returns inaccurate factors on some of these matrices
+        Eigen::JacobiSVD<Eigen::MatrixXcd> svd(unfolded, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        const Eigen::VectorXd& values = svd.singularValues();
+        const double total = values.squaredNorm();
+        Eigen::Index keep = std::min<Eigen::Index>(values.size(), max_bond_dimension);
+        double discarded = values.tail(values.size() - keep).squaredNorm();
+        while (keep > 1 && discarded + values(keep - 1) * values(keep - 1) <= truncation_threshold * total) {
+            --keep;
+            discarded += values(keep) * values(keep);
+        }
+        if (total > 0.0) {
+            truncation_error += discarded / total;
+        }
+
+        // Renormalize so truncation does not shrink the state
+        const double kept_norm = std::sqrt(std::max(total - discarded, 0.0));
+        const double scale = kept_norm > 0.0 ? std::sqrt(total) / kept_norm : 1.0;
+        const Eigen::MatrixXcd u = svd.matrixU().leftCols(keep);
+        const Eigen::MatrixXcd sv = (scale * values.head(keep)).asDiagonal() * svd.matrixV().leftCols(keep).adjoint();
+        sites[first + b][0] = u.topRows(left);
+        sites[first + b][1] = u.bottomRows(left);
+
+        std::vector<Eigen::MatrixXcd> remaining(rest);
+        for (std::size_t c = 0; c < rest; ++c) {
+            remaining[c] = sv.middleCols(static_cast<Eigen::Index>(c) * right, right);
+        }
+        rotated.swap(remaining);
+    }
+    sites[first + width - 1][0] = rotated[0];
+    sites[first + width - 1][1] = rotated[1];
+    center = first + width - 1;
+}
+
+int MPSState::measure(int qubit, std::mt19937_64& rng) {
+    if (qubit < 0 || qubit >= num_qubits) {
+        throw std::out_of_range("Qubit index out of range: " + std::to_string(qubit));
+    }
+    // With the center on this site its own tensor carries the whole norm
+    moveCenter(qubit);
+    Site& site = sites[qubit];
+    const double prob_zero = site[0].squaredNorm();
+    const double prob_one = site[1].squaredNorm();
+    const double prob_total = prob_zero + prob_one;
+
+    // Same draw as GateEngine::measure: u < P(1) happens with probability P(1)
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    const int result = (u * prob_total < prob_one) ? 1 : 0;
+    const double prob_result = result ? prob_one : prob_zero;
+    const double scale = prob_result > 1e-20 ? std::sqrt(prob_total / prob_result) : 1.0;
+    site[result] *= scale;
+    site[1 - result].setZero();
+    return result;
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @class MPSState
+ * @brief Matrix product state for wide, weakly entangled registers
+ *
+ * Site q holds two matrices A_q[0], A_q[1] of size χ_q × χ_{q+1}, and the
+ * amplitude of |b_{n-1}...b_0⟩ is the product A_0[b_0] · ... · A_{n-1}[b_{n-1}].
+ * Memory is O(n χ²) instead of O(2^n), where the bond dimension χ tracks
+ * the entanglement across each cut.
+ *
+ * The state is kept in mixed canonical form around an orthogonality
+ * center, so single-site probabilities and two-site updates are local.
+ * Multi-qubit gates run on adjacent sites: the sites are contracted, the
+ * gate applied, and the result split again with an SVD that keeps at most
+ * maxBondDimension singular values and drops the smallest ones while their
+ * combined weight stays below truncationThreshold. Non-adjacent qubits are
+ * brought together with SWAPs first and moved back afterwards.
+ */
+class MPSState {
+public:
+    /// Default cap on each bond dimension
+    static constexpr int DEFAULT_MAX_BOND_DIMENSION = 256;
+
+    /// Default discarded weight allowed per SVD (removes numerical noise only)
+    static constexpr double DEFAULT_TRUNCATION_THRESHOLD = 1e-12;
+
+    /// Widest gate applyGate accepts (the widest dense op, MAX_FUSED_WIDTH)
+    static constexpr int MAX_GATE_QUBITS = 3;
+
+    /**
+     * @brief Creates |0...0⟩ (all bond dimensions 1)
+     * @param numQubits Register width (at least 1)
+     * @param maxBondDimension Largest bond dimension kept by truncation (at least 1)
+     * @param truncationThreshold Discarded weight allowed per SVD, in [0, 1)
+     * @throws std::invalid_argument if an argument is out of range
+     */
+    explicit MPSState(int numQubits, int maxBondDimension = DEFAULT_MAX_BOND_DIMENSION,
+                      double truncationThreshold = DEFAULT_TRUNCATION_THRESHOLD);
+
+    /// Resets to |0...0⟩ and clears the truncation error
+    void initializeZeroState();
+
+    /**
+     * @brief Sets a computational basis state
+     * @param stateString Binary label, highest qubit first (e.g., "0101")
+     * @throws std::invalid_argument if the label is malformed
+     */
+    void setInitialState(const std::string& stateString);
+
+    /**
+     * @brief Gets the register width
+     * @return Number of qubits
+     */
+    int getNumQubits() const { return num_qubits; }
+
+    /**
+     * @brief Gets the dimension of one bond
+     * @param bond Bond between qubits bond and bond + 1, in [0, n - 1)
+     * @return Bond dimension
+     * @throws std::out_of_range if bond is out of range
+     */
+    int getBondDimension(int bond) const;
+
+    /**
+     * @brief Gets the largest bond dimension in the chain
+     * @return Max over all bonds (1 for product states)
+     */
+    int getMaxBondDimension() const;
+
+    /**
+     * @brief Gets the accumulated truncation error
+     * @return Sum of the discarded weights of every SVD since the last reset
+     *
+     * An upper estimate of 1 - |⟨ψ_exact|ψ⟩|² for small errors.
+     */
+    double getTruncationError() const { return truncation_error; }
+
+    /**
+     * @brief Gets the number of SWAPs inserted to reach non-adjacent qubits
+     * @return SWAP count since the last reset (moving in and back out)
+     */
+    std::uint64_t getSwapCount() const { return swap_count; }
+
+    /**
+     * @brief Gets the number of stored complex entries across all sites
+     * @return Sum of 2 χ_q χ_{q+1}
+     */
+    std::uint64_t storedAmplitudes() const;
+
+    /**
+     * @brief Gets one amplitude
+     * @param index Basis state index (registers of up to 64 qubits)
+     * @return Amplitude
+     * @throws std::invalid_argument if the register is wider than 64 qubits
+     */
+    std::complex<double> amplitude(std::uint64_t index) const;
+
+    /**
+     * @brief Gets one amplitude by label
+     * @param stateString Binary label, highest qubit first
+     * @return Amplitude
+     * @throws std::invalid_argument if the label is malformed
+     */
+    std::complex<double> amplitude(const std::string& stateString) const;
+
+    /**
+     * @brief Applies a unitary to a set of qubits
+     * @param qubits Distinct qubits, in ascending order (1-MAX_GATE_QUBITS of them)
+     * @param matrix Row-major 2^k x 2^k matrix; local bit b is qubits[b]
+     * @throws std::invalid_argument if the qubits or matrix size are invalid
+     */
+    void applyGate(const std::vector<int>& qubits, const std::vector<std::complex<double>>& matrix);
+
+    /**
+     * @brief Measures one qubit and collapses the state
+     * @param qubit Qubit index
+     * @param rng Random engine for the outcome
+     * @return Outcome (0 or 1)
+     * @throws std::out_of_range if qubit is out of range
+     */
+    int measure(int qubit, std::mt19937_64& rng);
+
+private:
+    /// Site tensor: one χl × χr matrix per physical value
+    using Site = std::array<Eigen::MatrixXcd, 2>;
+
+    /// Register width n
+    int num_qubits;
+
+    /// Cap on bond dimensions
+    int max_bond_dimension;
+
+    /// Discarded weight allowed per SVD
+    double truncation_threshold;
+
+    /// Site tensors, qubit 0 first
+    std::vector<Site> sites;
+
+    /// Sites left of it are left-canonical, sites right of it right-canonical
+    int center = 0;
+
+    /// Sum of discarded weights
+    double truncation_error = 0.0;
+
+    /// SWAPs inserted by applyGate
+    std::uint64_t swap_count = 0;
+
+    /// Moves the orthogonality center to site with QR sweeps
+    void moveCenter(int site);
+
+    /// Applies a gate to sites first..first+k-1; local bit b is site first + b
+    void applyAdjacent(int first, int width, const std::vector<std::complex<double>>& matrix);
+
+    /// Exchanges the qubits on sites site and site + 1
+    void swapSites(int site);
+};
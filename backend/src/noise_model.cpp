@@ -0,0 +1,124 @@
+#include "noise_model.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+void validateProbability(double probability, const char* name) {
+    if (!(probability >= 0.0 && probability <= 1.0)) {
+        throw std::invalid_argument(std::string(name) + " must be in [0, 1], got " + std::to_string(probability));
+    }
+}
+
+NoiseChannel makeChannel(NoiseKind kind, double probability, const char* name) {
+    validateProbability(probability, name);
+    NoiseChannel channel;
+    channel.kind = kind;
+    channel.probability = probability;
+    return channel;
+}
+
+// Readout errors are not state channels and cannot follow gates
+void validateStateChannel(const NoiseChannel& channel) {
+    if (channel.kind == NoiseKind::None || channel.kind == NoiseKind::Readout) {
+        throw std::invalid_argument("Gate and qubit noise must be a depolarizing or damping channel");
+    }
+}
+
+std::pair<OpCode, bool> gateKey(const std::string& gateName) {
+    int min_controls = 0;
+    OpCode opcode = parseOpCode(gateName, &min_controls);
+    return {opcode, min_controls > 0};
+}
+
+}  // namespace
+
+NoiseChannel depolarizing(double probability) {
+    return makeChannel(NoiseKind::Depolarizing, probability, "Depolarizing probability");
+}
+
+NoiseChannel amplitudeDamping(double gamma) {
+    return makeChannel(NoiseKind::AmplitudeDamping, gamma, "Amplitude damping gamma");
+}
+
+NoiseChannel phaseDamping(double lambda) {
+    return makeChannel(NoiseKind::PhaseDamping, lambda, "Phase damping lambda");
+}
+
+NoiseChannel readoutError(double probabilityZeroToOne, double probabilityOneToZero) {
+    NoiseChannel channel = makeChannel(NoiseKind::Readout, probabilityZeroToOne, "Readout error probability");
+    validateProbability(probabilityOneToZero, "Readout error probability");
+    channel.probability_one = probabilityOneToZero;
+    return channel;
+}
+
+std::vector<kernels::Matrix2> krausOperators(const NoiseChannel& channel) {
+    const double p = channel.probability;
+    switch (channel.kind) {
+        case NoiseKind::Depolarizing: {
+            const double keep = std::sqrt(1.0 - p);
+            const double flip = std::sqrt(p / 3.0);
+            const std::complex<double> i_flip(0.0, flip);
+            return {{keep, 0.0, 0.0, keep},
+                    {0.0, flip, flip, 0.0},
+                    {0.0, -i_flip, i_flip, 0.0},
+                    {flip, 0.0, 0.0, -flip}};
+        }
+        case NoiseKind::AmplitudeDamping:
+            return {{1.0, 0.0, 0.0, std::sqrt(1.0 - p)}, {0.0, std::sqrt(p), 0.0, 0.0}};
+        case NoiseKind::PhaseDamping:
+            return {{1.0, 0.0, 0.0, std::sqrt(1.0 - p)}, {0.0, 0.0, 0.0, std::sqrt(p)}};
+        case NoiseKind::None:
+        case NoiseKind::Readout:
+            break;
+    }
+    return {};
+}
+
+void NoiseModel::addGateNoise(const std::string& gateName, const NoiseChannel& channel) {
+    validateStateChannel(channel);
+    gate_noise[gateKey(gateName)].push_back(channel);
+}
+
+void NoiseModel::addQubitNoise(int qubit, const NoiseChannel& channel) {
+    if (qubit < 0) {
+        throw std::invalid_argument("Qubit index cannot be negative");
+    }
+    validateStateChannel(channel);
+    qubit_noise[qubit].push_back(channel);
+}
+
+void NoiseModel::setReadoutError(int qubit, const NoiseChannel& channel) {
+    if (qubit < -1) {
+        throw std::invalid_argument("Readout qubit must be -1 (all qubits) or a qubit index");
+    }
+    if (channel.kind != NoiseKind::Readout) {
+        throw std::invalid_argument("setReadoutError requires a readout channel");
+    }
+    readout[qubit] = channel;
+}
+
+std::vector<NoiseChannel> NoiseModel::channelsAfter(const std::string& gateName, int qubit) const {
+    std::vector<NoiseChannel> channels;
+    auto gate_it = gate_noise.find(gateKey(gateName));
+    if (gate_it != gate_noise.end()) {
+        channels = gate_it->second;
+    }
+    auto qubit_it = qubit_noise.find(qubit);
+    if (qubit_it != qubit_noise.end()) {
+        channels.insert(channels.end(), qubit_it->second.begin(), qubit_it->second.end());
+    }
+    return channels;
+}
+
+NoiseChannel NoiseModel::readoutFor(int qubit) const {
+    auto it = readout.find(qubit);
+    if (it == readout.end()) {
+        it = readout.find(-1);
+    }
+    return it == readout.end() ? NoiseChannel{} : it->second;
+}
+
+bool NoiseModel::empty() const {
+    return gate_noise.empty() && qubit_noise.empty() && readout.empty();
+}
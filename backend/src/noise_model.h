@@ -0,0 +1,130 @@
+#pragma once
+
+#include "compiled_circuit.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file noise_model.h
+ * @brief Noise channels attached to gate types and qubits
+ *
+ * Noisy circuits are simulated with stochastic pure-state trajectories:
+ * after each gate a NOISE op picks one Kraus branch of its channel with the
+ * Born probability and applies it with the ordinary state-vector kernels.
+ * Averaged over many trajectories this reproduces the density-matrix result
+ * while needing O(2^n) memory per trajectory instead of O(4^n).
+ *
+ * Depolarizing and phase damping are mixtures of unitaries and cost nothing
+ * unless a Pauli is drawn; amplitude damping needs one extra reduction for
+ * P(1). Readout errors do not touch the state and only flip the reported
+ * bit of a measurement.
+ */
+
+/**
+ * @brief Depolarizing channel: X, Y or Z each with probability p/3
+ * @param probability Total error probability p in [0, 1]
+ * @return Channel description
+ * @throws std::invalid_argument if probability is outside [0, 1]
+ */
+NoiseChannel depolarizing(double probability);
+
+/**
+ * @brief Amplitude damping (energy relaxation) with decay probability gamma
+ * @param gamma Probability that |1⟩ decays to |0⟩, in [0, 1]
+ * @return Channel description
+ * @throws std::invalid_argument if gamma is outside [0, 1]
+ */
+NoiseChannel amplitudeDamping(double gamma);
+
+/**
+ * @brief Phase damping (dephasing): off-diagonal terms scale by sqrt(1 - lambda)
+ * @param lambda Damping strength in [0, 1]
+ * @return Channel description
+ * @throws std::invalid_argument if lambda is outside [0, 1]
+ */
+NoiseChannel phaseDamping(double lambda);
+
+/**
+ * @brief Readout error on measurement results
+ * @param probabilityZeroToOne P(read 1 | state 0)
+ * @param probabilityOneToZero P(read 0 | state 1)
+ * @return Channel description
+ * @throws std::invalid_argument if a probability is outside [0, 1]
+ */
+NoiseChannel readoutError(double probabilityZeroToOne, double probabilityOneToZero);
+
+/**
+ * @brief Gets the Kraus operators of a state channel
+ * @param channel Depolarizing, amplitude- or phase-damping channel
+ * @return Matrices K_k with Σ K_k† K_k = I (empty for None / Readout)
+ */
+std::vector<kernels::Matrix2> krausOperators(const NoiseChannel& channel);
+
+/**
+ * @class NoiseModel
+ * @brief Which channels follow which gates, and per-qubit readout errors
+ *
+ * Gate noise applies to every qubit the gate touches (target and all
+ * controls) after each gate of that type; qubit noise applies after every
+ * gate touching that qubit. Gate types are matched like parseOpCode, so
+ * "X" and "Pauli-X" are the same type while "CZ" and "Z" are not.
+ */
+class NoiseModel {
+public:
+    /**
+     * @brief Attaches a channel to every gate of one type
+     * @param gateName Gate identifier ("H", "CNOT", ...)
+     * @param channel Depolarizing, amplitude- or phase-damping channel
+     * @throws std::invalid_argument if the gate is unknown or the channel is a readout error
+     */
+    void addGateNoise(const std::string& gateName, const NoiseChannel& channel);
+
+    /**
+     * @brief Attaches a channel to every gate touching one qubit
+     * @param qubit Qubit index (0-based)
+     * @param channel Depolarizing, amplitude- or phase-damping channel
+     * @throws std::invalid_argument if qubit < 0 or the channel is a readout error
+     */
+    void addQubitNoise(int qubit, const NoiseChannel& channel);
+
+    /**
+     * @brief Sets the readout error of one qubit, or of all qubits
+     * @param qubit Qubit index, or -1 for the default of every qubit without its own entry
+     * @param channel Channel from readoutError()
+     * @throws std::invalid_argument if the channel is not a readout error or qubit < -1
+     */
+    void setReadoutError(int qubit, const NoiseChannel& channel);
+
+    /**
+     * @brief Gets the channels to apply on one qubit after a gate
+     * @param gateName Name of the gate just applied
+     * @param qubit Qubit touched by the gate
+     * @return Gate-type channels followed by qubit channels
+     */
+    std::vector<NoiseChannel> channelsAfter(const std::string& gateName, int qubit) const;
+
+    /**
+     * @brief Gets the readout error of a qubit
+     * @param qubit Qubit index
+     * @return Readout channel (kind None if the qubit has none)
+     */
+    NoiseChannel readoutFor(int qubit) const;
+
+    /**
+     * @brief Checks whether any channel or readout error is configured
+     * @return True if the model is noiseless
+     */
+    bool empty() const;
+
+private:
+    /// Channels per gate type, keyed by (OpCode, implies controls)
+    std::map<std::pair<OpCode, bool>, std::vector<NoiseChannel>> gate_noise;
+
+    /// Channels per qubit
+    std::map<int, std::vector<NoiseChannel>> qubit_noise;
+
+    /// Readout errors per qubit (-1 holds the default)
+    std::map<int, NoiseChannel> readout;
+};
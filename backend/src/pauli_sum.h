@@ -0,0 +1,115 @@
+#pragma once
+
+#include "qubit_manager.h"
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file pauli_sum.h
+ * @brief Pauli-sum observables and their expectation values
+ *
+ * A Pauli string is stored as two bit masks: x_mask has the qubits carrying
+ * X or Y, z_mask the qubits carrying Z or Y. It maps |i⟩ to
+ * i^{#Y} (-1)^{popcount(i & z_mask)} |i ^ x_mask⟩, so ⟨ψ|P|ψ⟩ is one
+ * read-only pass over the amplitudes with no state copy.
+ *
+ * For large sums, qubit-wise commuting terms (equal letters wherever both
+ * act) are grouped. Each group rotates one copy of the state into its
+ * shared Z basis; a Walsh-Hadamard transform of the probabilities then
+ * yields every Z-string expectation at once, so a group of thousands of
+ * terms costs a few sweeps instead of one sweep per term.
+ */
+
+/**
+ * @struct PauliTerm
+ * @brief One weighted Pauli string
+ */
+struct PauliTerm {
+    /// Real weight of the string
+    double coefficient = 0.0;
+
+    /// Qubits carrying X or Y
+    std::uint64_t x_mask = 0;
+
+    /// Qubits carrying Z or Y
+    std::uint64_t z_mask = 0;
+};
+
+/**
+ * @brief Computes ⟨ψ|P|ψ⟩ for one Pauli string (coefficient not applied)
+ * @param state Amplitude array
+ * @param dimension Number of amplitudes
+ * @param term Pauli string; its qubits must be below log2(dimension)
+ * @return Real expectation value
+ */
+double pauliExpectation(const std::complex<double>* state, std::uint64_t dimension, const PauliTerm& term);
+
+/**
+ * @class PauliSum
+ * @brief Hermitian observable H = Σ c_k P_k
+ *
+ * @note Terms are kept in insertion order; equal strings are not merged
+ */
+class PauliSum {
+public:
+    /**
+     * @brief Adds a weighted Pauli string
+     * @param coefficient Real weight
+     * @param term Letters followed by qubit indices, e.g. "X0 Z3 Y12"; "" or "I" is the identity
+     * @throws std::invalid_argument if the string is malformed or repeats a qubit
+     */
+    void addTerm(double coefficient, const std::string& term);
+
+    /**
+     * @brief Adds a term given by its masks
+     * @param term Weighted Pauli string
+     */
+    void addTerm(const PauliTerm& term);
+
+    /**
+     * @brief Gets the terms in insertion order
+     * @return Term list
+     */
+    const std::vector<PauliTerm>& getTerms() const { return terms; }
+
+    /**
+     * @brief Gets the smallest register width the observable fits on
+     * @return Highest qubit index used plus one (0 for an identity-only sum)
+     */
+    int getNumQubits() const;
+
+    /**
+     * @brief Partitions the terms into qubit-wise commuting groups
+     * @return Term indices per group, in first-fit order
+     */
+    std::vector<std::vector<std::size_t>> groupQubitWiseCommuting() const;
+
+    /**
+     * @brief Computes ⟨ψ|H|ψ⟩
+     * @param qubits Register holding |ψ⟩ (not modified)
+     * @return Real expectation value
+     * @throws std::out_of_range if a term acts on a qubit outside the register
+     *
+     * Small groups are evaluated term by term with read-only passes; larger
+     * groups share one basis-rotated copy (see file comment).
+     */
+    double expectation(const QubitManager& qubits) const;
+
+    /**
+     * @brief Replaces |ψ⟩ by H|ψ⟩ (not normalized)
+     * @param qubits Register to transform
+     * @throws std::out_of_range if a term acts on a qubit outside the register
+     *
+     * Usable as the observable of CircuitManager::adjointGradient.
+     */
+    void apply(QubitManager& qubits) const;
+
+private:
+    /// Weighted Pauli strings
+    std::vector<PauliTerm> terms;
+
+    /// Throws if any term needs more than numQubits qubits
+    void checkWidth(int numQubits) const;
+};
@@ -0,0 +1,895 @@
+#include "qasm_parser.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+QasmError::QasmError(const std::string& source, int line, int column, const std::string& message)
+    : std::runtime_error(source + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " + message),
+      error_line(line), error_column(column) {}
+
+namespace {
+
+/// Largest parameter or qubit list of a custom gate (keeps expansion on the stack)
+constexpr int MAX_GATE_ARGUMENTS = 32;
+
+/// Deepest operand stack an angle expression may need
+constexpr int MAX_EXPRESSION_DEPTH = 64;
+
+enum class TokenKind { End, Identifier, Integer, Real, String, Arrow, Equal, Symbol };
+
+struct Token {
+    TokenKind kind = TokenKind::End;
+    std::string_view text;
+    int line = 1;
+    int column = 1;
+};
+
+// Produces one token at a time straight from the source buffer
+class Lexer {
+public:
+    Lexer(std::string_view source, const std::string& sourceName)
+        : position(source.data()), end(source.data() + source.size()), line_start(source.data()),
+          name(sourceName) {
+        advance();
+    }
+
+    const Token& peek() const { return current; }
+
+    Token take() {
+        Token token = current;
+        advance();
+        return token;
+    }
+
+    bool accept(char symbol) {
+        if (current.kind == TokenKind::Symbol && current.text[0] == symbol) {
+            advance();
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char symbol) {
+        if (!accept(symbol)) {
+            fail(current, std::string("expected '") + symbol + "' but found " + describe(current));
+        }
+    }
+
+    Token expect(TokenKind kind, const char* what) {
+        if (current.kind != kind) {
+            fail(current, std::string("expected ") + what + " but found " + describe(current));
+        }
+        return take();
+    }
+
+    [[noreturn]] void fail(const Token& at, const std::string& message) const {
+        throw QasmError(name, at.line, at.column, message);
+    }
+
+    static std::string describe(const Token& token) {
+        return token.kind == TokenKind::End ? "end of file" : "'" + std::string(token.text) + "'";
+    }
+
+private:
+    const char* position;
+    const char* end;
+    const char* line_start;
+    int line = 1;
+    const std::string& name;
+    Token current;
+
+    void newline() {
+        ++line;
+        line_start = position + 1;
+    }
+
+    void skipSpaceAndComments() {
+        while (position < end) {
+            const char c = *position;
+            if (c == '\n') {
+                newline();
+                ++position;
+            } else if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v') {
+                ++position;
+            } else if (c == '/' && position + 1 < end && position[1] == '/') {
+                while (position < end && *position != '\n') {
+                    ++position;
+                }
+            } else if (c == '/' && position + 1 < end && position[1] == '*') {
+                const Token start{TokenKind::Symbol, {}, line, static_cast<int>(position - line_start) + 1};
+                position += 2;
+                while (position < end && !(*position == '*' && position + 1 < end && position[1] == '/')) {
+                    if (*position == '\n') {
+                        newline();
+                    }
+                    ++position;
+                }
+                if (position >= end) {
+                    fail(start, "unterminated comment");
+                }
+                position += 2;
+            } else {
+                return;
+            }
+        }
+    }
+
+    static bool isIdentifierStart(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    void advance() {
+        skipSpaceAndComments();
+        current.line = line;
+        current.column = static_cast<int>(position - line_start) + 1;
+        const char* start = position;
+        if (position >= end) {
+            current.kind = TokenKind::End;
+            current.text = {};
+            return;
+        }
+
+        const char c = *position;
+        if (isIdentifierStart(c)) {
+            while (position < end && (isIdentifierStart(*position) || isDigit(*position))) {
+                ++position;
+            }
+            current.kind = TokenKind::Identifier;
+        } else if (isDigit(c) || (c == '.' && position + 1 < end && isDigit(position[1]))) {
+            current.kind = TokenKind::Integer;
+            while (position < end && isDigit(*position)) {
+                ++position;
+            }
+            if (position < end && *position == '.') {
+                current.kind = TokenKind::Real;
+                ++position;
+                while (position < end && isDigit(*position)) {
+                    ++position;
+                }
+            }
+            if (position < end && (*position == 'e' || *position == 'E')) {
+                const char* exponent = position + 1;
+                if (exponent < end && (*exponent == '+' || *exponent == '-')) {
+                    ++exponent;
+                }
+                if (exponent < end && isDigit(*exponent)) {
+                    current.kind = TokenKind::Real;
+                    position = exponent;
+                    while (position < end && isDigit(*position)) {
+                        ++position;
+                    }
+                }
+            }
+        } else if (c == '"') {
+            ++position;
+            while (position < end && *position != '"' && *position != '\n') {
+                ++position;
+            }
+            if (position >= end || *position != '"') {
+                current.text = std::string_view(start, 1);
+                fail(current, "unterminated string");
+            }
+            ++position;
+            current.kind = TokenKind::String;
+        } else if (c == '-' && position + 1 < end && position[1] == '>') {
+            position += 2;
+            current.kind = TokenKind::Arrow;
+        } else if (c == '=' && position + 1 < end && position[1] == '=') {
+            position += 2;
+            current.kind = TokenKind::Equal;
+        } else {
+            ++position;
+            current.kind = TokenKind::Symbol;
+        }
+        current.text = std::string_view(start, static_cast<std::size_t>(position - start));
+    }
+};
+
+/// One postfix instruction of an angle expression
+struct ExprOp {
+    enum Kind : std::uint8_t {
+        Constant, Parameter, Negate, Add, Subtract, Multiply, Divide, Power,
+        Sin, Cos, Tan, Exp, Ln, Sqrt
+    };
+    Kind kind;
+    double value;
+    int index;
+};
+
+using Expr = std::vector<ExprOp>;
+
+double evaluate(const Expr& expr, const double* parameters) {
+    std::array<double, MAX_EXPRESSION_DEPTH> stack;
+    int top = 0;
+    for (const ExprOp& op : expr) {
+        switch (op.kind) {
+            case ExprOp::Constant: stack[top++] = op.value; break;
+            case ExprOp::Parameter: stack[top++] = parameters[op.index]; break;
+            case ExprOp::Negate: stack[top - 1] = -stack[top - 1]; break;
+            case ExprOp::Add: --top; stack[top - 1] += stack[top]; break;
+            case ExprOp::Subtract: --top; stack[top - 1] -= stack[top]; break;
+            case ExprOp::Multiply: --top; stack[top - 1] *= stack[top]; break;
+            case ExprOp::Divide: --top; stack[top - 1] /= stack[top]; break;
+            case ExprOp::Power: --top; stack[top - 1] = std::pow(stack[top - 1], stack[top]); break;
+            case ExprOp::Sin: stack[top - 1] = std::sin(stack[top - 1]); break;
+            case ExprOp::Cos: stack[top - 1] = std::cos(stack[top - 1]); break;
+            case ExprOp::Tan: stack[top - 1] = std::tan(stack[top - 1]); break;
+            case ExprOp::Exp: stack[top - 1] = std::exp(stack[top - 1]); break;
+            case ExprOp::Ln: stack[top - 1] = std::log(stack[top - 1]); break;
+            case ExprOp::Sqrt: stack[top - 1] = std::sqrt(stack[top - 1]); break;
+        }
+    }
+    return stack[0];
+}
+
+/// Gates lowered directly to CircuitManager calls
+enum class Builtin {
+    U, CX, U3, U2, U1, U0, UFull, P, Id, X, Y, Z, H, S, Sdg, T, Tdg, SX, SXdg, RX, RY, RZ,
+    CY, CZ, CH, CRX, CRY, CRZ, CU1, CP, CU3, CU, CSX, Swap, CCX, CSwap, RXX, RZZ, C3X, C4X
+};
+
+/// A callable gate: built in, or an index into the custom definitions
+struct GateRef {
+    bool custom = false;
+    int id = 0;
+    int num_parameters = 0;
+    int num_qubits = 0;
+};
+
+struct BodyCall {
+    GateRef gate;
+    std::vector<Expr> parameters;
+    std::vector<int> qubits;
+};
+
+struct CustomGate {
+    int num_parameters = 0;
+    int num_qubits = 0;
+    std::vector<BodyCall> body;
+};
+
+struct BuiltinEntry {
+    const char* name;
+    Builtin id;
+    int num_parameters;
+    int num_qubits;
+};
+
+// Names made available by include "qelib1.inc" (U and CX are always defined)
+constexpr BuiltinEntry QELIB1_GATES[] = {
+    {"u3", Builtin::U3, 3, 1}, {"u2", Builtin::U2, 2, 1}, {"u1", Builtin::U1, 1, 1},
+    {"u0", Builtin::U0, 1, 1}, {"u", Builtin::UFull, 3, 1}, {"p", Builtin::P, 1, 1},
+    {"id", Builtin::Id, 0, 1}, {"x", Builtin::X, 0, 1}, {"y", Builtin::Y, 0, 1},
+    {"z", Builtin::Z, 0, 1}, {"h", Builtin::H, 0, 1}, {"s", Builtin::S, 0, 1},
+    {"sdg", Builtin::Sdg, 0, 1}, {"t", Builtin::T, 0, 1}, {"tdg", Builtin::Tdg, 0, 1},
+    {"sx", Builtin::SX, 0, 1}, {"sxdg", Builtin::SXdg, 0, 1}, {"rx", Builtin::RX, 1, 1},
+    {"ry", Builtin::RY, 1, 1}, {"rz", Builtin::RZ, 1, 1}, {"cx", Builtin::CX, 0, 2},
+    {"cy", Builtin::CY, 0, 2}, {"cz", Builtin::CZ, 0, 2}, {"ch", Builtin::CH, 0, 2},
+    {"crx", Builtin::CRX, 1, 2}, {"cry", Builtin::CRY, 1, 2}, {"crz", Builtin::CRZ, 1, 2},
+    {"cu1", Builtin::CU1, 1, 2}, {"cp", Builtin::CP, 1, 2}, {"cu3", Builtin::CU3, 3, 2},
+    {"cu", Builtin::CU, 4, 2}, {"csx", Builtin::CSX, 0, 2}, {"swap", Builtin::Swap, 0, 2},
+    {"ccx", Builtin::CCX, 0, 3}, {"cswap", Builtin::CSwap, 0, 3}, {"rxx", Builtin::RXX, 1, 2},
+    {"rzz", Builtin::RZZ, 1, 2}, {"c3x", Builtin::C3X, 0, 4}, {"c4x", Builtin::C4X, 0, 5},
+};
+
+/// Gate argument of a top-level statement: one qubit, or a whole register
+struct Operand {
+    Token token;
+    int offset = 0;
+    int size = 1;
+    bool whole = false;
+};
+
+const kernels::Matrix2 SX_MATRIX = {std::complex<double>(0.5, 0.5), std::complex<double>(0.5, -0.5),
+                                    std::complex<double>(0.5, -0.5), std::complex<double>(0.5, 0.5)};
+const kernels::Matrix2 SXDG_MATRIX = {std::complex<double>(0.5, -0.5), std::complex<double>(0.5, 0.5),
+                                      std::complex<double>(0.5, 0.5), std::complex<double>(0.5, -0.5)};
+
+class Parser {
+public:
+    Parser(std::string_view source, CircuitManager& target, const std::string& sourceName)
+        : lexer(source, sourceName), circuit(target) {
+        gates.emplace("U", GateRef{false, static_cast<int>(Builtin::U), 3, 1});
+        gates.emplace("CX", GateRef{false, static_cast<int>(Builtin::CX), 0, 2});
+    }
+
+    QasmProgram run() {
+        const int initial_size = circuit.getCircuitSize();
+        if (lexer.peek().kind == TokenKind::Identifier && lexer.peek().text == "OPENQASM") {
+            parseVersion();
+        }
+        while (lexer.peek().kind != TokenKind::End) {
+            parseStatement();
+        }
+        program.gates_emitted = static_cast<std::size_t>(circuit.getCircuitSize() - initial_size);
+        return std::move(program);
+    }
+
+private:
+    Lexer lexer;
+    CircuitManager& circuit;
+    QasmProgram program;
+    std::unordered_map<std::string, GateRef> gates;
+    std::vector<CustomGate> custom_gates;
+    std::unordered_map<std::string, int> qreg_index;
+    std::unordered_map<std::string, int> creg_index;
+    bool included_qelib1 = false;
+
+    /// Per-statement buffers, reused so top-level statements do not allocate
+    std::vector<Operand> operands;
+    Expr expression;
+
+    // --- Statements -------------------------------------------------------
+
+    void parseVersion() {
+        lexer.take();
+        Token version = lexer.peek();
+        if (version.kind != TokenKind::Real && version.kind != TokenKind::Integer) {
+            lexer.fail(version, "expected a version number after OPENQASM");
+        }
+        lexer.take();
+        if (version.text != "2" && version.text.substr(0, 2) != "2.") {
+            lexer.fail(version, "unsupported OpenQASM version " + std::string(version.text) + " (expected 2.0)");
+        }
+        lexer.expect(';');
+    }
+
+    void parseStatement() {
+        Token keyword = lexer.expect(TokenKind::Identifier, "a statement");
+        const std::string_view word = keyword.text;
+        if (word == "qreg" || word == "creg") {
+            parseRegister(keyword, word == "qreg");
+        } else if (word == "include") {
+            parseInclude();
+        } else if (word == "gate") {
+            parseGateDefinition();
+        } else if (word == "measure") {
+            parseMeasure();
+        } else if (word == "barrier") {
+            parseOperands(operands);
+            lexer.expect(';');
+        } else if (word == "OPENQASM") {
+            lexer.fail(keyword, "OPENQASM must be the first statement");
+        } else if (word == "reset" || word == "if" || word == "opaque") {
+            lexer.fail(keyword, "'" + std::string(word) + "' is not supported by this simulator");
+        } else {
+            parseGateCall(keyword);
+        }
+    }
+
+    void parseInclude() {
+        Token file = lexer.expect(TokenKind::String, "a file name");
+        if (file.text != "\"qelib1.inc\"") {
+            lexer.fail(file, "cannot include " + std::string(file.text) + ": only \"qelib1.inc\" is built in");
+        }
+        lexer.expect(';');
+        if (!included_qelib1) {
+            for (const BuiltinEntry& entry : QELIB1_GATES) {
+                gates.emplace(entry.name, GateRef{false, static_cast<int>(entry.id),
+                                                  entry.num_parameters, entry.num_qubits});
+            }
+            included_qelib1 = true;
+        }
+    }
+
+    void parseRegister(const Token& keyword, bool quantum) {
+        Token name = lexer.expect(TokenKind::Identifier, "a register name");
+        lexer.expect('[');
+        const int size = parseIndex();
+        lexer.expect(']');
+        lexer.expect(';');
+        if (size < 1) {
+            lexer.fail(name, "register " + std::string(name.text) + " must have at least one element");
+        }
+
+        const std::string key(name.text);
+        if (qreg_index.count(key) || creg_index.count(key)) {
+            lexer.fail(name, "register " + key + " is already declared");
+        }
+        std::vector<QasmRegister>& registers = quantum ? program.qregs : program.cregs;
+        int& total = quantum ? program.num_qubits : program.num_clbits;
+        if (quantum && total + static_cast<long long>(size) > QubitManager::MAX_QUBITS) {
+            lexer.fail(keyword, "program declares more than " + std::to_string(QubitManager::MAX_QUBITS) +
+                                " qubits");
+        }
+        (quantum ? qreg_index : creg_index).emplace(key, static_cast<int>(registers.size()));
+        registers.push_back({key, total, size});
+        total += size;
+    }
+
+    void parseMeasure() {
+        Operand qubit = parseOperand(true);
+        lexer.expect(TokenKind::Arrow, "'->'");
+        Operand bit = parseOperand(false);
+        lexer.expect(';');
+        if (qubit.size != bit.size) {
+            lexer.fail(bit.token, "measure needs matching operands: " + std::to_string(qubit.size) +
+                                  " qubit(s) into " + std::to_string(bit.size) + " bit(s)");
+        }
+        for (int i = 0; i < qubit.size; ++i) {
+            circuit.addGate("MEASURE", qubit.offset + i);
+            program.measurements.emplace_back(circuit.getCircuitSize() - 1, bit.offset + i);
+        }
+    }
+
+    void parseGateCall(const Token& name) {
+        const GateRef gate = lookupGate(name);
+        std::array<double, MAX_GATE_ARGUMENTS> parameters{};
+        int count = 0;
+        if (lexer.accept('(')) {
+            do {
+                if (count == MAX_GATE_ARGUMENTS) {
+                    lexer.fail(lexer.peek(), "too many parameters");
+                }
+                expression.clear();
+                parseExpression(expression, nullptr);
+                parameters[count++] = evaluate(expression, nullptr);
+            } while (lexer.accept(','));
+            lexer.expect(')');
+        }
+        if (count != gate.num_parameters) {
+            lexer.fail(name, std::string(name.text) + " takes " + std::to_string(gate.num_parameters) +
+                             " parameter(s), got " + std::to_string(count));
+        }
+
+        parseOperands(operands);
+        lexer.expect(';');
+        if (static_cast<int>(operands.size()) != gate.num_qubits) {
+            lexer.fail(name, std::string(name.text) + " takes " + std::to_string(gate.num_qubits) +
+                             " qubit(s), got " + std::to_string(operands.size()));
+        }
+
+        // Whole registers broadcast element-wise; single qubits repeat
+        int repeat = 1;
+        for (const Operand& operand : operands) {
+            if (operand.whole) {
+                if (repeat > 1 && operand.size != repeat) {
+                    lexer.fail(operand.token, "register sizes differ in broadcast (" + std::to_string(repeat) +
+                                              " vs " + std::to_string(operand.size) + ")");
+                }
+                repeat = operand.size;
+            }
+        }
+        std::array<int, MAX_GATE_ARGUMENTS> qubits{};
+        for (int i = 0; i < repeat; ++i) {
+            for (std::size_t k = 0; k < operands.size(); ++k) {
+                qubits[k] = operands[k].offset + (operands[k].whole ? i : 0);
+                for (std::size_t j = 0; j < k; ++j) {
+                    if (qubits[j] == qubits[k]) {
+                        lexer.fail(operands[k].token, "qubit " + std::to_string(qubits[k]) +
+                                                      " appears twice in the arguments of " + std::string(name.text));
+                    }
+                }
+            }
+            apply(gate, parameters.data(), qubits.data());
+        }
+    }
+
+    void parseGateDefinition() {
+        Token name = lexer.expect(TokenKind::Identifier, "a gate name");
+        const std::string key(name.text);
+        if (gates.count(key)) {
+            lexer.fail(name, "gate " + key + " is already defined");
+        }
+
+        std::vector<std::string_view> parameter_names;
+        if (lexer.accept('(')) {
+            if (!lexer.accept(')')) {
+                do {
+                    parameter_names.push_back(declareFormal(parameter_names, "parameter"));
+                } while (lexer.accept(','));
+                lexer.expect(')');
+            }
+        }
+        std::vector<std::string_view> qubit_names;
+        do {
+            qubit_names.push_back(declareFormal(qubit_names, "qubit argument"));
+        } while (lexer.accept(','));
+        if (parameter_names.size() > MAX_GATE_ARGUMENTS || qubit_names.size() > MAX_GATE_ARGUMENTS) {
+            lexer.fail(name, "gate " + key + " has more than " + std::to_string(MAX_GATE_ARGUMENTS) +
+                             " parameters or qubits");
+        }
+
+        CustomGate definition;
+        definition.num_parameters = static_cast<int>(parameter_names.size());
+        definition.num_qubits = static_cast<int>(qubit_names.size());
+        lexer.expect('{');
+        while (!lexer.accept('}')) {
+            parseBodyStatement(definition, parameter_names, qubit_names);
+        }
+
+        custom_gates.push_back(std::move(definition));
+        gates.emplace(key, GateRef{true, static_cast<int>(custom_gates.size()) - 1,
+                                   static_cast<int>(parameter_names.size()), static_cast<int>(qubit_names.size())});
+    }
+
+    std::string_view declareFormal(const std::vector<std::string_view>& existing, const char* what) {
+        Token formal = lexer.expect(TokenKind::Identifier, what);
+        for (std::string_view other : existing) {
+            if (other == formal.text) {
+                lexer.fail(formal, std::string(what) + " " + std::string(formal.text) + " is declared twice");
+            }
+        }
+        return formal.text;
+    }
+
+    void parseBodyStatement(CustomGate& definition, const std::vector<std::string_view>& parameterNames,
+                            const std::vector<std::string_view>& qubitNames) {
+        Token name = lexer.expect(TokenKind::Identifier, "a gate call or '}'");
+        const bool barrier = name.text == "barrier";
+        BodyCall call;
+        if (!barrier) {
+            call.gate = lookupGate(name);
+            if (lexer.accept('(')) {
+                do {
+                    call.parameters.emplace_back();
+                    parseExpression(call.parameters.back(), &parameterNames);
+                } while (lexer.accept(','));
+                lexer.expect(')');
+            }
+            if (static_cast<int>(call.parameters.size()) != call.gate.num_parameters) {
+                lexer.fail(name, std::string(name.text) + " takes " + std::to_string(call.gate.num_parameters) +
+                                 " parameter(s), got " + std::to_string(call.parameters.size()));
+            }
+        }
+
+        do {
+            Token argument = lexer.expect(TokenKind::Identifier, "a qubit argument");
+            int index = -1;
+            for (std::size_t k = 0; k < qubitNames.size(); ++k) {
+                if (qubitNames[k] == argument.text) {
+                    index = static_cast<int>(k);
+                }
+            }
+            if (index < 0) {
+                lexer.fail(argument, "unknown qubit argument " + std::string(argument.text));
+            }
+            for (int other : call.qubits) {
+                if (other == index) {
+                    lexer.fail(argument, "qubit argument " + std::string(argument.text) + " appears twice");
+                }
+            }
+            call.qubits.push_back(index);
+        } while (lexer.accept(','));
+        lexer.expect(';');
+
+        if (barrier) {
+            return;
+        }
+        if (static_cast<int>(call.qubits.size()) != call.gate.num_qubits) {
+            lexer.fail(name, std::string(name.text) + " takes " + std::to_string(call.gate.num_qubits) +
+                             " qubit(s), got " + std::to_string(call.qubits.size()));
+        }
+        definition.body.push_back(std::move(call));
+    }
+
+    // --- Operands and expressions -----------------------------------------
+
+    int parseIndex() {
+        Token number = lexer.expect(TokenKind::Integer, "an integer");
+        int value = 0;
+        auto [end, error] = std::from_chars(number.text.data(), number.text.data() + number.text.size(), value);
+        if (error != std::errc() || end != number.text.data() + number.text.size()) {
+            lexer.fail(number, "integer " + std::string(number.text) + " is out of range");
+        }
+        return value;
+    }
+
+    Operand parseOperand(bool quantum) {
+        Operand operand;
+        operand.token = lexer.expect(TokenKind::Identifier, quantum ? "a qubit" : "a classical bit");
+        const std::string key(operand.token.text);
+        const auto& index = quantum ? qreg_index : creg_index;
+        auto it = index.find(key);
+        if (it == index.end()) {
+            lexer.fail(operand.token, std::string(quantum ? "unknown quantum register " : "unknown classical register ") +
+                                      key);
+        }
+        const QasmRegister& reg = (quantum ? program.qregs : program.cregs)[it->second];
+        operand.offset = reg.offset;
+        operand.size = reg.size;
+        operand.whole = true;
+        if (lexer.accept('[')) {
+            Token position = lexer.peek();
+            const int element = parseIndex();
+            lexer.expect(']');
+            if (element >= reg.size) {
+                lexer.fail(position, "index " + std::to_string(element) + " is out of range for " + key + "[" +
+                                     std::to_string(reg.size) + "]");
+            }
+            operand.offset += element;
+            operand.size = 1;
+            operand.whole = false;
+        }
+        return operand;
+    }
+
+    void parseOperands(std::vector<Operand>& out) {
+        out.clear();
+        do {
+            out.push_back(parseOperand(true));
+        } while (lexer.accept(','));
+    }
+
+    GateRef lookupGate(const Token& name) {
+        auto it = gates.find(std::string(name.text));
+        if (it == gates.end()) {
+            lexer.fail(name, "unknown gate " + std::string(name.text) +
+                             (included_qelib1 ? "" : " (missing include \"qelib1.inc\"?)"));
+        }
+        return it->second;
+    }
+
+    // Precedence climbing straight to postfix; parameters resolve against names (null at top level)
+    void parseExpression(Expr& out, const std::vector<std::string_view>* names) {
+        const Token start = lexer.peek();
+        int depth = 0;
+        int peak = 0;
+        parseSum(out, names, depth, peak);
+        if (peak > MAX_EXPRESSION_DEPTH) {
+            lexer.fail(start, "expression is nested too deeply");
+        }
+    }
+
+    static void push(Expr& out, ExprOp op, int& depth, int& peak) {
+        if (op.kind == ExprOp::Constant || op.kind == ExprOp::Parameter) {
+            peak = std::max(peak, ++depth);
+        } else if (op.kind >= ExprOp::Add && op.kind <= ExprOp::Power) {
+            --depth;
+        }
+        out.push_back(op);
+    }
+
+    void parseSum(Expr& out, const std::vector<std::string_view>* names, int& depth, int& peak) {
+        parseProduct(out, names, depth, peak);
+        for (;;) {
+            if (lexer.accept('+')) {
+                parseProduct(out, names, depth, peak);
+                push(out, {ExprOp::Add, 0.0, 0}, depth, peak);
+            } else if (lexer.accept('-')) {
+                parseProduct(out, names, depth, peak);
+                push(out, {ExprOp::Subtract, 0.0, 0}, depth, peak);
+            } else {
+                return;
+            }
+        }
+    }
+
+    void parseProduct(Expr& out, const std::vector<std::string_view>* names, int& depth, int& peak) {
+        parseUnary(out, names, depth, peak);
+        for (;;) {
+            if (lexer.accept('*')) {
+                parseUnary(out, names, depth, peak);
+                push(out, {ExprOp::Multiply, 0.0, 0}, depth, peak);
+            } else if (lexer.accept('/')) {
+                parseUnary(out, names, depth, peak);
+                push(out, {ExprOp::Divide, 0.0, 0}, depth, peak);
+            } else {
+                return;
+            }
+        }
+    }
+
+    void parseUnary(Expr& out, const std::vector<std::string_view>* names, int& depth, int& peak) {
+        if (lexer.accept('-')) {
+            parseUnary(out, names, depth, peak);
+            push(out, {ExprOp::Negate, 0.0, 0}, depth, peak);
+        } else if (lexer.accept('+')) {
+            parseUnary(out, names, depth, peak);
+        } else {
+            parsePrimary(out, names, depth, peak);
+            if (lexer.accept('^')) {
+                parseUnary(out, names, depth, peak);  // Right-associative, binds tighter than unary minus
+                push(out, {ExprOp::Power, 0.0, 0}, depth, peak);
+            }
+        }
+    }
+
+    void parsePrimary(Expr& out, const std::vector<std::string_view>* names, int& depth, int& peak) {
+        Token token = lexer.take();
+        if (token.kind == TokenKind::Integer || token.kind == TokenKind::Real) {
+            double value = 0.0;
+            auto [end, error] = std::from_chars(token.text.data(), token.text.data() + token.text.size(), value);
+            if (error != std::errc() || end != token.text.data() + token.text.size()) {
+                lexer.fail(token, "invalid number " + std::string(token.text));
+            }
+            push(out, {ExprOp::Constant, value, 0}, depth, peak);
+            return;
+        }
+        if (token.kind == TokenKind::Symbol && token.text[0] == '(') {
+            parseSum(out, names, depth, peak);
+            lexer.expect(')');
+            return;
+        }
+        if (token.kind != TokenKind::Identifier) {
+            lexer.fail(token, "expected an expression but found " + Lexer::describe(token));
+        }
+
+        if (token.text == "pi") {
+            push(out, {ExprOp::Constant, M_PI, 0}, depth, peak);
+            return;
+        }
+        static const std::pair<std::string_view, ExprOp::Kind> FUNCTIONS[] = {
+            {"sin", ExprOp::Sin}, {"cos", ExprOp::Cos}, {"tan", ExprOp::Tan},
+            {"exp", ExprOp::Exp}, {"ln", ExprOp::Ln}, {"sqrt", ExprOp::Sqrt},
+        };
+        for (const auto& [function, kind] : FUNCTIONS) {
+            if (token.text == function) {
+                lexer.expect('(');
+                parseSum(out, names, depth, peak);
+                lexer.expect(')');
+                push(out, {kind, 0.0, 0}, depth, peak);
+                return;
+            }
+        }
+        if (names != nullptr) {
+            for (std::size_t k = 0; k < names->size(); ++k) {
+                if ((*names)[k] == token.text) {
+                    push(out, {ExprOp::Parameter, 0.0, static_cast<int>(k)}, depth, peak);
+                    return;
+                }
+            }
+        }
+        lexer.fail(token, "unknown identifier " + std::string(token.text) + " in expression");
+    }
+
+    // --- Emission ------------------------------------------------------------
+
+    // Expands custom gates recursively; their bodies only call earlier definitions
+    void apply(const GateRef& gate, const double* parameters, const int* qubits) {
+        if (!gate.custom) {
+            emit(static_cast<Builtin>(gate.id), parameters, qubits);
+            return;
+        }
+        const CustomGate& definition = custom_gates[gate.id];
+        std::array<double, MAX_GATE_ARGUMENTS> values;
+        std::array<int, MAX_GATE_ARGUMENTS> mapped;
+        for (const BodyCall& call : definition.body) {
+            for (std::size_t k = 0; k < call.parameters.size(); ++k) {
+                values[k] = evaluate(call.parameters[k], parameters);
+            }
+            for (std::size_t k = 0; k < call.qubits.size(); ++k) {
+                mapped[k] = qubits[call.qubits[k]];
+            }
+            apply(call.gate, values.data(), mapped.data());
+        }
+    }
+
+    void u3(int target, double theta, double phi, double lambda, const std::vector<int>& controls = {}) {
+        circuit.addParameterizedGate("U3", target, {GateParameter{theta}, GateParameter{phi}, GateParameter{lambda}},
+                                     controls);
+    }
+
+    void phase(int target, double angle) {
+        circuit.addParameterizedGate("PHASE", target, {GateParameter{angle}});
+    }
+
+    void emit(Builtin id, const double* p, const int* q) {
+        switch (id) {
+            case Builtin::U:
+            case Builtin::U3:
+            case Builtin::UFull: u3(q[0], p[0], p[1], p[2]); break;
+            case Builtin::U2: u3(q[0], M_PI / 2, p[0], p[1]); break;
+            case Builtin::U1:
+            case Builtin::P: phase(q[0], p[0]); break;
+            case Builtin::U0:
+            case Builtin::Id: break;
+            case Builtin::X: circuit.addGate("X", q[0]); break;
+            case Builtin::Y: circuit.addGate("Y", q[0]); break;
+            case Builtin::Z: circuit.addGate("Z", q[0]); break;
+            case Builtin::H: circuit.addGate("H", q[0]); break;
+            case Builtin::S: phase(q[0], M_PI / 2); break;
+            case Builtin::Sdg: phase(q[0], -M_PI / 2); break;
+            case Builtin::T: phase(q[0], M_PI / 4); break;
+            case Builtin::Tdg: phase(q[0], -M_PI / 4); break;
+            case Builtin::SX: circuit.addControlledUnitary(SX_MATRIX, q[0], {}); break;
+            case Builtin::SXdg: circuit.addControlledUnitary(SXDG_MATRIX, q[0], {}); break;
+            case Builtin::RX: circuit.addParameterizedGate("RX", q[0], {GateParameter{p[0]}}); break;
+            case Builtin::RY: circuit.addParameterizedGate("RY", q[0], {GateParameter{p[0]}}); break;
+            case Builtin::RZ: circuit.addParameterizedGate("RZ", q[0], {GateParameter{p[0]}}); break;
+            case Builtin::CX: circuit.addGate("CNOT", q[1], q[0]); break;
+            case Builtin::CY: circuit.addControlledGate("Y", q[1], {q[0]}); break;
+            case Builtin::CZ: circuit.addControlledGate("Z", q[1], {q[0]}); break;
+            case Builtin::CH: circuit.addControlledGate("H", q[1], {q[0]}); break;
+            case Builtin::CRX: circuit.addParameterizedGate("RX", q[1], {GateParameter{p[0]}}, {q[0]}); break;
+            case Builtin::CRY: circuit.addParameterizedGate("RY", q[1], {GateParameter{p[0]}}, {q[0]}); break;
+            case Builtin::CRZ: circuit.addParameterizedGate("RZ", q[1], {GateParameter{p[0]}}, {q[0]}); break;
+            case Builtin::CU1:
+            case Builtin::CP: circuit.addControlledGate("PHASE", q[1], {q[0]}, {}, p[0]); break;
+            case Builtin::CU3: u3(q[1], p[0], p[1], p[2], {q[0]}); break;
+            case Builtin::CU:
+                // Controlled e^{i gamma} U3: the phase lands on the control
+                u3(q[1], p[0], p[1], p[2], {q[0]});
+                phase(q[0], p[3]);
+                break;
+            case Builtin::CSX: circuit.addControlledUnitary(SX_MATRIX, q[1], {q[0]}); break;
+            case Builtin::Swap: circuit.addGate("SWAP", q[0], q[1]); break;
+            case Builtin::CCX: circuit.addGate("TOFFOLI", q[2], q[0], q[1]); break;
+            case Builtin::CSwap:
+                circuit.addGate("CNOT", q[1], q[2]);
+                circuit.addGate("TOFFOLI", q[2], q[0], q[1]);
+                circuit.addGate("CNOT", q[1], q[2]);
+                break;
+            case Builtin::RZZ:
+                circuit.addGate("CNOT", q[1], q[0]);
+                circuit.addParameterizedGate("RZ", q[1], {GateParameter{p[0]}});
+                circuit.addGate("CNOT", q[1], q[0]);
+                break;
+            case Builtin::RXX:
+                circuit.addGate("H", q[0]);
+                circuit.addGate("H", q[1]);
+                emit(Builtin::RZZ, p, q);
+                circuit.addGate("H", q[0]);
+                circuit.addGate("H", q[1]);
+                break;
+            case Builtin::C3X: circuit.addControlledGate("X", q[3], {q[0], q[1], q[2]}); break;
+            case Builtin::C4X: circuit.addControlledGate("X", q[4], {q[0], q[1], q[2], q[3]}); break;
+        }
+    }
+};
+
+/// Unmaps a read-only file view on scope exit
+struct MappedFile {
+    void* data = nullptr;
+    std::size_t size = 0;
+    ~MappedFile() {
+        if (data != nullptr) {
+            ::munmap(data, size);
+        }
+    }
+};
+
+}  // namespace
+
+QasmProgram parseQasm(std::string_view source, CircuitManager& circuit, const std::string& sourceName) {
+    // About one gate per statement; the headroom absorbs moderate broadcast and custom-gate
+    // expansion, since one late reallocation would move the whole gate list
+    const std::size_t statements = static_cast<std::size_t>(std::count(source.begin(), source.end(), ';'));
+    circuit.reserveGates(circuit.getCircuitSize() + statements + statements / 4);
+    return Parser(source, circuit, sourceName).run();
+}
+
+QasmProgram parseQasmFile(const std::string& path, CircuitManager& circuit) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        const std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Cannot stat " + path + ": " + reason);
+    }
+    MappedFile file;
+    file.size = static_cast<std::size_t>(status.st_size);
+    if (file.size > 0) {
+        void* mapping = ::mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            const std::string reason = std::strerror(errno);
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path + ": " + reason);
+        }
+        file.data = mapping;
+        ::madvise(mapping, file.size, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+    return parseQasm(std::string_view(static_cast<const char*>(file.data), file.size), circuit, path);
+}
+
+std::vector<int> classicalBits(const QasmProgram& program, const CircuitManager& circuit) {
+    std::vector<int> bits(program.num_clbits, -1);
+    for (const auto& [gate, bit] : program.measurements) {
+        bits[bit] = circuit.getGate(gate).measurement_result;
+    }
+    return bits;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "circuit_manager.h"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @file qasm_parser.h
+ * @brief Streaming OpenQASM 2.0 front end
+ *
+ * The parser tokenizes straight from the source buffer (a memory-mapped
+ * file for parseQasmFile) and emits each statement into a CircuitManager as
+ * soon as it is read; no syntax tree of the program is built. Only custom
+ * `gate` bodies are kept, compiled to gate calls with postfix angle
+ * expressions, and expanded at every use.
+ *
+ * Supported: OPENQASM 2.0 header, include "qelib1.inc", qreg / creg,
+ * U and CX, the qelib1 gates (u3 u2 u1 u0 u p id x y z h s sdg t tdg sx
+ * sxdg rx ry rz cx cy cz ch crx cry crz cu1 cp cu3 cu csx swap ccx cswap
+ * rxx rzz c3x c4x), custom gate definitions, register broadcasting,
+ * measure and barrier. Angle expressions accept pi, + - * / ^, unary minus
+ * and sin cos tan exp ln sqrt. Gates match their qelib1.inc definitions up
+ * to global phase (cu3 and cu are exact controlled-U3, as in Qiskit's
+ * copy). reset, if and opaque are rejected, since CircuitManager has no
+ * equivalent.
+ *
+ * Qubit k of the program is simulator qubit k, counting registers in
+ * declaration order; measurement outcomes stay on the MEASURE gates and
+ * QasmProgram::measurements maps them to classical bits.
+ */
+
+/**
+ * @class QasmError
+ * @brief Syntax or semantic error with its source position
+ *
+ * what() reads "source:line:column: message".
+ */
+class QasmError : public std::runtime_error {
+public:
+    QasmError(const std::string& source, int line, int column, const std::string& message);
+
+    /// 1-based line of the offending token
+    int line() const { return error_line; }
+
+    /// 1-based column of the offending token
+    int column() const { return error_column; }
+
+private:
+    int error_line;
+    int error_column;
+};
+
+/**
+ * @struct QasmRegister
+ * @brief One qreg or creg declaration
+ */
+struct QasmRegister {
+    /// Register name
+    std::string name;
+
+    /// Global index of element 0 (qubit or classical bit)
+    int offset = 0;
+
+    /// Number of elements
+    int size = 0;
+};
+
+/**
+ * @struct QasmProgram
+ * @brief Register layout and measurement map of a parsed program
+ */
+struct QasmProgram {
+    /// Total qubits over all qregs (the register width to simulate)
+    int num_qubits = 0;
+
+    /// Total classical bits over all cregs
+    int num_clbits = 0;
+
+    /// Quantum registers in declaration order
+    std::vector<QasmRegister> qregs;
+
+    /// Classical registers in declaration order
+    std::vector<QasmRegister> cregs;
+
+    /// (circuit gate index of a MEASURE, classical bit it writes)
+    std::vector<std::pair<int, int>> measurements;
+
+    /// Number of gates appended to the circuit
+    std::size_t gates_emitted = 0;
+};
+
+/**
+ * @brief Parses OpenQASM 2.0 source and appends its gates to a circuit
+ * @param source Program text
+ * @param circuit Circuit to append to (existing gates are kept)
+ * @param sourceName Name used in error messages
+ * @return Register layout and measurement map
+ * @throws QasmError on the first syntax or semantic error; gates emitted
+ *         before it stay in the circuit
+ */
+QasmProgram parseQasm(std::string_view source, CircuitManager& circuit,
+                      const std::string& sourceName = "<string>");
+
+/**
+ * @brief Memory-maps a file and parses it with parseQasm
+ * @param path OpenQASM 2.0 file
+ * @param circuit Circuit to append to
+ * @return Register layout and measurement map
+ * @throws std::runtime_error if the file cannot be opened or mapped
+ * @throws QasmError on parse errors (reported against path)
+ */
+QasmProgram parseQasmFile(const std::string& path, CircuitManager& circuit);
+
+/**
+ * @brief Collects measured values into classical bits after execution
+ * @param program Result of parseQasm for this circuit
+ * @param circuit Executed circuit
+ * @return One entry per classical bit: 0, 1, or -1 if never measured
+ *         (later measurements of a bit overwrite earlier ones)
+ */
+std::vector<int> classicalBits(const QasmProgram& program, const CircuitManager& circuit);
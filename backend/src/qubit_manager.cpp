@@ -1,68 +1,243 @@
 #include "qubit_manager.h"
+#include "utils.h"
+#include "thread_pool.h"
 #include <iostream>
-#include <bitset>
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
 
 // Constructor: Initializes quantum state to |00...0⟩
-QubitManager::QubitManager(int numQubits) : num_qubits(numQubits) {
+template <typename Real>
+BasicQubitManager<Real>::BasicQubitManager(int numQubits)
+    : state(nullptr, 0), num_qubits(numQubits), dimension(0) {
     if (numQubits < 1 || numQubits > MAX_QUBITS) {
-        throw std::invalid_argument("Number of qubits must be between 1 and " + 
+        throw std::invalid_argument("Number of qubits must be between 1 and " +
                                     std::to_string(MAX_QUBITS));
     }
-    int dimension = 1 << numQubits;  // 2^numQubits
-    state = Eigen::VectorXcd(dimension);
+
+    // Reject registers that cannot fit before touching the allocator
+    checkMemoryAvailable(numQubits);
+
+    dimension = std::uint64_t{1} << numQubits;  // 2^numQubits
+    allocateBuffer();
     initializeZeroState();
 }
 
+// File-backed constructor: maps a sparse file, so untouched amplitudes read as zero
+template <typename Real>
+BasicQubitManager<Real>::BasicQubitManager(int numQubits, const std::string& backingFile)
+    : state(nullptr, 0), num_qubits(numQubits), dimension(0) {
+    if (numQubits < 1 || numQubits > MAX_QUBITS) {
+        throw std::invalid_argument("Number of qubits must be between 1 and " +
+                                    std::to_string(MAX_QUBITS));
+    }
+    const std::uint64_t bytes = estimateMemoryBytes(numQubits);
+
+    int fd = ::open(backingFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create state file " + backingFile + ": " + std::strerror(errno));
+    }
+    struct statvfs fs;
+    if (::fstatvfs(fd, &fs) == 0 && bytes > static_cast<std::uint64_t>(fs.f_bavail) * fs.f_frsize) {
+        ::close(fd);
+        ::unlink(backingFile.c_str());
+        throw std::runtime_error("State vector for " + std::to_string(numQubits) + " qubits needs " +
+                                 std::to_string(bytes) + " bytes but " + backingFile + " has only " +
+                                 std::to_string(static_cast<std::uint64_t>(fs.f_bavail) * fs.f_frsize) +
+                                 " bytes free");
+    }
+    void* mapping = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+        mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, fd, 0);
+    }
+    const int error = errno;
+    ::close(fd);
+    ::unlink(backingFile.c_str());
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map " + std::to_string(bytes) + " bytes of " + backingFile +
+                                 ": " + std::strerror(error));
+    }
+
+    // Advice only: kernels sweep in index order, and huge pages cut TLB misses where supported
+    ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    ::madvise(mapping, bytes, MADV_HUGEPAGE);
+#endif
+
+    dimension = std::uint64_t{1} << numQubits;
+    buffer = std::unique_ptr<Amplitude[], BufferDeleter>(static_cast<Amplitude*>(mapping),
+                                                         BufferDeleter{mapping, bytes});
+    new (&state) StateVector(buffer.get(), static_cast<Eigen::Index>(dimension));
+    state(0) = Amplitude(1, 0);  // The rest of the fresh file is already zero
+}
+
+template <typename Real>
+BasicQubitManager<Real>::BasicQubitManager(int numQubits, std::unique_ptr<Amplitude[], BufferDeleter> storage)
+    : buffer(std::move(storage)), state(nullptr, 0), num_qubits(numQubits),
+      dimension(std::uint64_t{1} << numQubits) {
+    new (&state) StateVector(buffer.get(), static_cast<Eigen::Index>(dimension));
+}
+
+// Takes ownership first, so the region is released even when validation fails
+template <typename Real>
+BasicQubitManager<Real> BasicQubitManager<Real>::adoptMapping(int numQubits, void* mapping,
+                                                              std::size_t mappingBytes, std::size_t offset) {
+    std::unique_ptr<Amplitude[], BufferDeleter> storage(
+        reinterpret_cast<Amplitude*>(static_cast<char*>(mapping) + offset),
+        BufferDeleter{mapping, mappingBytes});
+    if (numQubits < 1 || numQubits > MAX_QUBITS) {
+        throw std::invalid_argument("Number of qubits must be between 1 and " +
+                                    std::to_string(MAX_QUBITS));
+    }
+    if (offset % STATE_ALIGNMENT != 0 || offset > mappingBytes ||
+        mappingBytes - offset < estimateMemoryBytes(numQubits)) {
+        throw std::invalid_argument("Mapping of " + std::to_string(mappingBytes) + " bytes at offset " +
+                                    std::to_string(offset) + " cannot hold an aligned " +
+                                    std::to_string(numQubits) + "-qubit state");
+    }
+    return BasicQubitManager(numQubits, std::move(storage));
+}
+
+template <typename Real>
+void BasicQubitManager<Real>::BufferDeleter::operator()(Amplitude* ptr) const {
+    if (mapping != nullptr) {
+        ::munmap(mapping, mapping_bytes);
+    } else {
+        std::free(ptr);
+    }
+}
+
+// Copy constructor: allocates a fresh aligned buffer and copies amplitudes.
+// Heap sources already passed the memory check; file-backed ones may exceed RAM.
+template <typename Real>
+BasicQubitManager<Real>::BasicQubitManager(const BasicQubitManager& other)
+    : state(nullptr, 0), num_qubits(other.num_qubits), dimension(other.dimension) {
+    if (other.buffer.get_deleter().mapping != nullptr) {
+        checkMemoryAvailable(num_qubits);
+    }
+    allocateBuffer();
+    std::memcpy(buffer.get(), other.buffer.get(), dimension * sizeof(Amplitude));
+}
+
+template <typename Real>
+BasicQubitManager<Real>& BasicQubitManager<Real>::operator=(const BasicQubitManager& other) {
+    if (this != &other) {
+        BasicQubitManager copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Move constructor: steals the buffer and re-seats the Eigen map
+template <typename Real>
+BasicQubitManager<Real>::BasicQubitManager(BasicQubitManager&& other) noexcept
+    : buffer(std::move(other.buffer)), state(nullptr, 0),
+      num_qubits(other.num_qubits), dimension(other.dimension) {
+    new (&state) StateVector(buffer.get(), static_cast<Eigen::Index>(dimension));
+    new (&other.state) StateVector(nullptr, 0);
+    other.dimension = 0;
+}
+
+template <typename Real>
+BasicQubitManager<Real>& BasicQubitManager<Real>::operator=(BasicQubitManager&& other) noexcept {
+    if (this != &other) {
+        buffer = std::move(other.buffer);
+        num_qubits = other.num_qubits;
+        dimension = other.dimension;
+        new (&state) StateVector(buffer.get(), static_cast<Eigen::Index>(dimension));
+        new (&other.state) StateVector(nullptr, 0);
+        other.dimension = 0;
+    }
+    return *this;
+}
+
+template <typename Real>
+void BasicQubitManager<Real>::checkMemoryAvailable(int numQubits) {
+    std::uint64_t required = estimateMemoryBytes(numQubits);
+    std::uint64_t available = availableMemoryBytes();
+    if (required > available) {
+        throw std::runtime_error("State vector for " + std::to_string(numQubits) +
+                                 " qubits needs " + std::to_string(required) +
+                                 " bytes but only " + std::to_string(available) +
+                                 " bytes are available");
+    }
+}
+
+// Allocates `dimension` amplitudes aligned to STATE_ALIGNMENT and maps them
+template <typename Real>
+void BasicQubitManager<Real>::allocateBuffer() {
+    std::uint64_t bytes = dimension * sizeof(Amplitude);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    std::uint64_t padded = (bytes + STATE_ALIGNMENT - 1) / STATE_ALIGNMENT * STATE_ALIGNMENT;
+    void* raw = std::aligned_alloc(STATE_ALIGNMENT, padded);
+    if (raw == nullptr) {
+        throw std::runtime_error("Failed to allocate " + std::to_string(padded) +
+                                 " bytes for " + std::to_string(num_qubits) + "-qubit state");
+    }
+    buffer = std::unique_ptr<Amplitude[], BufferDeleter>(static_cast<Amplitude*>(raw));
+    new (&state) StateVector(buffer.get(), static_cast<Eigen::Index>(dimension));
+}
+
+// Returns bytes required by a dense state vector of numQubits qubits
+template <typename Real>
+std::uint64_t BasicQubitManager<Real>::estimateMemoryBytes(int numQubits) {
+    return (std::uint64_t{1} << numQubits) * sizeof(Amplitude);
+}
+
 // Initializes state to |00...0⟩ (ground state)
-void QubitManager::initializeZeroState() {
-    state = Eigen::VectorXcd::Zero(1 << num_qubits);
-    state(0) = std::complex<double>(1.0, 0.0);  // Set amplitude at |0...0⟩ to 1
+template <typename Real>
+void BasicQubitManager<Real>::initializeZeroState() {
+    // Zero in parallel so large buffers are first-touched by the threads that sweep them
+    Amplitude* data = buffer.get();
+    ThreadPool::global().parallelFor(0, dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        std::fill(data + begin, data + end, Amplitude(0, 0));
+    });
+    state(0) = Amplitude(1, 0);  // Set amplitude at |0...0⟩ to 1
 }
 
 // Returns a reference to the quantum state vector
-Eigen::VectorXcd& QubitManager::getState() {
+template <typename Real>
+typename BasicQubitManager<Real>::StateVector& BasicQubitManager<Real>::getState() {
     return state;
 }
 
 // Returns a read-only reference to the quantum state vector
-const Eigen::VectorXcd& QubitManager::getState() const {
+template <typename Real>
+const typename BasicQubitManager<Real>::StateVector& BasicQubitManager<Real>::getState() const {
     return state;
 }
 
 // Returns the number of qubits
-int QubitManager::getNumQubits() const {
+template <typename Real>
+int BasicQubitManager<Real>::getNumQubits() const {
     return num_qubits;
 }
 
 // Prints quantum state amplitudes above threshold
-void QubitManager::printState() const {
-    for (int i = 0; i < state.size(); ++i) {
+template <typename Real>
+void BasicQubitManager<Real>::printState() const {
+    for (std::uint64_t i = 0; i < dimension; ++i) {
         // Only display amplitudes above threshold to avoid numerical noise
         if (std::abs(state(i)) > AMPLITUDE_THRESHOLD) {
-            std::cout << "| " << std::bitset<5>(i) << " ⟩ : " << state(i) << std::endl;
+            std::cout << "| " << formatBasisState(i, num_qubits) << " ⟩ : " << state(i) << std::endl;
         }
     }
 }
 
 // Sets quantum state from binary string (e.g., "00101")
-void QubitManager::setInitialState(const std::string& stateString) {
-    if (static_cast<int>(stateString.length()) != num_qubits) {
-        throw std::invalid_argument("Initial state length (" + std::to_string(stateString.length()) +
-                                    ") must match qubit count (" + std::to_string(num_qubits) + ")");
-    }
-
-    try {
-        // Convert binary string to decimal index
-        int index = std::stoi(stateString, nullptr, 2);
-        if (index >= (1 << num_qubits)) {
-            throw std::out_of_range("State index exceeds valid range for " +
-                                    std::to_string(num_qubits) + " qubits");
-        }
-        state.setZero();
-        state(index) = std::complex<double>(1.0, 0.0);
-    } catch (const std::exception& e) {
-        throw std::invalid_argument("Failed to parse initial state: " + std::string(e.what()));
-    }
+template <typename Real>
+void BasicQubitManager<Real>::setInitialState(const std::string& stateString) {
+    std::uint64_t index = parseBasisState(stateString, num_qubits);
+    state.setZero();
+    state(index) = Amplitude(1, 0);
 }
+
+template class BasicQubitManager<double>;
+template class BasicQubitManager<float>;
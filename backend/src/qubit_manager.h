@@ -2,31 +2,99 @@
 
 #include <Eigen/Dense>
 #include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
 #include <string>
 
 /**
- * @class QubitManager
+ * @class BasicQubitManager
  * @brief Manages quantum state vectors and qubit operations
- * 
- * Handles initialization, storage, and retrieval of quantum states
- * using Eigen's complex vector representation. Supports states up to 5 qubits.
- * 
+ * @tparam Real Amplitude component type: double (QubitManager) or float (QubitManagerF)
+ *
+ * Handles initialization, storage, and retrieval of quantum states.
+ * Amplitudes live in a 64-byte aligned buffer of 2^n complex values owned
+ * by the manager and are exposed through an Eigen map, so the register size
+ * is bounded only by available memory (checked up front at construction).
+ *
+ * A register may instead live in a memory-mapped file (see the
+ * backingFile constructor), so it can exceed physical memory; the page
+ * cache then holds the part currently being swept.
+ *
+ * Single precision halves the memory and bandwidth of every sweep, so a
+ * register one qubit wider fits, at the cost of ~1e-7 relative rounding
+ * per gate (see docs/API_REFERENCE.md for measured drift).
+ *
  * @note Thread-safe for read operations; not thread-safe for state modifications
  */
-class QubitManager {
+template <typename Real>
+class BasicQubitManager {
 public:
-    /// Maximum supported qubits
-    static constexpr int MAX_QUBITS = 5;
-    
-    /// Maximum state dimension (2^MAX_QUBITS)
-    static constexpr int MAX_STATE_DIMENSION = 32;
+    /// Complex amplitude type
+    using Amplitude = std::complex<Real>;
+
+    /// Eigen view over the aligned amplitude buffer
+    using StateVector = Eigen::Map<Eigen::Matrix<Amplitude, Eigen::Dynamic, 1>, Eigen::Aligned64>;
+
+    /// Maximum supported qubits (bounded by 64-bit indexing, not by RAM)
+    static constexpr int MAX_QUBITS = 48;
+
+    /// Alignment of the amplitude buffer in bytes (one cache line / AVX-512 register)
+    static constexpr std::size_t STATE_ALIGNMENT = 64;
 
     /**
      * @brief Constructs QubitManager with specified number of qubits
-     * @param numQubits Number of qubits (1-5)
+     * @param numQubits Number of qubits (1-MAX_QUBITS)
+     * @throws std::invalid_argument if numQubits out of valid range
+     * @throws std::runtime_error if the state vector does not fit in available memory
+     */
+    explicit BasicQubitManager(int numQubits);
+
+    /**
+     * @brief Constructs a register whose amplitudes live in a memory-mapped file
+     * @param numQubits Number of qubits (1-MAX_QUBITS)
+     * @param backingFile Path of a new file, created (or truncated) to 2^n amplitudes
      * @throws std::invalid_argument if numQubits out of valid range
+     * @throws std::runtime_error if the file cannot be created, sized or mapped,
+     *         or its file system lacks the space
+     *
+     * Only disk space bounds the register, so it may be larger than RAM.
+     * The mapping is shared, so the kernel writes dirty pages back to the
+     * file instead of needing swap. It is advised for sequential access and
+     * for transparent huge pages where the file system supports them. The
+     * file is unlinked once mapped, and its space is returned when the
+     * register is destroyed, even after a crash. Copies are held in memory.
+     * CircuitManager::executeCircuit runs such registers chunk by chunk.
+     */
+    BasicQubitManager(int numQubits, const std::string& backingFile);
+
+    /**
+     * @brief Adopts an existing memory mapping as the amplitude buffer
+     * @param numQubits Number of qubits (1-MAX_QUBITS)
+     * @param mapping Start of a region returned by mmap, owned from now on
+     * @param mappingBytes Length of the region
+     * @param offset Byte offset of amplitude 0, a multiple of STATE_ALIGNMENT
+     * @return Register viewing the mapped amplitudes in place (isFileBacked() is true)
+     * @throws std::invalid_argument if numQubits, offset or the region size do not fit
+     *
+     * Used by loadCheckpoint to run a checkpoint file without copying it.
+     * The region is unmapped when the register is destroyed, including on
+     * the throwing paths.
      */
-    explicit QubitManager(int numQubits);
+    static BasicQubitManager adoptMapping(int numQubits, void* mapping, std::size_t mappingBytes,
+                                          std::size_t offset);
+
+    /**
+     * @brief Deep-copies the amplitude buffer into heap memory
+     * @throws std::runtime_error if other is file-backed and its state does
+     *         not fit in available memory
+     */
+    BasicQubitManager(const BasicQubitManager& other);
+    BasicQubitManager& operator=(const BasicQubitManager& other);
+
+    /// Transfers ownership of the amplitude buffer
+    BasicQubitManager(BasicQubitManager&& other) noexcept;
+    BasicQubitManager& operator=(BasicQubitManager&& other) noexcept;
 
     /**
      * @brief Initializes quantum state to |00...0⟩ (ground state)
@@ -37,23 +105,35 @@ public:
      * @brief Returns mutable reference to quantum state vector
      * @return Reference to state vector with complex amplitudes
      */
-    Eigen::VectorXcd& getState();
+    StateVector& getState();
 
     /**
      * @brief Returns immutable reference to quantum state vector
      * @return Const reference to state vector
      */
-    const Eigen::VectorXcd& getState() const;
+    const StateVector& getState() const;
 
     /**
      * @brief Gets number of qubits in this manager
-     * @return Number of qubits (1-5)
+     * @return Number of qubits (1-MAX_QUBITS)
      */
     int getNumQubits() const;
 
+    /**
+     * @brief Gets number of amplitudes in the state vector
+     * @return 2^num_qubits
+     */
+    std::uint64_t getDimension() const { return dimension; }
+
+    /**
+     * @brief Checks whether the amplitudes live in a memory-mapped file
+     * @return True for registers built with a backing file
+     */
+    bool isFileBacked() const { return buffer.get_deleter().mapping != nullptr; }
+
     /**
      * @brief Prints all non-zero amplitudes to stdout
-     * 
+     *
      * Format: | binary_state ⟩ : amplitude
      * Only amplitudes with magnitude > 1e-10 are displayed
      */
@@ -64,18 +144,65 @@ public:
      * @param stateString Binary string (e.g., "00101")
      * @throws std::invalid_argument if string length != num_qubits
      * @throws std::invalid_argument if string contains non-binary characters
-     * 
+     *
      * Example: setInitialState("101") creates state |101⟩
      */
     void setInitialState(const std::string& stateString);
 
+    /**
+     * @brief Estimates bytes needed for an n-qubit state vector
+     * @param numQubits Number of qubits
+     * @return 2^numQubits * sizeof(Amplitude)
+     */
+    static std::uint64_t estimateMemoryBytes(int numQubits);
+
 private:
-    /// Quantum state vector with complex amplitudes
-    Eigen::VectorXcd state;
-    
-    /// Number of qubits managed (1-5)
+    /// Releases buffers from std::aligned_alloc, or unmaps file-backed ones
+    struct BufferDeleter {
+        /// Start and length of the file mapping (nullptr for heap buffers)
+        void* mapping = nullptr;
+        std::size_t mapping_bytes = 0;
+
+        void operator()(Amplitude* ptr) const;
+    };
+
+    /// Views `buffer`, which is already sized and filled
+    BasicQubitManager(int numQubits, std::unique_ptr<Amplitude[], BufferDeleter> storage);
+
+    /// Owned, STATE_ALIGNMENT-aligned amplitude storage
+    std::unique_ptr<Amplitude[], BufferDeleter> buffer;
+
+    /// Quantum state vector viewing `buffer`
+    StateVector state;
+
+    /// Number of qubits managed (1-MAX_QUBITS)
     int num_qubits;
-    
+
+    /// Number of amplitudes (2^num_qubits)
+    std::uint64_t dimension;
+
     /// Amplitude threshold for display (1e-10)
     static constexpr double AMPLITUDE_THRESHOLD = 1e-10;
+
+    /**
+     * @brief Rejects a heap register that would not fit in available memory
+     * @param numQubits Register width
+     * @throws std::runtime_error if estimateMemoryBytes exceeds availableMemoryBytes
+     */
+    static void checkMemoryAvailable(int numQubits);
+
+    /**
+     * @brief Allocates an aligned, uninitialized buffer of `dimension` amplitudes
+     * @throws std::runtime_error if the allocation fails
+     */
+    void allocateBuffer();
 };
+
+/// Double-precision register (the default throughout the simulator)
+using QubitManager = BasicQubitManager<double>;
+
+/// Single-precision register: half the memory, ~1e-7 relative rounding per gate
+using QubitManagerF = BasicQubitManager<float>;
+
+extern template class BasicQubitManager<double>;
+extern template class BasicQubitManager<float>;
@@ -0,0 +1,126 @@
+#include "sampler.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+
+namespace {
+
+// Single pass of the sorted uniforms against the running cumulative weight
+template <typename Weight>
+OutcomeCounts sortedSample(const Weight& weight, std::uint64_t count, double total,
+                           std::uint64_t shots, std::mt19937_64& rng) {
+    OutcomeCounts counts;
+    if (shots == 0 || count == 0) {
+        return counts;
+    }
+
+    std::vector<double> uniforms = sortedUniforms(shots, total, rng);
+    double cumulative = 0.0;
+    std::uint64_t next = 0;
+    std::uint64_t last_nonzero = 0;
+    for (std::uint64_t i = 0; i < count && next < shots; ++i) {
+        double w = weight(i);
+        if (w <= 0.0) {
+            continue;
+        }
+        last_nonzero = i;
+        cumulative += w;
+        std::uint64_t first = next;
+        while (next < shots && uniforms[next] < cumulative) {
+            ++next;
+        }
+        if (next > first) {
+            counts.emplace_back(i, next - first);
+        }
+    }
+
+    // Rounding in the cumulative sum can leave the largest draws unassigned
+    if (next < shots) {
+        if (!counts.empty() && counts.back().first == last_nonzero) {
+            counts.back().second += shots - next;
+        } else {
+            counts.emplace_back(last_nonzero, shots - next);
+        }
+    }
+    return counts;
+}
+
+// |amplitude|^2 in double, matching kernels::sumSquaredMagnitudes for float states
+template <typename Real>
+inline double probability(const std::complex<Real>& amplitude) {
+    const double re = amplitude.real(), im = amplitude.imag();
+    return re * re + im * im;
+}
+
+template <typename Real>
+OutcomeCounts sampleFromAmplitudesImpl(const std::complex<Real>* state, std::uint64_t dimension,
+                                       std::uint64_t shots, std::mt19937_64& rng) {
+    double total = ThreadPool::global().parallelSum(0, dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        return kernels::sumSquaredMagnitudes(state, begin, end);
+    });
+    return sortedSample([state](std::uint64_t i) { return probability(state[i]); },
+                        dimension, total, shots, rng);
+}
+
+template <typename Real>
+std::vector<double> marginalProbabilitiesImpl(const std::complex<Real>* state, int numQubits,
+                                              const std::vector<int>& qubits) {
+    std::vector<double> probabilities(std::size_t{1} << qubits.size(), 0.0);
+    const std::uint64_t dimension = std::uint64_t{1} << numQubits;
+    for (std::uint64_t i = 0; i < dimension; ++i) {
+        std::uint64_t outcome = 0;
+        for (std::size_t b = 0; b < qubits.size(); ++b) {
+            outcome |= ((i >> qubits[b]) & 1) << b;
+        }
+        probabilities[outcome] += probability(state[i]);
+    }
+    return probabilities;
+}
+
+}  // namespace
+
+// Normalized partial sums of N+1 exponentials are the order statistics of N uniforms
+std::vector<double> sortedUniforms(std::uint64_t shots, double scale, std::mt19937_64& rng) {
+    std::exponential_distribution<double> spacing(1.0);
+    std::vector<double> uniforms(shots);
+    double sum = 0.0;
+    for (std::uint64_t k = 0; k < shots; ++k) {
+        sum += spacing(rng);
+        uniforms[k] = sum;
+    }
+    sum += spacing(rng);
+    const double factor = scale / sum;
+    for (double& u : uniforms) {
+        u *= factor;
+    }
+    return uniforms;
+}
+
+OutcomeCounts sampleFromAmplitudes(const std::complex<double>* state, std::uint64_t dimension,
+                                   std::uint64_t shots, std::mt19937_64& rng) {
+    return sampleFromAmplitudesImpl(state, dimension, shots, rng);
+}
+
+OutcomeCounts sampleFromAmplitudes(const std::complex<float>* state, std::uint64_t dimension,
+                                   std::uint64_t shots, std::mt19937_64& rng) {
+    return sampleFromAmplitudesImpl(state, dimension, shots, rng);
+}
+
+OutcomeCounts sampleFromProbabilities(const std::vector<double>& probabilities,
+                                      std::uint64_t shots, std::mt19937_64& rng) {
+    double total = 0.0;
+    for (double p : probabilities) {
+        total += p;
+    }
+    return sortedSample([&probabilities](std::uint64_t i) { return probabilities[i]; },
+                        probabilities.size(), total, shots, rng);
+}
+
+std::vector<double> marginalProbabilities(const std::complex<double>* state, int numQubits,
+                                          const std::vector<int>& qubits) {
+    return marginalProbabilitiesImpl(state, numQubits, qubits);
+}
+
+std::vector<double> marginalProbabilities(const std::complex<float>* state, int numQubits,
+                                          const std::vector<int>& qubits) {
+    return marginalProbabilitiesImpl(state, numQubits, qubits);
+}
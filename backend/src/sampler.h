@@ -0,0 +1,74 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file sampler.h
+ * @brief Draws measurement shots from a final state distribution
+ *
+ * Shots are drawn without re-simulating: N sorted uniforms are generated in
+ * O(N) (normalized exponential spacings, no sort needed) and matched against
+ * the running cumulative probability in a single pass. Sampling the whole
+ * register walks the amplitudes directly, so no 2^n probability table is
+ * allocated; sampling a subset of qubits first builds the 2^m marginal.
+ */
+
+/// Bitstring -> number of shots (leftmost character is the highest measured qubit)
+using Histogram = std::map<std::string, std::uint64_t>;
+
+/// (outcome index, shot count) pairs in ascending outcome order
+using OutcomeCounts = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+
+/**
+ * @brief Generates shots uniform samples in [0, scale), already sorted
+ * @param shots Number of samples
+ * @param scale Upper bound of the interval
+ * @param rng Random engine
+ * @return Ascending samples
+ */
+std::vector<double> sortedUniforms(std::uint64_t shots, double scale, std::mt19937_64& rng);
+
+/**
+ * @brief Samples basis states with probability |amplitude|^2
+ * @param state Amplitude array
+ * @param dimension Number of amplitudes
+ * @param shots Number of shots
+ * @param rng Random engine
+ * @return Counts per observed basis index (norm need not be exactly 1)
+ */
+OutcomeCounts sampleFromAmplitudes(const std::complex<double>* state, std::uint64_t dimension,
+                                   std::uint64_t shots, std::mt19937_64& rng);
+
+/// Single-precision overload; probabilities are accumulated in double
+OutcomeCounts sampleFromAmplitudes(const std::complex<float>* state, std::uint64_t dimension,
+                                   std::uint64_t shots, std::mt19937_64& rng);
+
+/**
+ * @brief Samples outcomes from a (possibly unnormalized) probability table
+ * @param probabilities Non-negative weight per outcome
+ * @param shots Number of shots
+ * @param rng Random engine
+ * @return Counts per observed outcome
+ */
+OutcomeCounts sampleFromProbabilities(const std::vector<double>& probabilities,
+                                      std::uint64_t shots, std::mt19937_64& rng);
+
+/**
+ * @brief Computes the marginal distribution of a subset of qubits
+ * @param state Amplitude array of dimension 2^numQubits
+ * @param numQubits Register width
+ * @param qubits Measured qubits in ascending order; outcome bit b is qubits[b]
+ * @return 2^qubits.size() probabilities
+ */
+std::vector<double> marginalProbabilities(const std::complex<double>* state, int numQubits,
+                                          const std::vector<int>& qubits);
+
+/// Single-precision overload; probabilities are accumulated in double
+std::vector<double> marginalProbabilities(const std::complex<float>* state, int numQubits,
+                                          const std::vector<int>& qubits);
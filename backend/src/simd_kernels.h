@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstdint>
+
+/**
+ * @file simd_kernels.h
+ * @brief Vectorized state-vector kernels with runtime CPU dispatch
+ *
+ * Kernels operate on raw amplitude pointers so any storage (QubitManager
+ * buffers, temporary copies) can be passed in. Each entry point forwards to
+ * the widest implementation the CPU supports (AVX-512, AVX2+FMA or scalar),
+ * selected once at startup via CPUID.
+ *
+ * Single-qubit kernels iterate over amplitude *pairs* rather than basis
+ * states: pair k expands to indices (i0, i0 | 1<<t) where i0 is k with a
+ * zero bit inserted at position t. Ranges are expressed in pair indices so
+ * callers can split [0, 2^(n-1)) into independent chunks.
+ *
+ * Every kernel also has a std::complex<float> overload with the same
+ * contract. Matrices and scale factors stay double and are rounded to float
+ * once per call; reductions accumulate in double. A register holds twice as
+ * many float amplitudes, so the float kernels move half the bytes.
+ */
+namespace kernels {
+
+/// 2x2 complex matrix in row-major order: {m00, m01, m10, m11}
+using Matrix2 = std::array<std::complex<double>, 4>;
+
+/// Single-precision 2x2 matrix, narrowed from Matrix2 inside the float kernels
+using Matrix2f = std::array<std::complex<float>, 4>;
+
+/// Instruction set used by the dispatched kernels
+enum class SimdLevel {
+    Scalar = 0,  ///< Portable C++ loops
+    AVX2 = 1,    ///< 256-bit AVX2 + FMA (2 amplitudes per register)
+    AVX512 = 2   ///< 512-bit AVX-512F (4 amplitudes per register)
+};
+
+/**
+ * @brief Detects the widest instruction set supported by this CPU
+ * @return Highest usable SimdLevel
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Gets the instruction set currently used by dispatched kernels
+ * @return Active SimdLevel (defaults to detectSimdLevel())
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Overrides kernel dispatch (for testing and benchmarking)
+ * @param level Requested level; clamped to detectSimdLevel()
+ */
+void setSimdLevel(SimdLevel level);
+
+/**
+ * @brief Gets the instruction set applyMatrix2 dispatches to
+ * @param singlePrecision true for the std::complex<float> overload
+ * @return Level of the implementation that runs at the current setting
+ */
+SimdLevel matrix2Level(bool singlePrecision);
+
+/**
+ * @brief Gets the instruction set applyDenseMatrix dispatches to
+ * @param singlePrecision true for the std::complex<float> overload
+ * @param numPositions Qubits the matrix acts on, in [1, MAX_DENSE_QUBITS]
+ * @return Level of the implementation that runs at the current setting
+ */
+SimdLevel denseMatrixLevel(bool singlePrecision, int numPositions);
+
+/**
+ * @brief Gets a printable name for an instruction set level
+ * @param level SimdLevel to describe
+ * @return "scalar", "avx2" or "avx512"
+ */
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief Expands a pair index into the lower basis index of the pair
+ * @param pair Pair index in [0, 2^(n-1))
+ * @param targetQubit Qubit whose bit is inserted as zero
+ * @return Basis index with bit targetQubit cleared
+ */
+inline std::uint64_t insertZeroBit(std::uint64_t pair, int targetQubit) {
+    std::uint64_t low_mask = (std::uint64_t{1} << targetQubit) - 1;
+    return ((pair & ~low_mask) << 1) | (pair & low_mask);
+}
+
+/**
+ * @brief Expands k into the k-th index whose fixedMask bits are all zero
+ * @param k Enumeration index
+ * @param fixedMask Bits that must stay clear
+ * @return k's bits deposited, in order, into the free (unmasked) positions
+ */
+inline std::uint64_t depositFreeBits(std::uint64_t k, std::uint64_t fixedMask) {
+    std::uint64_t result = 0;
+    for (std::uint64_t bit = 1; k != 0; bit <<= 1) {
+        if (!(fixedMask & bit)) {
+            result |= (k & 1) ? bit : 0;
+            k >>= 1;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Applies a 2x2 unitary to targetQubit for pairs [pairBegin, pairEnd)
+ * @param state Amplitude array of dimension 2^n
+ * @param targetQubit Target qubit index (0-based)
+ * @param matrix Row-major gate matrix
+ * @param pairBegin First pair index (inclusive)
+ * @param pairEnd Last pair index (exclusive), at most 2^(n-1)
+ *
+ * For each pair: (a0, a1) <- (m00*a0 + m01*a1, m10*a0 + m11*a1).
+ */
+void applyMatrix2(std::complex<double>* state, int targetQubit, const Matrix2& matrix,
+                  std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+/**
+ * @brief Sums |amplitude|^2 over [begin, end)
+ * @param state Amplitude array
+ * @param begin First basis index (inclusive)
+ * @param end Last basis index (exclusive)
+ * @return Partial squared norm
+ */
+double sumSquaredMagnitudes(const std::complex<double>* state, std::uint64_t begin, std::uint64_t end);
+
+/**
+ * @brief Multiplies amplitudes in [begin, end) by a real factor
+ * @param state Amplitude array (modified in-place)
+ * @param factor Scale factor
+ * @param begin First basis index (inclusive)
+ * @param end Last basis index (exclusive)
+ */
+void scaleAmplitudes(std::complex<double>* state, double factor, std::uint64_t begin, std::uint64_t end);
+
+/**
+ * @brief Swaps amplitude pairs selected by fixed qubit positions
+ * @param state Amplitude array of dimension 2^n
+ * @param positions Qubits fixed by the gate, in ascending order
+ * @param numPositions Number of entries in positions
+ * @param maskA Bits set on the first member of each pair
+ * @param maskB Bits set on the second member of each pair
+ * @param begin First enumeration index (inclusive)
+ * @param end Last enumeration index (exclusive), at most 2^(n-numPositions)
+ *
+ * Index k expands to i (zero bits inserted at every position) and
+ * state[i | maskA] is exchanged with state[i | maskB]. CNOT, SWAP and
+ * Toffoli are all instances of this permutation.
+ */
+void swapMaskedPairs(std::complex<double>* state, const int* positions, int numPositions,
+                     std::uint64_t maskA, std::uint64_t maskB,
+                     std::uint64_t begin, std::uint64_t end);
+
+/**
+ * @brief Applies a 2x2 unitary to targetQubit where every control matches
+ * @param state Amplitude array of dimension 2^n
+ * @param targetQubit Target qubit index (0-based)
+ * @param matrix Row-major gate matrix
+ * @param controlMask Bits of all control qubits (positive and negative)
+ * @param controlValues Required value of each control bit (0 for negative controls)
+ * @param begin First enumeration index (inclusive)
+ * @param end Last enumeration index (exclusive), at most 2^(n-k-1) for k controls
+ *
+ * Only the 2^(n-k-1) pairs whose controls are satisfied are visited, so a
+ * k-controlled gate costs 1/2^k of an uncontrolled sweep. Runs of contiguous
+ * pairs (below the lowest control/target bit) go through applyMatrix2.
+ */
+void applyControlledMatrix2(std::complex<double>* state, int targetQubit, const Matrix2& matrix,
+                            std::uint64_t controlMask, std::uint64_t controlValues,
+                            std::uint64_t begin, std::uint64_t end);
+
+/// Largest number of qubits a dense kernel matrix may act on (8x8)
+constexpr int MAX_DENSE_QUBITS = 3;
+
+/**
+ * @brief Applies a dense 2^k x 2^k unitary to k qubits
+ * @param state Amplitude array of dimension 2^n
+ * @param positions The k qubits, in ascending order
+ * @param numPositions k, in [1, MAX_DENSE_QUBITS]
+ * @param matrix Row-major 2^k x 2^k matrix; local basis bit b is qubit positions[b]
+ * @param begin First enumeration index (inclusive)
+ * @param end Last enumeration index (exclusive), at most 2^(n-k)
+ *
+ * Index e expands to i (zero bits inserted at every position); the 2^k
+ * amplitudes i | offset(j) are gathered, multiplied and written back.
+ * Used for fused gate blocks, so a run of gates costs one sweep.
+ */
+void applyDenseMatrix(std::complex<double>* state, const int* positions, int numPositions,
+                      const std::complex<double>* matrix, std::uint64_t begin, std::uint64_t end);
+
+/**
+ * @brief Sums |amplitude|^2 of the pair members whose target bit equals bitValue
+ * @param state Amplitude array of dimension 2^n
+ * @param targetQubit Qubit index (0-based)
+ * @param bitValue 0 (lower member) or 1 (upper member)
+ * @param pairBegin First pair index (inclusive)
+ * @param pairEnd Last pair index (exclusive)
+ * @return Partial probability of measuring bitValue on targetQubit
+ */
+double sumSquaredMagnitudesForBit(const std::complex<double>* state, int targetQubit, int bitValue,
+                                  std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+/**
+ * @brief Projects pairs onto targetQubit == keptValue and rescales survivors
+ * @param state Amplitude array (modified in-place)
+ * @param targetQubit Qubit index (0-based)
+ * @param keptValue Measured bit value (0 or 1)
+ * @param scale Factor applied to kept amplitudes (1/sqrt(probability))
+ * @param pairBegin First pair index (inclusive)
+ * @param pairEnd Last pair index (exclusive)
+ */
+void collapsePairs(std::complex<double>* state, int targetQubit, int keptValue, double scale,
+                   std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+// ---------------------------------------------------------------------------
+// Single-precision overloads (same semantics as the double versions above)
+// ---------------------------------------------------------------------------
+
+void applyMatrix2(std::complex<float>* state, int targetQubit, const Matrix2& matrix,
+                  std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+double sumSquaredMagnitudes(const std::complex<float>* state, std::uint64_t begin, std::uint64_t end);
+
+void scaleAmplitudes(std::complex<float>* state, double factor, std::uint64_t begin, std::uint64_t end);
+
+void swapMaskedPairs(std::complex<float>* state, const int* positions, int numPositions,
+                     std::uint64_t maskA, std::uint64_t maskB,
+                     std::uint64_t begin, std::uint64_t end);
+
+void applyControlledMatrix2(std::complex<float>* state, int targetQubit, const Matrix2& matrix,
+                            std::uint64_t controlMask, std::uint64_t controlValues,
+                            std::uint64_t begin, std::uint64_t end);
+
+void applyDenseMatrix(std::complex<float>* state, const int* positions, int numPositions,
+                      const std::complex<double>* matrix, std::uint64_t begin, std::uint64_t end);
+
+double sumSquaredMagnitudesForBit(const std::complex<float>* state, int targetQubit, int bitValue,
+                                  std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+void collapsePairs(std::complex<float>* state, int targetQubit, int keptValue, double scale,
+                   std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+// ---------------------------------------------------------------------------
+// Split (structure-of-arrays) layout: amplitude i is (re[i], im[i]) in two
+// separate planes. A register then holds the real (or imaginary) parts of
+// 4 (AVX2) or 8 (AVX-512) consecutive amplitudes, so complex products are
+// plain FMAs with no swapping of real and imaginary lanes. Gates on the
+// lowest 2-3 qubits permute lanes instead. Semantics match the interleaved
+// kernels of the same name.
+// ---------------------------------------------------------------------------
+
+void applyMatrix2Split(double* re, double* im, int targetQubit, const Matrix2& matrix,
+                       std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+double sumSquaredMagnitudesSplit(const double* re, const double* im, std::uint64_t begin, std::uint64_t end);
+
+void swapMaskedPairsSplit(double* re, double* im, const int* positions, int numPositions,
+                          std::uint64_t maskA, std::uint64_t maskB,
+                          std::uint64_t begin, std::uint64_t end);
+
+void applyControlledMatrix2Split(double* re, double* im, int targetQubit, const Matrix2& matrix,
+                                 std::uint64_t controlMask, std::uint64_t controlValues,
+                                 std::uint64_t begin, std::uint64_t end);
+
+void applyDenseMatrixSplit(double* re, double* im, const int* positions, int numPositions,
+                           const std::complex<double>* matrix, std::uint64_t begin, std::uint64_t end);
+
+double sumSquaredMagnitudesForBitSplit(const double* re, const double* im, int targetQubit, int bitValue,
+                                       std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+void collapsePairsSplit(double* re, double* im, int targetQubit, int keptValue, double scale,
+                        std::uint64_t pairBegin, std::uint64_t pairEnd);
+
+}  // namespace kernels
@@ -0,0 +1,282 @@
+#include "sparse_state.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+/// Smallest table allocated
+constexpr std::size_t MIN_CAPACITY = 16;
+
+/// Entries with |amplitude|^2 below this are treated as cancelled
+constexpr double PRUNE_THRESHOLD = 1e-30;
+
+// splitmix64 finalizer: spreads the low bits basis indices differ in
+std::uint64_t mixBits(std::uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    return key ^ (key >> 31);
+}
+
+}  // namespace
+
+AmplitudeMap::AmplitudeMap() : keys(MIN_CAPACITY, EMPTY_KEY), values(MIN_CAPACITY) {}
+
+void AmplitudeMap::clear() {
+    std::fill(keys.begin(), keys.end(), EMPTY_KEY);
+    count = 0;
+}
+
+void AmplitudeMap::reserve(std::size_t entries) {
+    while (keys.size() < 2 * entries + 2) {
+        grow();
+    }
+}
+
+std::size_t AmplitudeMap::home(std::uint64_t key) const {
+    return mixBits(key) & (keys.size() - 1);
+}
+
+std::complex<double>& AmplitudeMap::operator[](std::uint64_t key) {
+    // Stay at most half full so probe runs stay short
+    if (2 * (count + 1) > keys.size()) {
+        grow();
+    }
+    std::size_t slot = home(key);
+    const std::size_t mask = keys.size() - 1;
+    while (keys[slot] != EMPTY_KEY) {
+        if (keys[slot] == key) {
+            return values[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    keys[slot] = key;
+    values[slot] = 0.0;
+    ++count;
+    return values[slot];
+}
+
+std::complex<double> AmplitudeMap::find(std::uint64_t key) const {
+    std::size_t slot = home(key);
+    const std::size_t mask = keys.size() - 1;
+    while (keys[slot] != EMPTY_KEY) {
+        if (keys[slot] == key) {
+            return values[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return 0.0;
+}
+
+void AmplitudeMap::swap(AmplitudeMap& other) {
+    keys.swap(other.keys);
+    values.swap(other.values);
+    std::swap(count, other.count);
+}
+
+void AmplitudeMap::grow() {
+    std::vector<std::uint64_t> old_keys(keys.size() * 2, EMPTY_KEY);
+    std::vector<std::complex<double>> old_values(values.size() * 2);
+    old_keys.swap(keys);
+    old_values.swap(values);
+    const std::size_t mask = keys.size() - 1;
+    for (std::size_t i = 0; i < old_keys.size(); ++i) {
+        if (old_keys[i] != EMPTY_KEY) {
+            std::size_t slot = home(old_keys[i]);
+            while (keys[slot] != EMPTY_KEY) {
+                slot = (slot + 1) & mask;
+            }
+            keys[slot] = old_keys[i];
+            values[slot] = old_values[i];
+        }
+    }
+}
+
+SparseState::SparseState(int numQubits) : num_qubits(numQubits) {
+    if (numQubits < 1 || numQubits > MAX_QUBITS) {
+        throw std::invalid_argument("Number of qubits must be between 1 and " + std::to_string(MAX_QUBITS));
+    }
+    initializeZeroState();
+}
+
+void SparseState::initializeZeroState() {
+    amplitudes.clear();
+    amplitudes[0] = 1.0;
+}
+
+void SparseState::setInitialState(const std::string& stateString) {
+    const std::uint64_t index = parseBasisState(stateString, num_qubits);
+    amplitudes.clear();
+    amplitudes[index] = 1.0;
+}
+
+void SparseState::applyOp(const CompiledOp& op) {
+    switch (op.opcode) {
+        case OpCode::CNOT:
+        case OpCode::SWAP:
+        case OpCode::Toffoli:
+            applyPermutation(op);
+            break;
+        case OpCode::PauliX:
+        case OpCode::PauliY:
+        case OpCode::PauliZ:
+        case OpCode::Hadamard:
+        case OpCode::Unitary:
+        case OpCode::Phase:
+        case OpCode::RX:
+        case OpCode::RY:
+        case OpCode::RZ:
+        case OpCode::U3:
+            applyMatrix2(op.target, op.matrix, 0, 0);
+            break;
+        case OpCode::Controlled:
+            applyMatrix2(op.target, op.matrix, op.control_mask, op.control_values);
+            break;
+        case OpCode::Fused:
+            applyDense(op);
+            break;
+        case OpCode::Measure:
+            throw std::invalid_argument("MEASURE is applied with SparseState::measure");
+        case OpCode::Noise:
+            throw std::invalid_argument("Sparse states do not support noise channels");
+    }
+}
+
+// Indices with (control=1, target=0) pattern mask_a trade places with mask_b
+void SparseState::applyPermutation(const CompiledOp& op) {
+    std::uint64_t involved = 0;
+    for (int i = 0; i < op.num_positions; ++i) {
+        involved |= std::uint64_t{1} << op.positions[i];
+    }
+    const std::uint64_t flip = op.mask_a ^ op.mask_b;
+    scratch.clear();
+    scratch.reserve(amplitudes.size());
+    amplitudes.forEach([&](std::uint64_t index, std::complex<double> value) {
+        const std::uint64_t pattern = index & involved;
+        scratch[(pattern == op.mask_a || pattern == op.mask_b) ? index ^ flip : index] = value;
+    });
+    amplitudes.swap(scratch);
+}
+
+void SparseState::applyMatrix2(int target, const kernels::Matrix2& matrix, std::uint64_t controlMask,
+                               std::uint64_t controlValues) {
+    const std::uint64_t bit = std::uint64_t{1} << target;
+
+    // Diagonal gates rescale entries in place and never create or cancel any
+    if (matrix[1] == 0.0 && matrix[2] == 0.0 && matrix[0] != 0.0 && matrix[3] != 0.0) {
+        amplitudes.forEach([&](std::uint64_t index, std::complex<double>& value) {
+            if ((index & controlMask) == controlValues) {
+                value *= (index & bit) ? matrix[3] : matrix[0];
+            }
+        });
+        return;
+    }
+
+    scratch.clear();
+    scratch.reserve(amplitudes.size());
+    amplitudes.forEach([&](std::uint64_t index, std::complex<double> value) {
+        if ((index & controlMask) != controlValues) {
+            scratch[index] += value;
+            return;
+        }
+        const int column = (index & bit) ? 1 : 0;
+        for (int row = 0; row < 2; ++row) {
+            const std::complex<double> entry = matrix[row * 2 + column];
+            if (entry != 0.0) {
+                scratch[row ? (index | bit) : (index & ~bit)] += entry * value;
+            }
+        }
+    });
+    commitScratch();
+}
+
+void SparseState::applyDense(const CompiledOp& op) {
+    const int width = op.num_positions;
+    const std::size_t dim = std::size_t{1} << width;
+    std::uint64_t involved = 0;
+    for (int b = 0; b < width; ++b) {
+        involved |= std::uint64_t{1} << op.positions[b];
+    }
+    auto deposit = [&](std::size_t local) {
+        std::uint64_t bits = 0;
+        for (int b = 0; b < width; ++b) {
+            bits |= static_cast<std::uint64_t>((local >> b) & 1) << op.positions[b];
+        }
+        return bits;
+    };
+
+    scratch.clear();
+    scratch.reserve(amplitudes.size());
+    amplitudes.forEach([&](std::uint64_t index, std::complex<double> value) {
+        std::size_t column = 0;
+        for (int b = 0; b < width; ++b) {
+            column |= ((index >> op.positions[b]) & 1) << b;
+        }
+        const std::uint64_t base = index & ~involved;
+        for (std::size_t row = 0; row < dim; ++row) {
+            const std::complex<double> entry = op.dense_matrix[row * dim + column];
+            if (entry != 0.0) {
+                scratch[base | deposit(row)] += entry * value;
+            }
+        }
+    });
+    commitScratch();
+}
+
+// Most scatters (permutations with phases) cancel nothing, so the result is
+// only rebuilt when an entry actually vanished
+void SparseState::commitScratch() {
+    amplitudes.swap(scratch);
+    bool cancelled = false;
+    amplitudes.forEach([&](std::uint64_t, std::complex<double> value) {
+        cancelled = cancelled || std::norm(value) < PRUNE_THRESHOLD;
+    });
+    if (!cancelled) {
+        return;
+    }
+    scratch.clear();
+    amplitudes.forEach([&](std::uint64_t index, std::complex<double> value) {
+        if (std::norm(value) >= PRUNE_THRESHOLD) {
+            scratch[index] = value;
+        }
+    });
+    amplitudes.swap(scratch);
+}
+
+int SparseState::measure(int qubit, std::mt19937_64& rng) {
+    if (qubit < 0 || qubit >= num_qubits) {
+        throw std::out_of_range("Qubit index out of range: " + std::to_string(qubit));
+    }
+    const std::uint64_t bit = std::uint64_t{1} << qubit;
+    double prob_one = 0.0;
+    amplitudes.forEach([&](std::uint64_t index, std::complex<double> value) {
+        if (index & bit) {
+            prob_one += std::norm(value);
+        }
+    });
+
+    // Same draw as GateEngine::measure: u < P(1) happens with probability P(1)
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    const int result = (u < prob_one) ? 1 : 0;
+    const double prob_result = result ? prob_one : 1.0 - prob_one;
+    const double scale = prob_result > 1e-20 ? 1.0 / std::sqrt(prob_result) : 1.0;
+
+    scratch.clear();
+    amplitudes.forEach([&](std::uint64_t index, std::complex<double> value) {
+        if (((index & bit) != 0) == (result == 1)) {
+            scratch[index] = value * scale;
+        }
+    });
+    amplitudes.swap(scratch);
+    return result;
+}
+
+void SparseState::toDense(std::complex<double>* state) const {
+    std::fill_n(state, std::uint64_t{1} << num_qubits, std::complex<double>(0.0));
+    amplitudes.forEach([&](std::uint64_t index, std::complex<double> value) {
+        state[index] = value;
+    });
+}
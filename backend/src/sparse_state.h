@@ -0,0 +1,199 @@
+#pragma once
+
+#include "compiled_circuit.h"
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @class AmplitudeMap
+ * @brief Open-addressing hash map from basis index to amplitude
+ *
+ * Keys and values live in two flat arrays with linear probing, so lookups
+ * touch one or two cache lines and iteration is a scan. The capacity is a
+ * power of two kept at most half full. There is no erase: sparse kernels
+ * write their result into a second map and swap.
+ */
+class AmplitudeMap {
+public:
+    /// Marks a free slot (never a valid index: registers have at most 63 qubits)
+    static constexpr std::uint64_t EMPTY_KEY = ~std::uint64_t{0};
+
+    AmplitudeMap();
+
+    /**
+     * @brief Gets the number of stored entries
+     * @return Entry count
+     */
+    std::size_t size() const { return count; }
+
+    /// Removes every entry, keeping the capacity
+    void clear();
+
+    /**
+     * @brief Grows the table so count entries fit without rehashing
+     * @param entries Expected number of entries
+     */
+    void reserve(std::size_t entries);
+
+    /**
+     * @brief Gets the amplitude of an index, inserting 0 if absent
+     * @param key Basis state index
+     * @return Reference valid until the next insertion
+     */
+    std::complex<double>& operator[](std::uint64_t key);
+
+    /**
+     * @brief Looks up an amplitude
+     * @param key Basis state index
+     * @return Stored amplitude, or 0 if absent
+     */
+    std::complex<double> find(std::uint64_t key) const;
+
+    /**
+     * @brief Calls f(index, amplitude) for every entry, in table order
+     * @param f Callable taking (std::uint64_t, std::complex<double>&)
+     */
+    template <typename Function>
+    void forEach(Function&& f) {
+        for (std::size_t slot = 0; slot < keys.size(); ++slot) {
+            if (keys[slot] != EMPTY_KEY) {
+                f(keys[slot], values[slot]);
+            }
+        }
+    }
+
+    /// @copydoc forEach
+    template <typename Function>
+    void forEach(Function&& f) const {
+        for (std::size_t slot = 0; slot < keys.size(); ++slot) {
+            if (keys[slot] != EMPTY_KEY) {
+                f(keys[slot], values[slot]);
+            }
+        }
+    }
+
+    /// Exchanges contents with another map in O(1)
+    void swap(AmplitudeMap& other);
+
+private:
+    /// Key of each slot (EMPTY_KEY if free)
+    std::vector<std::uint64_t> keys;
+
+    /// Amplitude of each slot
+    std::vector<std::complex<double>> values;
+
+    /// Occupied slots
+    std::size_t count = 0;
+
+    /// First slot to probe for key
+    std::size_t home(std::uint64_t key) const;
+
+    /// Doubles the capacity and reinserts every entry
+    void grow();
+};
+
+/**
+ * @class SparseState
+ * @brief State vector that stores only nonzero amplitudes
+ *
+ * Permutation gates (X, CNOT, SWAP, TOFFOLI and controlled X) only move
+ * entries and diagonal gates (Z, PHASE, RZ, controlled phases) only scale
+ * them, so mostly-classical circuits stay at a handful of entries on any
+ * register width up to MAX_QUBITS. Other gates scatter each entry into
+ * its 2^k partners and drop exact cancellations. Cost is O(entries) per
+ * gate instead of O(2^n).
+ */
+class SparseState {
+public:
+    /// Widest register (indices must fit below AmplitudeMap::EMPTY_KEY)
+    static constexpr int MAX_QUBITS = 63;
+
+    /**
+     * @brief Creates |0...0⟩
+     * @param numQubits Register width (1-MAX_QUBITS)
+     * @throws std::invalid_argument if numQubits is out of range
+     */
+    explicit SparseState(int numQubits);
+
+    /// Resets to |0...0⟩
+    void initializeZeroState();
+
+    /**
+     * @brief Sets a computational basis state
+     * @param stateString Binary label, highest qubit first (e.g., "0101")
+     * @throws std::invalid_argument if the label is malformed
+     */
+    void setInitialState(const std::string& stateString);
+
+    /**
+     * @brief Gets the register width
+     * @return Number of qubits
+     */
+    int getNumQubits() const { return num_qubits; }
+
+    /**
+     * @brief Gets the number of stored (nonzero) amplitudes
+     * @return Entry count
+     */
+    std::uint64_t size() const { return amplitudes.size(); }
+
+    /**
+     * @brief Gets one amplitude
+     * @param index Basis state index
+     * @return Amplitude (0 if not stored)
+     */
+    std::complex<double> amplitude(std::uint64_t index) const { return amplitudes.find(index); }
+
+    /**
+     * @brief Gets the stored entries
+     * @return Map from basis index to amplitude
+     */
+    const AmplitudeMap& getAmplitudes() const { return amplitudes; }
+
+    /**
+     * @brief Applies one compiled gate
+     * @param op Any op except MEASURE and NOISE
+     * @throws std::invalid_argument for MEASURE or NOISE ops
+     */
+    void applyOp(const CompiledOp& op);
+
+    /**
+     * @brief Measures one qubit and collapses the state
+     * @param qubit Qubit index
+     * @param rng Random engine for the outcome
+     * @return Outcome (0 or 1)
+     */
+    int measure(int qubit, std::mt19937_64& rng);
+
+    /**
+     * @brief Writes the state into a dense buffer
+     * @param state Buffer of 2^n amplitudes, overwritten entirely
+     */
+    void toDense(std::complex<double>* state) const;
+
+private:
+    /// Register width n
+    int num_qubits;
+
+    /// Nonzero amplitudes
+    AmplitudeMap amplitudes;
+
+    /// Destination of scattering kernels, swapped with amplitudes afterwards
+    AmplitudeMap scratch;
+
+    /// Moves entries of a CNOT / SWAP / TOFFOLI permutation
+    void applyPermutation(const CompiledOp& op);
+
+    /// Applies a 2x2 matrix to the entries whose control bits match
+    void applyMatrix2(int target, const kernels::Matrix2& matrix, std::uint64_t controlMask,
+                      std::uint64_t controlValues);
+
+    /// Applies a Fused dense matrix
+    void applyDense(const CompiledOp& op);
+
+    /// Moves scratch into amplitudes, dropping entries that cancelled
+    void commitScratch();
+};
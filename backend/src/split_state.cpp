@@ -0,0 +1,177 @@
+#include "split_state.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+SplitState::SplitState(int numQubits) : num_qubits(numQubits), dimension(0) {
+    if (numQubits < 1 || numQubits > QubitManager::MAX_QUBITS) {
+        throw std::invalid_argument("Number of qubits must be between 1 and " +
+                                    std::to_string(QubitManager::MAX_QUBITS));
+    }
+    std::uint64_t required = QubitManager::estimateMemoryBytes(numQubits);
+    std::uint64_t available = availableMemoryBytes();
+    if (required > available) {
+        throw std::runtime_error("State vector for " + std::to_string(numQubits) +
+                                 " qubits needs " + std::to_string(required) +
+                                 " bytes but only " + std::to_string(available) +
+                                 " bytes are available");
+    }
+    dimension = std::uint64_t{1} << numQubits;
+    allocatePlanes();
+    initializeZeroState();
+}
+
+SplitState::SplitState(const QubitManager& interleaved)
+    : num_qubits(interleaved.getNumQubits()), dimension(interleaved.getDimension()) {
+    allocatePlanes();
+    fromInterleaved(interleaved);
+}
+
+SplitState::SplitState(const SplitState& other) : num_qubits(other.num_qubits), dimension(other.dimension) {
+    allocatePlanes();
+    std::memcpy(planes.get(), other.planes.get(), 2 * dimension * sizeof(double));
+}
+
+SplitState& SplitState::operator=(const SplitState& other) {
+    if (this != &other) {
+        SplitState copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Both planes share one allocation, padded to a whole number of cache lines
+void SplitState::allocatePlanes() {
+    std::uint64_t bytes = 2 * dimension * sizeof(double);
+    std::uint64_t padded = (bytes + QubitManager::STATE_ALIGNMENT - 1) /
+                           QubitManager::STATE_ALIGNMENT * QubitManager::STATE_ALIGNMENT;
+    void* raw = std::aligned_alloc(QubitManager::STATE_ALIGNMENT, padded);
+    if (raw == nullptr) {
+        throw std::runtime_error("Failed to allocate " + std::to_string(padded) +
+                                 " bytes for " + std::to_string(num_qubits) + "-qubit state");
+    }
+    planes.reset(static_cast<double*>(raw));
+}
+
+void SplitState::initializeZeroState() {
+    double* data = planes.get();
+    ThreadPool::global().parallelFor(0, 2 * dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        std::fill(data + begin, data + end, 0.0);
+    });
+    data[0] = 1.0;
+}
+
+void SplitState::setInitialState(const std::string& stateString) {
+    std::uint64_t index = parseBasisState(stateString, num_qubits);
+    std::fill(planes.get(), planes.get() + 2 * dimension, 0.0);
+    planes[index] = 1.0;
+}
+
+void SplitState::toInterleaved(QubitManager& qubits) const {
+    if (qubits.getNumQubits() != num_qubits) {
+        throw std::invalid_argument("Cannot convert a " + std::to_string(num_qubits) + "-qubit state to a " +
+                                    std::to_string(qubits.getNumQubits()) + "-qubit register");
+    }
+    std::complex<double>* state = qubits.getState().data();
+    const double* re = real();
+    const double* im = imag();
+    ThreadPool::global().parallelFor(0, dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        for (std::uint64_t i = begin; i < end; ++i) {
+            state[i] = {re[i], im[i]};
+        }
+    });
+}
+
+void SplitState::fromInterleaved(const QubitManager& qubits) {
+    if (qubits.getNumQubits() != num_qubits) {
+        throw std::invalid_argument("Cannot convert a " + std::to_string(qubits.getNumQubits()) +
+                                    "-qubit register to a " + std::to_string(num_qubits) + "-qubit state");
+    }
+    const std::complex<double>* state = qubits.getState().data();
+    double* re = real();
+    double* im = imag();
+    ThreadPool::global().parallelFor(0, dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        for (std::uint64_t i = begin; i < end; ++i) {
+            re[i] = state[i].real();
+            im[i] = state[i].imag();
+        }
+    });
+}
+
+// Same dispatch and enumeration ranges as GateEngine::applyToBuffer
+void SplitState::applyOp(const CompiledOp& op) {
+    double* re = real();
+    double* im = imag();
+    ThreadPool& pool = ThreadPool::global();
+    switch (op.opcode) {
+        case OpCode::PauliX:
+        case OpCode::PauliY:
+        case OpCode::PauliZ:
+        case OpCode::Hadamard:
+        case OpCode::Unitary:
+        case OpCode::Phase:
+        case OpCode::RX:
+        case OpCode::RY:
+        case OpCode::RZ:
+        case OpCode::U3:
+            pool.parallelFor(0, dimension / 2, [&](std::uint64_t begin, std::uint64_t end) {
+                kernels::applyMatrix2Split(re, im, op.target, op.matrix, begin, end);
+            });
+            return;
+
+        case OpCode::CNOT:
+        case OpCode::SWAP:
+        case OpCode::Toffoli:
+            pool.parallelFor(0, dimension >> op.num_positions, [&](std::uint64_t begin, std::uint64_t end) {
+                kernels::swapMaskedPairsSplit(re, im, op.positions.data(), op.num_positions,
+                                              op.mask_a, op.mask_b, begin, end);
+            });
+            return;
+
+        case OpCode::Controlled: {
+            const int fixed_bits = __builtin_popcountll(op.control_mask) + 1;
+            pool.parallelFor(0, dimension >> fixed_bits, [&](std::uint64_t begin, std::uint64_t end) {
+                kernels::applyControlledMatrix2Split(re, im, op.target, op.matrix,
+                                                     op.control_mask, op.control_values, begin, end);
+            });
+            return;
+        }
+
+        case OpCode::Fused:
+            pool.parallelFor(0, dimension >> op.num_positions, [&](std::uint64_t begin, std::uint64_t end) {
+                kernels::applyDenseMatrixSplit(re, im, op.positions.data(), op.num_positions,
+                                               op.dense_matrix.data(), begin, end);
+            });
+            return;
+
+        case OpCode::Measure:
+            throw std::invalid_argument("MEASURE must go through SplitState::measure");
+
+        case OpCode::Noise:
+            throw std::invalid_argument("The split-layout backend does not support noise");
+    }
+}
+
+int SplitState::measure(int qubit, std::mt19937_64& rng) {
+    double* re = real();
+    double* im = imag();
+    const std::uint64_t pairs = dimension / 2;
+    ThreadPool& pool = ThreadPool::global();
+
+    double prob_one = pool.parallelSum(0, pairs, [&](std::uint64_t begin, std::uint64_t end) {
+        return kernels::sumSquaredMagnitudesForBitSplit(re, im, qubit, 1, begin, end);
+    });
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    int result = (u < prob_one) ? 1 : 0;
+    double prob_result = result ? prob_one : 1.0 - prob_one;
+
+    double scale = prob_result > 1e-20 ? 1.0 / std::sqrt(prob_result) : 1.0;
+    pool.parallelFor(0, pairs, [&](std::uint64_t begin, std::uint64_t end) {
+        kernels::collapsePairsSplit(re, im, qubit, result, scale, begin, end);
+    });
+    return result;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "compiled_circuit.h"
+#include "qubit_manager.h"
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+
+/**
+ * @class SplitState
+ * @brief Dense state vector stored as separate real and imaginary planes
+ *
+ * QubitManager interleaves (re, im) pairs, so every vectorized complex
+ * product swaps lanes within a register. Here amplitude i is
+ * (real()[i], imag()[i]): a register holds the real (or imaginary) parts of
+ * consecutive amplitudes and a gate is plain FMAs over the two planes (see
+ * the *Split kernels in simd_kernels.h). Memory use equals QubitManager's.
+ *
+ * The layout is internal: convert at API boundaries with the QubitManager
+ * constructor and toInterleaved. CircuitManager::executeCircuit runs
+ * compiled (and fused) plans on it directly.
+ */
+class SplitState {
+public:
+    /**
+     * @brief Creates |0...0⟩
+     * @param numQubits Register width (1-QubitManager::MAX_QUBITS)
+     * @throws std::invalid_argument if numQubits is out of range
+     * @throws std::runtime_error if the planes do not fit in available memory
+     */
+    explicit SplitState(int numQubits);
+
+    /**
+     * @brief Converts an interleaved register
+     * @param interleaved State to copy
+     */
+    explicit SplitState(const QubitManager& interleaved);
+
+    /// Deep-copies both planes
+    SplitState(const SplitState& other);
+    SplitState& operator=(const SplitState& other);
+
+    /// Transfers ownership of the planes
+    SplitState(SplitState&& other) noexcept = default;
+    SplitState& operator=(SplitState&& other) noexcept = default;
+
+    /// Resets to |0...0⟩
+    void initializeZeroState();
+
+    /**
+     * @brief Sets a computational basis state
+     * @param stateString Binary label, highest qubit first (e.g., "0101")
+     * @throws std::invalid_argument if the label is malformed
+     */
+    void setInitialState(const std::string& stateString);
+
+    /**
+     * @brief Gets the register width
+     * @return Number of qubits
+     */
+    int getNumQubits() const { return num_qubits; }
+
+    /**
+     * @brief Gets the number of amplitudes
+     * @return 2^num_qubits
+     */
+    std::uint64_t getDimension() const { return dimension; }
+
+    /// Real plane (2^n doubles, 64-byte aligned)
+    double* real() { return planes.get(); }
+    const double* real() const { return planes.get(); }
+
+    /// Imaginary plane (2^n doubles, directly after the real plane)
+    double* imag() { return planes.get() + dimension; }
+    const double* imag() const { return planes.get() + dimension; }
+
+    /**
+     * @brief Gets one amplitude
+     * @param index Basis state index
+     * @return real()[index] + i imag()[index]
+     */
+    std::complex<double> amplitude(std::uint64_t index) const {
+        return {planes[index], planes[dimension + index]};
+    }
+
+    /**
+     * @brief Writes the state into an interleaved register
+     * @param qubits Register of the same width (overwritten)
+     * @throws std::invalid_argument if the widths differ
+     */
+    void toInterleaved(QubitManager& qubits) const;
+
+    /**
+     * @brief Loads the state from an interleaved register
+     * @param qubits Register of the same width
+     * @throws std::invalid_argument if the widths differ
+     */
+    void fromInterleaved(const QubitManager& qubits);
+
+    /**
+     * @brief Applies one compiled gate
+     * @param op Any op except MEASURE and NOISE, lowered for getNumQubits() qubits
+     * @throws std::invalid_argument for MEASURE or NOISE ops
+     */
+    void applyOp(const CompiledOp& op);
+
+    /**
+     * @brief Measures one qubit, collapses and renormalizes the state
+     * @param qubit Qubit index
+     * @param rng Random engine for the outcome
+     * @return Outcome (0 or 1)
+     */
+    int measure(int qubit, std::mt19937_64& rng);
+
+private:
+    /// Releases buffers obtained from std::aligned_alloc
+    struct AlignedDeleter {
+        void operator()(double* ptr) const { std::free(ptr); }
+    };
+
+    /// Real plane followed by the imaginary plane
+    std::unique_ptr<double[], AlignedDeleter> planes;
+
+    /// Register width n
+    int num_qubits;
+
+    /// Number of amplitudes (2^n)
+    std::uint64_t dimension;
+
+    /// Allocates both planes, uninitialized
+    void allocatePlanes();
+};
@@ -0,0 +1,310 @@
+#include "stabilizer_tableau.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+int ParityOutcome::evaluate(const std::vector<std::uint64_t>& coins) const {
+    std::uint64_t parity = constant;
+    for (std::size_t w = 0; w < coin_mask.size() && w < coins.size(); ++w) {
+        parity ^= __builtin_popcountll(coin_mask[w] & coins[w]);
+    }
+    return static_cast<int>(parity & 1);
+}
+
+StabilizerTableau::StabilizerTableau(int numQubits) : num_qubits(numQubits) {
+    if (numQubits < 1) {
+        throw std::invalid_argument("Stabilizer tableau needs at least 1 qubit");
+    }
+    words = (static_cast<std::size_t>(numQubits) + 63) / 64;
+    const std::size_t rows = 2 * static_cast<std::size_t>(numQubits) + 1;
+    xs.resize(rows * words);
+    zs.resize(rows * words);
+    signs.resize(rows);
+    reset();
+}
+
+// Destabilizer k is X_k and stabilizer k is Z_k
+void StabilizerTableau::reset() {
+    std::fill(xs.begin(), xs.end(), 0);
+    std::fill(zs.begin(), zs.end(), 0);
+    std::fill(signs.begin(), signs.end(), 0);
+    num_coins = 0;
+    coin_words = 0;
+    coin_masks.clear();
+    for (int q = 0; q < num_qubits; ++q) {
+        const std::uint64_t bit = std::uint64_t{1} << (q & 63);
+        xs[static_cast<std::size_t>(q) * words + (q >> 6)] = bit;
+        zs[static_cast<std::size_t>(q + num_qubits) * words + (q >> 6)] = bit;
+    }
+}
+
+void StabilizerTableau::checkQubit(int q) const {
+    if (q < 0 || q >= num_qubits) {
+        throw std::out_of_range("Qubit index " + std::to_string(q) + " out of range for " +
+                                std::to_string(num_qubits) + " qubits");
+    }
+}
+
+bool StabilizerTableau::xBit(std::size_t row, int q) const {
+    return (xs[row * words + (q >> 6)] >> (q & 63)) & 1;
+}
+
+// Single-qubit gates update one bit column and the signs of all 2n rows
+void StabilizerTableau::applyHadamard(int q) {
+    checkQubit(q);
+    const std::size_t w = q >> 6;
+    const std::uint64_t m = std::uint64_t{1} << (q & 63);
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        std::uint64_t& x = xs[row * words + w];
+        std::uint64_t& z = zs[row * words + w];
+        const std::uint64_t differ = (x ^ z) & m;
+        signs[row] ^= (x & z & m) != 0;
+        x ^= differ;
+        z ^= differ;
+    }
+}
+
+void StabilizerTableau::applyPhase(int q) {
+    checkQubit(q);
+    const std::size_t w = q >> 6;
+    const std::uint64_t m = std::uint64_t{1} << (q & 63);
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        const std::uint64_t x = xs[row * words + w];
+        std::uint64_t& z = zs[row * words + w];
+        signs[row] ^= (x & z & m) != 0;
+        z ^= x & m;
+    }
+}
+
+// Paulis only flip the signs of rows that anticommute with them
+void StabilizerTableau::applyPauliX(int q) {
+    checkQubit(q);
+    const std::size_t w = q >> 6;
+    const std::uint64_t m = std::uint64_t{1} << (q & 63);
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        signs[row] ^= (zs[row * words + w] & m) != 0;
+    }
+}
+
+void StabilizerTableau::applyPauliY(int q) {
+    checkQubit(q);
+    const std::size_t w = q >> 6;
+    const std::uint64_t m = std::uint64_t{1} << (q & 63);
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        signs[row] ^= ((xs[row * words + w] ^ zs[row * words + w]) & m) != 0;
+    }
+}
+
+void StabilizerTableau::applyPauliZ(int q) {
+    checkQubit(q);
+    const std::size_t w = q >> 6;
+    const std::uint64_t m = std::uint64_t{1} << (q & 63);
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        signs[row] ^= (xs[row * words + w] & m) != 0;
+    }
+}
+
+void StabilizerTableau::applyCNOT(int control, int target) {
+    checkQubit(control);
+    checkQubit(target);
+    if (control == target) {
+        throw std::invalid_argument("Control and target qubits must be different");
+    }
+    const std::size_t cw = control >> 6, tw = target >> 6;
+    const int cs = control & 63, ts = target & 63;
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        std::uint64_t* x = &xs[row * words];
+        std::uint64_t* z = &zs[row * words];
+        const std::uint64_t xc = (x[cw] >> cs) & 1, zc = (z[cw] >> cs) & 1;
+        const std::uint64_t xt = (x[tw] >> ts) & 1, zt = (z[tw] >> ts) & 1;
+        signs[row] ^= xc & zt & (xt ^ zc ^ 1);
+        x[tw] ^= xc << ts;
+        z[cw] ^= zt << cs;
+    }
+}
+
+void StabilizerTableau::applyCZ(int a, int b) {
+    checkQubit(a);
+    checkQubit(b);
+    if (a == b) {
+        throw std::invalid_argument("CZ gate requires distinct qubits");
+    }
+    const std::size_t aw = a >> 6, bw = b >> 6;
+    const int as = a & 63, bs = b & 63;
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        const std::uint64_t* x = &xs[row * words];
+        std::uint64_t* z = &zs[row * words];
+        const std::uint64_t xa = (x[aw] >> as) & 1, za = (z[aw] >> as) & 1;
+        const std::uint64_t xb = (x[bw] >> bs) & 1, zb = (z[bw] >> bs) & 1;
+        signs[row] ^= xa & xb & (za ^ zb);
+        z[aw] ^= xb << as;
+        z[bw] ^= xa << bs;
+    }
+}
+
+void StabilizerTableau::applySWAP(int a, int b) {
+    checkQubit(a);
+    checkQubit(b);
+    if (a == b) {
+        throw std::invalid_argument("SWAP gate requires distinct qubits");
+    }
+    const std::size_t aw = a >> 6, bw = b >> 6;
+    const int as = a & 63, bs = b & 63;
+    for (std::size_t row = 0; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        for (std::uint64_t* bits : {&xs[row * words], &zs[row * words]}) {
+            const std::uint64_t differ = ((bits[aw] >> as) ^ (bits[bw] >> bs)) & 1;
+            bits[aw] ^= differ << as;
+            bits[bw] ^= differ << bs;
+        }
+    }
+}
+
+// Row h becomes P_i * P_h. Per qubit the product contributes a factor i^g
+// with g in {-1, 0, 1}; the masks below select the +1 and -1 cases
+// (XY, YZ, ZX give +1 and YX, ZY, XZ give -1) for 64 qubits at a time.
+void StabilizerTableau::rowMultiply(std::size_t h, std::size_t i) {
+    std::int64_t exponent = 2 * signs[h] + 2 * signs[i];
+    std::uint64_t* xh = &xs[h * words];
+    std::uint64_t* zh = &zs[h * words];
+    const std::uint64_t* xi = &xs[i * words];
+    const std::uint64_t* zi = &zs[i * words];
+    for (std::size_t w = 0; w < words; ++w) {
+        const std::uint64_t x1 = xi[w], z1 = zi[w], x2 = xh[w], z2 = zh[w];
+        const std::uint64_t y1 = x1 & z1, only_x1 = x1 & ~z1, only_z1 = ~x1 & z1;
+        const std::uint64_t positive = (only_x1 & x2 & z2) | (y1 & ~x2 & z2) | (only_z1 & x2 & ~z2);
+        const std::uint64_t negative = (y1 & x2 & ~z2) | (only_z1 & x2 & z2) | (only_x1 & ~x2 & z2);
+        exponent += __builtin_popcountll(positive) - __builtin_popcountll(negative);
+        xh[w] = x2 ^ x1;
+        zh[w] = z2 ^ z1;
+    }
+    // Products of commuting rows are Hermitian, so the exponent is 0 or 2 (mod 4)
+    signs[h] = (exponent & 3) == 2;
+    for (std::size_t w = 0; w < coin_words; ++w) {
+        coin_masks[h * coin_words + w] ^= coin_masks[i * coin_words + w];
+    }
+}
+
+bool StabilizerTableau::isDeterministic(int q) const {
+    checkQubit(q);
+    for (std::size_t row = num_qubits; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        if (xBit(row, q)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int StabilizerTableau::measure(int q, std::mt19937_64& rng) {
+    return signs[measureImpl(q, &rng)];
+}
+
+ParityOutcome StabilizerTableau::measureSymbolic(int q) {
+    const std::size_t row = measureImpl(q, nullptr);
+    ParityOutcome outcome;
+    outcome.constant = signs[row];
+    outcome.coin_mask.assign(coin_masks.begin() + row * coin_words, coin_masks.begin() + (row + 1) * coin_words);
+    return outcome;
+}
+
+void StabilizerTableau::addCoin(std::size_t row) {
+    if (num_coins == coin_words * 64) {
+        // Restride every row to one more word
+        const std::size_t rows = signs.size();
+        std::vector<std::uint64_t> widened(rows * (coin_words + 1), 0);
+        for (std::size_t r = 0; r < rows; ++r) {
+            std::copy_n(coin_masks.data() + r * coin_words, coin_words, &widened[r * (coin_words + 1)]);
+        }
+        coin_masks.swap(widened);
+        ++coin_words;
+    }
+    coin_masks[row * coin_words + num_coins / 64] |= std::uint64_t{1} << (num_coins % 64);
+    ++num_coins;
+}
+
+std::size_t StabilizerTableau::measureImpl(int q, std::mt19937_64* rng) {
+    checkQubit(q);
+    const std::size_t n = num_qubits;
+
+    // A stabilizer anticommuting with Z_q makes the outcome uniformly random
+    std::size_t p = n;
+    while (p < 2 * n && !xBit(p, q)) {
+        ++p;
+    }
+    if (p < 2 * n) {
+        for (std::size_t row = 0; row < 2 * n; ++row) {
+            if (row != p && xBit(row, q)) {
+                rowMultiply(row, p);
+            }
+        }
+        // The old stabilizer becomes a destabilizer; ±Z_q replaces it
+        std::copy_n(&xs[p * words], words, &xs[(p - n) * words]);
+        std::copy_n(&zs[p * words], words, &zs[(p - n) * words]);
+        signs[p - n] = signs[p];
+        std::fill_n(&xs[p * words], words, 0);
+        std::fill_n(&zs[p * words], words, 0);
+        zs[p * words + (q >> 6)] = std::uint64_t{1} << (q & 63);
+        if (coin_words > 0) {
+            std::copy_n(&coin_masks[p * coin_words], coin_words, &coin_masks[(p - n) * coin_words]);
+            std::fill_n(&coin_masks[p * coin_words], coin_words, 0);
+        }
+        if (rng) {
+            signs[p] = static_cast<std::uint8_t>((*rng)() & 1);
+        } else {
+            signs[p] = 0;
+            addCoin(p);
+        }
+        return p;
+    }
+
+    // Otherwise ±Z_q is the product of the stabilizers whose destabilizers anticommute with it
+    const std::size_t scratch = 2 * n;
+    std::fill_n(&xs[scratch * words], words, 0);
+    std::fill_n(&zs[scratch * words], words, 0);
+    signs[scratch] = 0;
+    if (coin_words > 0) {
+        std::fill_n(&coin_masks[scratch * coin_words], coin_words, 0);
+    }
+    for (std::size_t row = 0; row < n; ++row) {
+        if (xBit(row, q)) {
+            rowMultiply(scratch, row + n);
+        }
+    }
+    return scratch;
+}
+
+int StabilizerTableau::apply(const CliffordOp& op, std::mt19937_64& rng) {
+    switch (op.opcode) {
+        case OpCode::PauliX: applyPauliX(op.target); break;
+        case OpCode::PauliY: applyPauliY(op.target); break;
+        case OpCode::PauliZ:
+            if (op.control >= 0) {
+                applyCZ(op.control, op.target);
+            } else {
+                applyPauliZ(op.target);
+            }
+            break;
+        case OpCode::Hadamard: applyHadamard(op.target); break;
+        case OpCode::Phase: applyPhase(op.target); break;
+        case OpCode::CNOT: applyCNOT(op.control, op.target); break;
+        case OpCode::SWAP: applySWAP(op.control, op.target); break;
+        case OpCode::Measure: return measure(op.target, rng);
+        default:
+            throw std::invalid_argument(std::string(opCodeName(op.opcode)) + " is not a Clifford op");
+    }
+    return -1;
+}
+
+std::vector<std::string> StabilizerTableau::getStabilizers() const {
+    static const char letters[] = {'I', 'X', 'Z', 'Y'};
+    std::vector<std::string> stabilizers;
+    for (std::size_t row = num_qubits; row < 2 * static_cast<std::size_t>(num_qubits); ++row) {
+        std::string pauli(1, signs[row] ? '-' : '+');
+        for (int q = 0; q < num_qubits; ++q) {
+            const int x = (xs[row * words + (q >> 6)] >> (q & 63)) & 1;
+            const int z = (zs[row * words + (q >> 6)] >> (q & 63)) & 1;
+            pauli += letters[x | (z << 1)];
+        }
+        stabilizers.push_back(pauli);
+    }
+    return stabilizers;
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "compiled_circuit.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file stabilizer_tableau.h
+ * @brief Polynomial-time simulation of Clifford circuits
+ *
+ * A stabilizer state on n qubits is fully described by n stabilizer and n
+ * destabilizer Pauli strings (Aaronson-Gottesman tableau), so Clifford
+ * gates cost O(n) and measurements O(n^2 / 64) instead of O(2^n). Each
+ * Pauli row stores its X and Z bits packed 64 qubits per word; the row
+ * products measurements need run word by word, with the phase accumulated
+ * from two popcounts per word.
+ *
+ * Gates update the X/Z bits independently of the measurement outcomes, so
+ * every outcome of a Clifford circuit is a fixed XOR of the random coins
+ * flipped so far. measureSymbolic tracks those XORs, so one tableau run
+ * yields a sampler that draws each shot in O(measurements^2 / 64).
+ */
+
+/**
+ * @struct CliffordOp
+ * @brief One gate of a Clifford-only circuit
+ *
+ * Compiled plans address qubits through 64-bit masks, so CircuitManager
+ * lowers Clifford circuits to this form instead, which has no width limit.
+ * opcode is PauliX, PauliY, PauliZ, Hadamard, Phase (the S gate), CNOT,
+ * SWAP or Measure; PauliZ with a control is CZ.
+ */
+struct CliffordOp {
+    /// Gate kind
+    OpCode opcode = OpCode::PauliX;
+
+    /// Target qubit (one side of SWAP / CZ)
+    int target = -1;
+
+    /// Control of CNOT / CZ, other qubit of SWAP (-1 if unused)
+    int control = -1;
+
+    /// Index of the originating GateOperation (-1 if none)
+    int gate_index = -1;
+};
+
+/**
+ * @struct ParityOutcome
+ * @brief Measurement outcome as a function of the random coins
+ *
+ * The outcome is constant XOR the parity of the coins selected by
+ * coin_mask, where coin k is the k-th random outcome drawn by
+ * measureSymbolic (bit k % 64 of word k / 64).
+ */
+struct ParityOutcome {
+    /// Outcome when every coin is 0
+    int constant = 0;
+
+    /// Coins the outcome depends on
+    std::vector<std::uint64_t> coin_mask;
+
+    /**
+     * @brief Evaluates the outcome for one assignment of coins
+     * @param coins Coin values, packed like coin_mask
+     * @return 0 or 1
+     */
+    int evaluate(const std::vector<std::uint64_t>& coins) const;
+};
+
+/**
+ * @class StabilizerTableau
+ * @brief Stabilizer state of a register, stored as a bit-packed tableau
+ *
+ * Rows 0..n-1 are destabilizers, rows n..2n-1 stabilizers and row 2n is
+ * scratch space for deterministic measurements. The register starts in
+ * |0...0⟩, stabilized by Z on every qubit. Memory is about n^2 / 2 bytes,
+ * so thousands of qubits are practical.
+ */
+class StabilizerTableau {
+public:
+    /**
+     * @brief Creates a tableau for |0...0⟩
+     * @param numQubits Register width (at least 1)
+     * @throws std::invalid_argument if numQubits < 1
+     */
+    explicit StabilizerTableau(int numQubits);
+
+    /// Resets the register to |0...0⟩
+    void reset();
+
+    /**
+     * @brief Gets the register width
+     * @return Number of qubits
+     */
+    int getNumQubits() const { return num_qubits; }
+
+    /// @brief Applies Hadamard to qubit q
+    void applyHadamard(int q);
+
+    /// @brief Applies S = diag(1, i) to qubit q
+    void applyPhase(int q);
+
+    /// @brief Applies Pauli-X to qubit q
+    void applyPauliX(int q);
+
+    /// @brief Applies Pauli-Y to qubit q
+    void applyPauliY(int q);
+
+    /// @brief Applies Pauli-Z to qubit q
+    void applyPauliZ(int q);
+
+    /// @brief Applies CNOT with the given control and target
+    void applyCNOT(int control, int target);
+
+    /// @brief Applies CZ to qubits a and b
+    void applyCZ(int a, int b);
+
+    /// @brief Swaps qubits a and b
+    void applySWAP(int a, int b);
+
+    /**
+     * @brief Measures qubit q in the computational basis and collapses the state
+     * @param q Qubit index
+     * @param rng Source of the outcome when it is not determined by the state
+     * @return Outcome (0 or 1)
+     * @throws std::out_of_range if q is not a valid qubit
+     */
+    int measure(int q, std::mt19937_64& rng);
+
+    /**
+     * @brief Measures qubit q without fixing random outcomes
+     * @param q Qubit index
+     * @return Outcome as a parity of coins; a random outcome adds a new coin
+     * @throws std::out_of_range if q is not a valid qubit
+     *
+     * The state collapses as if the new coin were 0. Later gates and
+     * measurements keep tracking the coins, so their outcomes stay exact
+     * for every coin assignment.
+     */
+    ParityOutcome measureSymbolic(int q);
+
+    /**
+     * @brief Gets the number of coins drawn by measureSymbolic
+     * @return Coin count since construction or the last reset
+     */
+    std::size_t getCoinCount() const { return num_coins; }
+
+    /**
+     * @brief Checks whether measuring qubit q has a certain outcome
+     * @param q Qubit index
+     * @return True if Z_q (or -Z_q) is in the stabilizer group
+     */
+    bool isDeterministic(int q) const;
+
+    /**
+     * @brief Applies one lowered Clifford op
+     * @param op Gate or measurement
+     * @param rng Used by MEASURE
+     * @return Measurement outcome for MEASURE, -1 otherwise
+     */
+    int apply(const CliffordOp& op, std::mt19937_64& rng);
+
+    /**
+     * @brief Gets the stabilizer generators as signed Pauli strings
+     * @return n strings such as "+XX" or "-ZI"; character k is qubit k
+     */
+    std::vector<std::string> getStabilizers() const;
+
+private:
+    /// Register width n
+    int num_qubits;
+
+    /// 64-bit words per row
+    std::size_t words;
+
+    /// X bits of rows 0..2n, row-major
+    std::vector<std::uint64_t> xs;
+
+    /// Z bits of rows 0..2n, row-major
+    std::vector<std::uint64_t> zs;
+
+    /// Sign of each row (1 for -1)
+    std::vector<std::uint8_t> signs;
+
+    /// Coins drawn by measureSymbolic
+    std::size_t num_coins = 0;
+
+    /// 64-bit words per row of coin_masks (0 until the first coin)
+    std::size_t coin_words = 0;
+
+    /// Coins each row's sign depends on, row-major
+    std::vector<std::uint64_t> coin_masks;
+
+    /// Shared body of measure and measureSymbolic (rng is null for a new coin); returns the row holding ±Z_q
+    std::size_t measureImpl(int q, std::mt19937_64* rng);
+
+    /// Makes row depend on a fresh coin, widening coin_masks when needed
+    void addCoin(std::size_t row);
+
+    /// Throws std::out_of_range unless 0 <= q < n
+    void checkQubit(int q) const;
+
+    /// Reads the X bit of (row, q)
+    bool xBit(std::size_t row, int q) const;
+
+    /// Sets row h to the product row i * row h, tracking the sign
+    void rowMultiply(std::size_t h, std::size_t i);
+};
@@ -0,0 +1,198 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+// True while the current thread is executing chunks of a pool job
+thread_local bool in_pool_job = false;
+
+// Reads QS_NUM_THREADS; 0 (hardware concurrency) when unset or invalid
+unsigned threadsFromEnvironment() {
+    const char* value = std::getenv("QS_NUM_THREADS");
+    if (value == nullptr) {
+        return 0;
+    }
+    try {
+        return static_cast<unsigned>(std::stoul(value));
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned numThreads) {
+    startWorkers(numThreads);
+}
+
+ThreadPool::~ThreadPool() {
+    stopWorkers();
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool(threadsFromEnvironment());
+    return pool;
+}
+
+void ThreadPool::setThreadCount(unsigned numThreads) {
+    std::lock_guard<std::mutex> job_lock(job_mutex);
+    stopWorkers();
+    startWorkers(numThreads);
+}
+
+// Spawns numThreads - 1 workers; the thread calling parallelFor is the last one
+void ThreadPool::startWorkers(unsigned numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    thread_count = numThreads;
+    stopping = false;
+    for (unsigned i = 1; i < numThreads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, generation);
+    }
+}
+
+void ThreadPool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+// Sleeps until a new job generation is published, then helps drain its chunks
+void ThreadPool::workerLoop(std::uint64_t seen) {
+    in_pool_job = true;
+    std::unique_lock<std::mutex> lock(state_mutex);
+    while (true) {
+        work_ready.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        lock.unlock();
+        runChunks();
+        lock.lock();
+        if (--active_workers == 0) {
+            work_done.notify_all();
+        }
+    }
+}
+
+// Claims chunks until none remain; the first exception is kept for the caller
+void ThreadPool::runChunks() {
+    while (true) {
+        std::uint64_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= job_chunks) {
+            return;
+        }
+        std::uint64_t begin = job_begin + chunk * job_chunk;
+        std::uint64_t end = std::min(job_end, begin + job_chunk);
+        try {
+            (*job_body)(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            if (!job_error) {
+                job_error = std::current_exception();
+            }
+        }
+    }
+}
+
+void ThreadPool::parallelFor(std::uint64_t begin, std::uint64_t end, const RangeFunction& body) {
+    if (end <= begin) {
+        return;
+    }
+    std::uint64_t length = end - begin;
+    if (thread_count <= 1 || length < serial_threshold || in_pool_job) {
+        body(begin, end);
+        return;
+    }
+
+    // A few chunks per thread balances load without fragmenting SIMD loops
+    std::uint64_t target_chunks = std::uint64_t{thread_count} * 4;
+    std::uint64_t chunk = (length + target_chunks - 1) / target_chunks;
+    chunk = (chunk + CHUNK_GRANULARITY - 1) / CHUNK_GRANULARITY * CHUNK_GRANULARITY;
+    runJob(begin, end, chunk, body);
+}
+
+// Publishes one job to all workers, joins in, and waits for every worker to finish
+void ThreadPool::runJob(std::uint64_t begin, std::uint64_t end, std::uint64_t chunk, const RangeFunction& body) {
+    std::lock_guard<std::mutex> job_lock(job_mutex);
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        job_body = &body;
+        job_begin = begin;
+        job_end = end;
+        job_chunk = chunk;
+        job_chunks = (end - begin + chunk - 1) / chunk;
+        next_chunk.store(0, std::memory_order_relaxed);
+        active_workers = workers.size();
+        job_error = nullptr;
+        ++generation;
+    }
+    work_ready.notify_all();
+
+    in_pool_job = true;
+    runChunks();
+    in_pool_job = false;
+
+    std::exception_ptr error;
+    {
+        // Every worker reports back before the job fields can be reused
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_done.wait(lock, [&] { return active_workers == 0; });
+        error = job_error;
+        job_body = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+double ThreadPool::parallelSum(std::uint64_t begin, std::uint64_t end, const SumFunction& body) {
+    if (end <= begin) {
+        return 0.0;
+    }
+    std::uint64_t length = end - begin;
+    if (thread_count <= 1 || length < serial_threshold || in_pool_job) {
+        return body(begin, end);
+    }
+
+    // Fixed partitions so partial sums are combined in a deterministic order
+    std::uint64_t partitions = std::uint64_t{thread_count} * 4;
+    std::uint64_t chunk = (length + partitions - 1) / partitions;
+    chunk = (chunk + CHUNK_GRANULARITY - 1) / CHUNK_GRANULARITY * CHUNK_GRANULARITY;
+    partitions = (length + chunk - 1) / chunk;
+
+    std::vector<double> partials(partitions, 0.0);
+    runJob(0, partitions, 1, [&](std::uint64_t first, std::uint64_t last) {
+        for (std::uint64_t p = first; p < last; ++p) {
+            std::uint64_t chunk_begin = begin + p * chunk;
+            partials[p] = body(chunk_begin, std::min(end, chunk_begin + chunk));
+        }
+    });
+
+    double total = 0.0;
+    for (double partial : partials) {
+        total += partial;
+    }
+    return total;
+}
+
+void ThreadPool::parallelTasks(std::uint64_t count, const RangeFunction& body) {
+    if (thread_count <= 1 || count <= 1 || in_pool_job) {
+        for (std::uint64_t task = 0; task < count; ++task) {
+            body(task, task + 1);
+        }
+        return;
+    }
+    runJob(0, count, 1, body);
+}
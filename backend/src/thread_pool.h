@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Persistent worker pool for splitting state-vector sweeps
+ *
+ * Workers are started once and sleep between jobs, so a gate only pays a
+ * wake-up rather than thread creation. Index ranges smaller than the serial
+ * threshold run inline on the calling thread, which keeps small (GUI-sized)
+ * circuits free of any synchronization overhead.
+ *
+ * Kernels normally use the process-wide instance returned by global(),
+ * whose thread count defaults to std::thread::hardware_concurrency() and
+ * can be overridden with the QS_NUM_THREADS environment variable.
+ *
+ * @note Nested calls from inside a job run serially on the worker
+ * @note Concurrent callers are serialized; one job runs at a time
+ */
+class ThreadPool {
+public:
+    /// Range body: processes indices [begin, end)
+    using RangeFunction = std::function<void(std::uint64_t, std::uint64_t)>;
+
+    /// Range reduction body: returns the partial sum over [begin, end)
+    using SumFunction = std::function<double(std::uint64_t, std::uint64_t)>;
+
+    /// Default minimum range length before work is split across threads
+    static constexpr std::uint64_t DEFAULT_SERIAL_THRESHOLD = std::uint64_t{1} << 15;
+
+    /// Chunk boundaries are multiples of this (keeps SIMD loops on aligned pairs)
+    static constexpr std::uint64_t CHUNK_GRANULARITY = 64;
+
+    /**
+     * @brief Creates a pool with the given number of threads (including the caller)
+     * @param numThreads Total threads; 0 selects hardware_concurrency()
+     */
+    explicit ThreadPool(unsigned numThreads = 0);
+
+    /// Stops and joins all workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Returns the process-wide pool used by GateEngine and utils
+     * @return Shared ThreadPool instance
+     */
+    static ThreadPool& global();
+
+    /**
+     * @brief Restarts the pool with a new thread count
+     * @param numThreads Total threads; 0 selects hardware_concurrency()
+     */
+    void setThreadCount(unsigned numThreads);
+
+    /**
+     * @brief Gets the total number of threads used per job
+     * @return Worker count plus the calling thread
+     */
+    unsigned getThreadCount() const { return thread_count; }
+
+    /**
+     * @brief Sets the range length below which jobs run serially
+     * @param threshold Minimum number of indices worth splitting
+     */
+    void setSerialThreshold(std::uint64_t threshold) { serial_threshold = threshold; }
+
+    /**
+     * @brief Gets the serial threshold
+     * @return Minimum number of indices worth splitting
+     */
+    std::uint64_t getSerialThreshold() const { return serial_threshold; }
+
+    /**
+     * @brief Runs body over [begin, end) split into disjoint chunks
+     * @param begin First index (inclusive)
+     * @param end Last index (exclusive)
+     * @param body Called once per chunk; must be safe to run concurrently
+     * @throws Rethrows the first exception raised by any chunk
+     */
+    void parallelFor(std::uint64_t begin, std::uint64_t end, const RangeFunction& body);
+
+    /**
+     * @brief Sums body over disjoint chunks of [begin, end)
+     * @param begin First index (inclusive)
+     * @param end Last index (exclusive)
+     * @param body Returns the partial sum for one chunk
+     * @return Total of all partial sums (chunk order is deterministic)
+     */
+    double parallelSum(std::uint64_t begin, std::uint64_t end, const SumFunction& body);
+
+    /**
+     * @brief Runs count coarse tasks, one index per chunk, ignoring the serial threshold
+     * @param count Number of tasks; task i receives the range [i, i + 1)
+     * @param body Called once per task; must be safe to run concurrently
+     * @throws Rethrows the first exception raised by any task
+     *
+     * For work items that are each a whole simulation (e.g. noise
+     * trajectories). Kernels called from inside a task run serially.
+     */
+    void parallelTasks(std::uint64_t count, const RangeFunction& body);
+
+private:
+    /// Worker threads (thread_count - 1; the caller also executes chunks)
+    std::vector<std::thread> workers;
+
+    /// Total threads participating in a job
+    unsigned thread_count = 1;
+
+    /// Ranges shorter than this run inline
+    std::atomic<std::uint64_t> serial_threshold{DEFAULT_SERIAL_THRESHOLD};
+
+    /// Serializes concurrent parallelFor callers
+    std::mutex job_mutex;
+
+    /// Protects the job fields below and the worker wake-up
+    std::mutex state_mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+
+    /// Current job description
+    const RangeFunction* job_body = nullptr;
+    std::uint64_t job_begin = 0;
+    std::uint64_t job_chunk = 0;
+    std::uint64_t job_end = 0;
+    std::uint64_t job_chunks = 0;
+    std::atomic<std::uint64_t> next_chunk{0};
+    std::uint64_t active_workers = 0;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+    std::exception_ptr job_error;
+
+    void startWorkers(unsigned numThreads);
+    void stopWorkers();
+    void workerLoop(std::uint64_t seen);
+    void runChunks();
+    void runJob(std::uint64_t begin, std::uint64_t end, std::uint64_t chunk, const RangeFunction& body);
+};
@@ -1,24 +1,87 @@
 #include "utils.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+#include <cmath>
+#include <fstream>
 #include <iostream>
-#include <bitset>
+#include <stdexcept>
+#include <unistd.h>
 
 // Normalizes quantum state vector to unit norm
 // @param state Reference to quantum state vector to normalize
-void normalizeState(Eigen::VectorXcd& state) {
-    double norm = state.norm();
+void normalizeState(Eigen::Ref<Eigen::VectorXcd> state) {
+    const std::uint64_t dimension = state.size();
+    std::complex<double>* data = state.data();
+    ThreadPool& pool = ThreadPool::global();
+    double norm = std::sqrt(pool.parallelSum(0, dimension, [&](std::uint64_t begin, std::uint64_t end) {
+        return kernels::sumSquaredMagnitudes(data, begin, end);
+    }));
     if (norm > NORM_TOLERANCE) {
-        state /= norm;
+        pool.parallelFor(0, dimension, [&](std::uint64_t begin, std::uint64_t end) {
+            kernels::scaleAmplitudes(data, 1.0 / norm, begin, end);
+        });
     }
 }
 
 // Prints quantum state amplitudes above threshold in ket notation
 // @param state Reference to const quantum state vector to display
-void printState(const Eigen::VectorXcd& state) {
-    int dimension = state.size();
-    for (int i = 0; i < dimension; ++i) {
+void printState(const Eigen::Ref<const Eigen::VectorXcd>& state) {
+    std::uint64_t dimension = state.size();
+    int numQubits = 0;
+    while ((std::uint64_t{1} << numQubits) < dimension) {
+        ++numQubits;
+    }
+    for (std::uint64_t i = 0; i < dimension; ++i) {
         // Only display amplitudes above noise threshold to improve readability
         if (std::abs(state(i)) > AMPLITUDE_DISPLAY_THRESHOLD) {
-            std::cout << "| " << std::bitset<5>(i) << " ⟩ : " << state(i) << std::endl;
+            std::cout << "| " << formatBasisState(i, numQubits) << " ⟩ : " << state(i) << std::endl;
+        }
+    }
+}
+
+// Formats basis index as binary string, qubit (numQubits-1) leftmost
+std::string formatBasisState(std::uint64_t index, int numQubits) {
+    std::string bits(numQubits, '0');
+    for (int q = 0; q < numQubits; ++q) {
+        if ((index >> q) & 1) {
+            bits[numQubits - 1 - q] = '1';
         }
     }
+    return bits;
+}
+
+// Leftmost character is the highest qubit (inverse of formatBasisState)
+std::uint64_t parseBasisState(const std::string& stateString, int numQubits) {
+    if (static_cast<int>(stateString.length()) != numQubits) {
+        throw std::invalid_argument("Initial state length (" + std::to_string(stateString.length()) +
+                                    ") must match qubit count (" + std::to_string(numQubits) + ")");
+    }
+    std::uint64_t index = 0;
+    for (char c : stateString) {
+        if (c != '0' && c != '1') {
+            throw std::invalid_argument("Failed to parse initial state: invalid character '" +
+                                        std::string(1, c) + "'");
+        }
+        index = (index << 1) | static_cast<std::uint64_t>(c - '0');
+    }
+    return index;
+}
+
+// Reads MemAvailable from /proc/meminfo; falls back to total physical pages
+std::uint64_t availableMemoryBytes() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    std::uint64_t value = 0;
+    std::string unit;
+    while (meminfo >> key >> value >> unit) {
+        if (key == "MemAvailable:") {
+            return value * 1024;  // Reported in kB
+        }
+    }
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0) {
+        return UINT64_MAX;  // Unknown: do not block allocation
+    }
+    return static_cast<std::uint64_t>(pages) * static_cast<std::uint64_t>(page_size);
 }
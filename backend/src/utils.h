@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <cstdint>
+#include <string>
 
 /// Amplitude magnitude threshold for display (values below ignored)
 static constexpr double AMPLITUDE_DISPLAY_THRESHOLD = 1e-10;
@@ -15,12 +17,36 @@ static constexpr double NORM_TOLERANCE = 1e-6;
  * 
  * Ensures ||state|| = 1.0 within numerical precision.
  */
-void normalizeState(Eigen::VectorXcd& state);
+void normalizeState(Eigen::Ref<Eigen::VectorXcd> state);
 
 /**
  * @brief Prints quantum state to stdout
  * @param state State vector to display
  * 
  * Displays amplitudes above AMPLITUDE_DISPLAY_THRESHOLD threshold.
+ * The basis label width is derived from the vector dimension.
  */
-void printState(const Eigen::VectorXcd& state);
+void printState(const Eigen::Ref<const Eigen::VectorXcd>& state);
+
+/**
+ * @brief Formats a basis state index as a fixed-width binary string
+ * @param index Basis state index
+ * @param numQubits Number of qubits (label width)
+ * @return Binary string, most significant qubit first (e.g., "00101")
+ */
+std::string formatBasisState(std::uint64_t index, int numQubits);
+
+/**
+ * @brief Parses a binary basis-state label into an index
+ * @param stateString Binary string, most significant qubit first (e.g., "00101")
+ * @param numQubits Expected label width
+ * @return Basis state index
+ * @throws std::invalid_argument if the length differs from numQubits or a character is not 0/1
+ */
+std::uint64_t parseBasisState(const std::string& stateString, int numQubits);
+
+/**
+ * @brief Queries memory currently available to this process
+ * @return Available bytes (MemAvailable, falling back to physical memory)
+ */
+std::uint64_t availableMemoryBytes();
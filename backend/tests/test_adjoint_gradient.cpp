@@ -0,0 +1,147 @@
+#include "adjoint_gradient.h"
+#include "circuit_manager.h"
+#include "gate_engine.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace {
+
+// H = Z0 Z1 + 0.5 X2, applied in place
+void applyObservable(QubitManager& qubits) {
+    GateEngine engine;
+    QubitManager zz(qubits);
+    engine.applyPauliZ(zz, 0);
+    engine.applyPauliZ(zz, 1);
+    QubitManager x(qubits);
+    engine.applyPauliX(x, 2);
+    qubits.getState() = zz.getState() + 0.5 * x.getState();
+}
+
+double expectation(CircuitManager& circuit) {
+    QubitManager qubits(3);
+    circuit.executeCircuit(qubits);
+    QubitManager observed(qubits);
+    applyObservable(observed);
+    return qubits.getState().dot(observed.getState()).real();
+}
+
+// Variational ansatz using every rotation kind, with one shared parameter
+void buildAnsatz(CircuitManager& circuit) {
+    GateParameter a = circuit.parameter("a");
+    GateParameter b = circuit.parameter("b");
+    GateParameter c = circuit.parameter("c");
+    circuit.addParameterizedGate("RY", 0, {a});
+    circuit.addParameterizedGate("RX", 1, {b});
+    circuit.addGate("H", 2);
+    circuit.addGate("CNOT", 1, 0);
+    circuit.addParameterizedGate("RZ", 1, {c});
+    circuit.addParameterizedGate("U3", 2, {b, GateParameter{0.3}, c});
+    circuit.addGate("CNOT", 2, 1);
+    circuit.addParameterizedGate("PHASE", 0, {a});
+    circuit.addParameterizedGate("RY", 2, {GateParameter{0.7}});
+    circuit.addGate("H", 0);
+}
+
+}  // namespace
+
+// Test adjoint derivatives against central finite differences
+TEST(AdjointGradientTest, MatchesFiniteDifferences) {
+    CircuitManager circuit;
+    circuit.addParameter("a", 0.4);
+    circuit.addParameter("b", -1.1);
+    circuit.addParameter("c", 2.3);
+    buildAnsatz(circuit);
+
+    QubitManager qubits(3);
+    GradientResult result = circuit.adjointGradient(qubits, applyObservable);
+    EXPECT_NEAR(result.expectation, expectation(circuit), 1e-12);
+
+    // The register is returned to its initial state
+    EXPECT_NEAR(std::abs(qubits.getState()(0)), 1.0, 1e-12);
+
+    ASSERT_EQ(result.gradient.size(), 3u);
+    const double step = 1e-5;
+    for (std::size_t p = 0; p < 3; ++p) {
+        std::vector<double> values = circuit.getParameterValues();
+        values[p] += step;
+        circuit.bindParameters(values);
+        double plus = expectation(circuit);
+        values[p] -= 2 * step;
+        circuit.bindParameters(values);
+        double minus = expectation(circuit);
+        values[p] += step;
+        circuit.bindParameters(values);
+        EXPECT_NEAR(result.gradient[p], (plus - minus) / (2 * step), 1e-8) << circuit.getParameterNames()[p];
+    }
+}
+
+// Test rebinding the cached plan gives the same state as a fresh compile
+TEST(AdjointGradientTest, RebindingMatchesRecompile) {
+    CircuitManager circuit;
+    circuit.addParameter("a");
+    circuit.addParameter("b");
+    circuit.addParameter("c");
+    buildAnsatz(circuit);
+
+    QubitManager before(3);
+    circuit.executeCircuit(before);
+    const int sweeps = circuit.getFusionStats().sweeps_after;
+
+    circuit.setParameter("b", 0.9);
+    circuit.bindParameters({0.2, 0.9, -0.4});
+    QubitManager rebound(3);
+    circuit.executeCircuit(rebound);
+    EXPECT_EQ(circuit.getFusionStats().sweeps_after, sweeps);
+
+    CircuitManager fresh;
+    fresh.addParameter("a", 0.2);
+    fresh.addParameter("b", 0.9);
+    fresh.addParameter("c", -0.4);
+    buildAnsatz(fresh);
+    QubitManager expected(3);
+    fresh.executeCircuit(expected);
+    EXPECT_LT((rebound.getState() - expected.getState()).norm(), 1e-12);
+
+    // A user-held plan can be rebound directly as well
+    CompiledCircuit plan = circuit.compile(3);
+    bindParameters(plan, {0.2, 0.9, -0.4});
+    QubitManager replayed(3);
+    circuit.executeCompiled(plan, replayed);
+    EXPECT_LT((replayed.getState() - expected.getState()).norm(), 1e-12);
+}
+
+// Test rotation matrices, parameter errors and unsupported circuits
+TEST(AdjointGradientTest, RotationsAndErrors) {
+    GateEngine engine;
+    QubitManager qubits(1);
+    engine.applyRotation(qubits, OpCode::RY, 0, {M_PI});
+    EXPECT_NEAR(qubits.getState()(1).real(), 1.0, 1e-12);
+    engine.applyRotation(qubits, OpCode::U3, 0, {M_PI, 0.0, 0.0});
+    EXPECT_NEAR(qubits.getState()(0).real(), -1.0, 1e-12);
+    EXPECT_THROW(engine.applyRotation(qubits, OpCode::RX, 0, {}), std::invalid_argument);
+    EXPECT_THROW(engine.applyRotation(qubits, OpCode::Hadamard, 0, {}), std::invalid_argument);
+
+    CircuitManager circuit;
+    circuit.addParameter("theta");
+    EXPECT_THROW(circuit.addParameter("theta"), std::invalid_argument);
+    EXPECT_THROW(circuit.parameter("phi"), std::invalid_argument);
+    EXPECT_THROW(circuit.setParameter("phi", 1.0), std::invalid_argument);
+    EXPECT_THROW(circuit.bindParameters({1.0, 2.0}), std::invalid_argument);
+
+    // Too few angles, and symbolic angles on controlled gates, fail at compile time
+    CircuitManager missing;
+    missing.addParameterizedGate("U3", 0, {GateParameter{0.1}});
+    EXPECT_THROW(missing.compile(1), std::invalid_argument);
+    CircuitManager controlled;
+    controlled.addParameter("theta");
+    controlled.addParameterizedGate("RZ", 1, {controlled.parameter("theta")}, {0});
+    EXPECT_THROW(controlled.compile(2), std::invalid_argument);
+
+    CircuitManager measured;
+    measured.addParameter("theta");
+    measured.addParameterizedGate("RX", 0, {measured.parameter("theta")});
+    measured.addGate("MEASURE", 0);
+    QubitManager one(1);
+    EXPECT_THROW(measured.adjointGradient(one, [](QubitManager&) {}), std::invalid_argument);
+}
@@ -0,0 +1,67 @@
+#include "batched_state.h"
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include "utils.h"
+#include <gtest/gtest.h>
+
+// Builds a circuit touching every op kind the batched executor must shift
+static CircuitManager batchCircuit() {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    circuit.addGate("CNOT", 2, 0);
+    circuit.addGate("Y", 3);
+    circuit.addGate("SWAP", 1, 4);
+    circuit.addGate("TOFFOLI", 4, 0, 2);
+    circuit.addControlledGate("CPHASE", 3, {1}, {4}, 0.7);
+    circuit.addGate("H", 2);
+    circuit.addGate("Z", 2);
+    return circuit;
+}
+
+// Test every member of a batch matches running the circuit on it alone
+TEST(BatchedStateTest, BatchMatchesIndividualRuns) {
+    const int numQubits = 5;
+    const std::uint64_t members = 37;  // Not a power of two: exercises padding
+    for (int width : {0, 2, 3}) {
+        CircuitManager circuit = batchCircuit();
+        circuit.setMaxFusedWidth(width);
+
+        BatchedState batch(numQubits, members);
+        EXPECT_EQ(batch.getNumBlocks() * batch.getBlockWidth() >= members, true);
+        for (std::uint64_t m = 0; m < members; ++m) {
+            batch.setInitialState(m, formatBasisState(m % 32, numQubits));
+        }
+        circuit.executeBatch(batch);
+
+        for (std::uint64_t m = 0; m < members; ++m) {
+            QubitManager expected(numQubits);
+            expected.setInitialState(formatBasisState(m % 32, numQubits));
+            circuit.executeCircuit(expected);
+
+            QubitManager actual(numQubits);
+            batch.storeState(m, actual);
+            EXPECT_TRUE(actual.getState().isApprox(expected.getState(), 1e-12))
+                << "member " << m << " width " << width;
+        }
+    }
+}
+
+// Test load/store round trips and argument checking
+TEST(BatchedStateTest, LoadStoreAndValidation) {
+    BatchedState batch(3, 4);
+    QubitManager source(3);
+    source.setInitialState("110");
+    batch.loadState(2, source);
+    EXPECT_EQ(batch.amplitude(6, 2), std::complex<double>(1.0, 0.0));
+    EXPECT_EQ(batch.amplitude(0, 1), std::complex<double>(1.0, 0.0));
+
+    QubitManager wrong(2);
+    EXPECT_THROW(batch.loadState(0, wrong), std::invalid_argument);
+    EXPECT_THROW(batch.setInitialState(4, "000"), std::out_of_range);
+    EXPECT_THROW(BatchedState(BatchedState::MAX_QUBITS + 1, 2), std::invalid_argument);
+    EXPECT_THROW(BatchedState(3, 0), std::invalid_argument);
+
+    CircuitManager measured;
+    measured.addGate("MEASURE", 0);
+    EXPECT_THROW(measured.executeBatch(batch), std::invalid_argument);
+}
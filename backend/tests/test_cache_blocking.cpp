@@ -0,0 +1,129 @@
+#include "cache_blocking.h"
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <random>
+
+// Builds a random circuit over every gate kind, with gates on high qubits
+static CircuitManager randomCircuit(int qubits, int gates, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> qubit(0, qubits - 1);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    CircuitManager circuit;
+    for (int g = 0; g < gates; ++g) {
+        int a = qubit(rng), b = qubit(rng), c = qubit(rng);
+        while (b == a) b = qubit(rng);
+        while (c == a || c == b) c = qubit(rng);
+        switch (rng() % 8) {
+            case 0: circuit.addGate("H", a); break;
+            case 1: circuit.addGate("CNOT", a, b); break;
+            case 2: circuit.addGate("TOFFOLI", a, b, c); break;
+            case 3: circuit.addGate("SWAP", a, b); break;
+            case 4: circuit.addParameterizedGate("RY", a, {GateParameter{angle(rng)}}); break;
+            case 5: circuit.addParameterizedGate("PHASE", a, {GateParameter{angle(rng)}}); break;
+            case 6: circuit.addControlledGate("Y", a, {b}, {c}); break;
+            default: circuit.addGate("CZ", a, b); break;
+        }
+    }
+    return circuit;
+}
+
+// Test blocked plans reproduce the plain plan for several block widths, fused or not
+TEST(CacheBlockingTest, MatchesUnblockedExecution) {
+    constexpr int qubits = 9;
+    CircuitManager circuit = randomCircuit(qubits, 120, 5);
+    circuit.addGate("MEASURE", 8);
+    circuit.addGate("H", 8);
+    circuit.addGate("MEASURE", 1);
+
+    for (int width : {0, 2, 3}) {
+        circuit.setMaxFusedWidth(width);
+        CompiledCircuit plan = circuit.compile(qubits);
+        if (width > 0) {
+            fuseGates(plan, width);
+        }
+        QubitManager reference(qubits);
+        circuit.setSeed(2);
+        std::vector<int> expected = circuit.executeCompiled(plan, reference);
+
+        for (int block = 3; block <= qubits; ++block) {
+            BlockedCircuit blocked = blockCircuit(plan, block);
+            QubitManager state(qubits);
+            GateEngine engine;
+            engine.setSeed(2);
+            std::vector<int> results;
+            engine.executeBlocked(state, blocked, results);
+            EXPECT_EQ(results, expected) << "block " << block;
+            EXPECT_NEAR((state.getState() - reference.getState()).norm(), 0.0, 1e-10) << "block " << block;
+            if (block == qubits) {
+                EXPECT_EQ(blocked.stats.swaps, 0);
+            }
+        }
+    }
+}
+
+// Test a deep circuit on low qubits runs as one pass, and high controls need no SWAP
+TEST(CacheBlockingTest, LowGatesShareOnePass) {
+    CircuitManager circuit;
+    for (int layer = 0; layer < 10; ++layer) {
+        for (int q = 0; q < 4; ++q) {
+            circuit.addGate("H", q);
+        }
+        circuit.addGate("CNOT", 0, 7);
+        circuit.addGate("TOFFOLI", 1, 6, 5);
+    }
+    CompiledCircuit plan = circuit.compile(8);
+    BlockedCircuit blocked = blockCircuit(plan, 4);
+    EXPECT_EQ(blocked.stats.sweeps_before, 60);
+    EXPECT_EQ(blocked.stats.sweeps_after, 1);
+    EXPECT_EQ(blocked.stats.swaps, 0);
+
+    // A high target is swapped in once and stays low while it is reused
+    circuit.addGate("H", 7);
+    circuit.addGate("X", 7);
+    circuit.addGate("H", 0);
+    blocked = blockCircuit(circuit.compile(8), 4);
+    EXPECT_EQ(blocked.stats.swaps, 2);  // In, then back to the identity layout
+    EXPECT_EQ(blocked.stats.sweeps_after, 4);
+
+    EXPECT_THROW(blockCircuit(plan, 2), std::invalid_argument);
+}
+
+// Test CircuitManager blocks registers past MIN_BLOCKED_QUBITS and matches the plain sweep
+TEST(CacheBlockingTest, CircuitManagerBlocksWideRegisters) {
+    CircuitManager circuit = randomCircuit(MIN_BLOCKED_QUBITS, 40, 9);
+    QubitManager blocked(MIN_BLOCKED_QUBITS);
+    circuit.executeCircuit(blocked);
+    const BlockingStats& stats = circuit.getBlockingStats();
+    EXPECT_GT(stats.sweeps_before, stats.sweeps_after);
+
+    circuit.setBlockQubits(0);
+    QubitManager plain(MIN_BLOCKED_QUBITS);
+    circuit.executeCircuit(plain);
+    EXPECT_NEAR((blocked.getState() - plain.getState()).norm(), 0.0, 1e-10);
+
+    EXPECT_THROW(circuit.setBlockQubits(2), std::invalid_argument);
+    EXPECT_THROW(circuit.setBlockQubits(QubitManager::MAX_QUBITS + 1), std::invalid_argument);
+}
+
+// Test chunk widths follow available memory and stay within the register
+TEST(CacheBlockingTest, OutOfCoreBlockWidth) {
+    const std::size_t amplitude = sizeof(std::complex<double>);
+    // 1 GiB available: chunks of 256 MiB hold 2^24 amplitudes
+    EXPECT_EQ(outOfCoreBlockQubits(34, amplitude, std::uint64_t{1} << 30), 24);
+    EXPECT_EQ(outOfCoreBlockQubits(34, amplitude / 2, std::uint64_t{1} << 30), 25);
+    EXPECT_EQ(outOfCoreBlockQubits(20, amplitude, std::uint64_t{1} << 30), 20);
+    EXPECT_EQ(outOfCoreBlockQubits(34, amplitude, 0), kernels::MAX_DENSE_QUBITS);
+}
+
+// Test a file-backed register matches the in-memory sweep
+TEST(CacheBlockingTest, FileBackedRegisterMatchesInMemory) {
+    constexpr int qubits = MIN_BLOCKED_QUBITS;
+    CircuitManager circuit = randomCircuit(qubits, 40, 21);
+    QubitManager mapped(qubits, ::testing::TempDir() + "cache_blocking_backing.bin");
+    circuit.executeCircuit(mapped);
+
+    QubitManager memory(qubits);
+    circuit.executeCircuit(memory);
+    EXPECT_NEAR((mapped.getState() - memory.getState()).norm(), 0.0, 1e-10);
+}
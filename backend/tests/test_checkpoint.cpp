@@ -0,0 +1,158 @@
+#include "checkpoint.h"
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <unistd.h>
+
+// Builds a random circuit whose gates fuse across any split point
+static CircuitManager randomCircuit(int qubits, int gates, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> qubit(0, qubits - 1);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    CircuitManager circuit;
+    for (int g = 0; g < gates; ++g) {
+        int a = qubit(rng), b = qubit(rng);
+        while (b == a) b = qubit(rng);
+        switch (rng() % 5) {
+            case 0: circuit.addGate("H", a); break;
+            case 1: circuit.addGate("CNOT", a, b); break;
+            case 2: circuit.addParameterizedGate("RY", a, {GateParameter{angle(rng)}}); break;
+            case 3: circuit.addControlledGate("PHASE", a, {b}, {}, angle(rng)); break;
+            default: circuit.addParameterizedGate("U3", a, {GateParameter{angle(rng)}, GateParameter{angle(rng)},
+                                                           GateParameter{angle(rng)}}); break;
+        }
+    }
+    return circuit;
+}
+
+static std::string tempPath(const std::string& name) {
+    return ::testing::TempDir() + name;
+}
+
+// Test a saved register maps back bit-exactly, with its header fields
+TEST(CheckpointTest, RoundTripsBothPrecisions) {
+    const std::string path = tempPath("checkpoint_roundtrip.qsc");
+    CircuitManager circuit = randomCircuit(7, 50, 1);
+    QubitManager qubits(7);
+    circuit.executeCircuit(qubits);
+    saveCheckpoint(path, qubits, 50);
+
+    CheckpointInfo info = readCheckpointInfo(path);
+    EXPECT_EQ(info.num_qubits, 7);
+    EXPECT_EQ(info.precision_bytes, 8);
+    EXPECT_EQ(info.layout, StateLayout::Interleaved);
+    EXPECT_EQ(info.next_gate, 50u);
+    EXPECT_EQ(info.payload_bytes, 128u * 16);
+    EXPECT_TRUE(info.has_checksum);
+
+    QubitManager loaded = loadCheckpoint<double>(path);
+    EXPECT_TRUE(loaded.isFileBacked());
+    EXPECT_EQ((loaded.getState() - qubits.getState()).norm(), 0.0);
+
+    // Writes go to private pages, never to the file
+    loaded.initializeZeroState();
+    EXPECT_EQ((loadCheckpoint<double>(path).getState() - qubits.getState()).norm(), 0.0);
+    EXPECT_THROW(loadCheckpoint<float>(path), std::runtime_error);
+
+    QubitManagerF single(5);
+    single.setInitialState("10110");
+    saveCheckpoint(path, single, 0, false);
+    EXPECT_FALSE(readCheckpointInfo(path).has_checksum);
+    EXPECT_EQ(loadCheckpoint<float>(path).getState()(22), std::complex<float>(1.0f, 0.0f));
+    std::remove(path.c_str());
+}
+
+// Test split-layout states round-trip and are not mistaken for interleaved ones
+TEST(CheckpointTest, RoundTripsSplitLayout) {
+    const std::string path = tempPath("checkpoint_split.qsc");
+    QubitManager qubits(6);
+    randomCircuit(6, 30, 2).executeCircuit(qubits);
+    SplitState split(qubits);
+    saveCheckpoint(path, split, 3);
+
+    EXPECT_EQ(readCheckpointInfo(path).layout, StateLayout::Split);
+    SplitState loaded = loadSplitCheckpoint(path);
+    for (std::uint64_t i = 0; i < split.getDimension(); ++i) {
+        EXPECT_EQ(loaded.amplitude(i), split.amplitude(i));
+    }
+    EXPECT_THROW(loadCheckpoint<double>(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+// Test corrupt, truncated and foreign files are rejected
+TEST(CheckpointTest, RejectsDamagedFiles) {
+    const std::string path = tempPath("checkpoint_damaged.qsc");
+    QubitManager qubits(8);
+    randomCircuit(8, 20, 3).executeCircuit(qubits);
+    saveCheckpoint(path, qubits);
+
+    // Flip one payload byte: the header still decodes but the checksum fails
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(CHECKPOINT_HEADER_BYTES + 1000);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte ^= 0x10;
+        file.seekp(CHECKPOINT_HEADER_BYTES + 1000);
+        file.write(&byte, 1);
+    }
+    EXPECT_EQ(readCheckpointInfo(path).num_qubits, 8);
+    EXPECT_THROW(loadCheckpoint<double>(path), std::runtime_error);
+    EXPECT_NO_THROW(loadCheckpoint<double>(path, false));
+
+    ASSERT_EQ(::truncate(path.c_str(), CHECKPOINT_HEADER_BYTES + 100), 0);
+    EXPECT_THROW(readCheckpointInfo(path), std::runtime_error);
+
+    std::ofstream(path, std::ios::binary) << "not a checkpoint at all";
+    EXPECT_THROW(readCheckpointInfo(path), std::runtime_error);
+    EXPECT_THROW(readCheckpointInfo(tempPath("checkpoint_missing.qsc")), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+// Test the checksum is independent of how the work is split and sensitive to every block
+TEST(CheckpointTest, ChecksumCoversEveryByte) {
+    std::vector<unsigned char> data((3 << 20) + 17);
+    std::mt19937_64 rng(4);
+    for (auto& byte : data) byte = static_cast<unsigned char>(rng());
+    const std::uint64_t hash = checksum64(data.data(), data.size());
+    EXPECT_EQ(checksum64(data.data(), data.size()), hash);
+    for (std::size_t position : {std::size_t{0}, std::size_t{1} << 20, data.size() - 1}) {
+        data[position] ^= 1;
+        EXPECT_NE(checksum64(data.data(), data.size()), hash);
+        data[position] ^= 1;
+    }
+    EXPECT_NE(checksum64(data.data(), data.size() - 1), hash);
+}
+
+// Test splitting a run at a checkpoint and resuming gives the uninterrupted result
+TEST(CheckpointTest, ResumesFromGateIndex) {
+    const std::string path = tempPath("checkpoint_resume.qsc");
+    constexpr int qubits = 8;
+    CircuitManager circuit = randomCircuit(qubits, 120, 5);
+
+    QubitManager reference(qubits);
+    circuit.executeCircuit(reference);
+
+    QubitManager checkpointed(qubits);
+    circuit.executeWithCheckpoint(checkpointed, 47, path);
+    EXPECT_NEAR((checkpointed.getState() - reference.getState()).norm(), 0.0, 1e-10);
+    EXPECT_EQ(readCheckpointInfo(path).next_gate, 47u);
+
+    QubitManager resumed = circuit.resumeFromCheckpoint<double>(path);
+    EXPECT_NEAR((resumed.getState() - reference.getState()).norm(), 0.0, 1e-10);
+
+    // Ranges compose, and an explicit prefix equals the saved state
+    QubitManager prefix(qubits);
+    circuit.executeCircuit(prefix, 0, 47);
+    EXPECT_EQ((prefix.getState() - loadCheckpoint<double>(path).getState()).norm(), 0.0);
+    EXPECT_THROW(circuit.executeCircuit(prefix, 50, 40), std::out_of_range);
+    EXPECT_THROW(circuit.executeCircuit(prefix, 0, 121), std::out_of_range);
+
+    // A circuit shorter than the checkpoint cannot resume it
+    CircuitManager shorter = randomCircuit(qubits, 30, 5);
+    EXPECT_THROW(shorter.resumeFromCheckpoint<double>(path), std::out_of_range);
+    std::remove(path.c_str());
+}
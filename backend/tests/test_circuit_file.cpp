@@ -0,0 +1,159 @@
+#include "circuit_file.h"
+#include "circuit_manager.h"
+#include "qasm_parser.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+static std::string tempPath(const std::string& name) {
+    return ::testing::TempDir() + name;
+}
+
+// One gate of every shape the format encodes: plain, controlled, negative
+// controls, symbolic and constant angles, and a custom matrix
+static CircuitManager mixedCircuit() {
+    CircuitManager circuit;
+    circuit.addParameter("theta", 0.7);
+    circuit.addParameter("phi", -1.1);
+    circuit.addGate("H", 0);
+    circuit.addGate("cnot", 1, 0);
+    circuit.addGate("TOFFOLI", 2, 0, 1);
+    circuit.addControlledGate("X", 4, {0, 1}, {2});
+    circuit.addControlledGate("CPHASE", 3, {4}, {}, 0.25);
+    circuit.addParameterizedGate("RY", 2, {circuit.parameter("theta")});
+    circuit.addParameterizedGate("U3", 1, {GateParameter{0.3}, circuit.parameter("phi"), GateParameter{1.9}});
+    const double h = 1.0 / std::sqrt(2.0);
+    circuit.addControlledUnitary({h, std::complex<double>(0.0, h), std::complex<double>(0.0, h), h}, 3, {1});
+    circuit.addGate("SWAP", 0, 4);
+    return circuit;
+}
+
+// Test every gate field, the parameter table and the simulated state survive a round trip
+TEST(CircuitFileTest, RoundTripsEveryGateField) {
+    const std::string path = tempPath("circuit_roundtrip.qcf");
+    CircuitManager circuit = mixedCircuit();
+    circuit.saveCircuit(path);
+
+    CircuitFileInfo info = readCircuitFileInfo(path);
+    EXPECT_EQ(info.num_qubits, 5);
+    EXPECT_EQ(info.gate_count, 9u);
+    EXPECT_EQ(info.parameter_count, 2);
+    EXPECT_TRUE(isCircuitFile(path));
+
+    CircuitManager loaded;
+    loaded.addGate("X", 0);  // Replaced by the load
+    EXPECT_EQ(loaded.loadCircuit(path).gate_count, 9u);
+    ASSERT_EQ(loaded.getCircuitSize(), circuit.getCircuitSize());
+    for (int g = 0; g < circuit.getCircuitSize(); ++g) {
+        const GateOperation& a = circuit.getGate(g);
+        const GateOperation& b = loaded.getGate(g);
+        EXPECT_EQ(a.gate_name, b.gate_name);
+        EXPECT_EQ(a.target_qubit, b.target_qubit);
+        EXPECT_EQ(a.control_qubit1, b.control_qubit1);
+        EXPECT_EQ(a.control_qubit2, b.control_qubit2);
+        EXPECT_EQ(a.controls, b.controls);
+        EXPECT_EQ(a.negative_controls, b.negative_controls);
+        ASSERT_EQ(a.parameters.size(), b.parameters.size());
+        for (std::size_t p = 0; p < a.parameters.size(); ++p) {
+            EXPECT_EQ(a.parameters[p].value, b.parameters[p].value);
+            EXPECT_EQ(a.parameters[p].symbol, b.parameters[p].symbol);
+        }
+        EXPECT_EQ(a.matrix, b.matrix);
+    }
+    EXPECT_EQ(loaded.getParameterNames(), circuit.getParameterNames());
+    EXPECT_EQ(loaded.getParameterValues(), circuit.getParameterValues());
+
+    QubitManager expected(5), actual(5);
+    circuit.executeCircuit(expected);
+    loaded.executeCircuit(actual);
+    EXPECT_EQ((expected.getState() - actual.getState()).norm(), 0.0);
+
+    // Symbols stay symbolic after loading
+    loaded.setParameter("theta", 2.0);
+    circuit.setParameter("theta", 2.0);
+    expected.initializeZeroState();
+    actual.initializeZeroState();
+    circuit.executeCircuit(expected);
+    loaded.executeCircuit(actual);
+    EXPECT_EQ((expected.getState() - actual.getState()).norm(), 0.0);
+
+    CircuitManager empty;
+    empty.saveCircuit(path);
+    EXPECT_EQ(loaded.loadCircuit(path).num_qubits, 0);
+    EXPECT_EQ(loaded.getCircuitSize(), 0);
+    EXPECT_TRUE(loaded.getParameterNames().empty());
+    std::remove(path.c_str());
+}
+
+// Test corrupt, truncated and foreign files are rejected and leave the circuit intact
+TEST(CircuitFileTest, RejectsDamagedFiles) {
+    const std::string path = tempPath("circuit_damaged.qcf");
+    mixedCircuit().saveCircuit(path);
+    const CircuitFileInfo info = readCircuitFileInfo(path);
+
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(info.file_bytes) - 20);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte ^= 0x01;
+        file.seekp(static_cast<std::streamoff>(info.file_bytes) - 20);
+        file.write(&byte, 1);
+    }
+    EXPECT_EQ(readCircuitFileInfo(path).gate_count, 9u);
+    EXPECT_THROW(circuit.loadCircuit(path), std::runtime_error);
+    EXPECT_EQ(circuit.getCircuitSize(), 1);
+
+    ASSERT_EQ(::truncate(path.c_str(), static_cast<off_t>(info.file_bytes) - 8), 0);
+    EXPECT_THROW(readCircuitFileInfo(path), std::runtime_error);
+    EXPECT_THROW(circuit.loadCircuit(path), std::runtime_error);
+
+    std::ofstream(path, std::ios::binary) << "OPENQASM 2.0;";
+    EXPECT_FALSE(isCircuitFile(path));
+    EXPECT_THROW(circuit.loadCircuit(path), std::runtime_error);
+    EXPECT_FALSE(isCircuitFile(tempPath("circuit_missing.qcf")));
+    EXPECT_THROW(circuit.loadCircuit(tempPath("circuit_missing.qcf")), std::runtime_error);
+    EXPECT_EQ(circuit.getCircuitSize(), 1);
+    std::remove(path.c_str());
+}
+
+// Test a converted QASM program loads back to the circuit the parser builds
+TEST(CircuitFileTest, ConvertsQasmPrograms) {
+    const std::string qasm_path = tempPath("circuit_convert.qasm");
+    const std::string circuit_path = tempPath("circuit_convert.qcf");
+    std::ofstream(qasm_path) << R"(OPENQASM 2.0;
+include "qelib1.inc";
+gate bell a, b { h a; cx a, b; }
+qreg q[4];
+creg c[4];
+bell q[0], q[1];
+cu3(0.4, 0.2, -0.3) q[1], q[2];
+ccx q[0], q[2], q[3];
+rz(pi/8) q;
+measure q -> c;
+)";
+    CircuitManager parsed;
+    parseQasmFile(qasm_path, parsed);
+
+    CircuitFileInfo info = convertQasmToCircuitFile(qasm_path, circuit_path);
+    EXPECT_EQ(info.num_qubits, 4);
+    EXPECT_EQ(info.gate_count, static_cast<std::uint64_t>(parsed.getCircuitSize()));
+
+    CircuitManager loaded;
+    loaded.loadCircuit(circuit_path);
+    QubitManager expected(4), actual(4);
+    parsed.setSeed(9);
+    loaded.setSeed(9);
+    parsed.executeCircuit(expected);
+    loaded.executeCircuit(actual);
+    EXPECT_EQ((expected.getState() - actual.getState()).norm(), 0.0);
+
+    std::ofstream(qasm_path) << "OPENQASM 2.0;\nqreg q[1];\nfoo q[0];\n";
+    EXPECT_THROW(convertQasmToCircuitFile(qasm_path, circuit_path), QasmError);
+    std::remove(qasm_path.c_str());
+    std::remove(circuit_path.c_str());
+}
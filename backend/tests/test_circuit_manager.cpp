@@ -15,3 +15,123 @@ TEST(CircuitManagerTest, CircuitExecution) {
     EXPECT_NEAR(std::abs(qubits.getState()(0)), 1.0 / std::sqrt(2), 1e-6);
     EXPECT_NEAR(std::abs(qubits.getState()(3)), 1.0 / std::sqrt(2), 1e-6);
 }
+
+// Test that a compiled plan can be replayed and reports measurements by slot
+TEST(CircuitManagerTest, CompiledPlanReplay) {
+    CircuitManager circuit;
+    circuit.addGate("x", 0);
+    circuit.addGate("Toffoli", 2, 0, 1);
+    circuit.addGate("cnot", 1, 0);
+    circuit.addGate("MEASURE", 1);
+
+    CompiledCircuit plan = circuit.compile(3);
+    ASSERT_EQ(plan.ops.size(), 4u);
+    EXPECT_EQ(plan.ops[0].opcode, OpCode::PauliX);
+    EXPECT_EQ(plan.measurement_gates, std::vector<int>{3});
+
+    for (int run = 0; run < 3; ++run) {
+        QubitManager qubits(3);
+        std::vector<int> results = circuit.executeCompiled(plan, qubits);
+        ASSERT_EQ(results.size(), 1u);
+        EXPECT_EQ(results[0], 1);
+        EXPECT_NEAR(std::abs(qubits.getState()(3)), 1.0, 1e-12);
+    }
+
+    QubitManager wrong_width(4);
+    EXPECT_THROW(circuit.executeCompiled(plan, wrong_width), std::invalid_argument);
+}
+
+// Test that validation errors surface at compile time
+TEST(CircuitManagerTest, CompileRejectsInvalidGates) {
+    CircuitManager unknown;
+    unknown.addGate("FOO", 0);
+    EXPECT_THROW(unknown.compile(2), std::invalid_argument);
+
+    CircuitManager out_of_range;
+    out_of_range.addGate("H", 5);
+    EXPECT_THROW(out_of_range.compile(2), std::out_of_range);
+
+    CircuitManager missing_control;
+    missing_control.addGate("CNOT", 1);
+    EXPECT_THROW(missing_control.compile(2), std::invalid_argument);
+
+    // The cached plan is rebuilt once the circuit is fixed
+    QubitManager qubits(2);
+    missing_control.removeGate(0);
+    missing_control.addGate("X", 1);
+    missing_control.executeCircuit(qubits);
+    EXPECT_NEAR(std::abs(qubits.getState()(2)), 1.0, 1e-12);
+}
+
+// Test controlled aliases, multi-controlled X and negative controls
+TEST(CircuitManagerTest, MultiControlledGates) {
+    CircuitManager circuit;
+    circuit.addGate("X", 0);
+    circuit.addGate("X", 1);
+    circuit.addControlledGate("X", 3, {0, 1}, {2});         // q3 ^= q0 & q1 & !q2
+    circuit.addGate("TOFFOLI", 3, 0, 1);                     // undoes it
+    circuit.addControlledGate("MCX", 4, {0, 1}, {2});       // q4 ^= q0 & q1 & !q2
+    circuit.addGate("H", 2);
+    circuit.addGate("CZ", 2, 4);
+    circuit.addControlledGate("CPHASE", 2, {4}, {}, M_PI);  // cancels the CZ
+    circuit.addGate("H", 2);
+
+    QubitManager qubits(5);
+    circuit.executeCircuit(qubits);
+    EXPECT_NEAR(std::abs(qubits.getState()(0b10011)), 1.0, 1e-12);
+
+    circuit.setMaxFusedWidth(0);
+    QubitManager unfused(5);
+    circuit.executeCircuit(unfused);
+    EXPECT_TRUE(unfused.getState().isApprox(qubits.getState(), 1e-12));
+
+    CircuitManager missing;
+    missing.addGate("CZ", 1);
+    EXPECT_THROW(missing.compile(2), std::invalid_argument);
+
+    CircuitManager measured;
+    measured.addControlledGate("MEASURE", 0, {1});
+    EXPECT_THROW(measured.compile(2), std::invalid_argument);
+}
+
+// Test a single-precision register follows the double one through a deep random circuit
+TEST(CircuitManagerTest, SinglePrecisionTracksDouble) {
+    constexpr int qubits = 12;
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> qubit(0, qubits - 1);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    CircuitManager circuit;
+    for (int g = 0; g < 600; ++g) {
+        int a = qubit(rng), b = qubit(rng);
+        while (b == a) b = qubit(rng);
+        switch (rng() % 5) {
+            case 0: circuit.addGate("H", a); break;
+            case 1: circuit.addGate("CNOT", a, b); break;
+            case 2: circuit.addParameterizedGate("RY", a, {GateParameter{angle(rng)}}); break;
+            case 3: circuit.addParameterizedGate("RZ", a, {GateParameter{angle(rng)}}); break;
+            default: circuit.addControlledGate("PHASE", a, {b}, {}, angle(rng)); break;
+        }
+    }
+
+    QubitManager exact(qubits);
+    QubitManagerF approx(qubits);
+    circuit.executeCircuit(exact);
+    circuit.executeCircuit(approx);
+    double max_error = 0.0;
+    for (std::uint64_t i = 0; i < exact.getDimension(); ++i) {
+        max_error = std::max(max_error, std::abs(std::complex<double>(approx.getState()(i)) - exact.getState()(i)));
+    }
+    EXPECT_LT(max_error, 1e-5);
+    EXPECT_NEAR(approx.getState().cast<std::complex<double>>().norm(), 1.0, 1e-5);
+    EXPECT_EQ(QubitManagerF::estimateMemoryBytes(qubits) * 2, QubitManager::estimateMemoryBytes(qubits));
+
+    // Sampling and measurement run on the float register as well
+    circuit.addGate("MEASURE", 0);
+    QubitManagerF sampled(qubits);
+    Histogram histogram = circuit.sample(sampled, 1000);
+    std::uint64_t total = 0;
+    for (const auto& [bits, count] : histogram) {
+        total += count;
+    }
+    EXPECT_EQ(total, 1000u);
+}
@@ -0,0 +1,144 @@
+#include "density_matrix.h"
+#include "circuit_manager.h"
+#include <gtest/gtest.h>
+#include <Eigen/Dense>
+#include <cmath>
+
+namespace {
+
+using Matrix = Eigen::MatrixXcd;
+
+Matrix toEigen(const kernels::Matrix2& m) {
+    Matrix result(2, 2);
+    result << m[0], m[1], m[2], m[3];
+    return result;
+}
+
+// Embeds a one-qubit operator; qubit 0 is the least significant (rightmost) factor
+Matrix embed(const Matrix& op, int qubit, int numQubits) {
+    Matrix result = Matrix::Identity(1, 1);
+    for (int q = numQubits - 1; q >= 0; --q) {
+        const Matrix factor = q == qubit ? op : Matrix::Identity(2, 2);
+        Matrix next(result.rows() * 2, result.cols() * 2);
+        for (int r = 0; r < result.rows(); ++r) {
+            for (int c = 0; c < result.cols(); ++c) {
+                next.block(r * 2, c * 2, 2, 2) = result(r, c) * factor;
+            }
+        }
+        result = next;
+    }
+    return result;
+}
+
+Matrix applyChannel(const Matrix& rho, const NoiseChannel& channel, int qubit, int numQubits) {
+    Matrix result = Matrix::Zero(rho.rows(), rho.cols());
+    for (const kernels::Matrix2& k : krausOperators(channel)) {
+        const Matrix full = embed(toEigen(k), qubit, numQubits);
+        result += full * rho * full.adjoint();
+    }
+    return result;
+}
+
+void expectMatches(const DensityMatrixManager& rho, const Matrix& expected) {
+    for (std::uint64_t r = 0; r < rho.getDimension(); ++r) {
+        for (std::uint64_t c = 0; c < rho.getDimension(); ++c) {
+            EXPECT_NEAR(std::abs(rho.element(r, c) - expected(r, c)), 0.0, 1e-10) << r << "," << c;
+        }
+    }
+}
+
+}  // namespace
+
+// Test a noiseless circuit reproduces |ψ⟩⟨ψ| from the state-vector backend
+TEST(DensityMatrixTest, NoiselessMatchesStateVector) {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    circuit.addGate("CNOT", 2, 0);
+    circuit.addGate("Y", 1);
+    circuit.addGate("CZ", 2, 1);
+    circuit.addParameterizedGate("RX", 1, {GateParameter{0.7}});
+    circuit.addParameterizedGate("U3", 0, {GateParameter{0.3}, GateParameter{-1.1}, GateParameter{0.4}});
+    circuit.addGate("SWAP", 0, 1);
+    circuit.addGate("TOFFOLI", 2, 0, 1);
+
+    QubitManager pure(3);
+    circuit.executeCircuit(pure);
+    const Eigen::VectorXcd& psi = pure.getState();
+
+    for (int width : {0, 3}) {
+        circuit.setMaxFusedWidth(width);
+        DensityMatrixManager rho(3);
+        circuit.executeCircuit(rho);
+        expectMatches(rho, psi * psi.adjoint());
+        EXPECT_NEAR(rho.trace(), 1.0, 1e-12);
+        EXPECT_NEAR(rho.purity(), 1.0, 1e-12);
+    }
+
+    DensityMatrixManager from_pure(pure);
+    expectMatches(from_pure, psi * psi.adjoint());
+}
+
+// Test noise channels against an explicit Kraus-sum reference
+TEST(DensityMatrixTest, NoiseMatchesKrausReference) {
+    CircuitManager circuit;
+    circuit.addGate("X", 0);
+    circuit.addGate("H", 1);
+    circuit.addGate("CNOT", 0, 1);
+    NoiseModel model;
+    model.addGateNoise("X", amplitudeDamping(0.3));
+    model.addGateNoise("CNOT", depolarizing(0.15));
+    model.addQubitNoise(1, phaseDamping(0.4));
+    model.setReadoutError(-1, readoutError(0.1, 0.1));
+    circuit.setNoiseModel(model);
+
+    DensityMatrixManager rho(2);
+    circuit.executeCircuit(rho);
+
+    Matrix x(2, 2), h(2, 2), cnot = Matrix::Zero(4, 4);
+    x << 0, 1, 1, 0;
+    h << 1, 1, 1, -1;
+    h /= std::sqrt(2.0);
+    // Control qubit 1, target qubit 0
+    cnot(0, 0) = cnot(1, 1) = cnot(2, 3) = cnot(3, 2) = 1;
+
+    Matrix expected = Matrix::Zero(4, 4);
+    expected(0, 0) = 1;
+    Matrix gate = embed(x, 0, 2);
+    expected = applyChannel(gate * expected * gate.adjoint(), amplitudeDamping(0.3), 0, 2);
+    gate = embed(h, 1, 2);
+    expected = applyChannel(gate * expected * gate.adjoint(), phaseDamping(0.4), 1, 2);
+    expected = cnot * expected * cnot.adjoint();
+    for (int q : {0, 1}) {
+        expected = applyChannel(expected, depolarizing(0.15), q, 2);
+    }
+    expected = applyChannel(expected, phaseDamping(0.4), 1, 2);
+
+    expectMatches(rho, expected);
+    EXPECT_NEAR(rho.trace(), 1.0, 1e-12);
+    EXPECT_LT(rho.purity(), 1.0);
+}
+
+// Test non-selective measurement, basis-state preparation and invalid arguments
+TEST(DensityMatrixTest, MeasurementAndErrors) {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    circuit.addGate("MEASURE", 0);
+    DensityMatrixManager rho(1);
+    circuit.executeCircuit(rho);
+    EXPECT_NEAR(rho.element(0, 0).real(), 0.5, 1e-12);
+    EXPECT_NEAR(rho.element(1, 1).real(), 0.5, 1e-12);
+    EXPECT_NEAR(std::abs(rho.element(0, 1)), 0.0, 1e-12);
+    EXPECT_NEAR(rho.purity(), 0.5, 1e-12);
+
+    DensityMatrixManager basis(3);
+    basis.setInitialState("101");
+    std::vector<double> probabilities = basis.getProbabilities();
+    EXPECT_DOUBLE_EQ(probabilities[5], 1.0);
+    basis.initializeZeroState();
+    EXPECT_DOUBLE_EQ(basis.getProbabilities()[0], 1.0);
+
+    EXPECT_THROW(DensityMatrixManager(0), std::invalid_argument);
+    EXPECT_THROW(DensityMatrixManager(DensityMatrixManager::MAX_QUBITS + 1), std::invalid_argument);
+    EXPECT_THROW(basis.element(8, 0), std::out_of_range);
+    EXPECT_THROW(basis.setInitialState("10"), std::invalid_argument);
+}
@@ -32,3 +32,57 @@ TEST(GateEngineTest, CNOT) {
     EXPECT_NEAR(std::abs(qubits.getState()(0)), 1.0 / std::sqrt(2), 1e-6);
     EXPECT_NEAR(std::abs(qubits.getState()(3)), 1.0 / std::sqrt(2), 1e-6);
 }
+
+// Test multi-controlled gates against a full scan that tests every control bit
+TEST(GateEngineTest, MultiControlledMatchesFullScan) {
+    const int numQubits = 8;
+    const kernels::Matrix2 m = {{{0.6, 0.1}, {-0.2, 0.7}, {0.3, -0.4}, {0.5, 0.2}}};
+    GateEngine gateEngine;
+
+    struct Case { int target; std::vector<int> controls; std::vector<int> negative; };
+    // Low controls use the per-pair path, high ones the contiguous-run path
+    const std::vector<Case> cases = {{0, {3, 5}, {1}}, {6, {2, 4, 7}, {}}, {3, {5}, {6, 7}},
+                                     {7, {0, 1, 2, 3, 4}, {}}};
+    for (const Case& c : cases) {
+        QubitManager qubits(numQubits);
+        for (int q = 0; q < numQubits; ++q) {
+            gateEngine.applyHadamard(qubits, q);
+            gateEngine.applyControlledGate(qubits, m, q, {});
+        }
+        Eigen::VectorXcd expected = qubits.getState();
+
+        const std::uint64_t target_bit = std::uint64_t{1} << c.target;
+        for (std::uint64_t i = 0; i < qubits.getDimension(); ++i) {
+            bool fires = !(i & target_bit);
+            for (int q : c.controls) fires = fires && ((i >> q) & 1);
+            for (int q : c.negative) fires = fires && !((i >> q) & 1);
+            if (fires) {
+                std::complex<double> a0 = expected(i), a1 = expected(i | target_bit);
+                expected(i) = m[0] * a0 + m[1] * a1;
+                expected(i | target_bit) = m[2] * a0 + m[3] * a1;
+            }
+        }
+
+        gateEngine.applyControlledGate(qubits, m, c.target, c.controls, c.negative);
+        EXPECT_TRUE(qubits.getState().isApprox(expected, 1e-12)) << "target " << c.target;
+    }
+
+    QubitManager qubits(3);
+    EXPECT_THROW(gateEngine.applyMCX(qubits, {0, 1}, 1), std::invalid_argument);
+    EXPECT_THROW(gateEngine.applyMCX(qubits, {0, 3}, 2), std::out_of_range);
+}
+
+// Test CZ, controlled phase and a 3-control MCX on basis states
+TEST(GateEngineTest, ControlledPhaseAndMCX) {
+    GateEngine gateEngine;
+    QubitManager qubits(4);
+    qubits.setInitialState("0111");
+    gateEngine.applyCZ(qubits, 0, 1);
+    EXPECT_NEAR(qubits.getState()(7).real(), -1.0, 1e-12);
+
+    gateEngine.applyCPhase(qubits, 2, 1, M_PI / 2);
+    EXPECT_NEAR(std::abs(qubits.getState()(7) - std::complex<double>(0.0, -1.0)), 0.0, 1e-12);
+
+    gateEngine.applyMCX(qubits, {0, 1, 2}, 3);
+    EXPECT_NEAR(std::abs(qubits.getState()(15)), 1.0, 1e-12);
+}
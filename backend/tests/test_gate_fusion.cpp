@@ -0,0 +1,89 @@
+#include "gate_fusion.h"
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+
+// Builds a circuit mixing single-qubit gates, permutations and a measurement
+static CircuitManager mixedCircuit() {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    circuit.addGate("Y", 1);
+    circuit.addGate("H", 1);
+    circuit.addGate("CNOT", 2, 0);
+    circuit.addGate("H", 3);
+    circuit.addGate("Z", 2);
+    circuit.addGate("SWAP", 1, 3);
+    circuit.addGate("TOFFOLI", 1, 0, 2);
+    circuit.addGate("H", 1);
+    circuit.addGate("MEASURE", 3);
+    circuit.addGate("X", 3);
+    circuit.addGate("CNOT", 0, 3);
+    circuit.addGate("H", 2);
+    return circuit;
+}
+
+// Test H-Z-H-X on one qubit becomes a single sweep equal to the unfused result
+TEST(GateFusionTest, SingleQubitRunFusesToOneSweep) {
+    CircuitManager circuit;
+    for (const char* gate : {"H", "Z", "H", "X"}) {
+        circuit.addGate(gate, 1);
+    }
+
+    CompiledCircuit plan = circuit.compile(2);
+    FusionStats stats = fuseGates(plan, 1);
+    EXPECT_EQ(stats.sweeps_before, 4);
+    EXPECT_EQ(stats.sweeps_after, 1);
+    EXPECT_EQ(stats.sweepsSaved(), 3);
+    ASSERT_EQ(plan.ops.size(), 1u);
+    EXPECT_EQ(plan.ops[0].opcode, OpCode::Unitary);
+
+    // HZH = X, so the whole run is the identity
+    QubitManager qubits(2);
+    circuit.executeCompiled(plan, qubits);
+    EXPECT_NEAR(std::abs(qubits.getState()(0)), 1.0, 1e-12);
+}
+
+// Test every fusion width reproduces the unfused state and keeps measurements
+TEST(GateFusionTest, FusedPlansMatchUnfused) {
+    CircuitManager circuit = mixedCircuit();
+    CompiledCircuit reference_plan = circuit.compile(5);
+    QubitManager reference(5);
+    circuit.setSeed(1);
+    std::vector<int> expected = circuit.executeCompiled(reference_plan, reference);
+
+    for (int width = 1; width <= MAX_FUSED_WIDTH; ++width) {
+        CompiledCircuit plan = circuit.compile(5);
+        FusionStats stats = fuseGates(plan, width);
+        EXPECT_GT(stats.sweepsSaved(), 0) << "width " << width;
+        EXPECT_EQ(plan.measurement_gates, reference_plan.measurement_gates);
+
+        QubitManager qubits(5);
+        circuit.setSeed(1);
+        EXPECT_EQ(circuit.executeCompiled(plan, qubits), expected);
+        for (std::uint64_t i = 0; i < qubits.getDimension(); ++i) {
+            EXPECT_NEAR(std::abs(qubits.getState()(i) - reference.getState()(i)), 0.0, 1e-12)
+                << "width " << width << " index " << i;
+        }
+    }
+
+    CompiledCircuit plan = circuit.compile(5);
+    EXPECT_THROW(fuseGates(plan, MAX_FUSED_WIDTH + 1), std::invalid_argument);
+}
+
+// Test CircuitManager fuses by default and reports the saved sweeps
+TEST(GateFusionTest, CircuitManagerReportsSavedSweeps) {
+    CircuitManager circuit = mixedCircuit();
+    QubitManager fused(5);
+    circuit.setSeed(1);
+    circuit.executeCircuit(fused);
+    EXPECT_EQ(circuit.getMaxFusedWidth(), DEFAULT_FUSED_WIDTH);
+    EXPECT_GT(circuit.getFusionStats().sweepsSaved(), 0);
+
+    circuit.setMaxFusedWidth(0);
+    QubitManager unfused(5);
+    circuit.setSeed(1);
+    circuit.executeCircuit(unfused);
+    EXPECT_EQ(circuit.getFusionStats().sweepsSaved(), 0);
+    EXPECT_TRUE(fused.getState().isApprox(unfused.getState(), 1e-12));
+    EXPECT_THROW(circuit.setMaxFusedWidth(-1), std::invalid_argument);
+}
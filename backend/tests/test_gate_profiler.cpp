@@ -0,0 +1,188 @@
+#include "gate_profiler.h"
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+// H, CNOT, X and MEASURE on four qubits, unfused so each gate is one op
+static CircuitManager unfusedCircuit() {
+    CircuitManager circuit;
+    circuit.setMaxFusedWidth(0);
+    circuit.setSeed(3);
+    circuit.addGate("H", 0);
+    circuit.addGate("CNOT", 2, 0);
+    circuit.addGate("X", 3);
+    circuit.addGate("MEASURE", 2);
+    return circuit;
+}
+
+static std::size_t countOf(const std::string& text, const std::string& needle) {
+    std::size_t count = 0;
+    for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+// Test each op is recorded with its gate, qubits, bytes and kernel, and only while enabled
+TEST(GateProfilerTest, RecordsOneEventPerOp) {
+    CircuitManager circuit = unfusedCircuit();
+    QubitManager plain(4);
+    circuit.executeCircuit(plain);
+    EXPECT_FALSE(circuit.isProfiling());
+    EXPECT_TRUE(circuit.getProfile().getEvents().empty());
+
+    circuit.setProfiling(true);
+    circuit.setSeed(3);
+    QubitManager profiled(4);
+    circuit.executeCircuit(profiled);
+    EXPECT_EQ((plain.getState() - profiled.getState()).norm(), 0.0);
+
+    const std::vector<ProfileEvent>& events = circuit.getProfile().getEvents();
+    ASSERT_EQ(events.size(), 4u);
+    const char* names[] = {"H", "CNOT", "X", "MEASURE"};
+    for (int k = 0; k < 4; ++k) {
+        EXPECT_STREQ(events[k].name, names[k]);
+        EXPECT_EQ(events[k].gate_index, k);
+        EXPECT_GE(events[k].seconds, 0.0);
+        if (k > 0) {
+            EXPECT_GE(events[k].start_seconds, events[k - 1].start_seconds + events[k - 1].seconds);
+        }
+    }
+    const std::size_t amplitude = sizeof(std::complex<double>);
+    EXPECT_EQ(events[0].bytes, 2 * 16 * amplitude);
+    EXPECT_EQ(events[1].bytes, 2 * 8 * amplitude);  // Half the register swaps
+    EXPECT_EQ(events[3].bytes, (8 + 2 * 16) * amplitude);
+    EXPECT_EQ(events[1].qubits, (std::vector<int>{0, 2}));
+    EXPECT_EQ(events[2].qubits, (std::vector<int>{3}));
+    EXPECT_EQ(std::string(events[0].kernel).rfind("matrix2/", 0), 0u);
+    EXPECT_STREQ(events[1].kernel, "permute");
+    EXPECT_STREQ(events[3].kernel, "measure");
+
+    circuit.setProfiling(false);
+    circuit.executeCircuit(profiled);
+    EXPECT_EQ(circuit.getProfile().getEvents().size(), 4u);
+}
+
+// Test kernel names follow the level the kernels report at every SIMD setting
+TEST(GateProfilerTest, KernelNamesFollowDispatchedLevel) {
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+    for (int l = 0; l <= static_cast<int>(kernels::detectSimdLevel()); ++l) {
+        kernels::setSimdLevel(static_cast<kernels::SimdLevel>(l));
+        CompiledOp h;
+        h.opcode = OpCode::Hadamard;
+        CompiledOp fused;
+        fused.opcode = OpCode::Fused;
+        fused.num_positions = 1;
+        for (bool single : {false, true}) {
+            const std::size_t amplitude = single ? sizeof(std::complex<float>) : sizeof(std::complex<double>);
+            EXPECT_EQ(std::string(kernelVariant(h, amplitude)),
+                      std::string("matrix2/") + kernels::simdLevelName(kernels::matrix2Level(single)));
+            EXPECT_EQ(std::string(kernelVariant(fused, amplitude)),
+                      std::string("dense1/") + kernels::simdLevelName(kernels::denseMatrixLevel(single, 1)));
+        }
+    }
+    kernels::setSimdLevel(kernels::SimdLevel::Scalar);
+    CompiledOp h;
+    h.opcode = OpCode::Hadamard;
+    EXPECT_STREQ(kernelVariant(h, sizeof(std::complex<double>)), "matrix2/scalar");
+    kernels::setSimdLevel(original);
+}
+
+// Test totals per gate type accumulate over runs and reset with clearProfile
+TEST(GateProfilerTest, AggregatesPerGateType) {
+    CircuitManager circuit = unfusedCircuit();
+    circuit.addGate("H", 1);
+    circuit.setProfiling(true);
+    QubitManagerF qubits(4);
+    circuit.executeCircuit(qubits);
+    qubits.initializeZeroState();
+    circuit.executeCircuit(qubits);
+
+    const GateProfiler& profile = circuit.getProfile();
+    std::vector<GateTypeProfile> summary = profile.summary();
+    ASSERT_EQ(summary.size(), 4u);
+    EXPECT_TRUE(std::is_sorted(summary.begin(), summary.end(),
+                               [](const GateTypeProfile& a, const GateTypeProfile& b) { return a.seconds > b.seconds; }));
+    auto hadamard = std::find_if(summary.begin(), summary.end(),
+                                 [](const GateTypeProfile& total) { return total.name == "H"; });
+    ASSERT_NE(hadamard, summary.end());
+    EXPECT_EQ(hadamard->count, 4u);
+    EXPECT_EQ(hadamard->bytes, 4 * 2 * 16 * sizeof(std::complex<float>));
+
+    double seconds = 0.0;
+    std::uint64_t count = 0;
+    for (const GateTypeProfile& total : summary) {
+        seconds += total.seconds;
+        count += total.count;
+    }
+    EXPECT_EQ(count, profile.getEvents().size());
+    EXPECT_DOUBLE_EQ(seconds, profile.totalSeconds());
+
+    std::ostringstream table;
+    profile.printSummary(table);
+    EXPECT_NE(table.str().find("CNOT"), std::string::npos);
+
+    circuit.clearProfile();
+    EXPECT_TRUE(profile.getEvents().empty());
+    EXPECT_TRUE(profile.summary().empty());
+    EXPECT_TRUE(circuit.isProfiling());
+}
+
+// Test fused ops report their dense kernel and cache-blocked stages are timed as one event
+TEST(GateProfilerTest, ReportsFusedAndBlockedExecution) {
+    CircuitManager fused;
+    fused.addGate("H", 0);
+    fused.addGate("CNOT", 1, 0);
+    fused.addGate("H", 1);
+    fused.setProfiling(true);
+    QubitManager small(3);
+    fused.executeCircuit(small);
+    ASSERT_EQ(fused.getProfile().getEvents().size(), 1u);
+    EXPECT_STREQ(fused.getProfile().getEvents()[0].name, "FUSED");
+    EXPECT_EQ(std::string(fused.getProfile().getEvents()[0].kernel).rfind("dense2/", 0), 0u);
+
+    CircuitManager blocked;
+    for (int q = 0; q < 4; ++q) {
+        blocked.addGate("H", q);
+    }
+    blocked.setProfiling(true);
+    QubitManager large(MIN_BLOCKED_QUBITS);
+    blocked.executeCircuit(large);
+    const std::vector<ProfileEvent>& events = blocked.getProfile().getEvents();
+    ASSERT_EQ(events.size(), static_cast<std::size_t>(blocked.getBlockingStats().sweeps_after));
+    ASSERT_FALSE(events.empty());
+    EXPECT_STREQ(events[0].name, BLOCKED_STAGE_NAME);
+    EXPECT_EQ(events[0].bytes, 2 * large.getDimension() * sizeof(std::complex<double>));
+}
+
+// Test the trace is Trace Event Format with one complete event per op
+TEST(GateProfilerTest, WritesChromeTrace) {
+    CircuitManager circuit = unfusedCircuit();
+    circuit.setProfiling(true);
+    QubitManager qubits(4);
+    circuit.executeCircuit(qubits);
+
+    std::ostringstream out;
+    circuit.getProfile().writeChromeTrace(out);
+    const std::string trace = out.str();
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [", 0), 0u);
+    EXPECT_EQ(countOf(trace, "\"ph\": \"X\""), 4u);
+    EXPECT_NE(trace.find("\"name\": \"CNOT\""), std::string::npos);
+    EXPECT_NE(trace.find("\"qubits\": [0, 2]"), std::string::npos);
+    EXPECT_NE(trace.find("\"kernel\": \"permute\""), std::string::npos);
+    EXPECT_EQ(countOf(trace, "{"), countOf(trace, "}"));
+
+    const std::string path = ::testing::TempDir() + "gate_profile.json";
+    circuit.getProfile().writeChromeTrace(path);
+    std::ifstream file(path);
+    std::stringstream saved;
+    saved << file.rdbuf();
+    EXPECT_EQ(saved.str(), trace);
+    std::remove(path.c_str());
+    EXPECT_THROW(circuit.getProfile().writeChromeTrace(::testing::TempDir() + "missing/dir/trace.json"),
+                 std::runtime_error);
+}
@@ -0,0 +1,137 @@
+#include "mps_state.h"
+#include "circuit_manager.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+// Test the MPS backend against the dense backend on random circuits with non-adjacent gates
+TEST(MPSStateTest, MatchesDenseBackend) {
+    // Nine qubits reach bond 16, where the SVDs are large enough to leave Eigen's small-matrix path
+    constexpr int qubits = 9;
+    // RX(1.4), a non-Clifford unitary for the controlled-unitary cases
+    const double t = 0.7;
+    const kernels::Matrix2 unitary = {{{std::cos(t), 0.0}, {0.0, -std::sin(t)},
+                                       {0.0, -std::sin(t)}, {std::cos(t), 0.0}}};
+    for (std::uint64_t seed = 1; seed <= 8; ++seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int> qubit(0, qubits - 1);
+        std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+        CircuitManager circuit;
+        for (int g = 0; g < 150; ++g) {
+            int a = qubit(rng), b = qubit(rng), c = qubit(rng);
+            while (b == a) b = qubit(rng);
+            while (c == a || c == b) c = qubit(rng);
+            switch (rng() % 10) {
+                case 0: circuit.addGate("H", a); break;
+                case 1: circuit.addGate("CNOT", a, b); break;
+                case 2: circuit.addGate("TOFFOLI", a, b, c); break;
+                case 3: circuit.addGate("SWAP", a, b); break;
+                case 4: circuit.addParameterizedGate("RY", a, {GateParameter{angle(rng)}}); break;
+                case 5: circuit.addParameterizedGate("PHASE", a, {GateParameter{angle(rng)}}); break;
+                case 6: circuit.addControlledGate("Y", a, {b}, {c}); break;
+                case 7: circuit.addControlledUnitary(unitary, a, {b}); break;
+                case 8: circuit.addControlledUnitary(unitary, a, {}, {b, c}); break;
+                default: circuit.addGate("CZ", a, b); break;
+            }
+        }
+
+        QubitManager dense(qubits);
+        circuit.executeCircuit(dense);
+        MPSState mps(qubits);
+        circuit.executeCircuit(mps);
+        EXPECT_GT(mps.getSwapCount(), 0u);
+        EXPECT_LT(mps.getTruncationError(), 1e-10) << "seed " << seed;
+        // The reported truncation error must bound the actual error
+        const double bound = 1e-10 + 2.0 * std::sqrt(mps.getTruncationError());
+        for (std::uint64_t i = 0; i < dense.getDimension(); ++i) {
+            EXPECT_NEAR(std::abs(mps.amplitude(i) - dense.getState()(i)), 0.0, bound) << "seed " << seed << " " << i;
+        }
+
+        // Without truncation no bond is cut, so the state keeps its norm
+        MPSState exact(qubits, MPSState::DEFAULT_MAX_BOND_DIMENSION, 0.0);
+        circuit.executeCircuit(exact);
+        double norm = 0.0;
+        for (std::uint64_t i = 0; i < dense.getDimension(); ++i) {
+            norm += std::norm(exact.amplitude(i));
+        }
+        EXPECT_NEAR(norm, 1.0, 1e-10) << "seed " << seed;
+    }
+}
+
+// Test a GHZ chain on a register far too wide for any dense vector
+TEST(MPSStateTest, WideLowEntanglementCircuit) {
+    constexpr int qubits = 200;
+    CircuitManager ghz;
+    ghz.addGate("H", 0);
+    for (int q = 1; q < qubits; ++q) {
+        ghz.addGate("CNOT", q, q - 1);
+    }
+    MPSState mps(qubits);
+    ghz.executeCircuit(mps);
+    EXPECT_EQ(mps.getMaxBondDimension(), 2);
+    EXPECT_EQ(mps.getSwapCount(), 0u);
+    EXPECT_LE(mps.storedAmplitudes(), 8u * qubits);
+    EXPECT_NEAR(std::abs(mps.amplitude(std::string(qubits, '1'))), 1.0 / std::sqrt(2.0), 1e-12);
+    EXPECT_NEAR(std::abs(mps.amplitude("1" + std::string(qubits - 1, '0'))), 0.0, 1e-12);
+
+    // A long-range CNOT is routed through SWAPs and leaves the chain in place
+    CircuitManager bridge;
+    bridge.addGate("CNOT", qubits - 1, 0);
+    bridge.addGate("MEASURE", 100);
+    bridge.setSeed(3);
+    bridge.executeCircuit(mps);
+    EXPECT_EQ(mps.getSwapCount(), 2u * (qubits - 2));
+    const int result = bridge.getGate(1).measurement_result;
+    std::string label(qubits, result ? '1' : '0');
+    label[0] = '0';  // The CNOT cleared qubit 199 on the all-ones branch and left it 0 on the other
+    EXPECT_NEAR(std::abs(mps.amplitude(label)), 1.0, 1e-10);
+}
+
+// Test the bond-dimension cap, the reported truncation error and invalid arguments
+TEST(MPSStateTest, TruncationAndErrors) {
+    // A random brickwork circuit needs a bond dimension near 2^(n/2) for an exact result
+    constexpr int qubits = 10;
+    std::mt19937_64 rng(4);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    CircuitManager brickwork;
+    for (int layer = 0; layer < 10; ++layer) {
+        for (int q = 0; q < qubits; ++q) {
+            brickwork.addParameterizedGate("RY", q, {GateParameter{angle(rng)}});
+            brickwork.addParameterizedGate("RZ", q, {GateParameter{angle(rng)}});
+        }
+        for (int q = layer % 2; q + 1 < qubits; q += 2) {
+            brickwork.addGate("CNOT", q + 1, q);
+        }
+    }
+    MPSState exact(qubits);
+    brickwork.executeCircuit(exact);
+    EXPECT_GT(exact.getMaxBondDimension(), 16);
+    EXPECT_LT(exact.getTruncationError(), 1e-10);
+
+    MPSState capped(qubits, 4);
+    brickwork.executeCircuit(capped);
+    EXPECT_EQ(capped.getMaxBondDimension(), 4);
+    EXPECT_GT(capped.getTruncationError(), 1e-3);
+    double overlap_norm = 0.0;
+    std::complex<double> overlap = 0.0;
+    for (std::uint64_t i = 0; i < (std::uint64_t{1} << qubits); ++i) {
+        overlap += std::conj(exact.amplitude(i)) * capped.amplitude(i);
+        overlap_norm += std::norm(capped.amplitude(i));
+    }
+    EXPECT_NEAR(overlap_norm, 1.0, 1e-10);
+    EXPECT_GE(1.0 - std::norm(overlap), 0.0);
+    EXPECT_LE(1.0 - std::norm(overlap), 2.0 * capped.getTruncationError());
+
+    EXPECT_THROW(MPSState(0), std::invalid_argument);
+    EXPECT_THROW(MPSState(4, 0), std::invalid_argument);
+    EXPECT_THROW(MPSState(4, 8, 1.0), std::invalid_argument);
+    MPSState small(4);
+    EXPECT_THROW(small.getBondDimension(3), std::out_of_range);
+    EXPECT_THROW(small.applyGate({2, 1}, std::vector<std::complex<double>>(16)), std::invalid_argument);
+    CircuitManager wide;
+    wide.addControlledGate("X", 0, {1, 2, 3});
+    EXPECT_THROW(wide.executeCircuit(small), std::invalid_argument);
+    CircuitManager outside;
+    outside.addGate("H", 4);
+    EXPECT_THROW(outside.executeCircuit(small), std::out_of_range);
+}
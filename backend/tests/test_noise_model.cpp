@@ -0,0 +1,120 @@
+#include "noise_model.h"
+#include "circuit_manager.h"
+#include "thread_pool.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace {
+
+constexpr std::uint64_t SHOTS = 20000;
+
+// Fraction of shots reading "1" on a one-qubit circuit
+double fractionOne(CircuitManager& circuit) {
+    QubitManager qubits(1);
+    Histogram histogram = circuit.sample(qubits, SHOTS);
+    return static_cast<double>(histogram["1"]) / SHOTS;
+}
+
+// 5 standard deviations of a binomial proportion
+double tolerance(double p) {
+    return 5.0 * std::sqrt(p * (1.0 - p) / SHOTS) + 1e-9;
+}
+
+}  // namespace
+
+// Test each channel's trajectory average against its analytic outcome probability
+TEST(NoiseModelTest, ChannelsMatchAnalyticProbabilities) {
+    CircuitManager damped;
+    damped.addGate("X", 0);
+    NoiseModel damping;
+    damping.addGateNoise("X", amplitudeDamping(0.3));
+    damped.setNoiseModel(damping);
+    damped.setSeed(1);
+    EXPECT_NEAR(fractionOne(damped), 0.7, tolerance(0.7));
+
+    // X or Y (2 of the 3 Paulis) undo the flip
+    CircuitManager depolarized;
+    depolarized.addGate("Pauli-X", 0);
+    NoiseModel depolarizing_model;
+    depolarizing_model.addQubitNoise(0, depolarizing(0.3));
+    depolarized.setNoiseModel(depolarizing_model);
+    depolarized.setSeed(2);
+    EXPECT_NEAR(fractionOne(depolarized), 0.8, tolerance(0.8));
+
+    // H-H interferometer: coherence shrinks by sqrt(1 - lambda)
+    CircuitManager dephased;
+    dephased.addGate("H", 0);
+    dephased.addGate("H", 0);
+    dephased.addGate("MEASURE", 0);
+    NoiseModel dephasing;
+    dephasing.addGateNoise("H", phaseDamping(0.64));
+    dephased.setNoiseModel(dephasing);
+    dephased.setSeed(3);
+    EXPECT_NEAR(fractionOne(dephased), 0.2, tolerance(0.2));
+}
+
+// Test readout errors on terminal measurements, whole-register reads and trajectories
+TEST(NoiseModelTest, ReadoutErrors) {
+    NoiseModel model;
+    model.setReadoutError(-1, readoutError(0.0, 0.25));
+
+    CircuitManager measured;
+    measured.addGate("X", 0);
+    measured.addGate("MEASURE", 0);
+    measured.setNoiseModel(model);
+    measured.setSeed(4);
+    EXPECT_NEAR(fractionOne(measured), 0.75, tolerance(0.75));
+
+    CircuitManager unmeasured;
+    unmeasured.addGate("X", 0);
+    unmeasured.setNoiseModel(model);
+    unmeasured.setSeed(5);
+    EXPECT_NEAR(fractionOne(unmeasured), 0.75, tolerance(0.75));
+
+    // A mid-circuit measurement forces trajectories; qubit 1 has no error of its own
+    NoiseModel per_qubit;
+    per_qubit.setReadoutError(0, readoutError(0.5, 0.0));
+    CircuitManager mid;
+    mid.addGate("MEASURE", 0);
+    mid.addGate("X", 1);
+    mid.addGate("MEASURE", 1);
+    mid.setNoiseModel(per_qubit);
+    mid.setSeed(6);
+    QubitManager qubits(2);
+    Histogram histogram = mid.sample(qubits, SHOTS);
+    EXPECT_EQ(histogram["10"] + histogram["11"], SHOTS);
+    EXPECT_NEAR(static_cast<double>(histogram["11"]) / SHOTS, 0.5, tolerance(0.5));
+}
+
+// Test trajectories are reproducible across thread counts, and invalid configurations
+TEST(NoiseModelTest, DeterministicAcrossThreadsAndErrors) {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    circuit.addGate("CNOT", 1, 0);
+    circuit.addGate("H", 2);
+    NoiseModel model;
+    model.addGateNoise("CNOT", depolarizing(0.2));
+    model.addQubitNoise(2, amplitudeDamping(0.1));
+    circuit.setNoiseModel(model);
+
+    ThreadPool& pool = ThreadPool::global();
+    const unsigned threads = pool.getThreadCount();
+    pool.setThreadCount(1);
+    circuit.setSeed(9);
+    QubitManager qubits(3);
+    Histogram serial = circuit.sample(qubits, 2000);
+    pool.setThreadCount(4);
+    circuit.setSeed(9);
+    Histogram parallel = circuit.sample(qubits, 2000);
+    pool.setThreadCount(threads);
+    EXPECT_EQ(serial, parallel);
+
+    EXPECT_THROW(depolarizing(1.5), std::invalid_argument);
+    EXPECT_THROW(readoutError(0.1, -0.1), std::invalid_argument);
+    EXPECT_THROW(model.addGateNoise("H", readoutError(0.1, 0.1)), std::invalid_argument);
+    EXPECT_THROW(model.addGateNoise("FOO", depolarizing(0.1)), std::invalid_argument);
+    EXPECT_THROW(model.setReadoutError(0, depolarizing(0.1)), std::invalid_argument);
+
+    BatchedState batch(3, 4);
+    EXPECT_THROW(circuit.executeBatch(batch), std::invalid_argument);
+}
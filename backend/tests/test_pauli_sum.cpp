@@ -0,0 +1,121 @@
+#include "pauli_sum.h"
+#include "circuit_manager.h"
+#include "gate_engine.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace {
+
+QubitManager randomState(int numQubits, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> normal;
+    QubitManager qubits(numQubits);
+    for (std::uint64_t i = 0; i < qubits.getDimension(); ++i) {
+        qubits.getState()(i) = {normal(rng), normal(rng)};
+    }
+    qubits.getState().normalize();
+    return qubits;
+}
+
+// P|ψ⟩ built from GateEngine's Pauli gates, as an independent reference
+QubitManager applyWithGates(const QubitManager& qubits, const PauliTerm& term) {
+    GateEngine engine;
+    QubitManager result(qubits);
+    for (int q = 0; q < qubits.getNumQubits(); ++q) {
+        const bool x = (term.x_mask >> q) & 1;
+        const bool z = (term.z_mask >> q) & 1;
+        if (x && z) {
+            engine.applyPauliY(result, q);
+        } else if (x) {
+            engine.applyPauliX(result, q);
+        } else if (z) {
+            engine.applyPauliZ(result, q);
+        }
+    }
+    return result;
+}
+
+double referenceExpectation(const PauliSum& sum, const QubitManager& qubits) {
+    double total = 0.0;
+    for (const PauliTerm& term : sum.getTerms()) {
+        QubitManager image = applyWithGates(qubits, term);
+        total += term.coefficient * qubits.getState().dot(image.getState()).real();
+    }
+    return total;
+}
+
+}  // namespace
+
+// Test single strings, string parsing and the in-place application of H
+TEST(PauliSumTest, TermsMatchGateReference) {
+    QubitManager qubits = randomState(5, 3);
+    PauliSum sum;
+    sum.addTerm(0.5, "Z0 Z1");
+    sum.addTerm(-1.25, "X0 Y2 Z4");
+    sum.addTerm(0.75, "y1 y3");
+    sum.addTerm(2.0, "X4*X3");
+    sum.addTerm(0.1, "I");
+    EXPECT_EQ(sum.getNumQubits(), 5);
+
+    for (const PauliTerm& term : sum.getTerms()) {
+        QubitManager image = applyWithGates(qubits, term);
+        EXPECT_NEAR(pauliExpectation(qubits.getState().data(), qubits.getDimension(), term),
+                    qubits.getState().dot(image.getState()).real(), 1e-12);
+    }
+    EXPECT_NEAR(sum.expectation(qubits), referenceExpectation(sum, qubits), 1e-12);
+
+    // ⟨ψ|H|ψ⟩ through apply() agrees with the read-only evaluator
+    QubitManager applied(qubits);
+    sum.apply(applied);
+    EXPECT_NEAR(qubits.getState().dot(applied.getState()).real(), sum.expectation(qubits), 1e-12);
+
+    EXPECT_THROW(sum.addTerm(1.0, "X0 Z0"), std::invalid_argument);
+    EXPECT_THROW(sum.addTerm(1.0, "Q1"), std::invalid_argument);
+    EXPECT_THROW(sum.addTerm(1.0, "X"), std::invalid_argument);
+    EXPECT_THROW(sum.expectation(QubitManager(3)), std::out_of_range);
+}
+
+// Test qubit-wise commuting groups and the shared rotated-copy path
+TEST(PauliSumTest, GroupedEvaluationMatchesReference) {
+    const int n = 6;
+    QubitManager qubits = randomState(n, 11);
+
+    // Every string over {I, X} on qubits 0-2 combined with {I, Y} on 3-5:
+    // 64 mutually qubit-wise commuting terms, evaluated from one copy
+    PauliSum sum;
+    for (std::uint64_t m = 0; m < 64; ++m) {
+        PauliTerm term;
+        term.coefficient = 0.01 * static_cast<double>(m) - 0.3;
+        term.x_mask = m;
+        term.z_mask = m & 0b111000;
+        sum.addTerm(term);
+    }
+    // Two terms that conflict with the X/Y group and with each other
+    sum.addTerm(0.4, "Z0 Z3");
+    sum.addTerm(-0.6, "Y0 X5");
+
+    auto groups = sum.groupQubitWiseCommuting();
+    ASSERT_EQ(groups.size(), 3u);
+    EXPECT_EQ(groups[0].size(), 64u);
+    EXPECT_NEAR(sum.expectation(qubits), referenceExpectation(sum, qubits), 1e-11);
+}
+
+// Test the PauliSum overload of the adjoint gradient
+TEST(PauliSumTest, AdjointGradientWithPauliSum) {
+    CircuitManager circuit;
+    circuit.addParameter("theta", 0.3);
+    circuit.addParameterizedGate("RY", 0, {circuit.parameter("theta")});
+    circuit.addGate("CNOT", 1, 0);
+
+    PauliSum observable;
+    observable.addTerm(1.0, "Z0 Z1");
+    observable.addTerm(0.5, "X0 X1");
+    QubitManager qubits(2);
+    GradientResult result = circuit.adjointGradient(qubits, observable);
+
+    // RY(θ)|0⟩ then CNOT: ⟨ZZ⟩ = 1 and ⟨XX⟩ = sin θ
+    EXPECT_NEAR(result.expectation, 1.0 + 0.5 * std::sin(0.3), 1e-12);
+    ASSERT_EQ(result.gradient.size(), 1u);
+    EXPECT_NEAR(result.gradient[0], 0.5 * std::cos(0.3), 1e-12);
+}
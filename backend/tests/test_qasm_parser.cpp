@@ -0,0 +1,204 @@
+#include "qasm_parser.h"
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+// Parses a program and runs it on a fresh register of the declared width
+static QubitManager runQasm(const std::string& source, CircuitManager& circuit, QasmProgram* program = nullptr) {
+    QasmProgram parsed = parseQasm(source, circuit);
+    QubitManager qubits(parsed.num_qubits);
+    circuit.executeCircuit(qubits);
+    if (program != nullptr) {
+        *program = parsed;
+    }
+    return qubits;
+}
+
+// |⟨a|b⟩| = 1 when the states agree up to a global phase
+static double overlap(const QubitManager& a, const QubitManager& b) {
+    return std::abs(a.getState().dot(b.getState()));
+}
+
+// Random single-qubit rotations, so every gate acts on a generic state
+static std::string randomPrefix(int qubits, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::string prefix;
+    for (int q = 0; q < qubits; ++q) {
+        prefix += "u3(" + std::to_string(angle(rng)) + "," + std::to_string(angle(rng)) + "," +
+                  std::to_string(angle(rng)) + ") q[" + std::to_string(q) + "];\n";
+    }
+    for (int q = 0; q + 1 < qubits; ++q) {
+        prefix += "cx q[" + std::to_string(q) + "],q[" + std::to_string(q + 1) + "];\n";
+    }
+    return prefix;
+}
+
+// Test a GHZ program, its register layout and the classical bit map
+TEST(QasmParserTest, ParsesGhzProgram) {
+    const std::string source = R"(OPENQASM 2.0;
+include "qelib1.inc";
+// GHZ state over two registers
+qreg a[2];
+qreg b[1];
+creg c[3];
+h a[0];
+cx a[0], a[1];
+cx a[1], b[0];
+measure a -> c[0:1];
+)";
+    CircuitManager rejected;
+    EXPECT_THROW(parseQasm(source, rejected), QasmError);  // Slices are not OpenQASM 2.0
+
+    CircuitManager circuit;
+    QasmProgram program;
+    std::string valid = source.substr(0, source.find("measure")) + "measure a -> c[0];\n";
+    EXPECT_THROW(parseQasm(valid, circuit), QasmError);  // Two qubits into one bit
+
+    CircuitManager ghz;
+    valid = source.substr(0, source.find("measure")) + "measure a[0] -> c[2];\nmeasure b -> c[0];\n";
+    QubitManager qubits = runQasm(valid, ghz, &program);
+    EXPECT_EQ(program.num_qubits, 3);
+    EXPECT_EQ(program.num_clbits, 3);
+    ASSERT_EQ(program.qregs.size(), 2u);
+    EXPECT_EQ(program.qregs[1].name, "b");
+    EXPECT_EQ(program.qregs[1].offset, 2);
+    EXPECT_EQ(program.gates_emitted, 5u);
+
+    std::vector<int> bits = classicalBits(program, ghz);
+    EXPECT_EQ(bits[1], -1);
+    EXPECT_EQ(bits[0], bits[2]);
+    const std::uint64_t outcome = bits[0] ? 7 : 0;
+    EXPECT_NEAR(std::abs(qubits.getState()(outcome)), 1.0, 1e-12);
+}
+
+// Test every qelib1 gate against its qelib1.inc definition in terms of U and CX
+// (cu3 as in Qiskit's qelib1.inc, which includes the control phase)
+TEST(QasmParserTest, BuiltinsMatchQelib1Definitions) {
+    const std::string definitions = R"(
+gate d_u2(phi,lambda) q { U(pi/2,phi,lambda) q; }
+gate d_u1(lambda) q { U(0,0,lambda) q; }
+gate d_s a { d_u1(pi/2) a; }
+gate d_sdg a { d_u1(-pi/2) a; }
+gate d_t a { d_u1(pi/4) a; }
+gate d_tdg a { d_u1(-pi/4) a; }
+gate d_h a { d_u2(0,pi) a; }
+gate d_sx a { d_sdg a; d_h a; d_sdg a; }
+gate d_rx(theta) a { U(theta,-pi/2,pi/2) a; }
+gate d_ry(theta) a { U(theta,0,0) a; }
+gate d_rz(phi) a { d_u1(phi) a; }
+gate d_cz a,b { d_h b; CX a,b; d_h b; }
+gate d_cy a,b { d_sdg b; CX a,b; d_s b; }
+gate d_ch a,b { d_h b; d_sdg b; CX a,b; d_h b; d_t b; CX a,b; d_t b; d_h b; d_s b; x b; d_s a; }
+gate d_ccx a,b,c { d_h c; CX b,c; d_tdg c; CX a,c; d_t c; CX b,c; d_tdg c; CX a,c; d_t b; d_t c; d_h c;
+                   CX a,b; d_t a; d_tdg b; CX a,b; }
+gate d_crz(lambda) a,b { d_u1(lambda/2) b; CX a,b; d_u1(-lambda/2) b; CX a,b; }
+gate d_cu1(lambda) a,b { d_u1(lambda/2) a; CX a,b; d_u1(-lambda/2) b; CX a,b; d_u1(lambda/2) b; }
+gate d_cu3(theta,phi,lambda) c,t { d_u1((lambda+phi)/2) c; d_u1((lambda-phi)/2) t; CX c,t;
+                                   U(-theta/2,0,-(phi+lambda)/2) t; CX c,t; U(theta/2,phi,0) t; }
+gate d_swap a,b { CX a,b; CX b,a; CX a,b; }
+gate d_cswap a,b,c { CX c,b; d_ccx a,b,c; CX c,b; }
+gate d_rzz(theta) a,b { CX a,b; d_u1(theta) b; CX a,b; }
+)";
+    const std::vector<std::pair<std::string, std::string>> pairs = {
+        {"u2(0.3,-1.1) q[1];", "d_u2(0.3,-1.1) q[1];"},
+        {"s q[0]; t q[1]; sdg q[2]; tdg q[0];", "d_s q[0]; d_t q[1]; d_sdg q[2]; d_tdg q[0];"},
+        {"h q[2];", "d_h q[2];"},
+        {"sx q[1]; sxdg q[1]; sx q[0];", "d_sx q[0];"},
+        {"rx(0.7) q[0]; ry(-0.4) q[1]; rz(1.9) q[2];", "d_rx(0.7) q[0]; d_ry(-0.4) q[1]; d_rz(1.9) q[2];"},
+        {"cz q[0],q[2]; cy q[2],q[1];", "d_cz q[0],q[2]; d_cy q[2],q[1];"},
+        {"ch q[1],q[0];", "d_ch q[1],q[0];"},
+        {"ccx q[2],q[0],q[1];", "d_ccx q[2],q[0],q[1];"},
+        {"crz(0.9) q[0],q[1]; cu1(-0.6) q[1],q[2];", "d_crz(0.9) q[0],q[1]; d_cu1(-0.6) q[1],q[2];"},
+        {"cu3(0.5,1.2,-0.3) q[2],q[0];", "d_cu3(0.5,1.2,-0.3) q[2],q[0];"},
+        {"swap q[0],q[2]; cswap q[1],q[0],q[2];", "d_swap q[0],q[2]; d_cswap q[1],q[0],q[2];"},
+        {"rzz(0.8) q[0],q[1];", "d_rzz(0.8) q[0],q[1];"},
+        {"rxx(0.8) q[0],q[1];", "h q[0]; h q[1]; d_rzz(0.8) q[0],q[1]; h q[0]; h q[1];"},
+        {"cp(0.4) q[0],q[1]; p(0.2) q[2]; u(0.1,0.2,0.3) q[1];",
+         "d_cu1(0.4) q[0],q[1]; d_u1(0.2) q[2]; U(0.1,0.2,0.3) q[1];"},
+    };
+    const std::string header = "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[3];\n" + definitions;
+    for (std::size_t k = 0; k < pairs.size(); ++k) {
+        const std::string prefix = randomPrefix(3, k);
+        CircuitManager builtin, defined;
+        QubitManager a = runQasm(header + prefix + pairs[k].first, builtin);
+        QubitManager b = runQasm(header + prefix + pairs[k].second, defined);
+        EXPECT_NEAR(overlap(a, b), 1.0, 1e-10) << pairs[k].first;
+    }
+}
+
+// Test broadcasting over registers and angle expressions
+TEST(QasmParserTest, BroadcastsAndEvaluatesExpressions) {
+    CircuitManager broadcast, explicit_gates;
+    QubitManager a = runQasm("include \"qelib1.inc\"; qreg q[3]; qreg r[3]; h q; cx q, r; rz(-pi/2^2) r[1];"
+                             "u3(sin(pi/2)*2, ln(exp(0.5)), sqrt(4)-1.5e0) q;",
+                             broadcast);
+    QubitManager b = runQasm("include \"qelib1.inc\"; qreg q[3]; qreg r[3];"
+                             "h q[0]; h q[1]; h q[2]; cx q[0],r[0]; cx q[1],r[1]; cx q[2],r[2];"
+                             "rz(-0.7853981633974483) r[1];"
+                             "u3(2,0.5,0.5) q[0]; u3(2,0.5,0.5) q[1]; u3(2,0.5,0.5) q[2];",
+                             explicit_gates);
+    EXPECT_NEAR(overlap(a, b), 1.0, 1e-12);
+
+    CircuitManager mixed;
+    EXPECT_EQ(parseQasm("include \"qelib1.inc\"; qreg q[4]; qreg a[1]; cx a[0], q;", mixed).gates_emitted, 4u);
+    CircuitManager mismatched;
+    EXPECT_THROW(parseQasm("include \"qelib1.inc\"; qreg q[4]; qreg r[3]; cx q, r;", mismatched), QasmError);
+}
+
+// Test errors carry the line and column of the offending token
+TEST(QasmParserTest, ReportsErrorPositions) {
+    auto position = [](const std::string& source) {
+        CircuitManager circuit;
+        try {
+            parseQasm(source, circuit, "test.qasm");
+        } catch (const QasmError& error) {
+            return std::make_pair(error.line(), error.column());
+        }
+        return std::make_pair(0, 0);
+    };
+    const std::string header = "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[2];\n";
+    EXPECT_EQ(position(header + "h q[0];\n  foo q[1];\n"), std::make_pair(5, 3));   // Unknown gate
+    EXPECT_EQ(position(header + "h q[0]\nx q[1];\n"), std::make_pair(5, 1));        // Missing ';'
+    EXPECT_EQ(position(header + "x q[2];\n"), std::make_pair(4, 5));                // Index out of range
+    EXPECT_EQ(position(header + "rz q[0];\n"), std::make_pair(4, 1));               // Missing angle
+    EXPECT_EQ(position(header + "cx q[1], q[1];\n"), std::make_pair(4, 10));        // Repeated qubit
+    EXPECT_EQ(position(header + "reset q[0];\n"), std::make_pair(4, 1));            // Unsupported
+    EXPECT_EQ(position(header + "rx(theta) q[0];\n"), std::make_pair(4, 4));        // Unbound identifier
+    EXPECT_EQ(position(header + "gate g a { h b; }\n"), std::make_pair(4, 14));     // Unknown argument
+    EXPECT_EQ(position("qreg q[1];\nh q[0];\n"), std::make_pair(2, 1));             // No qelib1 included
+    EXPECT_EQ(position("OPENQASM 3.0;\n"), std::make_pair(1, 10));
+    EXPECT_EQ(position(header + "/* open comment\n"), std::make_pair(4, 1));
+
+    CircuitManager circuit;
+    try {
+        parseQasm(header + "y r[0];", circuit, "test.qasm");
+        FAIL() << "expected a QasmError";
+    } catch (const QasmError& error) {
+        EXPECT_STREQ(error.what(), "test.qasm:4:3: unknown quantum register r");
+    }
+}
+
+// Test files are read through parseQasmFile and named in errors
+TEST(QasmParserTest, ParsesFiles) {
+    const std::string path = ::testing::TempDir() + "qasm_parser_test.qasm";
+    std::ofstream(path) << "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[2];\nx q[1];\n";
+    CircuitManager circuit;
+    QasmProgram program = parseQasmFile(path, circuit);
+    EXPECT_EQ(program.num_qubits, 2);
+    EXPECT_EQ(circuit.getGate(0).gate_name, "X");
+
+    std::ofstream(path) << "qreg q[1];\nbad q;\n";
+    CircuitManager broken;
+    try {
+        parseQasmFile(path, broken);
+        FAIL() << "expected a QasmError";
+    } catch (const QasmError& error) {
+        EXPECT_EQ(std::string(error.what()).rfind(path + ":2:1:", 0), 0u) << error.what();
+    }
+    std::remove(path.c_str());
+    EXPECT_THROW(parseQasmFile(path, broken), std::runtime_error);
+}
@@ -1,6 +1,7 @@
 #include "qubit_manager.h"
 #include "utils.h"  // Include utils.h for normalizeState
 #include <gtest/gtest.h>
+#include <cstdio>
 
 // Test Initialization of QubitManager
 TEST(QubitManagerTest, Initialization) {
@@ -15,7 +16,7 @@ TEST(QubitManagerTest, Initialization) {
 // Test State Normalization
 TEST(QubitManagerTest, Normalization) {
     QubitManager qubits(5);
-    Eigen::VectorXcd& state = qubits.getState();
+    QubitManager::StateVector& state = qubits.getState();
     
     // Modify state arbitrarily
     state(0) = std::complex<double>(0.5, 0.5);
@@ -28,3 +29,56 @@ TEST(QubitManagerTest, Normalization) {
     double norm = state.squaredNorm();
     EXPECT_NEAR(norm, 1.0, 1e-6);
 }
+
+// Test registers beyond the old 5-qubit cap use an aligned 2^n buffer
+TEST(QubitManagerTest, LargeAlignedRegister) {
+    QubitManager qubits(20);
+    
+    EXPECT_EQ(qubits.getDimension(), std::uint64_t{1} << 20);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(qubits.getState().data()) % QubitManager::STATE_ALIGNMENT, 0u);
+    EXPECT_EQ(qubits.getState()(0), std::complex<double>(1.0, 0.0));
+    EXPECT_NEAR(qubits.getState().squaredNorm(), 1.0, 1e-12);
+}
+
+// Test allocations that cannot fit in memory are rejected up front
+TEST(QubitManagerTest, RejectsOversizedRegister) {
+    EXPECT_EQ(QubitManager::estimateMemoryBytes(30), std::uint64_t{16} << 30);
+    EXPECT_THROW(QubitManager(QubitManager::MAX_QUBITS), std::runtime_error);
+    EXPECT_THROW(QubitManager(QubitManager::MAX_QUBITS + 1), std::invalid_argument);
+}
+
+// Test initial state parsing and deep copies
+TEST(QubitManagerTest, InitialStateAndCopy) {
+    QubitManager qubits(3);
+    qubits.setInitialState("110");
+    EXPECT_EQ(qubits.getState()(6), std::complex<double>(1.0, 0.0));
+    EXPECT_THROW(qubits.setInitialState("1x0"), std::invalid_argument);
+
+    QubitManager copy(qubits);
+    copy.initializeZeroState();
+    EXPECT_EQ(qubits.getState()(6), std::complex<double>(1.0, 0.0));
+    EXPECT_EQ(copy.getState()(0), std::complex<double>(1.0, 0.0));
+}
+
+// Test a file-backed register starts in |0...0⟩, unlinks its file and copies into memory
+TEST(QubitManagerTest, FileBackedRegister) {
+    const std::string path = ::testing::TempDir() + "qubit_manager_backing.bin";
+    QubitManager qubits(6, path);
+    EXPECT_TRUE(qubits.isFileBacked());
+    std::FILE* backing = std::fopen(path.c_str(), "rb");
+    EXPECT_EQ(backing, nullptr);
+    if (backing != nullptr) {
+        std::fclose(backing);
+    }
+    EXPECT_EQ(qubits.getState()(0), std::complex<double>(1.0, 0.0));
+    EXPECT_NEAR(qubits.getState().norm(), 1.0, 1e-12);
+
+    qubits.setInitialState("000101");
+    QubitManager copy(qubits);
+    EXPECT_FALSE(copy.isFileBacked());
+    EXPECT_EQ(copy.getState()(5), std::complex<double>(1.0, 0.0));
+    EXPECT_FALSE(QubitManager(2).isFileBacked());
+
+    EXPECT_THROW(QubitManager(4, "/nonexistent-dir/state.bin"), std::runtime_error);
+    EXPECT_THROW(QubitManager(0, path), std::invalid_argument);
+}
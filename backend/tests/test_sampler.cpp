@@ -0,0 +1,96 @@
+#include "sampler.h"
+#include "circuit_manager.h"
+#include "gate_engine.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+
+// Test a Bell pair yields only correlated outcomes in roughly equal proportion
+TEST(SamplerTest, BellStateHistogram) {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    circuit.addGate("CNOT", 1, 0);
+    circuit.addGate("MEASURE", 0);
+    circuit.addGate("MEASURE", 1);
+    circuit.setSeed(7);
+
+    const std::uint64_t shots = 20000;
+    QubitManager qubits(2);
+    Histogram histogram = circuit.sample(qubits, shots);
+    ASSERT_EQ(histogram.size(), 2u);
+    EXPECT_EQ(histogram["00"] + histogram["11"], shots);
+    // 5 standard deviations of a fair binomial
+    EXPECT_NEAR(static_cast<double>(histogram["00"]), shots / 2.0, 5 * std::sqrt(shots / 4.0));
+
+    // The prefix ran once and the state was not collapsed
+    EXPECT_NEAR(std::abs(qubits.getState()(3)), 1.0 / std::sqrt(2), 1e-12);
+
+    // Equal seeds reproduce the histogram
+    circuit.setSeed(7);
+    QubitManager again(2);
+    EXPECT_EQ(circuit.sample(again, shots), histogram);
+    EXPECT_THROW(circuit.sample(again, 0), std::invalid_argument);
+}
+
+// Test measured subsets, unmeasured circuits and mid-circuit measurements
+TEST(SamplerTest, MarginalsAndMidCircuitMeasurement) {
+    CircuitManager subset;
+    subset.addGate("H", 0);
+    subset.addGate("X", 2);
+    subset.addGate("H", 1);
+    subset.addGate("MEASURE", 2);
+    subset.addGate("MEASURE", 0);
+    QubitManager qubits(3);
+    Histogram marginal = subset.sample(qubits, 1000);
+    ASSERT_EQ(marginal.size(), 2u);
+    EXPECT_EQ(marginal["10"] + marginal["11"], 1000u);
+
+    CircuitManager unmeasured;
+    unmeasured.addGate("X", 1);
+    QubitManager register_only(2);
+    EXPECT_EQ(unmeasured.sample(register_only, 10), (Histogram{{"10", 10}}));
+
+    // Measuring q0 before the CNOT forces per-shot simulation
+    CircuitManager mid;
+    mid.addGate("H", 0);
+    mid.addGate("MEASURE", 0);
+    mid.addGate("CNOT", 1, 0);
+    mid.addGate("MEASURE", 1);
+    mid.setSeed(3);
+    QubitManager mid_qubits(2);
+    Histogram correlated = mid.sample(mid_qubits, 400);
+    EXPECT_EQ(correlated["00"] + correlated["11"], 400u);
+    EXPECT_GT(correlated["00"], 100u);
+    EXPECT_GT(correlated["11"], 100u);
+}
+
+// Test the sorted single-pass sampler against a skewed table
+TEST(SamplerTest, SortedPassMatchesDistribution) {
+    std::mt19937_64 rng(11);
+    std::vector<double> uniforms = sortedUniforms(1000, 2.0, rng);
+    EXPECT_TRUE(std::is_sorted(uniforms.begin(), uniforms.end()));
+    EXPECT_LT(uniforms.back(), 2.0);
+
+    const std::vector<double> weights = {0.0, 0.1, 0.0, 0.6, 0.3};
+    const std::uint64_t shots = 100000;
+    OutcomeCounts counts = sampleFromProbabilities(weights, shots, rng);
+    ASSERT_EQ(counts.size(), 3u);
+    std::uint64_t total = 0;
+    for (const auto& [outcome, count] : counts) {
+        EXPECT_GT(weights[outcome], 0.0);
+        EXPECT_NEAR(static_cast<double>(count) / shots, weights[outcome], 0.01);
+        total += count;
+    }
+    EXPECT_EQ(total, shots);
+
+    // measureQubit now draws outcomes rather than thresholding at 0.5
+    GateEngine engine;
+    engine.setSeed(5);
+    int ones = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        QubitManager single(1);
+        engine.applyHadamard(single, 0);
+        ones += engine.measureQubit(single, 0);
+    }
+    EXPECT_GT(ones, 50);
+    EXPECT_LT(ones, 150);
+}
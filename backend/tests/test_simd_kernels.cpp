@@ -0,0 +1,265 @@
+#include "simd_kernels.h"
+#include "gate_engine.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+// Builds a reproducible random (unnormalized) amplitude vector
+static std::vector<std::complex<double>> randomAmplitudes(std::uint64_t dimension) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> dist;
+    std::vector<std::complex<double>> amps(dimension);
+    for (auto& a : amps) {
+        a = {dist(rng), dist(rng)};
+    }
+    return amps;
+}
+
+// Test every available SIMD level matches the scalar kernel for all targets
+TEST(SimdKernelsTest, Matrix2MatchesScalarForAllLevels) {
+    const int numQubits = 7;
+    const std::uint64_t dimension = std::uint64_t{1} << numQubits;
+    const kernels::Matrix2 m = {{{0.6, 0.1}, {-0.2, 0.7}, {0.3, -0.4}, {0.5, 0.2}}};
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+
+    for (int target = 0; target < numQubits; ++target) {
+        // Odd pair ranges exercise the scalar head/tail paths
+        for (auto range : {std::make_pair<std::uint64_t, std::uint64_t>(0, dimension / 2),
+                           std::make_pair<std::uint64_t, std::uint64_t>(3, dimension / 2 - 5)}) {
+            kernels::setSimdLevel(kernels::SimdLevel::Scalar);
+            auto expected = randomAmplitudes(dimension);
+            kernels::applyMatrix2(expected.data(), target, m, range.first, range.second);
+
+            for (auto level : {kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+                kernels::setSimdLevel(level);
+                auto actual = randomAmplitudes(dimension);
+                kernels::applyMatrix2(actual.data(), target, m, range.first, range.second);
+                for (std::uint64_t i = 0; i < dimension; ++i) {
+                    EXPECT_NEAR(std::abs(actual[i] - expected[i]), 0.0, 1e-12)
+                        << kernels::simdLevelName(kernels::getSimdLevel()) << " target " << target;
+                }
+            }
+        }
+    }
+    kernels::setSimdLevel(original);
+}
+
+// Test norm and scale kernels agree with direct computation on every level
+TEST(SimdKernelsTest, ReductionAndScale) {
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+    auto amps = randomAmplitudes(37);
+    double expected = 0.0;
+    for (std::uint64_t i = 1; i < 37; ++i) {
+        expected += std::norm(amps[i]);
+    }
+
+    for (auto level : {kernels::SimdLevel::Scalar, kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+        kernels::setSimdLevel(level);
+        EXPECT_NEAR(kernels::sumSquaredMagnitudes(amps.data(), 1, 37), expected, 1e-9);
+
+        auto scaled = amps;
+        kernels::scaleAmplitudes(scaled.data(), 0.5, 1, 37);
+        EXPECT_EQ(scaled[0], amps[0]);
+        EXPECT_NEAR(std::abs(scaled[36] - 0.5 * amps[36]), 0.0, 1e-15);
+    }
+    kernels::setSimdLevel(original);
+}
+
+// Test Pauli gates expressed through the generic kernel
+TEST(SimdKernelsTest, PauliGatesThroughKernel) {
+    QubitManager qubits(4);
+    GateEngine gateEngine;
+
+    gateEngine.applyPauliY(qubits, 2);  // |0000⟩ -> i|0100⟩
+    EXPECT_NEAR(std::abs(qubits.getState()(4) - std::complex<double>(0.0, 1.0)), 0.0, 1e-12);
+
+    gateEngine.applyPauliZ(qubits, 2);  // -> -i|0100⟩
+    EXPECT_NEAR(std::abs(qubits.getState()(4) - std::complex<double>(0.0, -1.0)), 0.0, 1e-12);
+
+    gateEngine.applyPauliX(qubits, 2);  // -> -i|0000⟩
+    EXPECT_NEAR(std::abs(qubits.getState()(0) - std::complex<double>(0.0, -1.0)), 0.0, 1e-12);
+}
+
+// Test the dense block kernel on every level, with and without qubit 0
+TEST(SimdKernelsTest, DenseMatrixMatchesScalar) {
+    const int numQubits = 6;
+    const std::uint64_t dimension = std::uint64_t{1} << numQubits;
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+    auto matrix = randomAmplitudes(64);
+
+    const std::vector<std::vector<int>> blocks = {{0, 3}, {2, 5}, {0, 1, 4}, {1, 2, 5}};
+    for (const auto& positions : blocks) {
+        const int k = static_cast<int>(positions.size());
+        const std::uint64_t count = dimension >> k;
+        kernels::setSimdLevel(kernels::SimdLevel::Scalar);
+        auto expected = randomAmplitudes(dimension);
+        kernels::applyDenseMatrix(expected.data(), positions.data(), k, matrix.data(), 1, count);
+
+        for (auto level : {kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+            kernels::setSimdLevel(level);
+            auto actual = randomAmplitudes(dimension);
+            kernels::applyDenseMatrix(actual.data(), positions.data(), k, matrix.data(), 1, count);
+            for (std::uint64_t i = 0; i < dimension; ++i) {
+                EXPECT_NEAR(std::abs(actual[i] - expected[i]), 0.0, 1e-12) << "k " << k;
+            }
+        }
+    }
+    kernels::setSimdLevel(original);
+}
+
+// Test the float kernels track the double ones to single-precision rounding on every level
+TEST(SimdKernelsTest, SinglePrecisionMatchesDouble) {
+    const int numQubits = 7;
+    const std::uint64_t dimension = std::uint64_t{1} << numQubits;
+    const kernels::Matrix2 m = {{{0.6, 0.1}, {-0.2, 0.7}, {0.3, -0.4}, {0.5, 0.2}}};
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+    auto matrix = randomAmplitudes(64);
+    const std::vector<std::vector<int>> blocks = {{1}, {0, 1}, {0, 3}, {2, 5}, {0, 1, 4}, {1, 2, 5}, {2, 3, 6}};
+    const auto reference = randomAmplitudes(dimension);
+    const std::vector<std::complex<float>> narrowed(reference.begin(), reference.end());
+    auto expectClose = [&](const std::vector<std::complex<double>>& expected,
+                           const std::vector<std::complex<float>>& actual, const std::string& what) {
+        for (std::uint64_t i = 0; i < dimension; ++i) {
+            EXPECT_NEAR(std::abs(std::complex<double>(actual[i]) - expected[i]), 0.0, 1e-5)
+                << kernels::simdLevelName(kernels::getSimdLevel()) << " " << what;
+        }
+    };
+
+    for (auto level : {kernels::SimdLevel::Scalar, kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+        kernels::setSimdLevel(level);
+        for (int target = 0; target < numQubits; ++target) {
+            auto expected = reference;
+            auto actual = narrowed;
+            kernels::applyMatrix2(expected.data(), target, m, 3, dimension / 2 - 5);
+            kernels::applyMatrix2(actual.data(), target, m, 3, dimension / 2 - 5);
+            expectClose(expected, actual, "target " + std::to_string(target));
+        }
+
+        for (const auto& positions : blocks) {
+            const int k = static_cast<int>(positions.size());
+            auto expected = reference;
+            auto actual = narrowed;
+            kernels::applyDenseMatrix(expected.data(), positions.data(), k, matrix.data(), 1, (dimension >> k) - 2);
+            kernels::applyDenseMatrix(actual.data(), positions.data(), k, matrix.data(), 1, (dimension >> k) - 2);
+            expectClose(expected, actual, "dense k " + std::to_string(k));
+        }
+
+        const double norm = kernels::sumSquaredMagnitudes(reference.data(), 1, 101);
+        EXPECT_NEAR(kernels::sumSquaredMagnitudes(narrowed.data(), 1, 101), norm, 1e-5 * norm);
+    }
+    kernels::setSimdLevel(original);
+}
+
+// Test controlled gates on every level, with contiguous runs and bit-by-bit stepping
+TEST(SimdKernelsTest, ControlledMatrix2MatchesScalar) {
+    const int numQubits = 7;
+    const std::uint64_t dimension = std::uint64_t{1} << numQubits;
+    const kernels::Matrix2 m = {{{0.6, 0.1}, {-0.2, 0.7}, {0.3, -0.4}, {0.5, 0.2}}};
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+
+    // {target, control mask, control values}: runs of 8, 4, 2 and 1 pairs, mixed negative controls
+    const std::vector<std::array<std::uint64_t, 3>> gates = {
+        {3, 0b1010000, 0b0010000}, {2, 0b1000000, 0b1000000}, {5, 0b0000010, 0b0000000}, {0, 0b0100100, 0b0100000}};
+    for (const auto& gate : gates) {
+        const int target = static_cast<int>(gate[0]);
+        const std::uint64_t count = dimension >> (__builtin_popcountll(gate[1]) + 1);
+        kernels::setSimdLevel(kernels::SimdLevel::Scalar);
+        auto expected = randomAmplitudes(dimension);
+        kernels::applyControlledMatrix2(expected.data(), target, m, gate[1], gate[2], 1, count - 1);
+
+        for (auto level : {kernels::SimdLevel::Scalar, kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+            kernels::setSimdLevel(level);
+            auto actual = randomAmplitudes(dimension);
+            // Split boundaries that fall inside runs
+            kernels::applyControlledMatrix2(actual.data(), target, m, gate[1], gate[2], 1, count / 2 + 1);
+            kernels::applyControlledMatrix2(actual.data(), target, m, gate[1], gate[2], count / 2 + 1, count - 1);
+            for (std::uint64_t i = 0; i < dimension; ++i) {
+                EXPECT_NEAR(std::abs(actual[i] - expected[i]), 0.0, 1e-12)
+                    << kernels::simdLevelName(kernels::getSimdLevel()) << " target " << target;
+            }
+        }
+    }
+    kernels::setSimdLevel(original);
+}
+
+// Test permutations match the scalar level when split into odd ranges, for runs swapped as ranges and one by one
+TEST(SimdKernelsTest, SwapMaskedPairsMatchesScalarAcrossSplits) {
+    const int numQubits = 7;
+    const std::uint64_t dimension = std::uint64_t{1} << numQubits;
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+
+    // {positions, mask_a, mask_b}: CNOT(4 -> 2), SWAP(3, 5), CNOT(3 -> 1), Toffoli(0, 4 -> 6)
+    struct Permutation {
+        std::vector<int> positions;
+        std::uint64_t mask_a;
+        std::uint64_t mask_b;
+    };
+    const std::vector<Permutation> permutations = {
+        {{2, 4}, 0b0010000, 0b0010100}, {{3, 5}, 0b0001000, 0b0100000},
+        {{1, 3}, 0b0001000, 0b0001010}, {{0, 4, 6}, 0b0010001, 0b1010001}};
+    for (const auto& p : permutations) {
+        const int k = static_cast<int>(p.positions.size());
+        const std::uint64_t count = dimension >> k;
+        kernels::setSimdLevel(kernels::SimdLevel::Scalar);
+        auto expected = randomAmplitudes(dimension);
+        kernels::swapMaskedPairs(expected.data(), p.positions.data(), k, p.mask_a, p.mask_b, 0, count);
+
+        for (auto level : {kernels::SimdLevel::Scalar, kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+            kernels::setSimdLevel(level);
+            auto actual = randomAmplitudes(dimension);
+            for (auto range : {std::make_pair<std::uint64_t, std::uint64_t>(0, 3),
+                               std::make_pair<std::uint64_t, std::uint64_t>(3, count / 2 + 1),
+                               std::make_pair(count / 2 + 1, count)}) {
+                kernels::swapMaskedPairs(actual.data(), p.positions.data(), k, p.mask_a, p.mask_b,
+                                         range.first, range.second);
+            }
+            for (std::uint64_t i = 0; i < dimension; ++i) {
+                EXPECT_EQ(actual[i], expected[i]) << kernels::simdLevelName(kernels::getSimdLevel()) << " k " << k;
+            }
+        }
+    }
+    kernels::setSimdLevel(original);
+}
+
+// Test measurement probabilities and collapse on every level, summed and applied over split pair ranges
+TEST(SimdKernelsTest, MeasurementKernelsMatchDirectComputation) {
+    const int numQubits = 7;
+    const std::uint64_t dimension = std::uint64_t{1} << numQubits;
+    const std::uint64_t pairs = dimension / 2;
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+    const auto reference = randomAmplitudes(dimension);
+    const std::vector<std::pair<std::uint64_t, std::uint64_t>> splits = {{0, 5}, {5, pairs / 2 + 3}, {pairs / 2 + 3, pairs}};
+
+    for (auto level : {kernels::SimdLevel::Scalar, kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+        kernels::setSimdLevel(level);
+        for (int target = 0; target < numQubits; ++target) {
+            const std::uint64_t bit = std::uint64_t{1} << target;
+            for (int value = 0; value < 2; ++value) {
+                double expected = 0.0;
+                for (std::uint64_t i = 0; i < dimension; ++i) {
+                    if (((i & bit) != 0) == (value == 1)) {
+                        expected += std::norm(reference[i]);
+                    }
+                }
+                double actual = 0.0;
+                for (const auto& range : splits) {
+                    actual += kernels::sumSquaredMagnitudesForBit(reference.data(), target, value,
+                                                                  range.first, range.second);
+                }
+                EXPECT_NEAR(actual, expected, 1e-9) << kernels::simdLevelName(level) << " target " << target;
+
+                auto collapsed = reference;
+                for (const auto& range : splits) {
+                    kernels::collapsePairs(collapsed.data(), target, value, 0.5, range.first, range.second);
+                }
+                for (std::uint64_t i = 0; i < dimension; ++i) {
+                    const bool kept = ((i & bit) != 0) == (value == 1);
+                    EXPECT_NEAR(std::abs(collapsed[i] - (kept ? 0.5 * reference[i] : 0.0)), 0.0, 1e-15)
+                        << kernels::simdLevelName(level) << " target " << target;
+                }
+            }
+        }
+    }
+    kernels::setSimdLevel(original);
+}
@@ -0,0 +1,128 @@
+#include "hybrid_state.h"
+#include "circuit_manager.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+// Test the sparse kernels against the dense backend on random circuits
+TEST(SparseStateTest, MatchesDenseBackend) {
+    constexpr int qubits = 6;
+    std::mt19937_64 rng(5);
+    std::uniform_int_distribution<int> qubit(0, qubits - 1);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    CircuitManager circuit;
+    for (int g = 0; g < 60; ++g) {
+        int a = qubit(rng), b = qubit(rng), c = qubit(rng);
+        while (b == a) b = qubit(rng);
+        while (c == a || c == b) c = qubit(rng);
+        switch (rng() % 9) {
+            case 0: circuit.addGate("H", a); break;
+            case 1: circuit.addGate("CNOT", a, b); break;
+            case 2: circuit.addGate("TOFFOLI", a, b, c); break;
+            case 3: circuit.addGate("SWAP", a, b); break;
+            case 4: circuit.addGate("CZ", a, b); break;
+            case 5: circuit.addParameterizedGate("RX", a, {GateParameter{angle(rng)}}); break;
+            case 6: circuit.addParameterizedGate("PHASE", a, {GateParameter{angle(rng)}}); break;
+            case 7: circuit.addControlledGate("Y", a, {b}, {c}); break;
+            default: circuit.addGate("X", a); break;
+        }
+    }
+
+    QubitManager dense(qubits);
+    circuit.executeCircuit(dense);
+    for (int width : {0, 3}) {
+        circuit.setMaxFusedWidth(width);
+        HybridState state(qubits, 1.0);
+        circuit.executeCircuit(state);
+        ASSERT_FALSE(state.isDense());
+        for (std::uint64_t i = 0; i < dense.getDimension(); ++i) {
+            EXPECT_NEAR(std::abs(state.amplitude(i) - dense.getState()(i)), 0.0, 1e-12) << i;
+        }
+    }
+}
+
+// Test a classical adder on a register far too wide for a dense vector
+TEST(SparseStateTest, WideClassicalCircuitStaysSparse) {
+    // Increment of a 40-bit counter (qubits 0-39) on a 63-qubit register
+    constexpr int qubits = 63;
+    CircuitManager increment;
+    for (int bit = 38; bit >= 0; --bit) {
+        std::vector<int> lower;
+        for (int q = 0; q <= bit; ++q) {
+            lower.push_back(q);
+        }
+        increment.addControlledGate("X", bit + 1, lower);
+    }
+    increment.addGate("X", 0);
+    increment.addGate("CNOT", 62, 39);
+    increment.addGate("MEASURE", 62);
+
+    HybridState state(qubits);
+    const std::uint64_t start = (std::uint64_t{1} << 40) - 3;  // 2^40 - 3
+    std::string label(qubits, '0');
+    for (int q = 0; q < 40; ++q) {
+        label[qubits - 1 - q] = ((start >> q) & 1) ? '1' : '0';
+    }
+    state.setInitialState(label);
+    for (int step = 0; step < 2; ++step) {
+        increment.executeCircuit(state);
+    }
+    EXPECT_EQ(state.storedAmplitudes(), 1u);
+    const std::uint64_t expected = start + 2;
+    // Qubit 62 copies the top bit each step, so two steps toggle it back to 0
+    EXPECT_NEAR(std::abs(state.amplitude(expected)), 1.0, 1e-12);
+    EXPECT_EQ(increment.getGate(increment.getCircuitSize() - 1).measurement_result, 0);
+
+    // A few superposed qubits only double the entry count each
+    CircuitManager spread;
+    for (int q = 50; q < 54; ++q) {
+        spread.addGate("H", q);
+    }
+    HybridState wide(qubits);
+    spread.executeCircuit(wide);
+    EXPECT_EQ(wide.storedAmplitudes(), 16u);
+    EXPECT_FALSE(wide.isDense());
+}
+
+// Test promotion at the occupancy threshold, measurement and invalid arguments
+TEST(SparseStateTest, PromotionAndErrors) {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    circuit.addGate("H", 1);
+    circuit.addGate("H", 2);
+    circuit.setMaxFusedWidth(0);
+    HybridState state(4, 0.25);
+    circuit.executeCircuit(state);
+    EXPECT_TRUE(state.isDense());
+    EXPECT_EQ(state.storedAmplitudes(), 16u);
+    EXPECT_NEAR(state.amplitude(7).real(), 1.0 / std::sqrt(8.0), 1e-12);
+    EXPECT_THROW(state.getSparse(), std::logic_error);
+
+    // Sparse measurement collapses and renormalizes
+    CircuitManager bell;
+    bell.addGate("H", 0);
+    bell.addGate("CNOT", 1, 0);
+    bell.addGate("MEASURE", 0);
+    bell.setSeed(2);
+    HybridState pair(2, 1.0);
+    bell.executeCircuit(pair);
+    const int result = bell.getGate(2).measurement_result;
+    const std::uint64_t survivor = result ? 3 : 0;
+    EXPECT_EQ(pair.storedAmplitudes(), 1u);
+    EXPECT_NEAR(std::abs(pair.amplitude(survivor)), 1.0, 1e-12);
+
+    // Noise needs the dense trajectory kernels
+    NoiseModel model;
+    model.addGateNoise("H", depolarizing(0.1));
+    bell.setNoiseModel(model);
+    HybridState noisy(2, 1.0);
+    bell.executeCircuit(noisy);
+    EXPECT_TRUE(noisy.isDense());
+
+    EXPECT_THROW(HybridState(0), std::invalid_argument);
+    EXPECT_THROW(HybridState(64), std::invalid_argument);
+    EXPECT_THROW(HybridState(4, 0.0), std::invalid_argument);
+    HybridState wide(50);
+    EXPECT_THROW(wide.promote(), std::invalid_argument);
+    EXPECT_THROW(wide.getDense(), std::logic_error);
+}
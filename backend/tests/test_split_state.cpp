@@ -0,0 +1,93 @@
+#include "split_state.h"
+#include "circuit_manager.h"
+#include "qubit_manager.h"
+#include <gtest/gtest.h>
+#include <random>
+
+// Builds a random circuit mixing fused-friendly gates, permutations and controls
+static CircuitManager randomCircuit(int qubits, int gates, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> qubit(0, qubits - 1);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    CircuitManager circuit;
+    for (int g = 0; g < gates; ++g) {
+        int a = qubit(rng), b = qubit(rng), c = qubit(rng);
+        while (b == a) b = qubit(rng);
+        while (c == a || c == b) c = qubit(rng);
+        switch (rng() % 7) {
+            case 0: circuit.addGate("H", a); break;
+            case 1: circuit.addGate("CNOT", a, b); break;
+            case 2: circuit.addGate("TOFFOLI", a, b, c); break;
+            case 3: circuit.addGate("SWAP", a, b); break;
+            case 4: circuit.addParameterizedGate("U3", a, {GateParameter{angle(rng)}, GateParameter{angle(rng)},
+                                                           GateParameter{angle(rng)}}); break;
+            case 5: circuit.addControlledGate("Y", a, {b}, {c}); break;
+            default: circuit.addControlledGate("PHASE", a, {b}, {}, angle(rng)); break;
+        }
+    }
+    return circuit;
+}
+
+// Test conversion to and from the interleaved layout is exact
+TEST(SplitStateTest, RoundTripsThroughInterleaved) {
+    QubitManager qubits(5);
+    CircuitManager circuit = randomCircuit(5, 40, 1);
+    circuit.executeCircuit(qubits);
+
+    SplitState split(qubits);
+    for (std::uint64_t i = 0; i < qubits.getDimension(); ++i) {
+        EXPECT_EQ(split.amplitude(i), qubits.getState()(i));
+    }
+    QubitManager back(5);
+    split.toInterleaved(back);
+    EXPECT_EQ((back.getState() - qubits.getState()).norm(), 0.0);
+
+    QubitManager wrong_width(4);
+    EXPECT_THROW(split.toInterleaved(wrong_width), std::invalid_argument);
+    EXPECT_THROW(SplitState(0), std::invalid_argument);
+
+    split.setInitialState("10010");
+    EXPECT_EQ(split.amplitude(18), std::complex<double>(1.0, 0.0));
+}
+
+// Test every SIMD level and fusion width matches the interleaved executor, measurements included
+TEST(SplitStateTest, MatchesInterleavedExecution) {
+    constexpr int qubits = 9;
+    CircuitManager circuit = randomCircuit(qubits, 150, 7);
+    circuit.addGate("MEASURE", 0);
+    circuit.addGate("H", 0);
+    circuit.addGate("MEASURE", 5);
+    const kernels::SimdLevel original = kernels::getSimdLevel();
+
+    for (int width : {0, 1, 2, 3}) {
+        circuit.setMaxFusedWidth(width);
+        for (auto level : {kernels::SimdLevel::Scalar, kernels::SimdLevel::AVX2, kernels::SimdLevel::AVX512}) {
+            kernels::setSimdLevel(level);
+            QubitManager reference(qubits);
+            circuit.setSeed(3);
+            circuit.executeCircuit(reference);
+            const int first = circuit.getGate(150).measurement_result;
+
+            SplitState split(qubits);
+            circuit.setSeed(3);
+            circuit.executeCircuit(split);
+            EXPECT_EQ(circuit.getGate(150).measurement_result, first);
+            QubitManager converted(qubits);
+            split.toInterleaved(converted);
+            EXPECT_NEAR((converted.getState() - reference.getState()).norm(), 0.0, 1e-10)
+                << kernels::simdLevelName(kernels::getSimdLevel()) << " width " << width;
+        }
+    }
+    kernels::setSimdLevel(original);
+}
+
+// Test noise models are rejected rather than silently ignored
+TEST(SplitStateTest, RejectsNoise) {
+    CircuitManager circuit;
+    circuit.addGate("H", 0);
+    NoiseModel model;
+    model.addGateNoise("H", depolarizing(0.1));
+    circuit.setNoiseModel(model);
+    SplitState split(2);
+    EXPECT_THROW(circuit.executeCircuit(split), std::invalid_argument);
+}
@@ -0,0 +1,156 @@
+#include "stabilizer_tableau.h"
+#include "circuit_manager.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+// Test stabilizer generators and measurements of Bell and GHZ states
+TEST(StabilizerTableauTest, BellAndGhzStates) {
+    StabilizerTableau bell(2);
+    bell.applyHadamard(0);
+    bell.applyCNOT(0, 1);
+    EXPECT_EQ(bell.getStabilizers(), (std::vector<std::string>{"+XX", "+ZZ"}));
+    EXPECT_FALSE(bell.isDeterministic(0));
+
+    std::mt19937_64 rng(7);
+    const int first = bell.measure(0, rng);
+    EXPECT_TRUE(bell.isDeterministic(1));
+    EXPECT_EQ(bell.measure(1, rng), first);
+
+    // Y anticommutes with Z: the flipped qubit reads 1, the phase shows in the sign
+    StabilizerTableau flipped(2);
+    flipped.applyPauliY(1);
+    EXPECT_EQ(flipped.getStabilizers(), (std::vector<std::string>{"+ZI", "-IZ"}));
+    EXPECT_EQ(flipped.measure(1, rng), 1);
+    EXPECT_EQ(flipped.measure(0, rng), 0);
+
+    // GHZ across word boundaries reads all zeros or all ones
+    StabilizerTableau ghz(130);
+    ghz.applyHadamard(0);
+    for (int q = 1; q < 130; ++q) {
+        ghz.applyCNOT(q - 1, q);
+    }
+    const int reference = ghz.measure(129, rng);
+    for (int q = 0; q < 130; ++q) {
+        EXPECT_EQ(ghz.measure(q, rng), reference);
+    }
+
+    EXPECT_THROW(StabilizerTableau(0), std::invalid_argument);
+    EXPECT_THROW(ghz.applyHadamard(130), std::out_of_range);
+    EXPECT_THROW(ghz.applyCNOT(3, 3), std::invalid_argument);
+}
+
+// Test random Clifford circuits against the state-vector backend's outcome distribution
+TEST(StabilizerTableauTest, MatchesStateVector) {
+    constexpr int qubits = 6;
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> qubit(0, qubits - 1);
+    for (int trial = 0; trial < 5; ++trial) {
+        CircuitManager circuit;
+        for (int g = 0; g < 40; ++g) {
+            const int a = qubit(rng);
+            int b = qubit(rng);
+            while (b == a) {
+                b = qubit(rng);
+            }
+            switch (rng() % 8) {
+                case 0: circuit.addGate("H", a); break;
+                case 1: circuit.addParameterizedGate("PHASE", a, {GateParameter{M_PI / 2}}); break;
+                case 2: circuit.addGate("CNOT", a, b); break;
+                case 3: circuit.addGate("CZ", a, b); break;
+                case 4: circuit.addGate("SWAP", a, b); break;
+                case 5: circuit.addGate("Y", a); break;
+                case 6: circuit.addParameterizedGate("RZ", a, {GateParameter{-M_PI / 2}}); break;
+                default: circuit.addControlledGate("X", a, {}, {b}); break;
+            }
+        }
+        ASSERT_TRUE(circuit.isClifford());
+
+        QubitManager state(qubits);
+        circuit.executeCircuit(state);
+        circuit.setBackend(Backend::Stabilizer);
+        circuit.setSeed(trial);
+        Histogram histogram = circuit.sample(qubits, 4000);
+
+        // Stabilizer-state distributions are uniform over their support
+        std::vector<double> nonzero;
+        for (std::uint64_t i = 0; i < state.getDimension(); ++i) {
+            const double p = std::norm(state.getState()(i));
+            if (p > 1e-12) {
+                nonzero.push_back(p);
+            }
+        }
+        const std::size_t support = nonzero.size();
+        for (double p : nonzero) {
+            EXPECT_NEAR(p, 1.0 / support, 1e-12);
+        }
+        EXPECT_EQ(histogram.size(), support);
+        for (const auto& [bits, count] : histogram) {
+            EXPECT_GT(std::norm(state.getState()(std::stoull(bits, nullptr, 2))), 1e-12) << bits;
+        }
+    }
+
+    // Mid-circuit measurement feeding later gates
+    CircuitManager mid;
+    mid.addGate("H", 0);
+    mid.addGate("MEASURE", 0);
+    mid.addGate("CNOT", 1, 0);
+    mid.addGate("H", 2);
+    mid.addGate("MEASURE", 1);
+    mid.addGate("MEASURE", 2);
+    mid.setBackend(Backend::Stabilizer);
+    Histogram histogram = mid.sample(3, 4000);
+    EXPECT_EQ(histogram.size(), 4u);
+    for (const auto& [bits, count] : histogram) {
+        EXPECT_EQ(bits[1], bits[2]) << bits;
+        EXPECT_NEAR(static_cast<double>(count) / 4000, 0.25, 0.04);
+    }
+}
+
+// Test automatic backend selection and the stabilizer backend's limits
+TEST(StabilizerTableauTest, AutomaticBackendSelection) {
+    constexpr int qubits = 1000;
+    CircuitManager ghz;
+    ghz.addGate("H", 0);
+    for (int q = 1; q < qubits; ++q) {
+        ghz.addGate("CNOT", q, q - 1);
+    }
+    EXPECT_EQ(ghz.selectBackend(qubits), Backend::Stabilizer);
+    EXPECT_EQ(ghz.selectBackend(4), Backend::StateVector);
+    ghz.setSeed(3);
+    Histogram histogram = ghz.sample(qubits, 200);
+    EXPECT_EQ(histogram.size(), 2u);
+    EXPECT_EQ(histogram[std::string(qubits, '0')] + histogram[std::string(qubits, '1')], 200u);
+
+    StabilizerTableau tableau(qubits);
+    ghz.addGate("MEASURE", 500);
+    ghz.executeCircuit(tableau);
+    EXPECT_NE(ghz.getGate(ghz.getCircuitSize() - 1).measurement_result, -1);
+
+    CircuitManager toffoli;
+    toffoli.addGate("TOFFOLI", 2, 0, 1);
+    EXPECT_FALSE(toffoli.isClifford());
+    EXPECT_EQ(toffoli.selectBackend(30), Backend::StateVector);
+    StabilizerTableau small(3);
+    EXPECT_THROW(toffoli.executeCircuit(small), std::invalid_argument);
+
+    CircuitManager noisy;
+    noisy.addGate("H", 0);
+    NoiseModel model;
+    model.addGateNoise("H", depolarizing(0.1));
+    noisy.setNoiseModel(model);
+    EXPECT_EQ(noisy.selectBackend(30), Backend::StateVector);
+    EXPECT_THROW(noisy.executeCircuit(small), std::invalid_argument);
+
+    CircuitManager rotation;
+    rotation.addParameterizedGate("PHASE", 0, {GateParameter{0.3}});
+    EXPECT_FALSE(rotation.isClifford());
+
+    // Unknown gates are left for the state-vector run to report
+    CircuitManager unknown;
+    unknown.addGate("H", 0);
+    unknown.addGate("FOO", 1);
+    EXPECT_FALSE(unknown.isClifford());
+    EXPECT_EQ(unknown.selectBackend(30), Backend::StateVector);
+    EXPECT_THROW(unknown.sample(2, 10), std::invalid_argument);
+}
@@ -0,0 +1,92 @@
+#include "thread_pool.h"
+#include "gate_engine.h"
+#include "qubit_manager.h"
+#include "utils.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+// Test every index is visited exactly once and sums are exact
+TEST(ThreadPoolTest, ParallelForAndSum) {
+    ThreadPool pool(4);
+    pool.setSerialThreshold(0);
+
+    std::vector<int> visits(10000, 0);
+    pool.parallelFor(0, visits.size(), [&](std::uint64_t begin, std::uint64_t end) {
+        for (std::uint64_t i = begin; i < end; ++i) {
+            visits[i]++;
+        }
+    });
+    for (int v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+
+    double sum = pool.parallelSum(0, 10000, [](std::uint64_t begin, std::uint64_t end) {
+        double partial = 0.0;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            partial += static_cast<double>(i);
+        }
+        return partial;
+    });
+    EXPECT_DOUBLE_EQ(sum, 9999.0 * 10000.0 / 2.0);
+}
+
+// Test exceptions thrown in a chunk reach the caller
+TEST(ThreadPoolTest, PropagatesExceptions) {
+    ThreadPool pool(3);
+    pool.setSerialThreshold(0);
+    EXPECT_THROW(pool.parallelFor(0, 1000, [](std::uint64_t begin, std::uint64_t) {
+        if (begin == 0) {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+}
+
+// Test threaded gates reproduce the serial result
+TEST(ThreadPoolTest, ThreadedGatesMatchSerial) {
+    ThreadPool& pool = ThreadPool::global();
+    const unsigned original_threads = pool.getThreadCount();
+    const std::uint64_t original_threshold = pool.getSerialThreshold();
+
+    auto run = [](QubitManager& qubits) {
+        GateEngine engine;
+        engine.setSeed(1);
+        for (int q = 0; q < 12; ++q) {
+            engine.applyHadamard(qubits, q);
+        }
+        engine.applyPauliY(qubits, 3);
+        engine.applyCNOT(qubits, 2, 9);
+        engine.applySWAP(qubits, 0, 11);
+        engine.applyToffoli(qubits, 1, 5, 7);
+        engine.applyPauliZ(qubits, 7);
+        engine.measureQubit(qubits, 4);
+    };
+
+    pool.setThreadCount(1);
+    QubitManager serial(12);
+    run(serial);
+
+    pool.setThreadCount(4);
+    pool.setSerialThreshold(0);
+    QubitManager threaded(12);
+    run(threaded);
+
+    for (std::uint64_t i = 0; i < serial.getDimension(); ++i) {
+        EXPECT_NEAR(std::abs(serial.getState()(i) - threaded.getState()(i)), 0.0, 1e-12);
+    }
+
+    normalizeState(threaded.getState());
+    EXPECT_NEAR(threaded.getState().squaredNorm(), 1.0, 1e-12);
+
+    pool.setThreadCount(original_threads);
+    pool.setSerialThreshold(original_threshold);
+}
+
+// Test Toffoli flips the target exactly once when both controls are set
+TEST(ThreadPoolTest, ToffoliFlipsTarget) {
+    QubitManager qubits(3);
+    GateEngine engine;
+    qubits.setInitialState("011");  // qubits 0 and 1 set
+    engine.applyToffoli(qubits, 0, 1, 2);
+    EXPECT_EQ(qubits.getState()(7), std::complex<double>(1.0, 0.0));
+}
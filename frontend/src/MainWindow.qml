@@ -62,7 +62,7 @@ ApplicationWindow {
 
                 ComboBox {
                     id: qubitCombo
-                    model: ["1", "2", "3", "4", "5"]
+                    model: Array.from({length: backend.getMaxQubits()}, (_, i) => String(i + 1))
                     currentIndex: 4  // Default to 5 qubits
                     onCurrentValueChanged: {
                         backend.setQubitCount(parseInt(currentValue))
@@ -1,8 +1,8 @@
 #include "backend_bridge.h"
+#include "utils.h"
 #include <QDebug>
 #include <sstream>
 #include <iomanip>
-#include <bitset>
 
 /// Constructs backend bridge with default 5-qubit system
 BackendBridge::BackendBridge(QObject *parent)
@@ -17,17 +17,27 @@ BackendBridge::~BackendBridge() {
 }
 
 /// Updates qubit count and resets quantum state
-/// @param count New number of qubits (1-5)
+/// @param count New number of qubits (getMinQubits()-getMaxQubits())
 void BackendBridge::setQubitCount(int count) {
-    if (count < 1 || count > 5) {
-        emit executionError("Qubit count must be between 1 and 5");
+    if (count < getMinQubits() || count > getMaxQubits()) {
+        emit executionError(QString("Qubit count must be between %1 and %2")
+            .arg(getMinQubits()).arg(getMaxQubits()));
         return;
     }
     if (count == numQubits) return;
 
+    // Allocate first so a register that does not fit leaves the old one intact
+    QubitManager *resized = nullptr;
+    try {
+        resized = new QubitManager(count);
+    } catch (const std::exception& e) {
+        emit executionError(QString("Cannot allocate %1 qubits: %2").arg(count).arg(e.what()));
+        return;
+    }
+
     numQubits = count;
     delete qubits;
-    qubits = new QubitManager(numQubits);
+    qubits = resized;
     circuit = CircuitManager();  // Reset circuit
     circuit_executed = false;
     formatQuantumState();
@@ -227,10 +237,9 @@ QString BackendBridge::getQuantumState() const {
     QString result;
     const auto& state = qubits->getState();
     
-    for (int i = 0; i < state.size(); ++i) {
+    for (std::uint64_t i = 0; i < qubits->getDimension(); ++i) {
         if (std::abs(state(i)) > 1e-6) {
-            std::bitset<5> bits(i);
-            QString basisState = QString::fromStdString(bits.to_string()).right(numQubits);
+            QString basisState = QString::fromStdString(formatBasisState(i, numQubits));
             result += QString("| %1 ⟩ : (%2, %3)\n")
                 .arg(basisState)
                 .arg(state(i).real(), 0, 'f', 6)
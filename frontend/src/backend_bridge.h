@@ -34,7 +34,7 @@ public:
     QString getCircuitDescription() const;
     QStringList getCircuitGates() const;
     bool isCircuitExecuted() const;
-    Q_INVOKABLE int getMaxQubits() const { return 5; }
+    Q_INVOKABLE int getMaxQubits() const { return QubitManager::MAX_QUBITS; }
     Q_INVOKABLE int getMinQubits() const { return 1; }
     Q_INVOKABLE int getCircuitSize() const;
 
@@ -31,7 +31,7 @@ private slots:
         BackendBridge bridge;
         bridge.setQubitCount(0);  // Out of range
         QCOMPARE(bridge.getQubitCount(), 5);  // Should remain unchanged
-        bridge.setQubitCount(6);  // Out of range
+        bridge.setQubitCount(QubitManager::MAX_QUBITS + 1);  // Out of range
         QCOMPARE(bridge.getQubitCount(), 5);  // Should remain unchanged
     }
 